@@ -0,0 +1,148 @@
+// ======================================================================
+//  Arquivo: agendador.c
+//  Descrição: Agendador de taxa fixa por timer de hardware, com
+//             contabilidade de atraso e estouro de orçamento por período
+// ======================================================================
+
+#include "agendador.h"
+#include "hardware/sync.h" // __wfe, __sev
+
+// ----------------------------------------------------------------------
+// Inicialização
+// ----------------------------------------------------------------------
+void agendador_iniciar(agendador_t *agendador, uint32_t periodo_us, uint32_t orcamento_us, uint64_t agora_us)
+{
+    agendador->periodo_us = periodo_us;
+    agendador->orcamento_us = orcamento_us;
+    agendador->inicio_us = agora_us;
+
+    agendador->liberados = 0;
+    agendador->atendidos = 0;
+    agendador->periodo_atual = 0;
+    agendador->comeco_trabalho_us = agora_us;
+
+    agendador->degradado = false;
+    agendador->periodos_sem_estouro = 0;
+
+    agendador->periodos = 0;
+    agendador->periodos_perdidos = 0;
+    agendador->estouros = 0;
+    agendador->periodos_degradados = 0;
+    agendador->atraso_us = 0;
+    agendador->atraso_maximo_us = 0;
+    agendador->atraso_total_us = 0;
+    agendador->trabalho_us = 0;
+    agendador->trabalho_maximo_us = 0;
+
+    agendador->pool = NULL;
+}
+
+// ----------------------------------------------------------------------
+// Liberação (callback do timer)
+// ----------------------------------------------------------------------
+void agendador_liberar(agendador_t *agendador)
+{
+    agendador->liberados = agendador->liberados + 1;
+}
+
+bool agendador_periodo_pendente(const agendador_t *agendador)
+{
+    return agendador->liberados != agendador->atendidos;
+}
+
+// ----------------------------------------------------------------------
+// Contabilidade de cada período
+// ----------------------------------------------------------------------
+uint32_t agendador_comecar_periodo(agendador_t *agendador, uint64_t agora_us)
+{
+    // Atende a liberação mais recente; as anteriores ainda pendentes foram perdidas
+    uint32_t liberados = agendador->liberados;
+    uint32_t pendentes = liberados - agendador->atendidos;
+    if (pendentes > 1)
+    {
+        agendador->periodos_perdidos += pendentes - 1;
+    }
+    agendador->atendidos = liberados;
+    agendador->periodo_atual = liberados;
+
+    // A liberação k é nominalmente em inicio_us + k·periodo_us (taxa fixa)
+    uint64_t nominal_us = agendador->inicio_us + (uint64_t)liberados * agendador->periodo_us;
+    uint32_t atraso_us = agora_us > nominal_us ? (uint32_t)(agora_us - nominal_us) : 0;
+    agendador->atraso_us = atraso_us;
+    agendador->atraso_total_us += atraso_us;
+    if (atraso_us > agendador->atraso_maximo_us)
+    {
+        agendador->atraso_maximo_us = atraso_us;
+    }
+
+    if (agendador->degradado)
+    {
+        agendador->periodos_degradados++;
+    }
+    agendador->comeco_trabalho_us = agora_us;
+    return liberados;
+}
+
+void agendador_terminar_periodo(agendador_t *agendador, uint64_t agora_us)
+{
+    uint32_t trabalho_us = (uint32_t)(agora_us - agendador->comeco_trabalho_us);
+    agendador->trabalho_us = trabalho_us;
+    if (trabalho_us > agendador->trabalho_maximo_us)
+    {
+        agendador->trabalho_maximo_us = trabalho_us;
+    }
+    agendador->periodos++;
+
+    // Estouro degrada já o próximo período; a volta exige uma sequência dentro do orçamento
+    if (trabalho_us > agendador->orcamento_us)
+    {
+        agendador->estouros++;
+        agendador->degradado = true;
+        agendador->periodos_sem_estouro = 0;
+    }
+    else if (agendador->degradado && ++agendador->periodos_sem_estouro >= AGENDADOR_PERIODOS_RECUPERACAO)
+    {
+        agendador->degradado = false;
+    }
+}
+
+bool agendador_baixa_prioridade(const agendador_t *agendador)
+{
+    return !agendador->degradado;
+}
+
+// ----------------------------------------------------------------------
+// Timer de hardware
+// ----------------------------------------------------------------------
+
+// Callback do timer (IRQ do núcleo do laço): libera o período e acorda o WFE.
+// O __sev cobre a liberação que chega entre o teste de pendência e o __wfe
+static bool agendador_callback(repeating_timer_t *timer)
+{
+    agendador_liberar((agendador_t *)timer->user_data);
+    __sev();
+    return true;
+}
+
+bool agendador_iniciar_timer(agendador_t *agendador)
+{
+    agendador_iniciar(agendador, agendador->periodo_us, agendador->orcamento_us, time_us_64());
+
+    agendador->pool = alarm_pool_create_with_unused_hardware_alarm(AGENDADOR_MAXIMO_TIMERS);
+    if (agendador->pool == NULL)
+    {
+        return false;
+    }
+
+    // Atraso negativo: intervalo entre os inícios dos callbacks (taxa fixa, sem deriva)
+    return alarm_pool_add_repeating_timer_us(agendador->pool, -(int64_t)agendador->periodo_us,
+                                             agendador_callback, agendador, &agendador->timer);
+}
+
+void agendador_aguardar(agendador_t *agendador)
+{
+    while (!agendador_periodo_pendente(agendador))
+    {
+        __wfe();
+    }
+}
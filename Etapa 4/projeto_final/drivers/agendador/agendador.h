@@ -0,0 +1,141 @@
+// ======================================================================
+//  Arquivo: agendador.h
+//  Descrição: Agendador de taxa fixa por timer de hardware, com
+//             contabilidade de atraso e estouro de orçamento por período
+// ======================================================================
+
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+
+#include <stdint.h>     // Tipos inteiros padrão
+#include <stdbool.h>    // Tipo booleano padrão
+#include "pico/time.h"  // repeating_timer_t, alarm_pool_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros padrão
+// ----------------------------------------------------------------------
+#define AGENDADOR_PERIODOS_RECUPERACAO 50 ///< Períodos seguidos dentro do orçamento para sair do modo degradado
+#define AGENDADOR_MAXIMO_TIMERS        2  ///< Timers do pool de alarmes do núcleo que chama agendador_iniciar_timer
+
+// ----------------------------------------------------------------------
+// Estrutura: agendador_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado e contabilidade do agendador de taxa fixa.
+ *
+ * O timer libera um período a cada periodo_us, a partir do instante inicial
+ * t0 (taxa fixa: a liberação k é em t0 + k·periodo_us, sem acumular o atraso
+ * de cada callback). O laço atende os períodos liberados:
+ *  - Atraso: início do trabalho em relação à liberação nominal do período
+ *  - Períodos perdidos: liberações que chegaram com o laço ainda ocupado;
+ *    o laço pula para a mais recente, sem tentar recuperar as anteriores
+ *  - Estouro: trabalho do período acima de orcamento_us; o período seguinte
+ *    roda degradado (sem os estágios de baixa prioridade) até
+ *    AGENDADOR_PERIODOS_RECUPERACAO períodos seguidos dentro do orçamento
+ *
+ * A contabilidade recebe o tempo como parâmetro (agendador_comecar_periodo,
+ * agendador_terminar_periodo), de modo que pode ser testada com relógio simulado.
+ */
+typedef struct {
+    uint32_t periodo_us;              ///< Período de liberação (us)
+    uint32_t orcamento_us;            ///< Trabalho máximo por período antes de degradar (us)
+    uint64_t inicio_us;               ///< Instante da liberação 0 (us desde o boot)
+
+    volatile uint32_t liberados;      ///< Períodos liberados (escrito só pelo callback do timer)
+    uint32_t atendidos;               ///< Períodos já atendidos pelo laço (próximo a atender)
+    uint32_t periodo_atual;           ///< Índice do período em execução
+    uint64_t comeco_trabalho_us;      ///< Início do trabalho do período em execução
+
+    bool degradado;                   ///< true: pular os estágios de baixa prioridade
+    uint32_t periodos_sem_estouro;    ///< Períodos seguidos dentro do orçamento
+
+    // Contabilidade
+    uint32_t periodos;                ///< Períodos executados
+    uint32_t periodos_perdidos;       ///< Liberações não atendidas (laço ocupado)
+    uint32_t estouros;                ///< Períodos com trabalho acima do orçamento
+    uint32_t periodos_degradados;     ///< Períodos executados sem a baixa prioridade
+    uint32_t atraso_us;               ///< Atraso do período em execução
+    uint32_t atraso_maximo_us;        ///< Maior atraso observado
+    uint64_t atraso_total_us;         ///< Soma dos atrasos (média = total / periodos)
+    uint32_t trabalho_us;             ///< Duração do último período executado
+    uint32_t trabalho_maximo_us;      ///< Maior duração observada
+
+    repeating_timer_t timer;          ///< Timer de hardware (agendador_iniciar_timer)
+    alarm_pool_t *pool;               ///< Pool de alarmes do núcleo do laço
+} agendador_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa o agendador e zera a contabilidade.
+ * @param agendador Estado do agendador
+ * @param periodo_us Período de liberação (us)
+ * @param orcamento_us Trabalho máximo por período antes de degradar (us)
+ * @param agora_us Instante da liberação 0 (us)
+ */
+void agendador_iniciar(agendador_t *agendador, uint32_t periodo_us, uint32_t orcamento_us, uint64_t agora_us);
+
+/**
+ * @brief Libera um período (chamada pelo callback do timer, ou pelo relógio simulado).
+ * @param agendador Estado do agendador
+ */
+void agendador_liberar(agendador_t *agendador);
+
+/**
+ * @brief Indica se há período liberado ainda não atendido.
+ * @param agendador Estado do agendador
+ */
+bool agendador_periodo_pendente(const agendador_t *agendador);
+
+/**
+ * @brief Começa o período liberado mais recente e contabiliza atraso e perdas.
+ *
+ * Só deve ser chamada com agendador_periodo_pendente() verdadeiro.
+ *
+ * @param agendador Estado do agendador
+ * @param agora_us Instante atual (us)
+ * @return Índice do período (para estágios que rodam a cada n períodos)
+ */
+uint32_t agendador_comecar_periodo(agendador_t *agendador, uint64_t agora_us);
+
+/**
+ * @brief Termina o período em execução e decide se o próximo roda degradado.
+ * @param agendador Estado do agendador
+ * @param agora_us Instante atual (us)
+ */
+void agendador_terminar_periodo(agendador_t *agendador, uint64_t agora_us);
+
+/**
+ * @brief Indica se os estágios de baixa prioridade podem rodar no período atual.
+ * @param agendador Estado do agendador
+ */
+bool agendador_baixa_prioridade(const agendador_t *agendador);
+
+/**
+ * @brief Cria um pool de alarmes no núcleo atual e inicia o timer de liberação.
+ *
+ * O callback roda na IRQ do núcleo que chama esta função (o mesmo do laço),
+ * sem depender do núcleo 0. Reinicia o instante 0 para agora.
+ *
+ * @param agendador Estado do agendador (já inicializado; deve permanecer válido)
+ * @return false se não houver alarme de hardware livre
+ */
+bool agendador_iniciar_timer(agendador_t *agendador);
+
+/**
+ * @brief Espera (WFE, núcleo em baixo consumo) até o próximo período liberado.
+ * @param agendador Estado do agendador
+ */
+void agendador_aguardar(agendador_t *agendador);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AGENDADOR_H
@@ -0,0 +1,194 @@
+// ======================================================================
+//  Arquivo: escalonador.c
+//  Descrição: Escalonador cooperativo de tarefas (execução até o fim),
+//             com prioridades, tarefas periódicas e por evento e
+//             orçamento de tempo medido por tarefa
+// ======================================================================
+
+#include "escalonador.h"
+#include "pico/time.h"      // time_us_64, best_effort_wfe_or_timeout
+#include "hardware/sync.h"  // __wfe, __sev
+#include <stdio.h>          // printf
+#include <string.h>         // memset
+
+// ----------------------------------------------------------------------
+// Inicialização e registro
+// ----------------------------------------------------------------------
+void escalonador_iniciar(escalonador_t *escalonador)
+{
+    memset(escalonador, 0, sizeof(escalonador_t));
+    escalonador->inicio_us = time_us_64();
+}
+
+int escalonador_registrar(escalonador_t *escalonador, const char *nome, escalonador_funcao_t funcao,
+                          void *contexto, uint8_t prioridade, uint32_t periodo_us, uint32_t orcamento_us)
+{
+    if (escalonador->quantidade >= ESCALONADOR_MAXIMO_TAREFAS || funcao == NULL)
+    {
+        return -1;
+    }
+
+    escalonador_tarefa_t *tarefa = &escalonador->tarefas[escalonador->quantidade];
+    memset(tarefa, 0, sizeof(escalonador_tarefa_t));
+    tarefa->nome = nome;
+    tarefa->funcao = funcao;
+    tarefa->contexto = contexto;
+    tarefa->prioridade = prioridade;
+    tarefa->periodo_us = periodo_us;
+    tarefa->orcamento_us = orcamento_us;
+    tarefa->proxima_us = time_us_64() + periodo_us;
+
+    return escalonador->quantidade++;
+}
+
+void escalonador_sinalizar(escalonador_t *escalonador, int tarefa)
+{
+    if (tarefa < 0 || tarefa >= escalonador->quantidade)
+    {
+        return;
+    }
+    escalonador->tarefas[tarefa].sinalizada = true;
+    __sev(); // Acorda o WFE de escalonador_aguardar, inclusive no outro núcleo
+}
+
+// ----------------------------------------------------------------------
+// Execução
+// ----------------------------------------------------------------------
+
+// Periódica vencida ou evento pendente
+static bool tarefa_pronta(const escalonador_tarefa_t *tarefa, uint64_t agora_us)
+{
+    if (tarefa->sinalizada)
+    {
+        return true;
+    }
+    return tarefa->periodo_us != ESCALONADOR_SEM_PERIODO && agora_us >= tarefa->proxima_us;
+}
+
+bool escalonador_executar(escalonador_t *escalonador)
+{
+    uint64_t agora_us = time_us_64();
+
+    // Pronta de maior prioridade (menor número); empate pela ordem de registro
+    escalonador_tarefa_t *escolhida = NULL;
+    for (uint8_t i = 0; i < escalonador->quantidade; i++)
+    {
+        escalonador_tarefa_t *tarefa = &escalonador->tarefas[i];
+        if (tarefa_pronta(tarefa, agora_us) && (escolhida == NULL || tarefa->prioridade < escolhida->prioridade))
+        {
+            escolhida = tarefa;
+        }
+    }
+    if (escolhida == NULL)
+    {
+        return false;
+    }
+
+    // Consome o evento antes de executar: um sinal durante a execução a deixa pronta de novo
+    escolhida->sinalizada = false;
+    if (escolhida->periodo_us != ESCALONADOR_SEM_PERIODO && agora_us >= escolhida->proxima_us)
+    {
+        uint32_t atraso_us = (uint32_t)(agora_us - escolhida->proxima_us);
+        if (atraso_us > escolhida->atraso_maximo_us)
+        {
+            escolhida->atraso_maximo_us = atraso_us;
+        }
+
+        // Taxa fixa; atrasada mais de um período, não tenta recuperar as execuções perdidas
+        escolhida->proxima_us += escolhida->periodo_us;
+        if (escolhida->proxima_us <= agora_us)
+        {
+            escolhida->proxima_us = agora_us + escolhida->periodo_us;
+        }
+    }
+
+    escolhida->funcao(escolhida->contexto);
+
+    uint32_t duracao_us = (uint32_t)(time_us_64() - agora_us);
+    escolhida->execucoes++;
+    escolhida->tempo_ultimo_us = duracao_us;
+    escolhida->tempo_total_us += duracao_us;
+    if (duracao_us > escolhida->tempo_maximo_us)
+    {
+        escolhida->tempo_maximo_us = duracao_us;
+    }
+    if (duracao_us > escolhida->orcamento_us)
+    {
+        escolhida->estouros++;
+    }
+    escalonador->ocupado_us += duracao_us;
+
+    return true;
+}
+
+void escalonador_aguardar(const escalonador_t *escalonador)
+{
+    // Vencimento periódico mais próximo; sinais pendentes não esperam
+    bool ha_periodica = false;
+    uint64_t proxima_us = 0;
+    for (uint8_t i = 0; i < escalonador->quantidade; i++)
+    {
+        const escalonador_tarefa_t *tarefa = &escalonador->tarefas[i];
+        if (tarefa->sinalizada)
+        {
+            return;
+        }
+        if (tarefa->periodo_us != ESCALONADOR_SEM_PERIODO && (!ha_periodica || tarefa->proxima_us < proxima_us))
+        {
+            proxima_us = tarefa->proxima_us;
+            ha_periodica = true;
+        }
+    }
+
+    if (ha_periodica)
+    {
+        // Retorna no vencimento ou antes, com qualquer evento (IRQ, __sev); o chamador reavalia
+        best_effort_wfe_or_timeout(from_us_since_boot(proxima_us));
+    }
+    else
+    {
+        __wfe();
+    }
+}
+
+// ----------------------------------------------------------------------
+// Estatísticas
+// ----------------------------------------------------------------------
+void escalonador_imprimir_estatisticas(const escalonador_t *escalonador)
+{
+    uint64_t decorrido_us = time_us_64() - escalonador->inicio_us;
+
+    printf("=== Tarefas (%lu s) ===\n", (unsigned long)(decorrido_us / 1000000));
+    printf("%-12s %3s %8s %8s %8s %8s %8s %8s %7s\n",
+           "tarefa", "pri", "periodo", "execs", "medio", "max", "orcam.", "atr.max", "estour.");
+    for (uint8_t i = 0; i < escalonador->quantidade; i++)
+    {
+        const escalonador_tarefa_t *tarefa = &escalonador->tarefas[i];
+        uint32_t medio_us = tarefa->execucoes > 0 ? (uint32_t)(tarefa->tempo_total_us / tarefa->execucoes) : 0;
+        printf("%-12s %3u %8lu %8lu %8lu %8lu %8lu %8lu %7lu\n",
+               tarefa->nome, (unsigned)tarefa->prioridade, (unsigned long)tarefa->periodo_us,
+               (unsigned long)tarefa->execucoes, (unsigned long)medio_us,
+               (unsigned long)tarefa->tempo_maximo_us, (unsigned long)tarefa->orcamento_us,
+               (unsigned long)tarefa->atraso_maximo_us, (unsigned long)tarefa->estouros);
+    }
+
+    // Ocupação em décimos de porcento, sem float no printf
+    uint32_t ocupacao = decorrido_us > 0 ? (uint32_t)(escalonador->ocupado_us * 1000 / decorrido_us) : 0;
+    printf("Tempos em us | ocupação: %lu.%lu%%\n", (unsigned long)(ocupacao / 10), (unsigned long)(ocupacao % 10));
+}
+
+void escalonador_zerar_estatisticas(escalonador_t *escalonador)
+{
+    for (uint8_t i = 0; i < escalonador->quantidade; i++)
+    {
+        escalonador_tarefa_t *tarefa = &escalonador->tarefas[i];
+        tarefa->execucoes = 0;
+        tarefa->estouros = 0;
+        tarefa->tempo_ultimo_us = 0;
+        tarefa->tempo_maximo_us = 0;
+        tarefa->tempo_total_us = 0;
+        tarefa->atraso_maximo_us = 0;
+    }
+    escalonador->inicio_us = time_us_64();
+    escalonador->ocupado_us = 0;
+}
@@ -0,0 +1,138 @@
+// ======================================================================
+//  Arquivo: escalonador.h
+//  Descrição: Escalonador cooperativo de tarefas (execução até o fim),
+//             com prioridades, tarefas periódicas e por evento e
+//             orçamento de tempo medido por tarefa
+// ======================================================================
+
+#ifndef ESCALONADOR_H
+#define ESCALONADOR_H
+
+#include <stdint.h>     // Tipos inteiros padrão
+#include <stdbool.h>    // Tipo booleano padrão
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros
+// ----------------------------------------------------------------------
+#define ESCALONADOR_MAXIMO_TAREFAS 8 ///< Tarefas registráveis (tabela estática, sem heap)
+#define ESCALONADOR_SEM_PERIODO    0 ///< Período de uma tarefa só por evento (escalonador_sinalizar)
+
+/**
+ * @brief Função de uma tarefa: roda até o fim, sem esperar por nada.
+ * @param contexto Ponteiro registrado com a tarefa
+ */
+typedef void (*escalonador_funcao_t)(void *contexto);
+
+// ----------------------------------------------------------------------
+// Estrutura: escalonador_tarefa_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Tarefa registrada e suas estatísticas de tempo de execução.
+ *
+ * Uma tarefa fica pronta quando seu período vence (periódica) ou quando é
+ * sinalizada (evento); as duas formas podem ser combinadas.
+ */
+typedef struct {
+    const char *nome;                 ///< Nome para o relatório
+    escalonador_funcao_t funcao;      ///< Função executada
+    void *contexto;                   ///< Argumento da função
+    uint8_t prioridade;               ///< 0 = mais alta; empate pela ordem de registro
+    uint32_t periodo_us;              ///< Período (us) ou ESCALONADOR_SEM_PERIODO
+    uint32_t orcamento_us;            ///< Duração máxima esperada de uma execução (us)
+    uint64_t proxima_us;              ///< Próximo vencimento (tarefas periódicas)
+    volatile bool sinalizada;         ///< Evento pendente (escrito por IRQ ou outro núcleo)
+
+    // Estatísticas
+    uint32_t execucoes;               ///< Execuções completas
+    uint32_t estouros;                ///< Execuções acima do orçamento
+    uint32_t tempo_ultimo_us;         ///< Duração da última execução
+    uint32_t tempo_maximo_us;         ///< Maior duração observada
+    uint64_t tempo_total_us;          ///< Soma das durações (média = total / execucoes)
+    uint32_t atraso_maximo_us;        ///< Maior atraso em relação ao vencimento (periódicas)
+} escalonador_tarefa_t;
+
+// ----------------------------------------------------------------------
+// Estrutura: escalonador_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Tabela de tarefas de um núcleo.
+ *
+ * Cooperativo: uma tarefa nunca é interrompida por outra, então a latência
+ * de uma tarefa de alta prioridade é limitada pela execução mais longa das
+ * demais. Os orçamentos tornam essa execução visível (estouros).
+ */
+typedef struct {
+    escalonador_tarefa_t tarefas[ESCALONADOR_MAXIMO_TAREFAS]; ///< Tarefas registradas
+    uint8_t quantidade;                                       ///< Tarefas em uso
+    uint64_t inicio_us;                                       ///< Início da contabilidade
+    uint64_t ocupado_us;                                      ///< Tempo total executando tarefas
+} escalonador_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa o escalonador sem tarefas.
+ * @param escalonador Estado do escalonador
+ */
+void escalonador_iniciar(escalonador_t *escalonador);
+
+/**
+ * @brief Registra uma tarefa.
+ *
+ * Tarefas periódicas vencem pela primeira vez um período após o registro.
+ *
+ * @param escalonador Estado do escalonador
+ * @param nome Nome para o relatório (deve permanecer válido)
+ * @param funcao Função da tarefa
+ * @param contexto Argumento da função
+ * @param prioridade 0 = mais alta
+ * @param periodo_us Período (us) ou ESCALONADOR_SEM_PERIODO (só por evento)
+ * @param orcamento_us Duração máxima esperada (us); acima dela a execução conta como estouro
+ * @return Identificador da tarefa, ou -1 com a tabela cheia
+ */
+int escalonador_registrar(escalonador_t *escalonador, const char *nome, escalonador_funcao_t funcao,
+                          void *contexto, uint8_t prioridade, uint32_t periodo_us, uint32_t orcamento_us);
+
+/**
+ * @brief Marca uma tarefa como pronta (seguro em IRQ e a partir do outro núcleo).
+ * @param escalonador Estado do escalonador
+ * @param tarefa Identificador retornado por escalonador_registrar
+ */
+void escalonador_sinalizar(escalonador_t *escalonador, int tarefa);
+
+/**
+ * @brief Executa até o fim a tarefa pronta de maior prioridade, se houver.
+ * @param escalonador Estado do escalonador
+ * @return true se uma tarefa foi executada
+ */
+bool escalonador_executar(escalonador_t *escalonador);
+
+/**
+ * @brief Espera (WFE) até o próximo vencimento periódico ou um sinal.
+ * @param escalonador Estado do escalonador
+ */
+void escalonador_aguardar(const escalonador_t *escalonador);
+
+/**
+ * @brief Imprime as estatísticas de cada tarefa e a ocupação do núcleo.
+ * @param escalonador Estado do escalonador
+ */
+void escalonador_imprimir_estatisticas(const escalonador_t *escalonador);
+
+/**
+ * @brief Zera as estatísticas (mantém as tarefas e seus vencimentos).
+ * @param escalonador Estado do escalonador
+ */
+void escalonador_zerar_estatisticas(escalonador_t *escalonador);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESCALONADOR_H
@@ -0,0 +1,140 @@
+// ======================================================================
+//  Arquivo: articulacao.c
+//  Descrição: Fusão direta da orientação relativa de uma articulação
+//             (dois sensores, sem orientação absoluta de cada segmento)
+// ======================================================================
+
+#include "articulacao.h"
+#include <math.h> // sqrtf
+
+// ----------------------------------------------------------------------
+// Funções auxiliares
+// ----------------------------------------------------------------------
+
+// Leva um vetor do referencial do tronco para o da coxa: Rᵀ v
+static void rotacionar_inverso(float q0, float q1, float q2, float q3, const float v[3], float saida[3])
+{
+    saida[0] = (1.0f - 2.0f*(q2*q2 + q3*q3))*v[0] + 2.0f*(q1*q2 + q0*q3)*v[1] + 2.0f*(q1*q3 - q0*q2)*v[2];
+    saida[1] = 2.0f*(q1*q2 - q0*q3)*v[0] + (1.0f - 2.0f*(q1*q1 + q3*q3))*v[1] + 2.0f*(q2*q3 + q0*q1)*v[2];
+    saida[2] = 2.0f*(q1*q3 + q0*q2)*v[0] + 2.0f*(q2*q3 - q0*q1)*v[1] + (1.0f - 2.0f*(q1*q1 + q2*q2))*v[2];
+}
+
+// Normaliza um vetor; retorna 0 se for nulo
+static int normalizar(const float v[3], float saida[3])
+{
+    float norma2 = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+    if (norma2 <= 0.0f) {
+        return 0;
+    }
+    float inv = 1.0f / sqrtf(norma2);
+    saida[0] = v[0] * inv;
+    saida[1] = v[1] * inv;
+    saida[2] = v[2] * inv;
+    return 1;
+}
+
+// Aceleração perto de 1 g: o acelerômetro mede essencialmente a gravidade
+static int mede_gravidade(const float accel[3])
+{
+    float desvio = accel[0]*accel[0] + accel[1]*accel[1] + accel[2]*accel[2] - 1.0f;
+    return desvio < ARTICULACAO_DESVIO_ACEL2_MAXIMO && desvio > -ARTICULACAO_DESVIO_ACEL2_MAXIMO;
+}
+
+// ----------------------------------------------------------------------
+// Inicialização
+// ----------------------------------------------------------------------
+void articulacao_iniciar(articulacao_t *filtro)
+{
+    filtro->q0 = 1.0f;
+    filtro->q1 = 0.0f;
+    filtro->q2 = 0.0f;
+    filtro->q3 = 0.0f;
+    filtro->integral[0] = 0.0f;
+    filtro->integral[1] = 0.0f;
+    filtro->integral[2] = 0.0f;
+    filtro->kp = ARTICULACAO_KP_PADRAO;
+    filtro->ki = ARTICULACAO_KI_PADRAO;
+    filtro->kp_mag = ARTICULACAO_KP_MAG_PADRAO;
+}
+
+// ----------------------------------------------------------------------
+// Atualização da orientação relativa
+// ----------------------------------------------------------------------
+void articulacao_atualizar(articulacao_t *filtro,
+                           const float gyro_tronco[3], const float accel_tronco[3], const float mag_tronco[3],
+                           const float gyro_coxa[3], const float accel_coxa[3], const float mag_coxa[3],
+                           float dt)
+{
+    float q0 = filtro->q0, q1 = filtro->q1, q2 = filtro->q2, q3 = filtro->q3;
+
+    // Velocidade angular relativa no referencial da coxa: ω_coxa - Rᵀ ω_tronco
+    float w[3];
+    rotacionar_inverso(q0, q1, q2, q3, gyro_tronco, w);
+    w[0] = gyro_coxa[0] - w[0];
+    w[1] = gyro_coxa[1] - w[1];
+    w[2] = gyro_coxa[2] - w[2];
+
+    float g_tronco[3], g_coxa[3];
+    if (mede_gravidade(accel_tronco) && mede_gravidade(accel_coxa) &&
+        normalizar(accel_tronco, g_tronco) && normalizar(accel_coxa, g_coxa)) {
+
+        // Vertical do tronco vista pela coxa segundo a estimativa atual
+        float v[3];
+        rotacionar_inverso(q0, q1, q2, q3, g_tronco, v);
+
+        // Erro = medida × estimativa (como no filtro de Mahony)
+        float e[3] = {
+            g_coxa[1]*v[2] - g_coxa[2]*v[1],
+            g_coxa[2]*v[0] - g_coxa[0]*v[2],
+            g_coxa[0]*v[1] - g_coxa[1]*v[0]
+        };
+
+        // Rumo relativo: só a componente do erro magnético em torno da vertical,
+        // para que distúrbios magnéticos não alterem a inclinação relativa
+        float rumo = 0.0f;
+        float m_tronco[3], m_coxa[3];
+        if (filtro->kp_mag > 0.0f && normalizar(mag_tronco, m_tronco) && normalizar(mag_coxa, m_coxa)) {
+            float u[3];
+            rotacionar_inverso(q0, q1, q2, q3, m_tronco, u);
+            float em[3] = {
+                m_coxa[1]*u[2] - m_coxa[2]*u[1],
+                m_coxa[2]*u[0] - m_coxa[0]*u[2],
+                m_coxa[0]*u[1] - m_coxa[1]*u[0]
+            };
+            rumo = em[0]*g_coxa[0] + em[1]*g_coxa[1] + em[2]*g_coxa[2];
+        }
+
+        // Realimentação integral (bias relativo dos giroscópios)
+        if (filtro->ki > 0.0f) {
+            filtro->integral[0] += filtro->ki * (e[0] + rumo*g_coxa[0]) * dt;
+            filtro->integral[1] += filtro->ki * (e[1] + rumo*g_coxa[1]) * dt;
+            filtro->integral[2] += filtro->ki * (e[2] + rumo*g_coxa[2]) * dt;
+        }
+
+        // Realimentação proporcional
+        float kr = filtro->kp_mag * rumo;
+        w[0] += filtro->kp * e[0] + kr * g_coxa[0];
+        w[1] += filtro->kp * e[1] + kr * g_coxa[1];
+        w[2] += filtro->kp * e[2] + kr * g_coxa[2];
+    }
+    w[0] += filtro->integral[0];
+    w[1] += filtro->integral[1];
+    w[2] += filtro->integral[2];
+
+    // Integra Ṙ = ½ R ⊗ ω_rel
+    float gx = 0.5f * dt * w[0];
+    float gy = 0.5f * dt * w[1];
+    float gz = 0.5f * dt * w[2];
+    float qa = q0, qb = q1, qc = q2;
+    q0 += -qb*gx - qc*gy - q3*gz;
+    q1 +=  qa*gx + qc*gz - q3*gy;
+    q2 +=  qa*gy - qb*gz + q3*gx;
+    q3 +=  qa*gz + qb*gy - qc*gx;
+
+    // Normaliza o quaternion
+    float inv = 1.0f / sqrtf(q0*q0 + q1*q1 + q2*q2 + q3*q3);
+    filtro->q0 = q0 * inv;
+    filtro->q1 = q1 * inv;
+    filtro->q2 = q2 * inv;
+    filtro->q3 = q3 * inv;
+}
@@ -0,0 +1,83 @@
+// ======================================================================
+//  Arquivo: articulacao.h
+//  Descrição: Fusão direta da orientação relativa de uma articulação
+//             (dois sensores, sem orientação absoluta de cada segmento)
+// ======================================================================
+
+#ifndef ARTICULACAO_H
+#define ARTICULACAO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Ganhos padrão
+// ----------------------------------------------------------------------
+#define ARTICULACAO_KP_PADRAO            0.5f  ///< Ganho proporcional da correção pela gravidade (rad/s)
+#define ARTICULACAO_KI_PADRAO            0.02f ///< Ganho integral (bias relativo dos giroscópios)
+#define ARTICULACAO_KP_MAG_PADRAO        0.1f  ///< Ganho da correção de rumo relativo pelos magnetômetros
+#define ARTICULACAO_DESVIO_ACEL2_MAXIMO  0.2f  ///< |‖a‖² - 1| acima do qual a gravidade não é usada (g²)
+
+// ----------------------------------------------------------------------
+// Estrutura: articulacao_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado da fusão relativa de uma articulação.
+ *
+ * O quaternion R leva vetores do referencial do sensor distal (coxa) para o do
+ * sensor proximal (tronco): v_tronco = R ⊗ v_coxa ⊗ R*. Equivale a
+ * q_tronco⁻¹ ⊗ q_coxa dos filtros absolutos, mas é estimado diretamente:
+ *  - Propagação pela diferença dos giroscópios: ω_rel = ω_coxa - Rᵀ ω_tronco
+ *  - Correção pela gravidade: a vertical medida pela coxa deve coincidir com a
+ *    medida pelo tronco levada ao referencial da coxa (Rᵀ g_tronco)
+ *  - Correção opcional do rumo relativo pelos magnetômetros (apenas a rotação
+ *    em torno da vertical), com ganho baixo
+ *
+ * A gravidade corrige dois dos três graus de liberdade; a rotação relativa em
+ * torno da vertical só é observável pelos magnetômetros ou quando a postura
+ * muda a direção da vertical nos segmentos.
+ */
+typedef struct {
+    float q0, q1, q2, q3; ///< Quaternion relativo R (coxa -> tronco)
+    float integral[3];    ///< Bias relativo estimado, referencial da coxa (rad/s)
+    float kp;             ///< Ganho proporcional (gravidade)
+    float ki;             ///< Ganho integral
+    float kp_mag;         ///< Ganho do rumo relativo (magnetômetros)
+} articulacao_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa a fusão com orientação relativa identidade e ganhos padrão.
+ * @param filtro Estado da fusão
+ */
+void articulacao_iniciar(articulacao_t *filtro);
+
+/**
+ * @brief Atualiza a orientação relativa com uma amostra de cada sensor.
+ *
+ * A correção pela gravidade é omitida se algum acelerômetro estiver zerado ou
+ * sob aceleração linear significativa; a de rumo, se algum magnetômetro estiver zerado.
+ *
+ * @param filtro Estado da fusão
+ * @param gyro_tronco Velocidade angular do sensor proximal [x, y, z] (rad/s)
+ * @param accel_tronco Aceleração do sensor proximal [x, y, z] (g)
+ * @param mag_tronco Campo magnético do sensor proximal [x, y, z] (qualquer unidade)
+ * @param gyro_coxa Velocidade angular do sensor distal [x, y, z] (rad/s)
+ * @param accel_coxa Aceleração do sensor distal [x, y, z] (g)
+ * @param mag_coxa Campo magnético do sensor distal [x, y, z] (qualquer unidade)
+ * @param dt Intervalo de integração (s)
+ */
+void articulacao_atualizar(articulacao_t *filtro,
+                           const float gyro_tronco[3], const float accel_tronco[3], const float mag_tronco[3],
+                           const float gyro_coxa[3], const float accel_coxa[3], const float mag_coxa[3],
+                           float dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARTICULACAO_H
@@ -0,0 +1,111 @@
+// ======================================================================
+//  Arquivo: complementar.c
+//  Descrição: Filtro complementar em quaternion (giroscópio + correções de
+//             inclinação pelo acelerômetro e de rumo pelo magnetômetro)
+//  Referência: R. Valenti, I. Dryanovski, J. Xiao, "Keeping a Good Attitude:
+//              A Quaternion-Based Orientation Filter for IMUs and MARGs", Sensors, 2015.
+// ======================================================================
+
+#include "complementar.h"
+#include <math.h> // sqrtf
+
+// Limite abaixo do qual a correção é singular (vetor oposto à referência)
+#define COMPLEMENTAR_EPSILON 1e-6f
+
+// ----------------------------------------------------------------------
+// Funções internas
+// ----------------------------------------------------------------------
+
+// Rotaciona v do referencial do sensor para o da Terra: out = q ⊗ v ⊗ q*
+static void rotacionar_para_terra(const complementar_t *f, const float v[3], float out[3])
+{
+    float w = f->q0, x = f->q1, y = f->q2, z = f->q3;
+    out[0] = (1.0f - 2.0f*(y*y + z*z))*v[0] + 2.0f*(x*y - w*z)*v[1] + 2.0f*(x*z + w*y)*v[2];
+    out[1] = 2.0f*(x*y + w*z)*v[0] + (1.0f - 2.0f*(x*x + z*z))*v[1] + 2.0f*(y*z - w*x)*v[2];
+    out[2] = 2.0f*(x*z - w*y)*v[0] + 2.0f*(y*z + w*x)*v[1] + (1.0f - 2.0f*(x*x + y*y))*v[2];
+}
+
+// Interpola a correção (dw, dx, dy, dz) a partir da identidade e aplica à esquerda: q = Δ ⊗ q
+static void aplicar_correcao(complementar_t *f, float dw, float dx, float dy, float dz, float alfa)
+{
+    // NLERP entre identidade e Δ (dw >= 0, então o caminho é o mais curto)
+    dw = (1.0f - alfa) + alfa*dw;
+    dx *= alfa; dy *= alfa; dz *= alfa;
+    float inv = 1.0f / sqrtf(dw*dw + dx*dx + dy*dy + dz*dz);
+    dw *= inv; dx *= inv; dy *= inv; dz *= inv;
+
+    float w = f->q0, x = f->q1, y = f->q2, z = f->q3;
+    f->q0 = dw*w - dx*x - dy*y - dz*z;
+    f->q1 = dw*x + dx*w + dy*z - dz*y;
+    f->q2 = dw*y - dx*z + dy*w + dz*x;
+    f->q3 = dw*z + dx*y - dy*x + dz*w;
+}
+
+// Limita o fator de interpolação a [0, 1]
+static float fator_interpolacao(float ganho, float dt)
+{
+    float alfa = ganho * dt;
+    return (alfa > 1.0f) ? 1.0f : alfa;
+}
+
+// ----------------------------------------------------------------------
+// Inicialização do filtro
+// ----------------------------------------------------------------------
+void complementar_iniciar(complementar_t *filtro)
+{
+    filtro->q0 = 1.0f;
+    filtro->q1 = 0.0f;
+    filtro->q2 = 0.0f;
+    filtro->q3 = 0.0f;
+    filtro->ganho_acel = COMPLEMENTAR_GANHO_ACEL_PADRAO;
+    filtro->ganho_mag = COMPLEMENTAR_GANHO_MAG_PADRAO;
+}
+
+// ----------------------------------------------------------------------
+// Atualização da orientação
+// ----------------------------------------------------------------------
+void complementar_atualizar(complementar_t *filtro, const float gyro[3], const float accel[3], const float mag[3], float dt)
+{
+    // === 1. Predição pelo giroscópio: q += 0.5 * q ⊗ (0, ω) * dt ===
+    float gx = 0.5f * dt * gyro[0], gy = 0.5f * dt * gyro[1], gz = 0.5f * dt * gyro[2];
+    float w = filtro->q0, x = filtro->q1, y = filtro->q2, z = filtro->q3;
+    w += -x*gx - y*gy - z*gz;
+    x +=  filtro->q0*gx + y*gz - z*gy;
+    y +=  filtro->q0*gy - filtro->q1*gz + z*gx;
+    z +=  filtro->q0*gz + filtro->q1*gy - filtro->q2*gx;
+    float inv = 1.0f / sqrtf(w*w + x*x + y*y + z*z);
+    filtro->q0 = w * inv; filtro->q1 = x * inv; filtro->q2 = y * inv; filtro->q3 = z * inv;
+
+    // === 2. Correção de inclinação: leva a gravidade medida para +Z da Terra ===
+    float norma2 = accel[0]*accel[0] + accel[1]*accel[1] + accel[2]*accel[2];
+    if (norma2 > 0.0f) {
+        float g[3];
+        rotacionar_para_terra(filtro, accel, g);
+        inv = 1.0f / sqrtf(norma2);
+        g[0] *= inv; g[1] *= inv; g[2] *= inv;
+
+        // Rotação mínima de g até (0, 0, 1): eixo g × z, sem componente vertical
+        float s = 2.0f * (1.0f + g[2]);
+        if (s > COMPLEMENTAR_EPSILON) {
+            float raiz = sqrtf(s);
+            aplicar_correcao(filtro, 0.5f * raiz, g[1] / raiz, -g[0] / raiz, 0.0f,
+                             fator_interpolacao(filtro->ganho_acel, dt));
+        }
+    }
+
+    // === 3. Correção de rumo: gira em torno da vertical até o norte ficar em +X ===
+    norma2 = mag[0]*mag[0] + mag[1]*mag[1] + mag[2]*mag[2];
+    if (norma2 > 0.0f) {
+        float l[3];
+        rotacionar_para_terra(filtro, mag, l);
+        float gama = l[0]*l[0] + l[1]*l[1];
+        float raiz_gama = sqrtf(gama);
+        float s = 2.0f * (gama + l[0]*raiz_gama);
+        if (gama > COMPLEMENTAR_EPSILON && s > COMPLEMENTAR_EPSILON) {
+            // cos(θ/2) = sqrt((Γ + lx·√Γ) / 2Γ), sin(θ/2) = -ly / sqrt(2(Γ + lx·√Γ))
+            float raiz = sqrtf(s);
+            aplicar_correcao(filtro, raiz / (2.0f * raiz_gama), 0.0f, 0.0f, -l[1] / raiz,
+                             fator_interpolacao(filtro->ganho_mag, dt));
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// ======================================================================
+//  Arquivo: complementar.h
+//  Descrição: Filtro complementar em quaternion (giroscópio + correções de
+//             inclinação pelo acelerômetro e de rumo pelo magnetômetro)
+// ======================================================================
+
+#ifndef COMPLEMENTAR_H
+#define COMPLEMENTAR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Ganhos padrão (fração da correção aplicada por segundo)
+// ----------------------------------------------------------------------
+#define COMPLEMENTAR_GANHO_ACEL_PADRAO  2.0f ///< Correção de inclinação (1/s)
+#define COMPLEMENTAR_GANHO_MAG_PADRAO   0.5f ///< Correção de rumo (1/s)
+
+// ----------------------------------------------------------------------
+// Estrutura: complementar_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado do filtro complementar para um sensor.
+ *
+ * A cada amostra a orientação é propagada pelo giroscópio e então corrigida
+ * por dois quaternions de correção desacoplados (Valenti et al., 2015): o do
+ * acelerômetro só altera a inclinação e o do magnetômetro só gira em torno da
+ * vertical. Cada correção é interpolada a partir da identidade por ganho * dt.
+ *
+ * O quaternion segue a mesma convenção do filtro de Madgwick: orientação do
+ * sensor em relação à Terra (v_terra = q ⊗ v_sensor ⊗ q*), norte magnético em +X.
+ */
+typedef struct {
+    float q0, q1, q2, q3; ///< Quaternion de orientação (w, x, y, z)
+    float ganho_acel;     ///< Ganho da correção de inclinação (1/s)
+    float ganho_mag;      ///< Ganho da correção de rumo (1/s)
+} complementar_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa o filtro com orientação identidade e ganhos padrão.
+ * @param filtro Estado do filtro
+ */
+void complementar_iniciar(complementar_t *filtro);
+
+/**
+ * @brief Atualiza a orientação com uma amostra do sensor.
+ *
+ * Com o magnetômetro zerado (ou acelerômetro zerado) a respectiva correção é omitida.
+ *
+ * @param filtro Estado do filtro
+ * @param gyro Velocidade angular [x, y, z] (rad/s)
+ * @param accel Aceleração [x, y, z] (qualquer unidade)
+ * @param mag Campo magnético [x, y, z] (qualquer unidade)
+ * @param dt Intervalo de integração (s)
+ */
+void complementar_atualizar(complementar_t *filtro, const float gyro[3], const float accel[3], const float mag[3], float dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPLEMENTAR_H
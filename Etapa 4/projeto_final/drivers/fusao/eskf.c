@@ -0,0 +1,256 @@
+// ======================================================================
+//  Arquivo: eskf.c
+//  Descrição: Filtro de Kalman de estado de erro (ESKF) para orientação e
+//             bias do giroscópio
+//  Referência: J. Solà, "Quaternion kinematics for the error-state Kalman
+//              filter", arXiv:1711.02508, 2017.
+// ======================================================================
+
+#include "eskf.h"
+#include <math.h>    // sqrtf, atan2f
+#include <stdbool.h> // bool
+#include <string.h>  // memset
+
+// ----------------------------------------------------------------------
+// Funções internas
+// ----------------------------------------------------------------------
+
+// Reinicia a covariância para a incerteza inicial (erros não correlacionados)
+static void covariancia_inicial(eskf_t *filtro)
+{
+    memset(filtro->P, 0, sizeof(filtro->P));
+    const float var_atitude = ESKF_INCERTEZA_ATITUDE_INICIAL * ESKF_INCERTEZA_ATITUDE_INICIAL;
+    const float var_bias = ESKF_INCERTEZA_BIAS_INICIAL * ESKF_INCERTEZA_BIAS_INICIAL;
+    for (int i = 0; i < 3; i++) {
+        filtro->P[i][i] = var_atitude;
+        filtro->P[i + 3][i + 3] = var_bias;
+    }
+}
+
+/*
+ * Atualização escalar de Kalman para uma medida z = h·δθ + ruído (h só tem
+ * componentes de atitude). Acumula a correção em dx e reduz P.
+ * Custo: ~80 multiplicações, uma divisão.
+ */
+static void atualizacao_escalar(float P[6][6], float dx[6], const float h[3], float inovacao, float variancia)
+{
+    float PHt[6];
+    for (int i = 0; i < 6; i++) {
+        PHt[i] = P[i][0] * h[0] + P[i][1] * h[1] + P[i][2] * h[2];
+    }
+
+    float S = h[0] * PHt[0] + h[1] * PHt[1] + h[2] * PHt[2] + variancia;
+    float inv_S = 1.0f / S;
+
+    // Inovação relativa ao erro já estimado nas medidas anteriores
+    float y = inovacao - (h[0] * dx[0] + h[1] * dx[1] + h[2] * dx[2]);
+
+    float K[6];
+    for (int i = 0; i < 6; i++) {
+        K[i] = PHt[i] * inv_S;
+        dx[i] += K[i] * y;
+    }
+
+    // P = P - K·(HP); apenas o triângulo superior é calculado e espelhado
+    for (int i = 0; i < 6; i++) {
+        for (int j = i; j < 6; j++) {
+            P[i][j] -= K[i] * PHt[j];
+            P[j][i] = P[i][j];
+        }
+    }
+}
+
+// Propaga a covariância: F = [[Ψ, -I·dt], [0, I]], Ψ = I - [ω·dt]×
+static void propagar_covariancia(eskf_t *filtro, const float w[3], float dt)
+{
+    float (*P)[6] = filtro->P;
+    const float tx = w[0] * dt, ty = w[1] * dt, tz = w[2] * dt;
+    const float Psi[3][3] = {
+        { 1.0f,   tz,  -ty },
+        {  -tz, 1.0f,   tx },
+        {   ty,  -tx, 1.0f }
+    };
+
+    // Blocos: A = P_θθ, B = P_θb, C = P_bb
+    float M[3][3], N[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            M[i][j] = Psi[i][0] * P[0][j] + Psi[i][1] * P[1][j] + Psi[i][2] * P[2][j];           // Ψ·A
+            N[i][j] = Psi[i][0] * P[0][j + 3] + Psi[i][1] * P[1][j + 3] + Psi[i][2] * P[2][j + 3]; // Ψ·B
+        }
+    }
+
+    const float ruido_atitude = filtro->ruido_giro * filtro->ruido_giro * dt;
+    const float ruido_bias = filtro->ruido_bias * filtro->ruido_bias * dt;
+    const float dt2 = dt * dt;
+
+    // A' = Ψ·A·Ψᵀ - dt·(Ψ·B + (Ψ·B)ᵀ) + dt²·C + Q_θ
+    float A[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            A[i][j] = M[i][0] * Psi[j][0] + M[i][1] * Psi[j][1] + M[i][2] * Psi[j][2]
+                    - dt * (N[i][j] + N[j][i]) + dt2 * P[i + 3][j + 3];
+        }
+        A[i][i] += ruido_atitude;
+    }
+
+    // B' = Ψ·B - dt·C (usa C antes da atualização)
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            P[i][j + 3] = N[i][j] - dt * P[i + 3][j + 3];
+            P[j + 3][i] = P[i][j + 3];
+        }
+    }
+
+    // C' = C + Q_b
+    for (int i = 0; i < 3; i++) {
+        P[i + 3][i + 3] += ruido_bias;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            P[i][j] = A[i][j];
+            P[j][i] = A[i][j];
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+// Inicialização do filtro
+// ----------------------------------------------------------------------
+void eskf_iniciar(eskf_t *filtro)
+{
+    filtro->q0 = 1.0f;
+    filtro->q1 = 0.0f;
+    filtro->q2 = 0.0f;
+    filtro->q3 = 0.0f;
+    filtro->bias[0] = 0.0f;
+    filtro->bias[1] = 0.0f;
+    filtro->bias[2] = 0.0f;
+    filtro->ruido_giro = ESKF_RUIDO_GIRO_PADRAO;
+    filtro->ruido_bias = ESKF_RUIDO_BIAS_PADRAO;
+    filtro->ruido_acel = ESKF_RUIDO_ACEL_PADRAO;
+    filtro->ruido_rumo = ESKF_RUIDO_RUMO_PADRAO;
+    covariancia_inicial(filtro);
+}
+
+// ----------------------------------------------------------------------
+// Definição direta da orientação
+// ----------------------------------------------------------------------
+void eskf_definir_orientacao(eskf_t *filtro, float q0, float q1, float q2, float q3)
+{
+    filtro->q0 = q0;
+    filtro->q1 = q1;
+    filtro->q2 = q2;
+    filtro->q3 = q3;
+    covariancia_inicial(filtro);
+}
+
+// ----------------------------------------------------------------------
+// Atualização da orientação
+// ----------------------------------------------------------------------
+void eskf_atualizar(eskf_t *filtro, const float gyro[3], const float accel[3], const float mag[3], float dt)
+{
+    // === 1. Propagação do estado nominal pelo giroscópio sem bias ===
+    float w[3] = {
+        gyro[0] - filtro->bias[0],
+        gyro[1] - filtro->bias[1],
+        gyro[2] - filtro->bias[2]
+    };
+
+    float q0 = filtro->q0, q1 = filtro->q1, q2 = filtro->q2, q3 = filtro->q3;
+    float meio_dt = 0.5f * dt;
+    float n0 = q0 + meio_dt * (-q1 * w[0] - q2 * w[1] - q3 * w[2]);
+    float n1 = q1 + meio_dt * ( q0 * w[0] + q2 * w[2] - q3 * w[1]);
+    float n2 = q2 + meio_dt * ( q0 * w[1] - q1 * w[2] + q3 * w[0]);
+    float n3 = q3 + meio_dt * ( q0 * w[2] + q1 * w[1] - q2 * w[0]);
+    float inv_norma = 1.0f / sqrtf(n0 * n0 + n1 * n1 + n2 * n2 + n3 * n3);
+    q0 = n0 * inv_norma;
+    q1 = n1 * inv_norma;
+    q2 = n2 * inv_norma;
+    q3 = n3 * inv_norma;
+
+    // === 2. Propagação da covariância do erro ===
+    propagar_covariancia(filtro, w, dt);
+
+    // Gravidade prevista no referencial do sensor (terceira linha da matriz de rotação)
+    float vx = 2.0f * (q1 * q3 - q0 * q2);
+    float vy = 2.0f * (q0 * q1 + q2 * q3);
+    float vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+
+    float dx[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    // === 3. Correção de inclinação pelo acelerômetro: a = v + [v]×·δθ ===
+    float norma2_acel = accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2];
+    if (norma2_acel > 0.0f) {
+        float inv = 1.0f / sqrtf(norma2_acel);
+        float ax = accel[0] * inv, ay = accel[1] * inv, az = accel[2] * inv;
+
+        // Aceleração linear afasta ‖a‖ de 1 g: aumenta a variância da medida
+        float desvio = norma2_acel - 1.0f;
+        float variancia = filtro->ruido_acel * filtro->ruido_acel + desvio * desvio;
+
+        const float hx[3] = { 0.0f, -vz,   vy };
+        const float hy[3] = {   vz, 0.0f, -vx };
+        const float hz[3] = {  -vy,   vx, 0.0f };
+        atualizacao_escalar(filtro->P, dx, hx, ax - vx, variancia);
+        atualizacao_escalar(filtro->P, dx, hy, ay - vy, variancia);
+        atualizacao_escalar(filtro->P, dx, hz, az - vz, variancia);
+    }
+
+    // === 4. Correção de rumo pelo magnetômetro (só em torno da vertical) ===
+    bool rumo_medido = false;
+    float norma2_mag = mag[0] * mag[0] + mag[1] * mag[1] + mag[2] * mag[2];
+    if (norma2_mag > 0.0f) {
+        // Componentes horizontais do campo no referencial da Terra
+        float hx = (1.0f - 2.0f * (q2 * q2 + q3 * q3)) * mag[0] + 2.0f * (q1 * q2 - q0 * q3) * mag[1] + 2.0f * (q1 * q3 + q0 * q2) * mag[2];
+        float hy = 2.0f * (q1 * q2 + q0 * q3) * mag[0] + (1.0f - 2.0f * (q1 * q1 + q3 * q3)) * mag[1] + 2.0f * (q2 * q3 - q0 * q1) * mag[2];
+
+        // Campo quase vertical: rumo indefinido
+        if (hx * hx + hy * hy > 1e-3f * norma2_mag) {
+            // O erro δθ gira o rumo estimado de -(v·δθ); o norte de referência está em +X
+            const float h_rumo[3] = { vx, vy, vz };
+            float rumo = atan2f(hy, hx);
+            atualizacao_escalar(filtro->P, dx, h_rumo, -rumo, filtro->ruido_rumo * filtro->ruido_rumo);
+            rumo_medido = true;
+        }
+    }
+
+    // Sem rumo medido, a rotação e o bias em torno da vertical não são observáveis:
+    // a correção nessa direção viria só de correlações espúrias (aceleração linear
+    // confundida com inclinação) e faria o bias divergir. Ela é descartada.
+    if (!rumo_medido) {
+        float vertical = dx[0] * vx + dx[1] * vy + dx[2] * vz;
+        dx[0] -= vertical * vx;
+        dx[1] -= vertical * vy;
+        dx[2] -= vertical * vz;
+        vertical = dx[3] * vx + dx[4] * vy + dx[5] * vz;
+        dx[3] -= vertical * vx;
+        dx[4] -= vertical * vy;
+        dx[5] -= vertical * vz;
+    }
+
+    // === 5. Injeção do erro no estado nominal: q = q ⊗ [1, δθ/2], b = b + δb ===
+    float ex = 0.5f * dx[0], ey = 0.5f * dx[1], ez = 0.5f * dx[2];
+    n0 = q0 - q1 * ex - q2 * ey - q3 * ez;
+    n1 = q1 + q0 * ex + q2 * ez - q3 * ey;
+    n2 = q2 + q0 * ey - q1 * ez + q3 * ex;
+    n3 = q3 + q0 * ez + q1 * ey - q2 * ex;
+    inv_norma = 1.0f / sqrtf(n0 * n0 + n1 * n1 + n2 * n2 + n3 * n3);
+    filtro->q0 = n0 * inv_norma;
+    filtro->q1 = n1 * inv_norma;
+    filtro->q2 = n2 * inv_norma;
+    filtro->q3 = n3 * inv_norma;
+
+    filtro->bias[0] += dx[3];
+    filtro->bias[1] += dx[4];
+    filtro->bias[2] += dx[5];
+}
+
+// ----------------------------------------------------------------------
+// Incerteza da atitude
+// ----------------------------------------------------------------------
+float eskf_variancia_atitude(const eskf_t *filtro)
+{
+    return filtro->P[0][0] + filtro->P[1][1] + filtro->P[2][2];
+}
@@ -0,0 +1,99 @@
+// ======================================================================
+//  Arquivo: eskf.h
+//  Descrição: Filtro de Kalman de estado de erro (ESKF) para orientação e
+//             bias do giroscópio
+// ======================================================================
+
+#ifndef ESKF_H
+#define ESKF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros padrão de ruído
+// ----------------------------------------------------------------------
+#define ESKF_RUIDO_GIRO_PADRAO   0.005f  ///< Densidade de ruído do giroscópio (rad/s/√Hz), inclui erro de escala
+#define ESKF_RUIDO_BIAS_PADRAO   0.0002f ///< Passeio aleatório do bias (rad/s/√s)
+#define ESKF_RUIDO_ACEL_PADRAO   0.1f    ///< Desvio do acelerômetro normalizado (adimensional), cobre aceleração linear moderada
+#define ESKF_RUIDO_RUMO_PADRAO   0.05f   ///< Desvio do rumo medido pelo magnetômetro (rad)
+#define ESKF_INCERTEZA_ATITUDE_INICIAL 0.3f  ///< Desvio inicial da atitude (rad)
+#define ESKF_INCERTEZA_BIAS_INICIAL    0.02f ///< Desvio inicial do bias (rad/s)
+
+// ----------------------------------------------------------------------
+// Estrutura: eskf_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado do ESKF para um sensor.
+ *
+ * Estado nominal: quaternion de orientação e bias do giroscópio. Estado de
+ * erro (6): pequeno ângulo de atitude no referencial do sensor
+ * (q_real = q ⊗ δq(δθ)) e erro do bias. P é a covariância desse erro.
+ *
+ * As medidas são processadas uma componente por vez (atualizações escalares
+ * sequenciais), de modo que não há inversão de matriz; tudo usa matrizes de
+ * tamanho fixo, sem alocação dinâmica.
+ *
+ * O quaternion segue a mesma convenção do filtro de Madgwick: orientação do
+ * sensor em relação à Terra (v_terra = q ⊗ v_sensor ⊗ q*), norte magnético em +X.
+ */
+typedef struct {
+    float q0, q1, q2, q3; ///< Quaternion de orientação (w, x, y, z)
+    float bias[3];        ///< Bias estimado do giroscópio (rad/s)
+    float P[6][6];        ///< Covariância do estado de erro [δθ, δb]
+    float ruido_giro;     ///< Densidade de ruído do giroscópio (rad/s/√Hz)
+    float ruido_bias;     ///< Passeio aleatório do bias (rad/s/√s)
+    float ruido_acel;     ///< Desvio do acelerômetro normalizado
+    float ruido_rumo;     ///< Desvio do rumo magnético (rad)
+} eskf_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa o filtro com orientação identidade, bias nulo, ruídos
+ *        padrão e covariância inicial.
+ * @param filtro Estado do filtro
+ */
+void eskf_iniciar(eskf_t *filtro);
+
+/**
+ * @brief Define a orientação e reinicia a covariância para a incerteza inicial.
+ * @param filtro Estado do filtro
+ * @param q0 Componente w
+ * @param q1 Componente x
+ * @param q2 Componente y
+ * @param q3 Componente z
+ */
+void eskf_definir_orientacao(eskf_t *filtro, float q0, float q1, float q2, float q3);
+
+/**
+ * @brief Propaga pelo giroscópio e corrige com acelerômetro e magnetômetro.
+ *
+ * O ruído do acelerômetro é inflado conforme |‖a‖² - 1|, reduzindo a
+ * correção durante acelerações lineares. O magnetômetro corrige apenas o
+ * rumo (rotação em torno da vertical). Medidas zeradas são ignoradas; sem
+ * magnetômetro, rumo e bias vertical ficam só com a integração do giroscópio.
+ *
+ * @param filtro Estado do filtro
+ * @param gyro Velocidade angular [x, y, z] (rad/s)
+ * @param accel Aceleração [x, y, z] (g)
+ * @param mag Campo magnético [x, y, z] (qualquer unidade)
+ * @param dt Intervalo de integração (s)
+ */
+void eskf_atualizar(eskf_t *filtro, const float gyro[3], const float accel[3], const float mag[3], float dt);
+
+/**
+ * @brief Variância total do erro de atitude (traço do bloco 3x3 de δθ).
+ * @param filtro Estado do filtro
+ * @return Variância (rad²)
+ */
+float eskf_variancia_atitude(const eskf_t *filtro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESKF_H
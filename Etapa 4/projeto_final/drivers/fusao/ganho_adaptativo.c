@@ -0,0 +1,42 @@
+// ======================================================================
+//  Arquivo: ganho_adaptativo.c
+//  Descrição: Ganho da fusão sensorial adaptado à intensidade do movimento
+// ======================================================================
+
+#include "ganho_adaptativo.h"
+
+// ----------------------------------------------------------------------
+// Inicialização
+// ----------------------------------------------------------------------
+void ganho_adaptativo_iniciar(ganho_adaptativo_t *ganho, float frequencia_hz)
+{
+    ganho->recuperacao = 0;
+    ganho->amostras_recuperacao = (uint16_t)(GANHO_TEMPO_RECUPERACAO_S * frequencia_hz + 0.5f);
+}
+
+// ----------------------------------------------------------------------
+// Fator do ganho para a amostra atual
+// ----------------------------------------------------------------------
+float ganho_adaptativo_fator(ganho_adaptativo_t *ganho, const float accel[3], const float gyro[3])
+{
+    float desvio_acel2 = accel[0]*accel[0] + accel[1]*accel[1] + accel[2]*accel[2] - 1.0f;
+    float giro2 = gyro[0]*gyro[0] + gyro[1]*gyro[1] + gyro[2]*gyro[2];
+
+    // Aceleração linear significativa: o acelerômetro não indica a vertical
+    if (desvio_acel2 > GANHO_DESVIO_ACEL2_MAXIMO || desvio_acel2 < -GANHO_DESVIO_ACEL2_MAXIMO) {
+        ganho->recuperacao = ganho->amostras_recuperacao;
+        return 0.0f;
+    }
+
+    if (giro2 > GANHO_GIRO2_MOVIMENTO) {
+        ganho->recuperacao = ganho->amostras_recuperacao;
+        return GANHO_FATOR_MOVIMENTO;
+    }
+
+    if (ganho->recuperacao > 0) {
+        ganho->recuperacao--;
+        return GANHO_FATOR_MOVIMENTO;
+    }
+
+    return (giro2 < GANHO_GIRO2_REPOUSO) ? GANHO_FATOR_REPOUSO : 1.0f;
+}
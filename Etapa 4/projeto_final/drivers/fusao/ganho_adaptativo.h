@@ -0,0 +1,79 @@
+// ======================================================================
+//  Arquivo: ganho_adaptativo.h
+//  Descrição: Ganho da fusão sensorial adaptado à intensidade do movimento
+// ======================================================================
+
+#ifndef GANHO_ADAPTATIVO_H
+#define GANHO_ADAPTATIVO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros padrão
+// ----------------------------------------------------------------------
+// Os fatores multiplicam o ganho nominal do filtro. Para o Madgwick
+// (beta nominal 0.2) resultam em 0.1 parado e 1.0 em movimento.
+#define GANHO_FATOR_REPOUSO         0.5f  ///< Fator parado: atenua o ruído do acelerômetro
+#define GANHO_FATOR_MOVIMENTO       5.0f  ///< Fator em movimento rápido: corrige a deriva do giroscópio mais depressa
+#define GANHO_GIRO2_REPOUSO         0.01f ///< ‖ω‖² abaixo do qual o sensor está parado ((rad/s)², ~6°/s)
+#define GANHO_GIRO2_MOVIMENTO       1.0f  ///< ‖ω‖² acima do qual o movimento é rápido ((rad/s)², ~57°/s)
+#define GANHO_DESVIO_ACEL2_MAXIMO   0.2f  ///< |‖a‖² - 1| acima do qual o acelerômetro é ignorado (g², ~10% da norma)
+#define GANHO_TEMPO_RECUPERACAO_S   0.5f  ///< Tempo com fator de movimento após um movimento rápido ou rejeição (s)
+
+// Teto do beta efetivo do Madgwick (nominal × escala de aquecimento × fator):
+// o aquecimento (×5) combinado com o fator de movimento chegaria a 5.0, 25× o
+// nominal; o teto é o ganho de movimento rápido em operação normal.
+#define GANHO_BETA_MAXIMO           1.0f
+
+// ----------------------------------------------------------------------
+// Estrutura: ganho_adaptativo_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado do ganho adaptativo de um sensor.
+ *
+ * Após um movimento rápido ou um período com o acelerômetro rejeitado, a
+ * estimativa acumulou erro do giroscópio; o fator de movimento é mantido por
+ * GANHO_TEMPO_RECUPERACAO_S (convertido em amostras pela frequência de
+ * amostragem) para corrigi-lo antes de voltar ao fator de repouso.
+ */
+typedef struct {
+    uint16_t recuperacao;          ///< Amostras restantes com fator de movimento
+    uint16_t amostras_recuperacao; ///< Duração da recuperação em amostras
+} ganho_adaptativo_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Zera o estado do ganho adaptativo.
+ * @param ganho Estado do sensor
+ * @param frequencia_hz Frequência de amostragem do filtro (Hz)
+ */
+void ganho_adaptativo_iniciar(ganho_adaptativo_t *ganho, float frequencia_hz);
+
+/**
+ * @brief Calcula o fator a aplicar ao ganho nominal do filtro nesta amostra.
+ *
+ * Usa apenas normas ao quadrado e comparações:
+ * - |‖a‖² - 1| acima do limite: 0 (a aceleração linear domina, acelerômetro rejeitado)
+ * - ‖ω‖² acima do limite de movimento, ou em recuperação: GANHO_FATOR_MOVIMENTO
+ * - ‖ω‖² abaixo do limite de repouso: GANHO_FATOR_REPOUSO
+ * - caso contrário: 1 (ganho nominal)
+ *
+ * @param ganho Estado do sensor
+ * @param accel Aceleração [x, y, z] (g)
+ * @param gyro Velocidade angular [x, y, z] (rad/s)
+ * @return Fator multiplicativo do ganho
+ */
+float ganho_adaptativo_fator(ganho_adaptativo_t *ganho, const float accel[3], const float gyro[3]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GANHO_ADAPTATIVO_H
@@ -0,0 +1,116 @@
+// ======================================================================
+//  Arquivo: mahony.c
+//  Descrição: Filtro de Mahony (complementar não linear com realimentação PI)
+//  Referência: R. Mahony, T. Hamel, J.-M. Pflimlin, "Nonlinear Complementary
+//              Filters on the Special Orthogonal Group", IEEE TAC, 2008.
+// ======================================================================
+
+#include "mahony.h"
+#include <math.h> // sqrtf
+
+// ----------------------------------------------------------------------
+// Inicialização do filtro
+// ----------------------------------------------------------------------
+void mahony_iniciar(mahony_t *filtro)
+{
+    filtro->q0 = 1.0f;
+    filtro->q1 = 0.0f;
+    filtro->q2 = 0.0f;
+    filtro->q3 = 0.0f;
+    filtro->integral[0] = 0.0f;
+    filtro->integral[1] = 0.0f;
+    filtro->integral[2] = 0.0f;
+    filtro->kp = MAHONY_KP_PADRAO;
+    filtro->ki = MAHONY_KI_PADRAO;
+}
+
+// ----------------------------------------------------------------------
+// Atualização da orientação
+// ----------------------------------------------------------------------
+void mahony_atualizar(mahony_t *filtro, const float gyro[3], const float accel[3], const float mag[3], float dt)
+{
+    float q0 = filtro->q0, q1 = filtro->q1, q2 = filtro->q2, q3 = filtro->q3;
+    float gx = gyro[0], gy = gyro[1], gz = gyro[2];
+    float ax = accel[0], ay = accel[1], az = accel[2];
+    float mx = mag[0], my = mag[1], mz = mag[2];
+
+    float norma2_acel = ax*ax + ay*ay + az*az;
+    float norma2_mag = mx*mx + my*my + mz*mz;
+
+    // Correção só é calculada com acelerômetro válido
+    if (norma2_acel > 0.0f) {
+        float inv = 1.0f / sqrtf(norma2_acel);
+        ax *= inv; ay *= inv; az *= inv;
+
+        // Direção estimada da gravidade no referencial do sensor (metade)
+        float meio_vx = q1*q3 - q0*q2;
+        float meio_vy = q0*q1 + q2*q3;
+        float meio_vz = q0*q0 - 0.5f + q3*q3;
+
+        // Erro = produto vetorial entre medida e estimativa
+        float meio_ex = ay*meio_vz - az*meio_vy;
+        float meio_ey = az*meio_vx - ax*meio_vz;
+        float meio_ez = ax*meio_vy - ay*meio_vx;
+
+        // Parcela magnética (omitida com magnetômetro zerado)
+        if (norma2_mag > 0.0f) {
+            inv = 1.0f / sqrtf(norma2_mag);
+            mx *= inv; my *= inv; mz *= inv;
+
+            float q0q1 = q0*q1, q0q2 = q0*q2, q0q3 = q0*q3;
+            float q1q1 = q1*q1, q1q2 = q1*q2, q1q3 = q1*q3;
+            float q2q2 = q2*q2, q2q3 = q2*q3, q3q3 = q3*q3;
+
+            // Campo medido no referencial da Terra, projetado no plano X-Z (norte em +X)
+            float hx = 2.0f * (mx*(0.5f - q2q2 - q3q3) + my*(q1q2 - q0q3) + mz*(q1q3 + q0q2));
+            float hy = 2.0f * (mx*(q1q2 + q0q3) + my*(0.5f - q1q1 - q3q3) + mz*(q2q3 - q0q1));
+            float bx = sqrtf(hx*hx + hy*hy);
+            float bz = 2.0f * (mx*(q1q3 - q0q2) + my*(q2q3 + q0q1) + mz*(0.5f - q1q1 - q2q2));
+
+            // Direção estimada do campo no referencial do sensor (metade)
+            float meio_wx = bx*(0.5f - q2q2 - q3q3) + bz*(q1q3 - q0q2);
+            float meio_wy = bx*(q1q2 - q0q3) + bz*(q0q1 + q2q3);
+            float meio_wz = bx*(q0q2 + q1q3) + bz*(0.5f - q1q1 - q2q2);
+
+            meio_ex += my*meio_wz - mz*meio_wy;
+            meio_ey += mz*meio_wx - mx*meio_wz;
+            meio_ez += mx*meio_wy - my*meio_wx;
+        }
+
+        // Realimentação integral (estimativa do bias do giroscópio)
+        if (filtro->ki > 0.0f) {
+            filtro->integral[0] += 2.0f * filtro->ki * meio_ex * dt;
+            filtro->integral[1] += 2.0f * filtro->ki * meio_ey * dt;
+            filtro->integral[2] += 2.0f * filtro->ki * meio_ez * dt;
+            gx += filtro->integral[0];
+            gy += filtro->integral[1];
+            gz += filtro->integral[2];
+        } else {
+            filtro->integral[0] = 0.0f;
+            filtro->integral[1] = 0.0f;
+            filtro->integral[2] = 0.0f;
+        }
+
+        // Realimentação proporcional
+        gx += 2.0f * filtro->kp * meio_ex;
+        gy += 2.0f * filtro->kp * meio_ey;
+        gz += 2.0f * filtro->kp * meio_ez;
+    }
+
+    // Integra a taxa de variação do quaternion
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    float qa = q0, qb = q1, qc = q2;
+    q0 += -qb*gx - qc*gy - q3*gz;
+    q1 +=  qa*gx + qc*gz - q3*gy;
+    q2 +=  qa*gy - qb*gz + q3*gx;
+    q3 +=  qa*gz + qb*gy - qc*gx;
+
+    // Normaliza o quaternion
+    float inv = 1.0f / sqrtf(q0*q0 + q1*q1 + q2*q2 + q3*q3);
+    filtro->q0 = q0 * inv;
+    filtro->q1 = q1 * inv;
+    filtro->q2 = q2 * inv;
+    filtro->q3 = q3 * inv;
+}
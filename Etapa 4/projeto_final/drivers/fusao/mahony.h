@@ -0,0 +1,62 @@
+// ======================================================================
+//  Arquivo: mahony.h
+//  Descrição: Filtro de Mahony (complementar não linear com realimentação PI)
+// ======================================================================
+
+#ifndef MAHONY_H
+#define MAHONY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Ganhos padrão
+// ----------------------------------------------------------------------
+#define MAHONY_KP_PADRAO  0.5f  ///< Ganho proporcional (rad/s por unidade de erro)
+#define MAHONY_KI_PADRAO  0.0f  ///< Ganho integral (0 desabilita a estimativa de bias)
+
+// ----------------------------------------------------------------------
+// Estrutura: mahony_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado do filtro de Mahony para um sensor.
+ *
+ * O quaternion segue a mesma convenção do filtro de Madgwick: orientação do
+ * sensor em relação à Terra (v_terra = q ⊗ v_sensor ⊗ q*), norte magnético em +X.
+ */
+typedef struct {
+    float q0, q1, q2, q3; ///< Quaternion de orientação (w, x, y, z)
+    float integral[3];    ///< Termo integral do erro (bias do giroscópio estimado, rad/s)
+    float kp;             ///< Ganho proporcional
+    float ki;             ///< Ganho integral
+} mahony_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa o filtro com orientação identidade e ganhos padrão.
+ * @param filtro Estado do filtro
+ */
+void mahony_iniciar(mahony_t *filtro);
+
+/**
+ * @brief Atualiza a orientação com uma amostra do sensor.
+ *
+ * Com o magnetômetro zerado (ou acelerômetro zerado) a respectiva correção é omitida.
+ *
+ * @param filtro Estado do filtro
+ * @param gyro Velocidade angular [x, y, z] (rad/s)
+ * @param accel Aceleração [x, y, z] (qualquer unidade)
+ * @param mag Campo magnético [x, y, z] (qualquer unidade)
+ * @param dt Intervalo de integração (s)
+ */
+void mahony_atualizar(mahony_t *filtro, const float gyro[3], const float accel[3], const float mag[3], float dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAHONY_H
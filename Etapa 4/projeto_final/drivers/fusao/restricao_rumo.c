@@ -0,0 +1,74 @@
+// ======================================================================
+//  Arquivo: restricao_rumo.c
+//  Descrição: Correção do rumo relativo entre os segmentos pela restrição
+//             articular do quadril (operação sem magnetômetro)
+// ======================================================================
+
+#include "restricao_rumo.h"
+#include "trig_rapida.h" // trig_atan2f
+
+#define GRAUS_PARA_RAD 0.01745329f
+
+// ----------------------------------------------------------------------
+// Funções auxiliares
+// ----------------------------------------------------------------------
+
+// Eixo X do segmento na Terra (primeira coluna da matriz de rotação), componentes horizontais
+static void eixo_x_horizontal(Quaternion q, float *hx, float *hy)
+{
+    *hx = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
+    *hy = 2.0f * (q.x * q.y + q.w * q.z);
+}
+
+// Componente vertical do eixo longitudinal Y do segmento (segunda coluna, linha Z)
+static float eixo_y_vertical(Quaternion q)
+{
+    return 2.0f * (q.y * q.z + q.w * q.x);
+}
+
+// ----------------------------------------------------------------------
+// Inicialização
+// ----------------------------------------------------------------------
+void restricao_rumo_iniciar(restricao_rumo_t *restricao)
+{
+    restricao->ganho = RESTRICAO_RUMO_GANHO_PADRAO;
+    restricao->rumo_maximo = RESTRICAO_RUMO_MAXIMO_GRAUS * GRAUS_PARA_RAD;
+    restricao->correcao_acumulada = 0.0f;
+}
+
+// ----------------------------------------------------------------------
+// Correção do rumo relativo
+// ----------------------------------------------------------------------
+float restricao_rumo_calcular(restricao_rumo_t *restricao, Quaternion q_tronco, Quaternion q_coxa, bool parado, float dt)
+{
+    float tx, ty, cx, cy;
+    eixo_x_horizontal(q_tronco, &tx, &ty);
+    eixo_x_horizontal(q_coxa, &cx, &cy);
+
+    // Eixo de flexão perto da vertical (inclinação lateral extrema): rumo indefinido
+    if (tx * tx + ty * ty < RESTRICAO_RUMO_HORIZONTAL2_MINIMO ||
+        cx * cx + cy * cy < RESTRICAO_RUMO_HORIZONTAL2_MINIMO) {
+        return 0.0f;
+    }
+
+    // Ângulo do eixo do tronco até o da coxa, em torno de +Z
+    float rumo = trig_atan2f(tx * cy - ty * cx, tx * cx + ty * cy);
+
+    float correcao = 0.0f;
+    if (rumo > restricao->rumo_maximo) {
+        correcao = restricao->rumo_maximo - rumo;
+    } else if (rumo < -restricao->rumo_maximo) {
+        correcao = -restricao->rumo_maximo - rumo;
+    } else if (parado &&
+               eixo_y_vertical(q_tronco) > RESTRICAO_RUMO_COS_EM_PE &&
+               eixo_y_vertical(q_coxa) > RESTRICAO_RUMO_COS_EM_PE) {
+        float passo = restricao->ganho * dt;
+        if (passo > 1.0f) {
+            passo = 1.0f;
+        }
+        correcao = -passo * rumo;
+    }
+
+    restricao->correcao_acumulada += correcao;
+    return correcao;
+}
@@ -0,0 +1,81 @@
+// ======================================================================
+//  Arquivo: restricao_rumo.h
+//  Descrição: Correção do rumo relativo entre os segmentos pela restrição
+//             articular do quadril (operação sem magnetômetro)
+// ======================================================================
+
+#ifndef RESTRICAO_RUMO_H
+#define RESTRICAO_RUMO_H
+
+#include <stdbool.h>           // Tipo booleano padrão
+#include "algoritmo_postura.h" // Estrutura Quaternion
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros padrão
+// ----------------------------------------------------------------------
+#define RESTRICAO_RUMO_MAXIMO_GRAUS       60.0f ///< |Rumo relativo| anatomicamente possível (rotação em pé, abdução com o quadril fletido)
+#define RESTRICAO_RUMO_GANHO_PADRAO       0.2f  ///< Volta ao neutro em pé e parado (1/s): constante de tempo de 5 s
+#define RESTRICAO_RUMO_COS_EM_PE          0.94f ///< cos(20°): eixo longitudinal considerado vertical
+#define RESTRICAO_RUMO_HORIZONTAL2_MINIMO 0.25f ///< |Projeção horizontal do eixo X|² mínima (eixo inclinado até 60°)
+
+// ----------------------------------------------------------------------
+// Estrutura: restricao_rumo_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estado da correção de rumo relativo por restrição articular.
+ *
+ * Sem magnetômetro, a rotação de cada sensor em torno da vertical só vem do
+ * giroscópio: o bias residual de cada um deriva o rumo relativo entre tronco e
+ * coxa, que aparece como rotação (em pé) ou abdução (com o quadril fletido).
+ * O rumo relativo é medido entre os eixos de flexão (X) dos dois segmentos
+ * projetados no plano horizontal, e duas restrições o limitam:
+ *  - Amplitude: além de rumo_maximo a articulação não chega; o excesso é
+ *    deriva e é removido de uma vez
+ *  - Postura neutra: em pé e parado o pé aponta para a frente, como na
+ *    calibração; o rumo volta ao neutro com o ganho dado (deriva residual de
+ *    bias × 1/ganho). Uma rotação real mantida em pé também é absorvida nesse
+ *    tempo: é o custo de não ter referência de rumo
+ *
+ * A correção é uma rotação da coxa em torno da vertical da Terra: não altera a
+ * inclinação, então não disputa com a correção pela gravidade dos filtros.
+ */
+typedef struct {
+    float ganho;              ///< Ganho da volta ao neutro (1/s)
+    float rumo_maximo;        ///< Limite anatômico do rumo relativo (rad)
+    float correcao_acumulada; ///< Soma das correções aplicadas (rad), para diagnóstico
+} restricao_rumo_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa com os parâmetros padrão e zera o acumulado.
+ * @param restricao Estado da restrição
+ */
+void restricao_rumo_iniciar(restricao_rumo_t *restricao);
+
+/**
+ * @brief Calcula a correção do rumo da coxa para o intervalo dt.
+ *
+ * Sem correção (retorna 0) se algum eixo de flexão estiver perto da vertical,
+ * onde o rumo relativo é indefinido.
+ *
+ * @param restricao Estado da restrição
+ * @param q_tronco Orientação do segmento tronco (segmento -> Terra, unitário)
+ * @param q_coxa Orientação do segmento coxa (segmento -> Terra, unitário)
+ * @param parado true se os dois sensores estão quase estáticos
+ * @param dt Intervalo desde a última chamada (s)
+ * @return Ângulo (rad) a girar a coxa em torno da vertical da Terra (+Z)
+ */
+float restricao_rumo_calcular(restricao_rumo_t *restricao, Quaternion q_tronco, Quaternion q_coxa, bool parado, float dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RESTRICAO_RUMO_H
@@ -17,6 +17,7 @@
 
 #include "MadgwickAHRS.h"
 #include <math.h>
+#include <stdint.h>
 
 //---------------------------------------------------------------------------------------------------
 // Definitions
@@ -51,6 +52,7 @@ void MadgwickAHRSinit(AHRS_data_t* imu, float desired_sample_freq)
 	imu->orientation.q3 = 0.0f;
 	imu->beta = betaDef3; // 2 * proportional gain (Kp)
 	imu->sample_freq = desired_sample_freq; // sample frequency in Hz
+	imu->delta_t = 1.0f / desired_sample_freq; // nominal integration step in seconds
 }
 
 //---------------------------------------------------------------------------------------------------
@@ -78,7 +80,6 @@ void MadgwickAHRSupdate(AHRS_data_t *imu) {
 	float q2 = imu->orientation.q2;
 	float q3 = imu->orientation.q3;
 	float beta = imu->beta;
-	float sampleFreq = imu->sample_freq;
 
 	// Use IMU algorithm if magnetometer measurement invalid (avoids NaN in magnetometer normalisation)
 	if((mx == 0.0f) && (my == 0.0f) && (mz == 0.0f)) {
@@ -164,7 +165,7 @@ void MadgwickAHRSupdate(AHRS_data_t *imu) {
 	}
 
 	// Integrate rate of change of quaternion to yield quaternion
-	float dt = 1.0f / sampleFreq;
+	float dt = imu->delta_t;
 	imu->orientation.q0 += qDot1 * dt;
 	imu->orientation.q1 += qDot2 * dt;
 	imu->orientation.q2 += qDot3 * dt;
@@ -195,7 +196,6 @@ void MadgwickAHRSupdateIMU(AHRS_data_t *imu) {
 	float q2 = imu->orientation.q2;
 	float q3 = imu->orientation.q3;
 	float beta = imu->beta;
-	float sampleFreq = imu->sample_freq;
 
 	// Define local variables for the Madgwick algorithm
 	float recipNorm;
@@ -252,7 +252,7 @@ void MadgwickAHRSupdateIMU(AHRS_data_t *imu) {
 	}
 
 	// Integrate rate of change of quaternion to yield quaternion
-	float dt = 1.0f / sampleFreq;
+	float dt = imu->delta_t;
 	imu->orientation.q0 += qDot1 * dt;
 	imu->orientation.q1 += qDot2 * dt;
 	imu->orientation.q2 += qDot3 * dt;
@@ -266,16 +266,257 @@ void MadgwickAHRSupdateIMU(AHRS_data_t *imu) {
 	imu->orientation.q3 *= recipNorm;
 }
 
+//---------------------------------------------------------------------------------------------------
+// Batch (structure-of-arrays) algorithm updates
+//
+// Same equations as the single-sensor updates, applied to every sensor of the batch in one loop.
+// The loop body has no data-dependent branches: invalid measurements are handled with selects,
+// so the host compiler can auto-vectorise it (-O3 -fno-math-errno -fno-trapping-math).
+
+/**
+ * @brief Initializes a batch of sensors with identity orientation and shared gain/frequency.
+ *
+ * @param batch Pointer to the batch structure.
+ * @param n Number of sensors in the batch (clamped to AHRS_BATCH_MAX).
+ * @param desired_sample_freq Desired sample frequency in Hz.
+ */
+void MadgwickAHRSbatchInit(AHRS_batch_t *batch, unsigned int n, float desired_sample_freq)
+{
+	batch->n = (n > AHRS_BATCH_MAX) ? AHRS_BATCH_MAX : n;
+	for (unsigned int i = 0; i < AHRS_BATCH_MAX; i++) {
+		batch->q0[i] = 1.0f;
+		batch->q1[i] = 0.0f;
+		batch->q2[i] = 0.0f;
+		batch->q3[i] = 0.0f;
+		batch->ax[i] = batch->ay[i] = batch->az[i] = 0.0f;
+		batch->gx[i] = batch->gy[i] = batch->gz[i] = 0.0f;
+		batch->mx[i] = batch->my[i] = batch->mz[i] = 0.0f;
+		batch->beta[i] = betaDef3;
+	}
+	batch->sample_freq = desired_sample_freq;
+	batch->delta_t = 1.0f / desired_sample_freq;
+}
+
+/**
+ * @brief Updates the orientation of every sensor of the batch using IMU and magnetometer data.
+ *
+ * Sensors whose magnetometer reads all zeros get the IMU-only correction (the magnetic residuals
+ * are zeroed, which reduces the gradient to the IMU one), matching MadgwickAHRSupdate().
+ *
+ * @param batch Pointer to the batch structure.
+ */
+void MadgwickAHRSbatchUpdate(AHRS_batch_t *batch) {
+
+	// Shared parameters, loaded once for the whole batch
+	const unsigned int n = batch->n;
+	const float dt = batch->delta_t;
+
+	float * restrict Q0 = batch->q0;
+	float * restrict Q1 = batch->q1;
+	float * restrict Q2 = batch->q2;
+	float * restrict Q3 = batch->q3;
+	const float * restrict AX = batch->ax;
+	const float * restrict AY = batch->ay;
+	const float * restrict AZ = batch->az;
+	const float * restrict GX = batch->gx;
+	const float * restrict GY = batch->gy;
+	const float * restrict GZ = batch->gz;
+	const float * restrict BETA = batch->beta;
+	const float * restrict MX = batch->mx;
+	const float * restrict MY = batch->my;
+	const float * restrict MZ = batch->mz;
+
+	for (unsigned int i = 0; i < n; i++) {
+		float q0 = Q0[i], q1 = Q1[i], q2 = Q2[i], q3 = Q3[i];
+		float gx = GX[i], gy = GY[i], gz = GZ[i];
+		float ax = AX[i], ay = AY[i], az = AZ[i];
+		float mx = MX[i], my = MY[i], mz = MZ[i];
+
+		// Rate of change of quaternion from gyroscope
+		float qDot1 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+		float qDot2 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+		float qDot3 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+		float qDot4 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+		// Validity masks replace the early returns of the single-sensor version
+		float aNorm2 = ax * ax + ay * ay + az * az;
+		float mNorm2 = mx * mx + my * my + mz * mz;
+		float ganho = (aNorm2 > 0.0f) ? BETA[i] : 0.0f;
+		float usaMag = (mNorm2 > 0.0f) ? 1.0f : 0.0f;
+
+		// Normalise accelerometer and magnetometer measurements
+		float recipNorm = invSqrt((aNorm2 > 0.0f) ? aNorm2 : 1.0f);
+		ax *= recipNorm;
+		ay *= recipNorm;
+		az *= recipNorm;
+		recipNorm = invSqrt((mNorm2 > 0.0f) ? mNorm2 : 1.0f);
+		mx *= recipNorm;
+		my *= recipNorm;
+		mz *= recipNorm;
+
+		// Auxiliary variables to avoid repeated arithmetic
+		float _2q0mx = 2.0f * q0 * mx;
+		float _2q0my = 2.0f * q0 * my;
+		float _2q0mz = 2.0f * q0 * mz;
+		float _2q1mx = 2.0f * q1 * mx;
+		float _2q0 = 2.0f * q0;
+		float _2q1 = 2.0f * q1;
+		float _2q2 = 2.0f * q2;
+		float _2q3 = 2.0f * q3;
+		float q0q0 = q0 * q0;
+		float q0q1 = q0 * q1;
+		float q0q2 = q0 * q2;
+		float q0q3 = q0 * q3;
+		float q1q1 = q1 * q1;
+		float q1q2 = q1 * q2;
+		float q1q3 = q1 * q3;
+		float q2q2 = q2 * q2;
+		float q2q3 = q2 * q3;
+		float q3q3 = q3 * q3;
+
+		// Reference direction of Earth's magnetic field
+		float hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 + _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
+		float hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 + my * q2q2 + _2q2 * mz * q3 - my * q3q3;
+		float _2bx = sqrtf(hx * hx + hy * hy);
+		float _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 + _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
+		float _4bx = 2.0f * _2bx;
+		float _4bz = 2.0f * _2bz;
+
+		// Objective function residuals; magnetic ones vanish when the magnetometer is invalid
+		float f0 = 2.0f * q1q3 - 2.0f * q0q2 - ax;
+		float f1 = 2.0f * q0q1 + 2.0f * q2q3 - ay;
+		float f2 = 1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az;
+		float f3 = usaMag * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx);
+		float f4 = usaMag * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my);
+		float f5 = usaMag * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+
+		// Gradient descent algorithm corrective step
+		float s0 = -_2q2 * f0 + _2q1 * f1 - _2bz * q2 * f3 + (-_2bx * q3 + _2bz * q1) * f4 + _2bx * q2 * f5;
+		float s1 = _2q3 * f0 + _2q0 * f1 - 4.0f * q1 * f2 + _2bz * q3 * f3 + (_2bx * q2 + _2bz * q0) * f4 + (_2bx * q3 - _4bz * q1) * f5;
+		float s2 = -_2q0 * f0 + _2q3 * f1 - 4.0f * q2 * f2 + (-_4bx * q2 - _2bz * q0) * f3 + (_2bx * q1 + _2bz * q3) * f4 + (_2bx * q0 - _4bz * q2) * f5;
+		float s3 = _2q1 * f0 + _2q2 * f1 + (-_4bx * q3 + _2bz * q1) * f3 + (-_2bx * q0 + _2bz * q2) * f4 + _2bx * q1 * f5;
+		float sNorm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+		recipNorm = ganho * invSqrt((sNorm2 > 0.0f) ? sNorm2 : 1.0f); // normalise step magnitude and apply gain
+
+		// Apply feedback step
+		qDot1 -= recipNorm * s0;
+		qDot2 -= recipNorm * s1;
+		qDot3 -= recipNorm * s2;
+		qDot4 -= recipNorm * s3;
+
+		// Integrate rate of change of quaternion to yield quaternion
+		q0 += qDot1 * dt;
+		q1 += qDot2 * dt;
+		q2 += qDot3 * dt;
+		q3 += qDot4 * dt;
+
+		// Normalise quaternion
+		recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+		Q0[i] = q0 * recipNorm;
+		Q1[i] = q1 * recipNorm;
+		Q2[i] = q2 * recipNorm;
+		Q3[i] = q3 * recipNorm;
+	}
+}
+
+/**
+ * @brief Updates the orientation of every sensor of the batch using IMU data only.
+ *
+ * @param batch Pointer to the batch structure.
+ */
+void MadgwickAHRSbatchUpdateIMU(AHRS_batch_t *batch) {
+
+	// Shared parameters, loaded once for the whole batch
+	const unsigned int n = batch->n;
+	const float dt = batch->delta_t;
+
+	float * restrict Q0 = batch->q0;
+	float * restrict Q1 = batch->q1;
+	float * restrict Q2 = batch->q2;
+	float * restrict Q3 = batch->q3;
+	const float * restrict AX = batch->ax;
+	const float * restrict AY = batch->ay;
+	const float * restrict AZ = batch->az;
+	const float * restrict GX = batch->gx;
+	const float * restrict GY = batch->gy;
+	const float * restrict GZ = batch->gz;
+	const float * restrict BETA = batch->beta;
+
+	for (unsigned int i = 0; i < n; i++) {
+		float q0 = Q0[i], q1 = Q1[i], q2 = Q2[i], q3 = Q3[i];
+		float gx = GX[i], gy = GY[i], gz = GZ[i];
+		float ax = AX[i], ay = AY[i], az = AZ[i];
+
+		// Rate of change of quaternion from gyroscope
+		float qDot1 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+		float qDot2 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+		float qDot3 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+		float qDot4 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+		// Normalise accelerometer measurement (feedback disabled if invalid)
+		float aNorm2 = ax * ax + ay * ay + az * az;
+		float ganho = (aNorm2 > 0.0f) ? BETA[i] : 0.0f;
+		float recipNorm = invSqrt((aNorm2 > 0.0f) ? aNorm2 : 1.0f);
+		ax *= recipNorm;
+		ay *= recipNorm;
+		az *= recipNorm;
+
+		// Auxiliary variables to avoid repeated arithmetic
+		float _2q0 = 2.0f * q0;
+		float _2q1 = 2.0f * q1;
+		float _2q2 = 2.0f * q2;
+		float _2q3 = 2.0f * q3;
+		float _4q0 = 4.0f * q0;
+		float _4q1 = 4.0f * q1;
+		float _4q2 = 4.0f * q2;
+		float _8q1 = 8.0f * q1;
+		float _8q2 = 8.0f * q2;
+		float q0q0 = q0 * q0;
+		float q1q1 = q1 * q1;
+		float q2q2 = q2 * q2;
+		float q3q3 = q3 * q3;
+
+		// Gradient decent algorithm corrective step
+		float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+		float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+		float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+		float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+		float sNorm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+		recipNorm = ganho * invSqrt((sNorm2 > 0.0f) ? sNorm2 : 1.0f); // normalise step magnitude and apply gain
+
+		// Apply feedback step
+		qDot1 -= recipNorm * s0;
+		qDot2 -= recipNorm * s1;
+		qDot3 -= recipNorm * s2;
+		qDot4 -= recipNorm * s3;
+
+		// Integrate rate of change of quaternion to yield quaternion
+		q0 += qDot1 * dt;
+		q1 += qDot2 * dt;
+		q2 += qDot3 * dt;
+		q3 += qDot4 * dt;
+
+		// Normalise quaternion
+		recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+		Q0[i] = q0 * recipNorm;
+		Q1[i] = q1 * recipNorm;
+		Q2[i] = q2 * recipNorm;
+		Q3[i] = q3 * recipNorm;
+	}
+}
+
 //---------------------------------------------------------------------------------------------------
 // Fast inverse square-root
 // See: http://en.wikipedia.org/wiki/Fast_inverse_square_root
 
 static inline float invSqrt(float x) {
+	// Bit reinterpretation through a union with a 32-bit integer: 'long' is 64 bits on host
+	// builds (batch replay), which made the original pointer cast read past the float.
+	union { float f; int32_t i; } conv;
 	float halfx = 0.5f * x;
-	float y = x;
-	long i = *(long*)&y;
-	i = 0x5f3759df - (i>>1);
-	y = *(float*)&i;
+	conv.f = x;
+	conv.i = 0x5f3759df - (conv.i >> 1);
+	float y = conv.f;
 	y = y * (1.5f - (halfx * y * y));
 	return y;
 }
@@ -9,6 +9,9 @@
 // 29/09/2011	SOH Madgwick    Initial release
 // 02/10/2011	SOH Madgwick	Optimised for reduced CPU load
 //
+// Two implementations share this interface: MadgwickAHRS.c (float) and MadgwickAHRS_fixo.c
+// (Q7.24 fixed point, for the FPU-less RP2040). CMake option MADGWICK_PONTO_FIXO selects one.
+//
 //=====================================================================================================
 #ifndef MadgwickAHRS_h
 #define MadgwickAHRS_h
@@ -33,9 +36,30 @@ typedef struct {
     float gyro[3]; // Gyroscope measurements
     float mag[3]; // Magnetometer measurements
     float beta; // Algorithm gain
-    float sample_freq; // Sampling frequency in Hz
+    float sample_freq; // Nominal sampling frequency in Hz
+    float delta_t; // Integration step in seconds (1 / sample_freq after init; may be set to the measured interval before each update)
 } AHRS_data_t;
 
+// Maximum number of sensors in a batch. Host builds that replay many recorded sessions at once
+// may raise it (e.g. -DAHRS_BATCH_MAX=64).
+#ifndef AHRS_BATCH_MAX
+#define AHRS_BATCH_MAX 4
+#endif
+
+// Structure-of-arrays state for updating several sensors in one loop. Index i of every array
+// belongs to sensor i; the gain is per sensor (so it can adapt to each sensor's motion) and the
+// sample frequency is shared by the whole batch.
+typedef struct {
+    unsigned int n; // Number of sensors in use (<= AHRS_BATCH_MAX)
+    float q0[AHRS_BATCH_MAX], q1[AHRS_BATCH_MAX], q2[AHRS_BATCH_MAX], q3[AHRS_BATCH_MAX]; // Orientation quaternions
+    float ax[AHRS_BATCH_MAX], ay[AHRS_BATCH_MAX], az[AHRS_BATCH_MAX]; // Accelerometer measurements
+    float gx[AHRS_BATCH_MAX], gy[AHRS_BATCH_MAX], gz[AHRS_BATCH_MAX]; // Gyroscope measurements (rad/s)
+    float mx[AHRS_BATCH_MAX], my[AHRS_BATCH_MAX], mz[AHRS_BATCH_MAX]; // Magnetometer measurements
+    float beta[AHRS_BATCH_MAX]; // Algorithm gain of each sensor
+    float sample_freq; // Nominal sampling frequency in Hz
+    float delta_t; // Integration step in seconds, shared by the batch (see AHRS_data_t)
+} AHRS_batch_t;
+
 //---------------------------------------------------------------------------------------------------
 // Public function declarations
 
@@ -43,6 +67,10 @@ void MadgwickAHRSinit(AHRS_data_t* imu, float desired_sample_freq);
 void MadgwickAHRSupdate(AHRS_data_t *imu);
 void MadgwickAHRSupdateIMU(AHRS_data_t *imu);
 
+void MadgwickAHRSbatchInit(AHRS_batch_t *batch, unsigned int n, float desired_sample_freq);
+void MadgwickAHRSbatchUpdate(AHRS_batch_t *batch);
+void MadgwickAHRSbatchUpdateIMU(AHRS_batch_t *batch);
+
 #ifdef __cplusplus
 }
 #endif
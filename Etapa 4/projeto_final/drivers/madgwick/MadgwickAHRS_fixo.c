@@ -0,0 +1,444 @@
+//=====================================================================================================
+// MadgwickAHRS_fixo.c
+//=====================================================================================================
+//
+// Fixed-point (Q7.24) implementation of Madgwick's IMU and AHRS algorithms.
+// See: http://www.x-io.co.uk/node/8#open_source_ahrs_and_imu_algorithms
+//
+// Drop-in replacement for MadgwickAHRS.c, selected at build time with the CMake option
+// MADGWICK_PONTO_FIXO. The public interface (MadgwickAHRS.h) is unchanged: inputs and the
+// orientation quaternion stay in float inside AHRS_data_t and are converted once per update,
+// while all the filter arithmetic runs on 32-bit integers with 64-bit products. The RP2040
+// (Cortex-M0+) has no FPU, so this avoids ~150 soft-float operations per sensor per sample.
+//
+// Date			Author          Notes
+// 29/09/2011	SOH Madgwick    Initial release
+// 02/10/2011	SOH Madgwick	Optimised for reduced CPU load
+// 19/02/2012	SOH Madgwick	Magnetometer measurement is normalised
+// 07/02/2025   HipSafe         Fixed-point port for the FPU-less RP2040
+//=====================================================================================================
+
+//---------------------------------------------------------------------------------------------------
+// Header files
+
+#include "MadgwickAHRS.h"
+#include <stdint.h>
+
+//---------------------------------------------------------------------------------------------------
+// Definitions
+
+#define betaDef		0.5f		// 2 * proportional gain (increased for faster convergence)
+#define betaDef2	0.05f		// 2 * proportional gain
+#define betaDef3    0.2f        // Used for faster initial convergence.
+
+// Q7.24 format: range [-128, 128), resolution 6e-8. The integer headroom covers the
+// unnormalised gradient step (|s| can reach a few tens) and raw magnetometer norms.
+#define Q_FRAC		24
+#define Q_UM		((q24_t)1 << Q_FRAC)	// 1.0
+#define Q_MEIO		((q24_t)1 << (Q_FRAC - 1))	// 0.5
+
+// Magnetometer input is pre-scaled by 2^-6 (only its direction is used) so that
+// readings up to ±8192 uT fit the Q7.24 range.
+#define MAG_ESCALA	(1.0f / 64.0f)
+
+typedef int32_t q24_t;
+
+//---------------------------------------------------------------------------------------------------
+// Function declarations
+
+static inline q24_t q_mul(q24_t a, q24_t b);
+static inline int64_t q_quadrado(q24_t a);
+static inline q24_t q_de_float(float f);
+static inline float q_para_float(q24_t q);
+static q24_t q_inv_sqrt(int64_t x);
+
+//====================================================================================================
+// Functions
+
+//---------------------------------------------------------------------------------------------------
+// AHRS algorithm data structures initialization
+
+/**
+ * @brief Initializes the MadgwickAHRS's imu_data_t data structure.
+ *
+ * @param imu Pointer to the imu_data_t structure which`ll store the orientation and sensor data.
+ * @param desired_sample_freq Desired sample frequency in Hz.
+ */
+void MadgwickAHRSinit(AHRS_data_t* imu, float desired_sample_freq)
+{
+	// Inits quaternion of sensor frame relative to auxiliary frame
+	imu->orientation.q0 = 1.0f;
+	imu->orientation.q1 = 0.0f;
+	imu->orientation.q2 = 0.0f;
+	imu->orientation.q3 = 0.0f;
+	imu->beta = betaDef3; // 2 * proportional gain (Kp)
+	imu->sample_freq = desired_sample_freq; // sample frequency in Hz
+	imu->delta_t = 1.0f / desired_sample_freq; // nominal integration step in seconds
+}
+
+//---------------------------------------------------------------------------------------------------
+// AHRS algorithm update (with magnetometer data)
+
+/**
+ * @brief Whenever called, updates the orientation quaternion based on IMU and magnetometer data.
+ *
+ * @param imu Pointer to the imu_data_t structure.
+ */
+void MadgwickAHRSupdate(AHRS_data_t *imu) {
+
+	// Use IMU algorithm if magnetometer measurement invalid (avoids NaN in magnetometer normalisation)
+	if((imu->mag[0] == 0.0f) && (imu->mag[1] == 0.0f) && (imu->mag[2] == 0.0f)) {
+		MadgwickAHRSupdateIMU(imu);
+		return;
+	}
+
+	// Convert the imu data structure to Q7.24 once
+	q24_t gx = q_de_float(imu->gyro[0]);
+	q24_t gy = q_de_float(imu->gyro[1]);
+	q24_t gz = q_de_float(imu->gyro[2]);
+	q24_t ax = q_de_float(imu->accel[0]);
+	q24_t ay = q_de_float(imu->accel[1]);
+	q24_t az = q_de_float(imu->accel[2]);
+	q24_t mx = q_de_float(imu->mag[0] * MAG_ESCALA);
+	q24_t my = q_de_float(imu->mag[1] * MAG_ESCALA);
+	q24_t mz = q_de_float(imu->mag[2] * MAG_ESCALA);
+	q24_t q0 = q_de_float(imu->orientation.q0);
+	q24_t q1 = q_de_float(imu->orientation.q1);
+	q24_t q2 = q_de_float(imu->orientation.q2);
+	q24_t q3 = q_de_float(imu->orientation.q3);
+	q24_t beta = q_de_float(imu->beta);
+	q24_t dt = q_de_float(imu->delta_t);
+
+	// Define local variables for the Madgwick algorithm
+	q24_t recipNorm;
+	q24_t s0, s1, s2, s3;
+	q24_t qDot1, qDot2, qDot3, qDot4;
+	q24_t hx, hy;
+	q24_t f0, f1, f2, f3, f4, f5;
+	q24_t _2q0mx, _2q0my, _2q0mz, _2q1mx, _2bx, _2bz, _4bx, _4bz, _2q0, _2q1, _2q2, _2q3, _2q0q2, _2q2q3, q0q0, q0q1, q0q2, q0q3, q1q1, q1q2, q1q3, q2q2, q2q3, q3q3;
+
+	// Rate of change of quaternion from gyroscope
+	qDot1 = (-q_mul(q1, gx) - q_mul(q2, gy) - q_mul(q3, gz)) / 2;
+	qDot2 = (q_mul(q0, gx) + q_mul(q2, gz) - q_mul(q3, gy)) / 2;
+	qDot3 = (q_mul(q0, gy) - q_mul(q1, gz) + q_mul(q3, gx)) / 2;
+	qDot4 = (q_mul(q0, gz) + q_mul(q1, gy) - q_mul(q2, gx)) / 2;
+
+	// Compute feedback only if accelerometer measurement valid (avoids NaN in accelerometer normalisation)
+	if(!((ax == 0) && (ay == 0) && (az == 0))) {
+
+		// Normalise accelerometer measurement
+		recipNorm = q_inv_sqrt(q_quadrado(ax) + q_quadrado(ay) + q_quadrado(az));
+		ax = q_mul(ax, recipNorm);
+		ay = q_mul(ay, recipNorm);
+		az = q_mul(az, recipNorm);
+
+		// Normalise magnetometer measurement
+		recipNorm = q_inv_sqrt(q_quadrado(mx) + q_quadrado(my) + q_quadrado(mz));
+		mx = q_mul(mx, recipNorm);
+		my = q_mul(my, recipNorm);
+		mz = q_mul(mz, recipNorm);
+
+		// Auxiliary variables to avoid repeated arithmetic
+		_2q0mx = 2 * q_mul(q0, mx);
+		_2q0my = 2 * q_mul(q0, my);
+		_2q0mz = 2 * q_mul(q0, mz);
+		_2q1mx = 2 * q_mul(q1, mx);
+		_2q0 = 2 * q0;
+		_2q1 = 2 * q1;
+		_2q2 = 2 * q2;
+		_2q3 = 2 * q3;
+		_2q0q2 = 2 * q_mul(q0, q2);
+		_2q2q3 = 2 * q_mul(q2, q3);
+		q0q0 = q_mul(q0, q0);
+		q0q1 = q_mul(q0, q1);
+		q0q2 = q_mul(q0, q2);
+		q0q3 = q_mul(q0, q3);
+		q1q1 = q_mul(q1, q1);
+		q1q2 = q_mul(q1, q2);
+		q1q3 = q_mul(q1, q3);
+		q2q2 = q_mul(q2, q2);
+		q2q3 = q_mul(q2, q3);
+		q3q3 = q_mul(q3, q3);
+
+		// Reference direction of Earth's magnetic field
+		hx = q_mul(mx, q0q0) - q_mul(_2q0my, q3) + q_mul(_2q0mz, q2) + q_mul(mx, q1q1) + q_mul(q_mul(_2q1, my), q2) + q_mul(q_mul(_2q1, mz), q3) - q_mul(mx, q2q2) - q_mul(mx, q3q3);
+		hy = q_mul(_2q0mx, q3) + q_mul(my, q0q0) - q_mul(_2q0mz, q1) + q_mul(_2q1mx, q2) - q_mul(my, q1q1) + q_mul(my, q2q2) + q_mul(q_mul(_2q2, mz), q3) - q_mul(my, q3q3);
+		int64_t h2 = q_quadrado(hx) + q_quadrado(hy);
+		_2bx = (h2 > 0) ? (q24_t)(((int64_t)h2 * q_inv_sqrt(h2)) >> Q_FRAC) : 0; // sqrt(h2) = h2 / sqrt(h2)
+		_2bz = -q_mul(_2q0mx, q2) + q_mul(_2q0my, q1) + q_mul(mz, q0q0) + q_mul(_2q1mx, q3) - q_mul(mz, q1q1) + q_mul(q_mul(_2q2, my), q3) - q_mul(mz, q2q2) + q_mul(mz, q3q3);
+		_4bx = 2 * _2bx;
+		_4bz = 2 * _2bz;
+
+		// Objective function residuals (shared by the four gradient components)
+		f0 = 2 * q1q3 - _2q0q2 - ax;
+		f1 = 2 * q0q1 + _2q2q3 - ay;
+		f2 = Q_UM - 2 * q1q1 - 2 * q2q2 - az;
+		f3 = q_mul(_2bx, Q_MEIO - q2q2 - q3q3) + q_mul(_2bz, q1q3 - q0q2) - mx;
+		f4 = q_mul(_2bx, q1q2 - q0q3) + q_mul(_2bz, q0q1 + q2q3) - my;
+		f5 = q_mul(_2bx, q0q2 + q1q3) + q_mul(_2bz, Q_MEIO - q1q1 - q2q2) - mz;
+
+		// Gradient descent algorithm corrective step
+		s0 = -q_mul(_2q2, f0) + q_mul(_2q1, f1) - q_mul(q_mul(_2bz, q2), f3) + q_mul(-q_mul(_2bx, q3) + q_mul(_2bz, q1), f4) + q_mul(q_mul(_2bx, q2), f5);
+		s1 = q_mul(_2q3, f0) + q_mul(_2q0, f1) - 4 * q_mul(q1, f2) + q_mul(q_mul(_2bz, q3), f3) + q_mul(q_mul(_2bx, q2) + q_mul(_2bz, q0), f4) + q_mul(q_mul(_2bx, q3) - q_mul(_4bz, q1), f5);
+		s2 = -q_mul(_2q0, f0) + q_mul(_2q3, f1) - 4 * q_mul(q2, f2) + q_mul(-q_mul(_4bx, q2) - q_mul(_2bz, q0), f3) + q_mul(q_mul(_2bx, q1) + q_mul(_2bz, q3), f4) + q_mul(q_mul(_2bx, q0) - q_mul(_4bz, q2), f5);
+		s3 = q_mul(_2q1, f0) + q_mul(_2q2, f1) + q_mul(-q_mul(_4bx, q3) + q_mul(_2bz, q1), f3) + q_mul(-q_mul(_2bx, q0) + q_mul(_2bz, q2), f4) + q_mul(q_mul(_2bx, q1), f5);
+		recipNorm = q_inv_sqrt(q_quadrado(s0) + q_quadrado(s1) + q_quadrado(s2) + q_quadrado(s3)); // normalise step magnitude
+		s0 = q_mul(s0, recipNorm);
+		s1 = q_mul(s1, recipNorm);
+		s2 = q_mul(s2, recipNorm);
+		s3 = q_mul(s3, recipNorm);
+
+		// Apply feedback step
+		qDot1 -= q_mul(beta, s0);
+		qDot2 -= q_mul(beta, s1);
+		qDot3 -= q_mul(beta, s2);
+		qDot4 -= q_mul(beta, s3);
+	}
+
+	// Integrate rate of change of quaternion to yield quaternion
+	q0 += q_mul(qDot1, dt);
+	q1 += q_mul(qDot2, dt);
+	q2 += q_mul(qDot3, dt);
+	q3 += q_mul(qDot4, dt);
+
+	// Normalise quaternion and convert back to float
+	recipNorm = q_inv_sqrt(q_quadrado(q0) + q_quadrado(q1) + q_quadrado(q2) + q_quadrado(q3));
+	imu->orientation.q0 = q_para_float(q_mul(q0, recipNorm));
+	imu->orientation.q1 = q_para_float(q_mul(q1, recipNorm));
+	imu->orientation.q2 = q_para_float(q_mul(q2, recipNorm));
+	imu->orientation.q3 = q_para_float(q_mul(q3, recipNorm));
+}
+
+//---------------------------------------------------------------------------------------------------
+// IMU algorithm update (with no magnetometer data)
+
+void MadgwickAHRSupdateIMU(AHRS_data_t *imu) {
+
+	// Convert the imu data structure to Q7.24 once
+	q24_t gx = q_de_float(imu->gyro[0]);
+	q24_t gy = q_de_float(imu->gyro[1]);
+	q24_t gz = q_de_float(imu->gyro[2]);
+	q24_t ax = q_de_float(imu->accel[0]);
+	q24_t ay = q_de_float(imu->accel[1]);
+	q24_t az = q_de_float(imu->accel[2]);
+	q24_t q0 = q_de_float(imu->orientation.q0);
+	q24_t q1 = q_de_float(imu->orientation.q1);
+	q24_t q2 = q_de_float(imu->orientation.q2);
+	q24_t q3 = q_de_float(imu->orientation.q3);
+	q24_t beta = q_de_float(imu->beta);
+	q24_t dt = q_de_float(imu->delta_t);
+
+	// Define local variables for the Madgwick algorithm
+	q24_t recipNorm;
+	q24_t s0, s1, s2, s3;
+	q24_t qDot1, qDot2, qDot3, qDot4;
+	q24_t _2q0, _2q1, _2q2, _2q3, _4q0, _4q1, _4q2 ,_8q1, _8q2, q0q0, q1q1, q2q2, q3q3;
+
+	// Rate of change of quaternion from gyroscope
+	qDot1 = (-q_mul(q1, gx) - q_mul(q2, gy) - q_mul(q3, gz)) / 2;
+	qDot2 = (q_mul(q0, gx) + q_mul(q2, gz) - q_mul(q3, gy)) / 2;
+	qDot3 = (q_mul(q0, gy) - q_mul(q1, gz) + q_mul(q3, gx)) / 2;
+	qDot4 = (q_mul(q0, gz) + q_mul(q1, gy) - q_mul(q2, gx)) / 2;
+
+	// Compute feedback only if accelerometer measurement valid (avoids NaN in accelerometer normalisation)
+	if(!((ax == 0) && (ay == 0) && (az == 0))) {
+
+		// Normalise accelerometer measurement
+		recipNorm = q_inv_sqrt(q_quadrado(ax) + q_quadrado(ay) + q_quadrado(az));
+		ax = q_mul(ax, recipNorm);
+		ay = q_mul(ay, recipNorm);
+		az = q_mul(az, recipNorm);
+
+		// Auxiliary variables to avoid repeated arithmetic
+		_2q0 = 2 * q0;
+		_2q1 = 2 * q1;
+		_2q2 = 2 * q2;
+		_2q3 = 2 * q3;
+		_4q0 = 4 * q0;
+		_4q1 = 4 * q1;
+		_4q2 = 4 * q2;
+		_8q1 = 8 * q1;
+		_8q2 = 8 * q2;
+		q0q0 = q_mul(q0, q0);
+		q1q1 = q_mul(q1, q1);
+		q2q2 = q_mul(q2, q2);
+		q3q3 = q_mul(q3, q3);
+
+		// Gradient decent algorithm corrective step
+		s0 = q_mul(_4q0, q2q2) + q_mul(_2q2, ax) + q_mul(_4q0, q1q1) - q_mul(_2q1, ay);
+		s1 = q_mul(_4q1, q3q3) - q_mul(_2q3, ax) + 4 * q_mul(q0q0, q1) - q_mul(_2q0, ay) - _4q1 + q_mul(_8q1, q1q1) + q_mul(_8q1, q2q2) + q_mul(_4q1, az);
+		s2 = 4 * q_mul(q0q0, q2) + q_mul(_2q0, ax) + q_mul(_4q2, q3q3) - q_mul(_2q3, ay) - _4q2 + q_mul(_8q2, q1q1) + q_mul(_8q2, q2q2) + q_mul(_4q2, az);
+		s3 = 4 * q_mul(q1q1, q3) - q_mul(_2q1, ax) + 4 * q_mul(q2q2, q3) - q_mul(_2q2, ay);
+
+		// A zero step means the estimate already matches gravity: nothing to correct
+		int64_t s_norma2 = q_quadrado(s0) + q_quadrado(s1) + q_quadrado(s2) + q_quadrado(s3);
+		if (s_norma2 > 0) {
+			recipNorm = q_inv_sqrt(s_norma2); // normalise step magnitude
+			s0 = q_mul(s0, recipNorm);
+			s1 = q_mul(s1, recipNorm);
+			s2 = q_mul(s2, recipNorm);
+			s3 = q_mul(s3, recipNorm);
+
+			// Apply feedback step
+			qDot1 -= q_mul(beta, s0);
+			qDot2 -= q_mul(beta, s1);
+			qDot3 -= q_mul(beta, s2);
+			qDot4 -= q_mul(beta, s3);
+		}
+	}
+
+	// Integrate rate of change of quaternion to yield quaternion
+	q0 += q_mul(qDot1, dt);
+	q1 += q_mul(qDot2, dt);
+	q2 += q_mul(qDot3, dt);
+	q3 += q_mul(qDot4, dt);
+
+	// Normalise quaternion and convert back to float
+	recipNorm = q_inv_sqrt(q_quadrado(q0) + q_quadrado(q1) + q_quadrado(q2) + q_quadrado(q3));
+	imu->orientation.q0 = q_para_float(q_mul(q0, recipNorm));
+	imu->orientation.q1 = q_para_float(q_mul(q1, recipNorm));
+	imu->orientation.q2 = q_para_float(q_mul(q2, recipNorm));
+	imu->orientation.q3 = q_para_float(q_mul(q3, recipNorm));
+}
+
+//---------------------------------------------------------------------------------------------------
+// Batch (structure-of-arrays) algorithm updates
+//
+// The Cortex-M0+ has no SIMD, so the fixed-point batch simply runs the single-sensor kernel for
+// each index. The shared gain and frequency are taken from the batch once.
+
+/**
+ * @brief Initializes a batch of sensors with identity orientation and shared gain/frequency.
+ *
+ * @param batch Pointer to the batch structure.
+ * @param n Number of sensors in the batch (clamped to AHRS_BATCH_MAX).
+ * @param desired_sample_freq Desired sample frequency in Hz.
+ */
+void MadgwickAHRSbatchInit(AHRS_batch_t *batch, unsigned int n, float desired_sample_freq)
+{
+	batch->n = (n > AHRS_BATCH_MAX) ? AHRS_BATCH_MAX : n;
+	for (unsigned int i = 0; i < AHRS_BATCH_MAX; i++) {
+		batch->q0[i] = 1.0f;
+		batch->q1[i] = 0.0f;
+		batch->q2[i] = 0.0f;
+		batch->q3[i] = 0.0f;
+		batch->ax[i] = batch->ay[i] = batch->az[i] = 0.0f;
+		batch->gx[i] = batch->gy[i] = batch->gz[i] = 0.0f;
+		batch->mx[i] = batch->my[i] = batch->mz[i] = 0.0f;
+		batch->beta[i] = betaDef3;
+	}
+	batch->sample_freq = desired_sample_freq;
+	batch->delta_t = 1.0f / desired_sample_freq;
+}
+
+// Runs the single-sensor update on every index of the batch
+static void batch_executar(AHRS_batch_t *batch, void (*atualizar)(AHRS_data_t *)) {
+	AHRS_data_t imu;
+	imu.sample_freq = batch->sample_freq;
+	imu.delta_t = batch->delta_t;
+
+	for (unsigned int i = 0; i < batch->n; i++) {
+		imu.beta = batch->beta[i];
+		imu.orientation.q0 = batch->q0[i];
+		imu.orientation.q1 = batch->q1[i];
+		imu.orientation.q2 = batch->q2[i];
+		imu.orientation.q3 = batch->q3[i];
+		imu.accel[0] = batch->ax[i];
+		imu.accel[1] = batch->ay[i];
+		imu.accel[2] = batch->az[i];
+		imu.gyro[0] = batch->gx[i];
+		imu.gyro[1] = batch->gy[i];
+		imu.gyro[2] = batch->gz[i];
+		imu.mag[0] = batch->mx[i];
+		imu.mag[1] = batch->my[i];
+		imu.mag[2] = batch->mz[i];
+
+		atualizar(&imu);
+
+		batch->q0[i] = imu.orientation.q0;
+		batch->q1[i] = imu.orientation.q1;
+		batch->q2[i] = imu.orientation.q2;
+		batch->q3[i] = imu.orientation.q3;
+	}
+}
+
+void MadgwickAHRSbatchUpdate(AHRS_batch_t *batch) {
+	batch_executar(batch, MadgwickAHRSupdate);
+}
+
+void MadgwickAHRSbatchUpdateIMU(AHRS_batch_t *batch) {
+	batch_executar(batch, MadgwickAHRSupdateIMU);
+}
+
+//---------------------------------------------------------------------------------------------------
+// Q7.24 arithmetic helpers
+
+static inline q24_t q_mul(q24_t a, q24_t b) {
+	return (q24_t)(((int64_t)a * b) >> Q_FRAC);
+}
+
+// Square kept in 64 bits: norms of unnormalised vectors may exceed the Q7.24 range
+static inline int64_t q_quadrado(q24_t a) {
+	return ((int64_t)a * a) >> Q_FRAC;
+}
+
+static inline q24_t q_de_float(float f) {
+	return (q24_t)(f * (float)Q_UM);
+}
+
+static inline float q_para_float(q24_t q) {
+	return (float)q * (1.0f / (float)Q_UM);
+}
+
+//---------------------------------------------------------------------------------------------------
+// Integer inverse square-root
+//
+// x is a positive Q7.24 value held in 64 bits. It is normalised by an even power of two to
+// m in [0.25, 1) (Q2.30), a 24-entry table gives 1/sqrt(m) within 3%, and two Newton-Raphson
+// iterations y = y * (3 - m * y^2) / 2 bring the relative error below 3e-6 (the float
+// invSqrt() used by MadgwickAHRS.c stops at ~2e-3). The result is rescaled back to Q7.24.
+
+static const int32_t inv_sqrt_tabela[24] = {	// 1/sqrt((i + 8.5) / 32) in Q3.29
+	1041682578, 985333074, 937238702, 895562589,
+	858993459, 826566842, 797555404, 771398898,
+	747657839, 725981977, 706088274, 687745184,
+	670761200, 654976372, 640255922, 626485368,
+	613566757, 601415717, 589959130, 579133272,
+	568882316, 559157115, 549914212, 541115017,
+};
+
+static q24_t q_inv_sqrt(int64_t x) {
+	if (x <= 0) {
+		return 0;
+	}
+
+	// Bit length of x, then an even shift p that brings m = x * 2^p into [2^28, 2^30)
+	int bits = 64 - __builtin_clzll((uint64_t)x);
+	int p = 30 - bits;
+	if (p & 1) {
+		p -= 1;
+	}
+	int64_t m = (p >= 0) ? (x << p) : (x >> -p);
+
+	// Initial guess from the table, indexed by the top bits of m
+	int64_t y = inv_sqrt_tabela[(m >> 25) - 8];
+
+	// Newton-Raphson iterations in Q3.29 (m in Q2.30)
+	for (int i = 0; i < 2; i++) {
+		int64_t y2 = (y * y) >> 29;
+		int64_t my2 = (m * y2) >> 30;
+		y = (y * ((3LL << 29) - my2)) >> 30;
+	}
+
+	// m = x_real * 2^(p - 6), so 1/sqrt(x_real) = y * 2^((p - 6) / 2); Q3.29 -> Q7.24 is >> 5
+	int deslocamento = 5 - (p - 6) / 2;
+	if (deslocamento >= 0) {
+		return (q24_t)(y >> deslocamento);
+	}
+	int64_t r = y << -deslocamento;
+	return (r > INT32_MAX) ? INT32_MAX : (q24_t)r;
+}
+
+//====================================================================================================
+// END OF CODE
+//====================================================================================================
@@ -0,0 +1,125 @@
+// ======================================================================
+//  Arquivo: medicao.c
+//  Descrição: Medição do tempo de execução por etapa do pipeline (mínimo,
+//             média, máximo e histograma logarítmico), só em builds com
+//             MEDIR_TEMPOS
+// ======================================================================
+
+#include "medicao.h"
+
+#ifdef MEDIR_TEMPOS
+
+#include <stdio.h>   // printf
+#include <string.h>  // memcpy
+
+// ----------------------------------------------------------------------
+// Estado global
+// ----------------------------------------------------------------------
+static medicao_estatistica_t g_etapas[MEDICAO_ETAPAS]; ///< Uma linha por etapa
+static volatile uint32_t g_pedido_zerar = 0;           ///< Incrementado pelo núcleo 0 a cada pedido
+
+static const char *const NOMES[MEDICAO_ETAPAS] = {
+    "periodo_nucleo1",
+    "leitura_sensores",
+    "fusao",
+    "getPosition",
+    "dangerCheck",
+    "gravacao_sd",
+};
+
+/**
+ * @brief Faixa do histograma: 0 para 0us; k para [2^(k-1), 2^k) us, limitada à última.
+ */
+static uint32_t faixa(uint32_t duracao_us)
+{
+    if (duracao_us == 0)
+    {
+        return 0;
+    }
+    uint32_t k = 32u - (uint32_t)__builtin_clz(duracao_us);
+    return k < MEDICAO_FAIXAS ? k : MEDICAO_FAIXAS - 1;
+}
+
+// ----------------------------------------------------------------------
+// Registro (núcleo da etapa)
+// ----------------------------------------------------------------------
+void medicao_registrar(medicao_etapa_t etapa, uint32_t duracao_us)
+{
+    medicao_estatistica_t *e = &g_etapas[etapa];
+
+    // Pedido de zerar atendido pelo próprio escritor
+    uint32_t pedido = g_pedido_zerar;
+    if (e->geracao != pedido)
+    {
+        e->contagem = 0;
+        e->soma_us = 0;
+        e->maximo_us = 0;
+        for (uint32_t k = 0; k < MEDICAO_FAIXAS; k++)
+        {
+            e->faixas[k] = 0;
+        }
+        e->geracao = pedido;
+    }
+
+    if (e->contagem == 0 || duracao_us < e->minimo_us)
+    {
+        e->minimo_us = duracao_us;
+    }
+    if (duracao_us > e->maximo_us)
+    {
+        e->maximo_us = duracao_us;
+    }
+    e->soma_us += duracao_us;
+    e->faixas[faixa(duracao_us)]++;
+    e->contagem++;
+}
+
+// ----------------------------------------------------------------------
+// Consulta e relatório (núcleo 0)
+// ----------------------------------------------------------------------
+void medicao_ler(medicao_etapa_t etapa, medicao_estatistica_t *copia)
+{
+    memcpy(copia, &g_etapas[etapa], sizeof(*copia));
+    if (copia->geracao != g_pedido_zerar)
+    {
+        memset(copia, 0, sizeof(*copia));
+    }
+}
+
+void medicao_zerar(void)
+{
+    g_pedido_zerar = g_pedido_zerar + 1;
+}
+
+void medicao_imprimir(void)
+{
+    printf("=== Tempos por etapa (us) ===\n");
+    printf("%-17s %9s %7s %7s %7s\n", "etapa", "medidas", "min", "media", "max");
+    for (int i = 0; i < MEDICAO_ETAPAS; i++)
+    {
+        medicao_estatistica_t e;
+        medicao_ler((medicao_etapa_t)i, &e);
+        if (e.contagem == 0)
+        {
+            printf("%-17s %9s\n", NOMES[i], "-");
+            continue;
+        }
+
+        printf("%-17s %9lu %7lu %7lu %7lu\n", NOMES[i], (unsigned long)e.contagem,
+               (unsigned long)e.minimo_us, (unsigned long)(e.soma_us / e.contagem),
+               (unsigned long)e.maximo_us);
+
+        // Histograma: só as faixas com medidas, pelo limite inferior
+        printf("  ");
+        for (uint32_t k = 0; k < MEDICAO_FAIXAS; k++)
+        {
+            if (e.faixas[k] != 0)
+            {
+                printf(" >=%lu:%lu", k == 0 ? 0ul : 1ul << (k - 1), (unsigned long)e.faixas[k]);
+            }
+        }
+        printf("\n");
+    }
+}
+
+#endif // MEDIR_TEMPOS
@@ -0,0 +1,102 @@
+// ======================================================================
+//  Arquivo: medicao.h
+//  Descrição: Medição do tempo de execução por etapa do pipeline (mínimo,
+//             média, máximo e histograma logarítmico), só em builds com
+//             MEDIR_TEMPOS
+// ======================================================================
+
+#ifndef MEDICAO_H
+#define MEDICAO_H
+
+#include <stdint.h>       // Tipos inteiros padrão
+#include "pico/stdlib.h"  // time_us_32
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Etapas medidas
+// ----------------------------------------------------------------------
+/**
+ * @brief Etapas instrumentadas. Cada uma é medida por um único núcleo
+ *        (único escritor da sua linha da tabela).
+ */
+typedef enum {
+    MEDICAO_PERIODO_NUCLEO1 = 0, ///< Trabalho de um período do laço de tempo real (núcleo 1)
+    MEDICAO_LEITURA_SENSORES,    ///< Leitura das FIFOs e dos magnetômetros (núcleo 1)
+    MEDICAO_FUSAO,               ///< Uma atualização do motor de fusão, p.ex. MadgwickAHRSbatchUpdate (núcleo 1)
+    MEDICAO_GET_POSITION,        ///< getPosition: ângulos do quadril (núcleo 1)
+    MEDICAO_DANGER_CHECK,        ///< dangerCheck: eventos e alarme (núcleo 1)
+    MEDICAO_GRAVACAO_SD,         ///< append_csv_block de um lote (núcleo 0)
+    MEDICAO_ETAPAS
+} medicao_etapa_t;
+
+#define MEDICAO_FAIXAS 20 ///< Faixas do histograma: 0us, [1,2), [2,4), ... e a última a partir de 2^18us (~262ms)
+
+// ----------------------------------------------------------------------
+// Marcadores de início e fim
+// ----------------------------------------------------------------------
+// Sem MEDIR_TEMPOS (build padrão) os marcadores não geram código e a tabela,
+// as funções e a leitura do timer não existem no binário.
+#ifdef MEDIR_TEMPOS
+#define MEDICAO_INICIO(etapa) const uint32_t medicao_inicio_##etapa = time_us_32()
+#define MEDICAO_FIM(etapa)    medicao_registrar((etapa), time_us_32() - medicao_inicio_##etapa)
+#else
+#define MEDICAO_INICIO(etapa) do {} while (0)
+#define MEDICAO_FIM(etapa)    do {} while (0)
+#endif
+
+#ifdef MEDIR_TEMPOS
+
+// ----------------------------------------------------------------------
+// Estrutura: medicao_estatistica_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Estatísticas de uma etapa, em tabela estática.
+ *
+ * Escrita só pelo núcleo que executa a etapa; a impressão no núcleo 0 lê
+ * palavras de 32 bits sem trava (uma linha pode sair com uma medida a mais
+ * em um campo que em outro). Zerar é um pedido atendido pelo próprio escritor
+ * na medida seguinte.
+ */
+typedef struct {
+    uint32_t contagem;                 ///< Medidas registradas
+    uint32_t minimo_us;                ///< Menor duração
+    uint32_t maximo_us;                ///< Maior duração (tempo de pior caso observado)
+    uint64_t soma_us;                  ///< Soma das durações, para a média
+    uint32_t faixas[MEDICAO_FAIXAS];   ///< Histograma: faixa k >= 1 conta durações em [2^(k-1), 2^k) us
+    uint32_t geracao;                  ///< Último pedido de zerar atendido
+} medicao_estatistica_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Registra uma duração da etapa (use MEDICAO_INICIO/MEDICAO_FIM).
+ * @param etapa Etapa medida
+ * @param duracao_us Duração (us)
+ */
+void medicao_registrar(medicao_etapa_t etapa, uint32_t duracao_us);
+
+/**
+ * @brief Copia as estatísticas de uma etapa.
+ * @param etapa Etapa
+ * @param[out] copia Estatísticas (zeradas se houver pedido de zerar pendente)
+ */
+void medicao_ler(medicao_etapa_t etapa, medicao_estatistica_t *copia);
+
+/** @brief Pede que todas as etapas sejam zeradas (cada uma na sua próxima medida). */
+void medicao_zerar(void);
+
+/** @brief Imprime mínimo, média, máximo e histograma de cada etapa. */
+void medicao_imprimir(void);
+
+#endif // MEDIR_TEMPOS
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEDICAO_H
@@ -9,105 +9,18 @@
  * - Magnetômetro AK8963 de 3 eixos (integrado)
  */
 #include "mpu9250_i2c.h"
+#include "mpu9250_regs.h"  // Mapa de registradores do MPU9250 e do AK8963
 #include <stdio.h>
 #include <stdlib.h>
 
-/**
- * ENDEREÇOS DOS REGISTRADORES DO MPU9250
- * ====================================
- * Estes endereços definem os registradores internos do MPU9250 
- * que controlam configuração, leitura de dados e status do sensor
- */
-#define MPU9250_WHO_AM_I        0x75  // Registrador de identificação do chip
-#define MPU9250_PWR_MGMT_1      0x6B  // Gerenciamento de energia principal
-#define MPU9250_PWR_MGMT_2      0x6C  // Gerenciamento de energia dos sensores
-#define MPU9250_CONFIG          0x1A  // Configuração do filtro digital passa-baixa
-#define MPU9250_GYRO_CONFIG     0x1B  // Configuração do giroscópio (range e self-test)
-#define MPU9250_ACCEL_CONFIG    0x1C  // Configuração do acelerômetro (range e self-test)
-#define MPU9250_ACCEL_CONFIG2   0x1D  // Configuração adicional do acelerômetro (DLPF)
-#define MPU9250_SMPLRT_DIV      0x19  // Divisor da taxa de amostragem
-#define MPU9250_INT_PIN_CFG     0x37  // Configuração do pino de interrupção
-#define MPU9250_INT_ENABLE      0x38  // Habilitação de interrupções
-#define MPU9250_INT_STATUS      0x3A  // Status das interrupções
-#define MPU9250_ACCEL_XOUT_H    0x3B  // Início dos dados do acelerômetro (byte alto X)
-#define MPU9250_TEMP_OUT_H      0x41  // Dados de temperatura (byte alto)
-#define MPU9250_GYRO_XOUT_H     0x43  // Início dos dados do giroscópio (byte alto X)
-#define MPU9250_USER_CTRL       0x6A  // Controle de usuário (I2C master, reset, etc.)
-#define MPU9250_I2C_MST_CTRL    0x24  // Controle do I2C master
-#define MPU9250_I2C_SLV0_ADDR   0x25  // Endereço do dispositivo slave 0
-#define MPU9250_I2C_SLV0_REG    0x26  // Registrador do slave 0 para leitura/escrita
-#define MPU9250_I2C_SLV0_CTRL   0x27  // Controle do slave 0 (enable, length)
-#define MPU9250_I2C_SLV0_DO     0x63  // Dados de saída para escrita no slave 0
-#define MPU9250_EXT_SENS_DATA_00 0x49 // Início dos dados lidos dos sensores externos
-
-/**
- * ENDEREÇOS DOS REGISTRADORES DO MAGNETÔMETRO AK8963
- * =================================================
- * O magnetômetro AK8963 é um chip separado integrado ao MPU9250.
- * É acessado via I2C master do MPU9250 ou através de bypass I2C.
- */
-#define AK8963_WHO_AM_I     0x00  // Identificação do chip magnetômetro
-#define AK8963_INFO         0x01  // Informações do dispositivo
-#define AK8963_ST1          0x02  // Status 1 (data ready)
-#define AK8963_XOUT_L       0x03  // Dados magnéticos X (byte baixo)
-#define AK8963_XOUT_H       0x04  // Dados magnéticos X (byte alto)
-#define AK8963_YOUT_L       0x05  // Dados magnéticos Y (byte baixo)
-#define AK8963_YOUT_H       0x06  // Dados magnéticos Y (byte alto)
-#define AK8963_ZOUT_L       0x07  // Dados magnéticos Z (byte baixo)
-#define AK8963_ZOUT_H       0x08  // Dados magnéticos Z (byte alto)
-#define AK8963_ST2          0x09  // Status 2 (overflow)
-#define AK8963_CNTL1        0x0A  // Controle 1 (modo de operação)
-#define AK8963_CNTL2        0x0B  // Controle 2 (reset)
-#define AK8963_ASTC         0x0C  // Self-test
-#define AK8963_I2CDIS       0x0F  // Desabilita I2C
-#define AK8963_ASAX         0x10  // Ajuste de sensibilidade X
-#define AK8963_ASAY         0x11  // Ajuste de sensibilidade Y
-#define AK8963_ASAZ         0x12  // Ajuste de sensibilidade Z
-
-/**
- * REGISTRADORES DE SELF-TEST
- * ==========================
- * Utilizados para verificar a integridade dos sensores
- */
-#define SELF_TEST_X_GYRO   0x00  // Self-test giroscópio eixo X
-#define SELF_TEST_Y_GYRO   0x01  // Self-test giroscópio eixo Y
-#define SELF_TEST_Z_GYRO   0x02  // Self-test giroscópio eixo Z
-#define SELF_TEST_X_ACCEL  0x0D  // Self-test acelerômetro eixo X
-#define SELF_TEST_Y_ACCEL  0x0E  // Self-test acelerômetro eixo Y
-#define SELF_TEST_Z_ACCEL  0x0F  // Self-test acelerômetro eixo Z
-
-/**
- * DEFINIÇÕES DE BITS DOS REGISTRADORES
- * ===================================
- * Máscaras e valores específicos para configuração dos registradores
- */
-#define PWR_RESET           0x80 // Bit 7 - Reset do dispositivo
-#define CLOCK_SEL_PLL       0x01 // Seleção de clock PLL (mais estável)
-#define I2C_MST_EN          0x20 // Habilita modo I2C master
-#define I2C_SLV0_EN         0x80 // Habilita slave 0 do I2C master
-#define I2C_READ_FLAG       0x80 // Flag para operação de leitura I2C
-#define BYPASS_EN           0x02 // Habilita bypass I2C (acesso direto ao magnetômetro)
-
-/**
- * IDS DOS DISPOSITIVOS
- * ===================
- * Valores esperados no registrador WHO_AM_I para identificação dos chips
- */
-#define MPU9250_ID          0x71  // ID do chip MPU9250
-#define MPU9255_ID          0x73  // ID do chip MPU9255 (variante do MPU9250)
-#define AK8963_ID           0x48  // ID do chip magnetômetro AK8963
-
 /**
  * PROTÓTIPOS DAS FUNÇÕES INTERNAS
  * ==============================
  * Funções auxiliares para comunicação I2C de baixo nível
  */
 static void mpu9250_write_reg(mpu9250_t *mpu, uint8_t reg, uint8_t data);
-static uint8_t mpu9250_read_reg(mpu9250_t *mpu, uint8_t reg);
-static void mpu9250_read_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len);
 static void mpu9250_write_mag_reg(mpu9250_t *mpu, uint8_t reg, uint8_t data);
 static uint8_t mpu9250_read_mag_reg(mpu9250_t *mpu, uint8_t reg);
-static void mpu9250_read_mag_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len);
 static void mpu9250_update_sensitivity_factors(mpu9250_t *mpu);
 
 /**
@@ -191,7 +104,8 @@ void mpu9250_reset(mpu9250_t *mpu)
  * 4. Configura ranges do acelerômetro e giroscópio
  * 5. Configura filtros digitais (DLPF)
  * 6. Define taxa de amostragem
- * 7. Inicializa magnetômetro se solicitado
+ * 7. Sem magnetômetro, desliga-o (power-down); com ele, a habilitação fica para
+ *    o chamador, como sequência em etapas (sequenciaHabilitarMagnetometro)
  * 
  * @param mpu Ponteiro para a estrutura do MPU9250
  * @param config Ponteiro para estrutura de configuração com parâmetros desejados
@@ -223,13 +137,10 @@ bool mpu9250_init(mpu9250_t *mpu, mpu9250_config_t *config)
     // Configure sample rate
     mpu9250_set_sample_rate(mpu, config->sample_rate_divider);
     
-    // Initialize magnetometer if enabled
-    if (config->enable_magnetometer) 
+    // 6-DOF mode: power the magnetometer down (enabling it is a stepwise sequence run by the caller)
+    if (!config->enable_magnetometer) 
     {
-        if (!mpu9250_enable_magnetometer(mpu, true)) 
-        {
-            return false;
-        }
+        mpu9250_disable_magnetometer(mpu);
     }
     
     return true;
@@ -375,138 +286,33 @@ void mpu9250_set_sample_rate(mpu9250_t *mpu, uint8_t divider)
 }
 
 /**
- * @brief Habilita ou desabilita o magnetômetro AK8963 integrado
+ * @brief Desabilita o magnetômetro AK8963 e o coloca em power-down
  * 
- * Esta é uma das funções mais complexas do driver, pois o magnetômetro AK8963 é um
- * chip separado que deve ser acessado através do MPU9250. O processo envolve:
- * 
- * HABILITAÇÃO:
- * 1. Configurar bypass I2C para acesso direto temporário
- * 2. Verificar conectividade com o magnetômetro
- * 3. Ler valores de calibração de fábrica (ASA - Adjustment Values)
- * 4. Configurar modo de operação contínuo
- * 5. Configurar I2C master do MPU9250 para leitura automática
- * 6. Verificar configuração final
- * 
- * DESABILITAÇÃO:
- * 1. Colocar magnetômetro em power-down
- * 2. Desabilitar bypass I2C
+ * Para a leitura automática pelo I2C master e, via bypass, desliga o AK8963.
+ * A habilitação, longa e cheia de esperas, é uma sequência em etapas
+ * (sequenciaHabilitarMagnetometro, em sequencias_mpu9250.h).
  * 
  * @param mpu Ponteiro para a estrutura do MPU9250
- * @param enable true para habilitar, false para desabilitar
- * @return true se operação bem-sucedida, false caso contrário
  */
-bool mpu9250_enable_magnetometer(mpu9250_t *mpu, bool enable)
+void mpu9250_disable_magnetometer(mpu9250_t *mpu)
 {
-    if (enable) 
-    {
-        printf("Starting magnetometer initialization...\n");
-        
-        // 1. Desabilita I2C master e ativa bypass para acesso direto ao magnetômetro
-        // Isso permite comunicação direta com o AK8963 temporariamente
-        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, 0x00);
-        sleep_ms(10);
-        uint8_t int_pin_cfg = mpu9250_read_reg(mpu, MPU9250_INT_PIN_CFG);
-        mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg | BYPASS_EN);
-        sleep_ms(100);
-        
-        // 2. Testa conexão com magnetômetro via bypass
-        if (!mpu9250_test_mag_connection(mpu)) 
-        {
-            printf("ERROR: Magnetometer not detected!\n");
-            return false;
-        }
-        printf("Magnetometer detected successfully\n");
-        
-        // 3. Reset do magnetômetro para estado conhecido
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL2, 0x01);
-        sleep_ms(100);
-        
-        // 4. Entra no modo FUSE ROM para ler valores de calibração de fábrica
-        // Os valores ASA (Adjustment Sensitivity Adjustment) compensam variações de fabricação
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL1, AK8963_FUSE_ROM);
-        sleep_ms(100);
-        
-        // 5. Lê valores de calibração ASA (Adjustment Sensitivity Adjustment)
-        // Estes valores são únicos para cada chip e corrigem variações de fabricação
-        uint8_t asa_data[3];
-        mpu9250_read_mag_regs(mpu, AK8963_ASAX, asa_data, 3);
-        for (int i = 0; i < 3; i++) {
-            // Fórmula do datasheet: ASA = (valor_lido - 128)/256 + 1
-            mpu->mag_asa[i] = ((float)asa_data[i] - 128.0f) / 256.0f + 1.0f;
-        }
-        printf("ASA values: X=%.3f, Y=%.3f, Z=%.3f\n", 
-               mpu->mag_asa[0], mpu->mag_asa[1], mpu->mag_asa[2]);
-        
-        // 6. Power down antes de configurar modo contínuo (transição obrigatória)
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL1, AK8963_POWER_DOWN);
-        sleep_ms(100);
-        
-        // 7. Configura magnetômetro para modo contínuo 2 (100Hz) com resolução 16-bit
-        // 0x16 = Continuous mode 2 (100Hz) + 16-bit output
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL1, 0x16);
-        sleep_ms(100);
-        
-        // 8. Verifica se entrou corretamente no modo contínuo
-        uint8_t cntl1 = mpu9250_read_mag_reg(mpu, AK8963_CNTL1);
-        printf("AK8963 CNTL1: 0x%02X (Expected: 0x16)\n", cntl1);
-        
-        // 9. Desativa bypass - volta para comunicação via I2C master
-        mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
-        sleep_ms(10);
-        
-        // 10. Primeiro desabilita todas as slaves I2C (limpeza preventiva)
-        for (int i = 0; i < 4; i++) {
-            mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_CTRL + i*3, 0x00);
-        }
-        sleep_ms(10);
-        
-        // 11. Configura clock do I2C master ANTES de habilitar (400kHz)
-        // 0x0D = frequência de ~400kHz para comunicação com magnetômetro
-        mpu9250_write_reg(mpu, MPU9250_I2C_MST_CTRL, 0x0D);
-        sleep_ms(10);
-        
-        // 12. Configura Slave 0 para leitura automática do magnetômetro
-        // Endereço do AK8963 com bit de leitura (0x8C = 0x0C | 0x80)
-        mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_ADDR, AK8963_ADDR | I2C_READ_FLAG);
-        sleep_ms(5);
-        // Registrador inicial para leitura (ST1 - inclui status + dados + ST2)
-        mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_REG, AK8963_ST1);
-        sleep_ms(5);
-        // Habilita slave 0 + lê 8 bytes (ST1 + 6 bytes dados + ST2)
-        mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_CTRL, 0x88);
-        sleep_ms(10);
-        
-        // 13. Agora habilita I2C master para começar leituras automáticas
-        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, I2C_MST_EN);
-        sleep_ms(100);
-        
-        // 14. Verificação final da configuração
-        uint8_t verify_addr = mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_ADDR);
-        uint8_t verify_reg = mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_REG);
-        uint8_t verify_ctrl = mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_CTRL);
-        uint8_t verify_user = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
-        
-        printf("Final verification:\n");
-        printf("  I2C_SLV0_ADDR: 0x%02X (Expected: 0x8C)\n", verify_addr);
-        printf("  I2C_SLV0_REG: 0x%02X (Expected: 0x02)\n", verify_reg);
-        printf("  I2C_SLV0_CTRL: 0x%02X (Expected: 0x88)\n", verify_ctrl);
-        printf("  USER_CTRL: 0x%02X (Expected: 0x20)\n", verify_user);
-        
-        mpu->mag_enabled = true;
-        printf("Magnetometer initialization completed\n");
-    } 
-    else 
-    {
-        // DESABILITAÇÃO DO MAGNETÔMETRO
-        // Coloca magnetômetro em power-down
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL1, AK8963_POWER_DOWN);
-        // Desabilita bypass mode
-        uint8_t int_pin_cfg = mpu9250_read_reg(mpu, MPU9250_INT_PIN_CFG);
-        mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
-        mpu->mag_enabled = false;
-    }
-    return true;
+    // Para a leitura automática: sem I2C master o AK8963 só é acessível via bypass
+    mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_CTRL, 0x00);
+    uint8_t user_ctrl = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
+    mpu9250_write_reg(mpu, MPU9250_USER_CTRL, user_ctrl & ~I2C_MST_EN);
+    sleep_ms(10);
+    mpu->mag_enabled = false;
+    mpu->mag_overflow = false;
+
+    // Coloca magnetômetro em power-down. O reset do MPU9250 não alcança o
+    // AK8963: após um reboot só do RP2040 ele pode seguir em modo contínuo
+    uint8_t int_pin_cfg = mpu9250_read_reg(mpu, MPU9250_INT_PIN_CFG);
+    mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg | BYPASS_EN);
+    sleep_ms(10);
+    mpu9250_write_mag_reg(mpu, AK8963_CNTL1, AK8963_POWER_DOWN);
+
+    // Desabilita bypass mode
+    mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
 }
 
 /**
@@ -573,9 +379,9 @@ void mpu9250_read_raw_motion(mpu9250_t *mpu, int16_t accel[3], int16_t gyro[3],
  */
 void mpu9250_read_raw_mag(mpu9250_t *mpu, int16_t mag[3])
 {
-    if (!mpu->mag_enabled) 
+    if (!mpu->mag_enabled || mpu->mag_overflow) 
     {
-        // Magnetômetro não habilitado - retorna zeros
+        // Magnetômetro não habilitado ou aguardando recuperação - retorna zeros
         mag[0] = mag[1] = mag[2] = 0;
         return;
     }
@@ -586,40 +392,36 @@ void mpu9250_read_raw_mag(mpu9250_t *mpu, int16_t mag[3])
     // Lê os 8 bytes de dados do magnetômetro capturados automaticamente
     // Layout: ST1(0), HXL(1), HXH(2), HYL(3), HYH(4), HZL(5), HZH(6), ST2(7)
     mpu9250_read_regs(mpu, MPU9250_EXT_SENS_DATA_00, buffer, 8);
-    
+    mpu9250_mag_decode(mpu, buffer, mag);
+}
+
+/**
+ * @brief Converte os 8 bytes de EXT_SENS_DATA_00 em leitura bruta do magnetômetro
+ * 
+ * Separada da leitura para ser usada também com bytes lidos fora do driver
+ * (captura por DMA, ver captura_sensores.h).
+ * 
+ * @param mpu Ponteiro para a estrutura do MPU9250 (recebe mag_overflow)
+ * @param buffer ST1, HXL, HXH, HYL, HYH, HZL, HZH, ST2
+ * @param mag Array para dados brutos do magnetômetro [X,Y,Z] realinhados
+ * @return true se havia dado novo e válido (senão mag recebe zeros)
+ */
+bool mpu9250_mag_decode(mpu9250_t *mpu, const uint8_t buffer[8], int16_t mag[3])
+{
     // Verifica se dados estão prontos (bit 0 do ST1 = DRDY)
-    if (!(buffer[0] & 0x01)) {
+    if (!(buffer[0] & AK8963_ST1_DRDY)) {
         // Dados não prontos, retorna zeros
         mag[0] = mag[1] = mag[2] = 0;
-        return;
+        return false;
     }
     
-    // Verifica ST2 para overflow magnético (bit 3 = HOFL)
-    if (buffer[7] & 0x08) {
-        // Overflow detectado - sensor magnético saturado, necessário reset
-        printf("Magnetometer overflow detected, resetting...\n");
-        
-        // Ativa bypass temporariamente para reset direto do magnetômetro
-        uint8_t user_ctrl = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
-        uint8_t int_pin_cfg = mpu9250_read_reg(mpu, MPU9250_INT_PIN_CFG);
-        
-        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, 0x00);
-        mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg | BYPASS_EN);
-        sleep_ms(10);
-        
-        // Reset e reconfigura magnetômetro
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL1, AK8963_POWER_DOWN);
-        sleep_ms(10);
-        mpu9250_write_mag_reg(mpu, AK8963_CNTL1, 0x16); // Continuous mode 2 + 16-bit
-        sleep_ms(10);
-        
-        // Restaura modo I2C master
-        mpu9250_write_reg(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
-        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, user_ctrl);
-        sleep_ms(10);
-        
+    // Verifica ST2 para overflow magnético (bit 3 = HOFL): sensor saturado, precisa
+    // de reset. O reset é uma sequência em etapas (sequenciaRecuperarMagnetometro),
+    // retomada pelo laço do núcleo 1; até ela terminar as leituras retornam zeros
+    if (buffer[7] & AK8963_ST2_HOFL) {
+        mpu->mag_overflow = true;
         mag[0] = mag[1] = mag[2] = 0;
-        return;
+        return false;
     }
     
     // Converte dados do magnetômetro (formato little endian: byte baixo primeiro)
@@ -638,6 +440,7 @@ void mpu9250_read_raw_mag(mpu9250_t *mpu, int16_t mag[3])
     mag[0] = mag_raw[1];
     mag[1] = mag_raw[0];
     mag[2] = -mag_raw[2];
+    return true;
 }
 
 /**
@@ -728,6 +531,134 @@ void mpu9250_read_data(mpu9250_t *mpu, mpu9250_data_t *data)
     mpu9250_read_mag(mpu, data->mag);
 }
 
+/**
+ * @brief Habilita ou desabilita a FIFO de acelerômetro e giroscópio
+ * 
+ * Com a FIFO habilitada o sensor grava cada amostra (na taxa definida por
+ * SMPLRT_DIV) independentemente do firmware, que pode ler várias de uma vez
+ * sem perder amostras nem depender do período do loop principal.
+ * 
+ * O bit I2C_MST_EN do USER_CTRL é preservado para não interromper a leitura
+ * automática do magnetômetro. O magnetômetro não é gravado na FIFO: sua taxa
+ * própria (100Hz) é menor que a da FIFO e ele é lido diretamente.
+ * 
+ * @param mpu Ponteiro para a estrutura do MPU9250
+ * @param enable true para habilitar, false para desabilitar
+ */
+void mpu9250_fifo_enable(mpu9250_t *mpu, bool enable)
+{
+    uint8_t user_ctrl = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
+    
+    // Para a gravação e esvazia a FIFO
+    mpu9250_write_reg(mpu, MPU9250_FIFO_EN, 0x00);
+    mpu9250_write_reg(mpu, MPU9250_USER_CTRL, (user_ctrl & ~USER_FIFO_EN) | USER_FIFO_RST);
+    
+    if (enable) 
+    {
+        // Sinaliza transbordo em INT_STATUS (o pino de interrupção não é usado)
+        mpu9250_write_reg(mpu, MPU9250_INT_ENABLE, INT_FIFO_OFLOW);
+        mpu9250_read_reg(mpu, MPU9250_INT_STATUS); // Limpa status pendente
+        
+        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, user_ctrl | USER_FIFO_EN);
+        mpu9250_write_reg(mpu, MPU9250_FIFO_EN, FIFO_EN_GYRO_ACCEL);
+    } 
+    else 
+    {
+        mpu9250_write_reg(mpu, MPU9250_INT_ENABLE, 0x00);
+        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, user_ctrl & ~USER_FIFO_EN);
+    }
+}
+
+/**
+ * @brief Lê as amostras de acelerômetro e giroscópio acumuladas na FIFO
+ * 
+ * Cada amostra tem 12 bytes em big endian, na ordem dos registradores:
+ * acelerômetro X, Y, Z e giroscópio X, Y, Z. Apenas amostras completas são
+ * lidas; bytes de uma amostra parcial ficam para a próxima chamada.
+ * 
+ * Se a FIFO transbordou, as amostras mais antigas foram sobrescritas e o
+ * alinhamento de 12 bytes foi perdido: a FIFO é esvaziada e nenhuma amostra é
+ * retornada, cabendo ao chamador tratar a lacuna.
+ * 
+ * @param mpu Ponteiro para a estrutura do MPU9250
+ * @param frames Buffer para as amostras lidas
+ * @param max_frames Número máximo de amostras a ler
+ * @param overflow Recebe true se houve transbordo (pode ser NULL)
+ * @return Número de amostras lidas
+ */
+uint16_t mpu9250_fifo_read(mpu9250_t *mpu, mpu9250_fifo_frame_t *frames, uint16_t max_frames, bool *overflow)
+{
+    const uint16_t BYTES_POR_AMOSTRA = MPU9250_FIFO_BYTES_AMOSTRA;
+    const uint16_t AMOSTRAS_POR_LEITURA = 21; // 252 bytes: cabe no tamanho de leitura de mpu9250_read_regs
+    
+    if (overflow) *overflow = false;
+    
+    // Transbordo: descarta o conteúdo desalinhado
+    if (mpu9250_read_reg(mpu, MPU9250_INT_STATUS) & INT_FIFO_OFLOW) 
+    {
+        if (overflow) *overflow = true;
+        uint8_t user_ctrl = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
+        mpu9250_write_reg(mpu, MPU9250_USER_CTRL, user_ctrl | USER_FIFO_RST);
+        return 0;
+    }
+    
+    uint8_t count_buf[2] = {0, 0}; // Falha de comunicação resulta em FIFO vazia
+    mpu9250_read_regs(mpu, MPU9250_FIFO_COUNTH, count_buf, 2);
+    uint16_t bytes = (uint16_t)(((count_buf[0] & 0x1F) << 8) | count_buf[1]);
+    
+    uint16_t total = bytes / BYTES_POR_AMOSTRA;
+    if (total > max_frames) total = max_frames;
+    
+    // Lê em blocos para limitar o buffer na pilha
+    uint8_t buffer[AMOSTRAS_POR_LEITURA * BYTES_POR_AMOSTRA];
+    uint16_t lidas = 0;
+    while (lidas < total) 
+    {
+        uint16_t bloco = total - lidas;
+        if (bloco > AMOSTRAS_POR_LEITURA) bloco = AMOSTRAS_POR_LEITURA;
+        mpu9250_read_regs(mpu, MPU9250_FIFO_R_W, buffer, (uint8_t)(bloco * BYTES_POR_AMOSTRA));
+        
+        mpu9250_fifo_decode(buffer, bloco, &frames[lidas]);
+        lidas += bloco;
+    }
+    
+    return lidas;
+}
+
+/**
+ * @brief Converte amostras da FIFO (12 bytes cada, big endian) em mpu9250_fifo_frame_t
+ * 
+ * Ordem dos registradores: acelerômetro X, Y, Z e giroscópio X, Y, Z.
+ * 
+ * Os 12 bytes de uma amostra são todos lidos antes de qualquer escrita, então
+ * frames pode coincidir com bytes (conversão no lugar, sem buffer extra).
+ * 
+ * @param bytes Bytes lidos de FIFO_R_W (12 por amostra)
+ * @param n_frames Número de amostras completas em bytes
+ * @param frames Buffer de saída (n_frames amostras; pode ser o próprio bytes)
+ */
+void mpu9250_fifo_decode(const uint8_t *bytes, uint16_t n_frames, mpu9250_fifo_frame_t *frames)
+{
+    for (uint16_t i = 0; i < n_frames; i++) 
+    {
+        const uint8_t *b = &bytes[i * MPU9250_FIFO_BYTES_AMOSTRA];
+        int16_t ax = (int16_t)((b[0] << 8) | b[1]);
+        int16_t ay = (int16_t)((b[2] << 8) | b[3]);
+        int16_t az = (int16_t)((b[4] << 8) | b[5]);
+        int16_t gx = (int16_t)((b[6] << 8) | b[7]);
+        int16_t gy = (int16_t)((b[8] << 8) | b[9]);
+        int16_t gz = (int16_t)((b[10] << 8) | b[11]);
+
+        mpu9250_fifo_frame_t *f = &frames[i];
+        f->accel[0] = ax;
+        f->accel[1] = ay;
+        f->accel[2] = az;
+        f->gyro[0]  = gx;
+        f->gyro[1]  = gy;
+        f->gyro[2]  = gz;
+    }
+}
+
 /**
  * @brief Lê apenas a temperatura calibrada
  * 
@@ -859,190 +790,41 @@ void mpu9250_calibrate_gyro(mpu9250_t *mpu, uint16_t samples, float gyro_offset[
 }
 
 /**
- * @brief Executa self-test completo do MPU9250
- * 
- * O self-test é um teste de integridade que verifica se os sensores estão
- * funcionando corretamente comparando suas respostas com e sem estimulação
- * interna. O teste segue o procedimento do datasheet:
- * 
- * 1. Lê códigos de self-test de fábrica
- * 2. Salva configuração atual (incluindo I2C master)
- * 3. Configura sensor para condições de teste
- * 4. Coleta amostras sem self-test (operação normal)
- * 5. Coleta amostras com self-test habilitado
- * 6. Restaura configuração original
- * 7. Calcula resposta ao self-test (diferença entre modos)
- * 8. Valida se resposta está dentro dos limites esperados
- * 
- * IMPORTANTE: Preserva completamente a configuração do I2C master para
- * não interromper a operação do magnetômetro.
+ * FUNÇÕES DE BAIXO NÍVEL - COMUNICAÇÃO I2C
+ * ========================================
+ * Estas funções implementam a comunicação I2C básica com o MPU9250 e
+ * magnetômetro AK8963. As estáticas são auxiliares da API; as públicas
+ * (leituras e escritas sem espera) servem às sequências em etapas
+ * (sequencias_mpu9250.h).
+ */
+
+/**
+ * @brief Escreve um valor em um registrador do MPU9250
  * 
  * @param mpu Ponteiro para a estrutura do MPU9250
- * @return true se todos os testes passaram, false caso contrário
+ * @param reg Endereço do registrador (8 bits)
+ * @param data Valor a ser escrito (8 bits)
  */
-bool mpu9250_self_test(mpu9250_t *mpu)
+static void mpu9250_write_reg(mpu9250_t *mpu, uint8_t reg, uint8_t data)
 {
-    // Leitura dos códigos de fábrica de self-test
-    // Estes valores são únicos para cada chip e definem a resposta esperada
-    uint8_t st_gyro[3], st_accel[3];
-    st_gyro[0]  = mpu9250_read_reg(mpu, SELF_TEST_X_GYRO);
-    st_gyro[1]  = mpu9250_read_reg(mpu, SELF_TEST_Y_GYRO);
-    st_gyro[2]  = mpu9250_read_reg(mpu, SELF_TEST_Z_GYRO);
-    st_accel[0] = mpu9250_read_reg(mpu, SELF_TEST_X_ACCEL);
-    st_accel[1] = mpu9250_read_reg(mpu, SELF_TEST_Y_ACCEL);
-    st_accel[2] = mpu9250_read_reg(mpu, SELF_TEST_Z_ACCEL);
-
-    printf("Factory self-test codes (Accel: %02X %02X %02X, Gyro: %02X %02X %02X)\n",
-           st_accel[0], st_accel[1], st_accel[2], st_gyro[0], st_gyro[1], st_gyro[2]);
-
-    // Salva configuração atual incluindo registradores do I2C master
-    // CRÍTICO: Deve preservar configuração do magnetômetro
-    uint8_t saved_config[10];
-    saved_config[0] = mpu9250_read_reg(mpu, MPU9250_SMPLRT_DIV);
-    saved_config[1] = mpu9250_read_reg(mpu, MPU9250_CONFIG);
-    saved_config[2] = mpu9250_read_reg(mpu, MPU9250_GYRO_CONFIG);
-    saved_config[3] = mpu9250_read_reg(mpu, MPU9250_ACCEL_CONFIG);
-    saved_config[4] = mpu9250_read_reg(mpu, MPU9250_ACCEL_CONFIG2);
-    saved_config[5] = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
-    saved_config[6] = mpu9250_read_reg(mpu, MPU9250_I2C_MST_CTRL);
-    saved_config[7] = mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_ADDR);
-    saved_config[8] = mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_REG);
-    saved_config[9] = mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_CTRL);
-    
-    printf("Starting MPU9250 self-test...\n");
-    
-    // Configura para self-test conforme datasheet
-    mpu9250_write_reg(mpu, MPU9250_SMPLRT_DIV, 0x00);    // Taxa de amostragem = 1kHz
-    mpu9250_write_reg(mpu, MPU9250_CONFIG, 0x02);         // DLPF = 92Hz
-    mpu9250_write_reg(mpu, MPU9250_GYRO_CONFIG, 0x00);    // ±250 dps, sem self-test
-    mpu9250_write_reg(mpu, MPU9250_ACCEL_CONFIG, 0x00);   // ±2g, sem self-test  
-    mpu9250_write_reg(mpu, MPU9250_ACCEL_CONFIG2, 0x02);  // DLPF = 92Hz
-    
-    sleep_ms(50); // Aguarda estabilização das configurações
-    
-    // Collect normal operation samples (no self-test)
-    int32_t accel_normal_sum[3] = {0}, gyro_normal_sum[3] = {0};
-    int16_t accel_raw[3], gyro_raw[3], temp_raw;
-    
-    for (int i = 0; i < 200; i++) 
-    {
-        mpu9250_read_raw_motion(mpu, accel_raw, gyro_raw, &temp_raw);
-        accel_normal_sum[0] += accel_raw[0];
-        accel_normal_sum[1] += accel_raw[1];
-        accel_normal_sum[2] += accel_raw[2];
-        gyro_normal_sum[0] += gyro_raw[0];
-        gyro_normal_sum[1] += gyro_raw[1];
-        gyro_normal_sum[2] += gyro_raw[2];
-        sleep_ms(1);
-    }
-    
-    // Enable self-test
-    mpu9250_write_reg(mpu, MPU9250_GYRO_CONFIG, 0xE0);    // Enable XYZ self-test, ±250 dps
-    mpu9250_write_reg(mpu, MPU9250_ACCEL_CONFIG, 0xE0);   // Enable XYZ self-test, ±2g
-    
-    sleep_ms(50); // Wait for self-test to stabilize
-    
-    // Collect self-test samples
-    int32_t accel_st_sum[3] = {0}, gyro_st_sum[3] = {0};
-    
-    for (int i = 0; i < 200; i++) 
-    {
-        mpu9250_read_raw_motion(mpu, accel_raw, gyro_raw, &temp_raw);
-        accel_st_sum[0] += accel_raw[0];
-        accel_st_sum[1] += accel_raw[1];
-        accel_st_sum[2] += accel_raw[2];
-        gyro_st_sum[0] += gyro_raw[0];
-        gyro_st_sum[1] += gyro_raw[1];
-        gyro_st_sum[2] += gyro_raw[2];
-        sleep_ms(1);
-    }
-    
-    // Restore original configuration including I2C master settings
-    mpu9250_write_reg(mpu, MPU9250_SMPLRT_DIV, saved_config[0]);
-    mpu9250_write_reg(mpu, MPU9250_CONFIG, saved_config[1]);
-    mpu9250_write_reg(mpu, MPU9250_GYRO_CONFIG, saved_config[2]);
-    mpu9250_write_reg(mpu, MPU9250_ACCEL_CONFIG, saved_config[3]);
-    mpu9250_write_reg(mpu, MPU9250_ACCEL_CONFIG2, saved_config[4]);
-    mpu9250_write_reg(mpu, MPU9250_USER_CTRL, saved_config[5]);
-    mpu9250_write_reg(mpu, MPU9250_I2C_MST_CTRL, saved_config[6]);
-    mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_ADDR, saved_config[7]);
-    mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_REG, saved_config[8]);
-    mpu9250_write_reg(mpu, MPU9250_I2C_SLV0_CTRL, saved_config[9]);
-    sleep_ms(10); // Give time for I2C master to restart
-    
-    // Calculate averages
-    int32_t accel_normal_avg[3], accel_st_avg[3];
-    int32_t gyro_normal_avg[3], gyro_st_avg[3];
-    
-    for (int i = 0; i < 3; i++) 
-    {
-        accel_normal_avg[i] = accel_normal_sum[i] / 200;
-        accel_st_avg[i] = accel_st_sum[i] / 200;
-        gyro_normal_avg[i] = gyro_normal_sum[i] / 200;
-        gyro_st_avg[i] = gyro_st_sum[i] / 200;
-    }
-    
-    // Calculate self-test responses
-    int32_t accel_str[3], gyro_str[3];
-    bool test_passed = true;
-    
-    printf("Self-test results:\n");
-    
-    for (int i = 0; i < 3; i++) 
-    {
-        // Self-test response = self-test output - normal output
-        accel_str[i] = accel_st_avg[i] - accel_normal_avg[i];
-        gyro_str[i] = gyro_st_avg[i] - gyro_normal_avg[i];
-        
-        printf("Axis %d - Accel STR: %ld, Gyro STR: %ld\n", i, accel_str[i], gyro_str[i]);
-        
-        // Check factory self-test codes for validity
-        if (st_accel[i] == 0 || st_gyro[i] == 0) {
-            printf("Self-test axis %d returned invalid factory code\n", i);
-            test_passed = false;
-        }
-        
-        // Check if self-test response is within acceptable range
-        // Accelerometer: should have significant response (>1000 LSB change for ±2g range)
-        // Gyroscope: should have significant response (>50 LSB change for ±250dps range)
-        // Based on MPU9250 datasheet and observed values, adjusted thresholds
-        if (labs(accel_str[i]) < 1000 || labs(accel_str[i]) > 14000) {
-            printf("Accelerometer axis %d failed: STR = %ld\n", i, accel_str[i]);
-            test_passed = false;
-        }
-        
-        // Adjusted gyroscope threshold based on datasheet and real hardware behavior
-        // Typical self-test response should be between 50-32000 LSB for ±250dps range
-        if (labs(gyro_str[i]) < 50 || labs(gyro_str[i]) > 32000) {
-            printf("Gyroscope axis %d failed: STR = %ld\n", i, gyro_str[i]);
-            test_passed = false;
-        }
-    }
-    
-    printf("Self-test %s\n", test_passed ? "PASSED" : "FAILED");
-    return test_passed;
+    mpu9250_write_reg_nowait(mpu, reg, data);
+    sleep_us(MPU9250_ESPERA_ESCRITA_US); // Pequeno delay para garantir conclusão da escrita
 }
 
 /**
- * FUNÇÕES INTERNAS - COMUNICAÇÃO I2C DE BAIXO NÍVEL
- * ================================================
- * Estas funções implementam a comunicação I2C básica com o MPU9250 e
- * magnetômetro AK8963. São funções auxiliares utilizadas pelas funções
- * públicas da API.
- */
-
-/**
- * @brief Escreve um valor em um registrador do MPU9250
+ * @brief Escreve um valor em um registrador do MPU9250, sem a espera após a escrita
+ * 
+ * Para sequências em etapas, que suspendem pelo tempo de MPU9250_ESPERA_ESCRITA_US
+ * em vez de dormir.
  * 
  * @param mpu Ponteiro para a estrutura do MPU9250
  * @param reg Endereço do registrador (8 bits)
  * @param data Valor a ser escrito (8 bits)
  */
-static void mpu9250_write_reg(mpu9250_t *mpu, uint8_t reg, uint8_t data)
+void mpu9250_write_reg_nowait(mpu9250_t *mpu, uint8_t reg, uint8_t data)
 {
     uint8_t buffer[2] = {reg, data};
     i2c_write_blocking(mpu->i2c, mpu->addr, buffer, 2, false);
-    sleep_us(500); // Pequeno delay para garantir conclusão da escrita
 }
 
 /**
@@ -1052,7 +834,7 @@ static void mpu9250_write_reg(mpu9250_t *mpu, uint8_t reg, uint8_t data)
  * @param reg Endereço do registrador a ser lido
  * @return Valor lido do registrador (8 bits)
  */
-static uint8_t mpu9250_read_reg(mpu9250_t *mpu, uint8_t reg)
+uint8_t mpu9250_read_reg(mpu9250_t *mpu, uint8_t reg)
 {
     uint8_t data;
     // Primeira transação: envia endereço do registrador
@@ -1070,7 +852,7 @@ static uint8_t mpu9250_read_reg(mpu9250_t *mpu, uint8_t reg)
  * @param buffer Buffer para armazenar os dados lidos
  * @param len Número de bytes a serem lidos
  */
-static void mpu9250_read_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len)
+void mpu9250_read_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len)
 {
     // Primeira transação: envia endereço inicial
     i2c_write_blocking(mpu->i2c, mpu->addr, &reg, 1, true);
@@ -1089,10 +871,23 @@ static void mpu9250_read_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint
  * @param data Valor a ser escrito
  */
 static void mpu9250_write_mag_reg(mpu9250_t *mpu, uint8_t reg, uint8_t data)
+{
+    mpu9250_write_mag_reg_nowait(mpu, reg, data);
+    sleep_us(MPU9250_ESPERA_ESCRITA_US); // Delay para garantir conclusão da escrita
+}
+
+/**
+ * @brief Escreve um valor em um registrador do magnetômetro AK8963 (bypass),
+ *        sem a espera após a escrita
+ * 
+ * @param mpu Ponteiro para a estrutura do MPU9250
+ * @param reg Endereço do registrador do AK8963
+ * @param data Valor a ser escrito
+ */
+void mpu9250_write_mag_reg_nowait(mpu9250_t *mpu, uint8_t reg, uint8_t data)
 {
     uint8_t buffer[2] = {reg, data};
     i2c_write_blocking(mpu->i2c, AK8963_ADDR, buffer, 2, false);
-    sleep_us(500); // Delay para garantir conclusão da escrita
 }
 
 /**
@@ -1160,7 +955,7 @@ static uint8_t mpu9250_read_mag_reg(mpu9250_t *mpu, uint8_t reg)
  * @param buffer Buffer para armazenar os dados lidos
  * @param len Número de bytes a serem lidos
  */
-static void mpu9250_read_mag_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len)
+void mpu9250_read_mag_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len)
 {
     i2c_write_blocking(mpu->i2c, AK8963_ADDR, &reg, 1, true);
     i2c_read_blocking(mpu->i2c, AK8963_ADDR, buffer, len, false);
@@ -29,6 +29,7 @@ extern "C" {
 #define GYRO_SENS_2000DPS  16.4f   ///< Sensibilidade do giroscópio ±2000°/s
 
 #define MAG_SENS 0.15f ///< Sensibilidade do magnetômetro (LSB/µT)
+#define MPU9250_FIFO_BYTES_AMOSTRA 12 ///< Bytes por amostra na FIFO (acelerômetro e giroscópio)
 
 // ----------------------------------------------------------------------
 // Endereços I2C dos sensores
@@ -37,6 +38,8 @@ extern "C" {
 #define MPU9250_ADDR_1 0x69 ///< Endereço alternativo do MPU9250 (AD0=1)
 #define AK8963_ADDR    0x0C ///< Endereço do magnetômetro AK8963
 
+#define MPU9250_ESPERA_ESCRITA_US 500 ///< Espera após cada escrita de registrador
+
 // ----------------------------------------------------------------------
 // Pinos GPIO para interface I2C
 // ----------------------------------------------------------------------
@@ -100,6 +103,7 @@ typedef struct{
     // Calibração do magnetômetro
     float mag_asa[3];       ///< Ajuste de sensibilidade do magnetômetro
     bool mag_enabled;       ///< true se magnetômetro habilitado
+    bool mag_overflow;      ///< Transbordo magnético aguardando sequenciaRecuperarMagnetometro (leituras zeradas)
 
     // Offsets de calibração (em unidades físicas)
     float accel_offset[3];  ///< Offset do acelerômetro (g)
@@ -127,6 +131,14 @@ typedef struct {
     float temp;         ///< Temperatura em °C
 } mpu9250_data_t;
 
+/**
+ * @brief Amostra bruta lida da FIFO (acelerômetro e giroscópio).
+ */
+typedef struct {
+    int16_t accel[3];   ///< Acelerômetro bruto [x, y, z]
+    int16_t gyro[3];    ///< Giroscópio bruto [x, y, z]
+} mpu9250_fifo_frame_t;
+
 /**
  * @brief Estrutura de configuração para ajustes do sensor.
  */
@@ -135,7 +147,7 @@ typedef struct {
     mpu9250_gyro_range_t gyro_range;   ///< Range do giroscópio
     mpu9250_dlpf_t dlpf_filter;        ///< Filtro digital passa-baixa
     uint8_t sample_rate_divider;       ///< Divisor da taxa de amostragem
-    bool enable_magnetometer;          ///< true para habilitar magnetômetro
+    bool enable_magnetometer;          ///< false: mpu9250_init desliga o magnetômetro; true: o chamador executa sequenciaHabilitarMagnetometro
 } mpu9250_config_t;
 
 // ----------------------------------------------------------------------
@@ -177,8 +189,8 @@ bool mpu9250_test_connection(mpu9250_t *mpu);
 /** @brief Verifica se o magnetômetro está conectado e respondendo. */
 bool mpu9250_test_mag_connection(mpu9250_t *mpu);
 
-/** @brief Habilita/desabilita o magnetômetro. */
-bool mpu9250_enable_magnetometer(mpu9250_t *mpu, bool enable);
+/** @brief Desabilita o magnetômetro e o coloca em power-down (habilitação: sequenciaHabilitarMagnetometro). */
+void mpu9250_disable_magnetometer(mpu9250_t *mpu);
 
 /** @brief Lê dados brutos dos sensores do MPU9250. */
 void mpu9250_read_raw(mpu9250_t *mpu, mpu9250_raw_data_t *data);
@@ -198,6 +210,44 @@ void mpu9250_read_motion(mpu9250_t *mpu, float accel[3], float gyro[3], float *t
 /** @brief Lê dados processados do magnetômetro. */
 void mpu9250_read_mag(mpu9250_t *mpu, float mag[3]);
 
+/**
+ * @brief Habilita/desabilita a FIFO com acelerômetro e giroscópio a cada amostra.
+ *
+ * A FIFO é esvaziada ao habilitar. Cada amostra ocupa 12 bytes; com 512 bytes
+ * a FIFO comporta 42 amostras (84 ms a 500Hz) entre leituras.
+ */
+void mpu9250_fifo_enable(mpu9250_t *mpu, bool enable);
+
+/**
+ * @brief Lê as amostras acumuladas na FIFO, na ordem em que foram medidas.
+ * @param frames Buffer de saída
+ * @param max_frames Capacidade do buffer (amostras excedentes ficam para a próxima leitura)
+ * @param overflow Recebe true se a FIFO transbordou; nesse caso ela é esvaziada e nada é lido
+ * @return Número de amostras lidas
+ */
+uint16_t mpu9250_fifo_read(mpu9250_t *mpu, mpu9250_fifo_frame_t *frames, uint16_t max_frames, bool *overflow);
+
+/**
+ * @brief Converte bytes lidos de FIFO_R_W (12 por amostra, big endian) em amostras.
+ *
+ * frames pode ser o próprio buffer de bytes (conversão no lugar): cada amostra
+ * convertida ocupa exatamente os 12 bytes de que veio.
+ *
+ * @param bytes Bytes da FIFO
+ * @param n_frames Número de amostras completas
+ * @param frames Buffer de saída (ou o mesmo endereço de bytes)
+ */
+void mpu9250_fifo_decode(const uint8_t *bytes, uint16_t n_frames, mpu9250_fifo_frame_t *frames);
+
+/**
+ * @brief Converte os 8 bytes de EXT_SENS_DATA_00 (ST1, HX, HY, HZ, ST2) em leitura bruta alinhada.
+ *
+ * Transbordo magnético (ST2.HOFL) marca mpu->mag_overflow.
+ *
+ * @return true se havia dado novo e válido (senão mag recebe zeros)
+ */
+bool mpu9250_mag_decode(mpu9250_t *mpu, const uint8_t buffer[8], int16_t mag[3]);
+
 /** @brief Lê dados da temperatura. */
 float mpu9250_read_temperature(mpu9250_t *mpu);
 
@@ -211,8 +261,24 @@ void mpu9250_debug_mag_status(mpu9250_t *mpu);
  */
 void mpu9250_calibrate_gyro(mpu9250_t *mpu, uint16_t samples, float gyro_offset[3]);
 
-/** @brief Função de auto-teste para o MPU9250. */
-bool mpu9250_self_test(mpu9250_t *mpu);
+// ----------------------------------------------------------------------
+// Acesso de baixo nível, para as sequências em etapas (sequencias_mpu9250.h)
+// ----------------------------------------------------------------------
+
+/** @brief Lê um registrador do MPU9250. */
+uint8_t mpu9250_read_reg(mpu9250_t *mpu, uint8_t reg);
+
+/** @brief Lê registradores sequenciais do MPU9250. */
+void mpu9250_read_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len);
+
+/** @brief Escreve um registrador do MPU9250 sem esperar MPU9250_ESPERA_ESCRITA_US (quem chama espera). */
+void mpu9250_write_reg_nowait(mpu9250_t *mpu, uint8_t reg, uint8_t data);
+
+/** @brief Escreve um registrador do AK8963 via bypass, sem esperar MPU9250_ESPERA_ESCRITA_US. */
+void mpu9250_write_mag_reg_nowait(mpu9250_t *mpu, uint8_t reg, uint8_t data);
+
+/** @brief Lê registradores sequenciais do AK8963 via bypass. */
+void mpu9250_read_mag_regs(mpu9250_t *mpu, uint8_t reg, uint8_t *buffer, uint8_t len);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,106 @@
+// ======================================================================
+//  Arquivo: mpu9250_regs.h
+//  Descrição: Mapa de registradores do MPU9250 e do magnetômetro AK8963,
+//             compartilhado pelo driver e pelas sequências em etapas
+//             (sequencias_mpu9250.h)
+// ======================================================================
+
+#ifndef MPU9250_REGS_H
+#define MPU9250_REGS_H
+
+/**
+ * ENDEREÇOS DOS REGISTRADORES DO MPU9250
+ * ====================================
+ * Estes endereços definem os registradores internos do MPU9250 
+ * que controlam configuração, leitura de dados e status do sensor
+ */
+#define MPU9250_WHO_AM_I        0x75  // Registrador de identificação do chip
+#define MPU9250_PWR_MGMT_1      0x6B  // Gerenciamento de energia principal
+#define MPU9250_PWR_MGMT_2      0x6C  // Gerenciamento de energia dos sensores
+#define MPU9250_CONFIG          0x1A  // Configuração do filtro digital passa-baixa
+#define MPU9250_GYRO_CONFIG     0x1B  // Configuração do giroscópio (range e self-test)
+#define MPU9250_ACCEL_CONFIG    0x1C  // Configuração do acelerômetro (range e self-test)
+#define MPU9250_ACCEL_CONFIG2   0x1D  // Configuração adicional do acelerômetro (DLPF)
+#define MPU9250_SMPLRT_DIV      0x19  // Divisor da taxa de amostragem
+#define MPU9250_INT_PIN_CFG     0x37  // Configuração do pino de interrupção
+#define MPU9250_INT_ENABLE      0x38  // Habilitação de interrupções
+#define MPU9250_INT_STATUS      0x3A  // Status das interrupções
+#define MPU9250_ACCEL_XOUT_H    0x3B  // Início dos dados do acelerômetro (byte alto X)
+#define MPU9250_TEMP_OUT_H      0x41  // Dados de temperatura (byte alto)
+#define MPU9250_GYRO_XOUT_H     0x43  // Início dos dados do giroscópio (byte alto X)
+#define MPU9250_USER_CTRL       0x6A  // Controle de usuário (I2C master, reset, etc.)
+#define MPU9250_I2C_MST_CTRL    0x24  // Controle do I2C master
+#define MPU9250_I2C_SLV0_ADDR   0x25  // Endereço do dispositivo slave 0
+#define MPU9250_I2C_SLV0_REG    0x26  // Registrador do slave 0 para leitura/escrita
+#define MPU9250_I2C_SLV0_CTRL   0x27  // Controle do slave 0 (enable, length)
+#define MPU9250_I2C_SLV0_DO     0x63  // Dados de saída para escrita no slave 0
+#define MPU9250_EXT_SENS_DATA_00 0x49 // Início dos dados lidos dos sensores externos
+#define MPU9250_FIFO_EN         0x23  // Seleção dos dados gravados na FIFO
+#define MPU9250_FIFO_COUNTH     0x72  // Número de bytes na FIFO (byte alto)
+#define MPU9250_FIFO_R_W        0x74  // Leitura/escrita da FIFO
+
+/**
+ * ENDEREÇOS DOS REGISTRADORES DO MAGNETÔMETRO AK8963
+ * =================================================
+ * O magnetômetro AK8963 é um chip separado integrado ao MPU9250.
+ * É acessado via I2C master do MPU9250 ou através de bypass I2C.
+ */
+#define AK8963_WHO_AM_I     0x00  // Identificação do chip magnetômetro
+#define AK8963_INFO         0x01  // Informações do dispositivo
+#define AK8963_ST1          0x02  // Status 1 (data ready)
+#define AK8963_XOUT_L       0x03  // Dados magnéticos X (byte baixo)
+#define AK8963_XOUT_H       0x04  // Dados magnéticos X (byte alto)
+#define AK8963_YOUT_L       0x05  // Dados magnéticos Y (byte baixo)
+#define AK8963_YOUT_H       0x06  // Dados magnéticos Y (byte alto)
+#define AK8963_ZOUT_L       0x07  // Dados magnéticos Z (byte baixo)
+#define AK8963_ZOUT_H       0x08  // Dados magnéticos Z (byte alto)
+#define AK8963_ST2          0x09  // Status 2 (overflow)
+#define AK8963_CNTL1        0x0A  // Controle 1 (modo de operação)
+#define AK8963_CNTL2        0x0B  // Controle 2 (reset)
+#define AK8963_ASTC         0x0C  // Self-test
+#define AK8963_I2CDIS       0x0F  // Desabilita I2C
+#define AK8963_ASAX         0x10  // Ajuste de sensibilidade X
+#define AK8963_ASAY         0x11  // Ajuste de sensibilidade Y
+#define AK8963_ASAZ         0x12  // Ajuste de sensibilidade Z
+
+/**
+ * REGISTRADORES DE SELF-TEST
+ * ==========================
+ * Utilizados para verificar a integridade dos sensores
+ */
+#define SELF_TEST_X_GYRO   0x00  // Self-test giroscópio eixo X
+#define SELF_TEST_Y_GYRO   0x01  // Self-test giroscópio eixo Y
+#define SELF_TEST_Z_GYRO   0x02  // Self-test giroscópio eixo Z
+#define SELF_TEST_X_ACCEL  0x0D  // Self-test acelerômetro eixo X
+#define SELF_TEST_Y_ACCEL  0x0E  // Self-test acelerômetro eixo Y
+#define SELF_TEST_Z_ACCEL  0x0F  // Self-test acelerômetro eixo Z
+
+/**
+ * DEFINIÇÕES DE BITS DOS REGISTRADORES
+ * ===================================
+ * Máscaras e valores específicos para configuração dos registradores
+ */
+#define PWR_RESET           0x80 // Bit 7 - Reset do dispositivo
+#define CLOCK_SEL_PLL       0x01 // Seleção de clock PLL (mais estável)
+#define I2C_MST_EN          0x20 // Habilita modo I2C master
+#define I2C_SLV0_EN         0x80 // Habilita slave 0 do I2C master
+#define I2C_READ_FLAG       0x80 // Flag para operação de leitura I2C
+#define BYPASS_EN           0x02 // Habilita bypass I2C (acesso direto ao magnetômetro)
+#define USER_FIFO_EN        0x40 // USER_CTRL: habilita a FIFO
+#define USER_FIFO_RST       0x04 // USER_CTRL: reseta a FIFO
+#define FIFO_EN_GYRO_ACCEL  0x78 // FIFO_EN: giroscópio X, Y, Z e acelerômetro
+#define INT_FIFO_OFLOW      0x10 // INT_ENABLE/INT_STATUS: transbordo da FIFO
+#define AK8963_BIT_16       0x10 // CNTL1: saída de 16 bits (somada ao modo de ak8963_mode_t)
+#define AK8963_ST1_DRDY     0x01 // ST1: dado novo pronto
+#define AK8963_ST2_HOFL     0x08 // ST2: transbordo magnético (sensor saturado)
+
+/**
+ * IDS DOS DISPOSITIVOS
+ * ===================
+ * Valores esperados no registrador WHO_AM_I para identificação dos chips
+ */
+#define MPU9250_ID          0x71  // ID do chip MPU9250
+#define MPU9255_ID          0x73  // ID do chip MPU9255 (variante do MPU9250)
+#define AK8963_ID           0x48  // ID do chip magnetômetro AK8963
+
+#endif // MPU9250_REGS_H
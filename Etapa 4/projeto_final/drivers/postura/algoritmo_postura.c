@@ -8,8 +8,9 @@
 #endif
 
 #include "algoritmo_postura.h"
+#include "trig_rapida.h" // atan2 e asin polinomiais (float e ponto fixo)
 #include <stdio.h>
-#include <math.h>   // Funções matemáticas: cosf, sinf, atan2f, asinf, fabsf, fmaxf, fminf
+#include <math.h>   // Funções matemáticas: cosf, sinf, sqrtf
 
 // ----------------------------------------------------------------------
 // Função interna: Normaliza um quaternion (garante unidade numérica)
@@ -27,24 +28,6 @@ static Quaternion quaternion_normalize(Quaternion q)
     return q;
 }
 
-// ----------------------------------------------------------------------
-// Função interna: Normalização com precisão dupla
-// ----------------------------------------------------------------------
-static Quaternion quaternion_normalize_double(Quaternion q)
-{
-    double norm = sqrt((double)q.w*q.w + (double)q.x*q.x + (double)q.y*q.y + (double)q.z*q.z);
-    if (norm > 0.0) {
-        double inv = 1.0 / norm;
-        q.w *= (float)inv;
-        q.x *= (float)inv;
-        q.y *= (float)inv;
-        q.z *= (float)inv;
-    } else {
-        q.w = 1.0f; q.x = q.y = q.z = 0.0f;
-    }
-    return q;
-}
-
 // ----------------------------------------------------------------------
 // Conversão de ângulos de Euler (roll, pitch, yaw) para quaternion
 // ----------------------------------------------------------------------
@@ -72,6 +55,7 @@ Quaternion euler_to_quaternion(float roll, float pitch, float yaw)
 
 // ----------------------------------------------------------------------
 // Multiplicação de dois quaternions (q1 * q2)
+// Produto de unitários já é unitário: não renormaliza
 // ----------------------------------------------------------------------
 Quaternion quaternion_multiply(Quaternion q1, Quaternion q2)
 {
@@ -80,7 +64,7 @@ Quaternion quaternion_multiply(Quaternion q1, Quaternion q2)
     q.x = q1.w*q2.x + q1.x*q2.w + q1.y*q2.z - q1.z*q2.y;
     q.y = q1.w*q2.y - q1.x*q2.z + q1.y*q2.w + q1.z*q2.x;
     q.z = q1.w*q2.z + q1.x*q2.y - q1.y*q2.x + q1.z*q2.w;
-    return quaternion_normalize(q); // Normaliza para manter unidade
+    return q;
 }
 
 // ----------------------------------------------------------------------
@@ -96,20 +80,138 @@ Quaternion quaternion_conjugate(Quaternion q)
     return qc;
 }
 
+// ----------------------------------------------------------------------
+// Converte uma matriz de rotação (colunas x, y, z) em quaternion
+// ----------------------------------------------------------------------
+Quaternion quaternion_from_axes(const float x[3], const float y[3], const float z[3])
+{
+    // Elementos da matriz R = [x y z] (colunas)
+    float r00 = x[0], r01 = y[0], r02 = z[0];
+    float r10 = x[1], r11 = y[1], r12 = z[1];
+    float r20 = x[2], r21 = y[2], r22 = z[2];
+
+    Quaternion q;
+    float traco = r00 + r11 + r22;
+
+    // Escolhe o ramo numericamente mais estável (método de Shepperd)
+    if (traco > 0.0f) {
+        float s = 2.0f * sqrtf(traco + 1.0f);
+        q.w = 0.25f * s;
+        q.x = (r21 - r12) / s;
+        q.y = (r02 - r20) / s;
+        q.z = (r10 - r01) / s;
+    } else if (r00 > r11 && r00 > r22) {
+        float s = 2.0f * sqrtf(1.0f + r00 - r11 - r22);
+        q.w = (r21 - r12) / s;
+        q.x = 0.25f * s;
+        q.y = (r01 + r10) / s;
+        q.z = (r02 + r20) / s;
+    } else if (r11 > r22) {
+        float s = 2.0f * sqrtf(1.0f + r11 - r00 - r22);
+        q.w = (r02 - r20) / s;
+        q.x = (r01 + r10) / s;
+        q.y = 0.25f * s;
+        q.z = (r12 + r21) / s;
+    } else {
+        float s = 2.0f * sqrtf(1.0f + r22 - r00 - r11);
+        q.w = (r10 - r01) / s;
+        q.x = (r02 + r20) / s;
+        q.y = (r12 + r21) / s;
+        q.z = 0.25f * s;
+    }
+
+    // Mantém a parte escalar positiva (mesma rotação, representação canônica)
+    if (q.w < 0.0f) {
+        q.w = -q.w; q.x = -q.x; q.y = -q.y; q.z = -q.z;
+    }
+    return q;
+}
+
+// ----------------------------------------------------------------------
+// Orientação inicial a partir de uma amostra do acelerômetro e do magnetômetro
+// ----------------------------------------------------------------------
+Quaternion quaternion_from_accel_mag(const float accel[3], const float mag[3])
+{
+    Quaternion identidade = {1.0f, 0.0f, 0.0f, 0.0f};
+
+    // Vertical da Terra (+Z) no referencial do sensor: o acelerômetro parado mede +1g para cima
+    float z[3] = {accel[0], accel[1], accel[2]};
+    float norma = sqrtf(z[0]*z[0] + z[1]*z[1] + z[2]*z[2]);
+    if (norma < 1e-6f) {
+        return identidade; // Sem gravidade medida: orientação indeterminada
+    }
+    z[0] /= norma; z[1] /= norma; z[2] /= norma;
+
+    // Norte (+X da Terra): componente horizontal do campo magnético
+    // Sem magnetômetro, usa o eixo X do sensor projetado no plano horizontal (rumo arbitrário)
+    float x[3] = {mag[0], mag[1], mag[2]};
+    if (x[0] == 0.0f && x[1] == 0.0f && x[2] == 0.0f) {
+        x[0] = 1.0f;
+    }
+    float projecao = x[0]*z[0] + x[1]*z[1] + x[2]*z[2];
+    x[0] -= projecao * z[0]; x[1] -= projecao * z[1]; x[2] -= projecao * z[2];
+    norma = sqrtf(x[0]*x[0] + x[1]*x[1] + x[2]*x[2]);
+    if (norma < 1e-6f) {
+        // Referência paralela à vertical: usa o eixo Y do sensor
+        x[0] = 0.0f; x[1] = 1.0f; x[2] = 0.0f;
+        projecao = z[1];
+        x[0] -= projecao * z[0]; x[1] -= projecao * z[1]; x[2] -= projecao * z[2];
+        norma = sqrtf(x[0]*x[0] + x[1]*x[1] + x[2]*x[2]);
+    }
+    x[0] /= norma; x[1] /= norma; x[2] /= norma;
+
+    // Oeste (+Y da Terra) completa a base dextrogira
+    float y[3] = {
+        z[1]*x[2] - z[2]*x[1],
+        z[2]*x[0] - z[0]*x[2],
+        z[0]*x[1] - z[1]*x[0]
+    };
+
+    // x, y, z são os eixos da Terra vistos pelo sensor (linhas da matriz sensor -> Terra):
+    // a matriz com essas colunas é a transposta, logo a orientação é o conjugado
+    return quaternion_conjugate(quaternion_from_axes(x, y, z));
+}
+
 // ----------------------------------------------------------------------
 // Calcula o quaternion relativo (tronco -> coxa)
 // q_rel = q_tronco^{-1} * q_coxa
 // ----------------------------------------------------------------------
 Quaternion relative_quaternion(Quaternion q_tronco, Quaternion q_coxa)
 {
-    // Garante unitários para que conjugado == inverso
-    q_tronco = quaternion_normalize(q_tronco);
-    q_coxa   = quaternion_normalize(q_coxa);
-
-    Quaternion q_inv = quaternion_conjugate(q_tronco); // Inverso (unitário)
-    Quaternion q_rel = quaternion_multiply(q_inv, q_coxa);
-    // Normaliza resultado para estabilidade numérica
-    return quaternion_normalize(q_rel);
+    // Entradas unitárias: conjugado == inverso e o produto permanece unitário
+    Quaternion q_inv = quaternion_conjugate(q_tronco);
+    return quaternion_multiply(q_inv, q_coxa);
+}
+
+// ----------------------------------------------------------------------
+// Componentes dos ângulos do quadril (argumentos de atan2/asin)
+// ----------------------------------------------------------------------
+componentes_quadril_t quaternion_to_hip_components(Quaternion q)
+{
+    // q unitário (ver algoritmo_postura.h): as fórmulas abaixo assumem norma 1
+    componentes_quadril_t c;
+#ifdef ANGULOS_SWING_TWIST
+    // Eixo femoral (Y da coxa) levado ao referencial do tronco: d = R·Y, segunda
+    // coluna da matriz de rotação. A torção em torno de Y não altera d.
+    c.flexao_sen  = 2.0f * (q.y * q.z + q.w * q.x);         // d_z
+    c.flexao_cos  = 1.0f - 2.0f * (q.x * q.x + q.z * q.z);  // d_y
+    c.aducao_sen  = 2.0f * (q.w * q.z - q.x * q.y);         // -d_x
+    c.aducao_cos  = 0.0f;                                   // Não usado (adução = asin)
+
+    // Torção: projeção de q no eixo Y, com w ≥ 0 (q e -q são a mesma rotação)
+    float sinal = (q.w < 0.0f) ? -1.0f : 1.0f;
+    c.rotacao_sen = sinal * q.y;
+    c.rotacao_cos = sinal * q.w;
+#else
+    // Sequência XYZ: roll (X), pitch (Y), yaw (Z)
+    c.flexao_sen  = 2.0f * (q.w * q.x + q.y * q.z);
+    c.flexao_cos  = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+    c.aducao_sen  = 2.0f * (q.w * q.z + q.x * q.y);
+    c.aducao_cos  = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
+    c.rotacao_sen = 2.0f * (q.w * q.y - q.z * q.x);
+    c.rotacao_cos = 0.0f;                                   // Não usado (rotação = asin)
+#endif
+    return c;
 }
 
 // ----------------------------------------------------------------------
@@ -117,27 +219,93 @@ Quaternion relative_quaternion(Quaternion q_tronco, Quaternion q_coxa)
 // ----------------------------------------------------------------------
 void quaternion_to_hip_angles(Quaternion q, float *flexao, float *aducao, float *rotacao)
 {
-    // Garante unidade
-    q = quaternion_normalize(q);
+#ifdef ANGULOS_PONTO_FIXO
+    // Componentes em Q7.24; cada soma de produtos usa 64 bits e volta com >> 23 (fator 2)
+    const float ESCALA = (float)TRIG_Q_UM;
+    int64_t w = (int64_t)(q.w * ESCALA), x = (int64_t)(q.x * ESCALA);
+    int64_t y = (int64_t)(q.y * ESCALA), z = (int64_t)(q.z * ESCALA);
 
+#ifdef ANGULOS_SWING_TWIST
+    trig_q24_t d_z = (trig_q24_t)((y * z + w * x) >> (TRIG_Q_FRAC - 1));
+    trig_q24_t d_y = TRIG_Q_UM - (trig_q24_t)((x * x + z * z) >> (TRIG_Q_FRAC - 1));
+    trig_q24_t menos_d_x = (trig_q24_t)((w * z - x * y) >> (TRIG_Q_FRAC - 1));
+    trig_q24_t sinal = (w < 0) ? -1 : 1;
+    float roll = (float)trig_atan2_q24(d_z, d_y) / ESCALA;
+    float aduc = (float)trig_asin_q24(menos_d_x) / ESCALA;
+    float torcao = 2.0f * (float)trig_atan2_q24(sinal * (trig_q24_t)y, sinal * (trig_q24_t)w) / ESCALA;
+#else
     // roll (X) - flexão/extensão
-    float sinr_cosp = 2.0f * (q.w * q.x + q.y * q.z);
-    float cosr_cosp = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
-    float roll = atan2f(sinr_cosp, cosr_cosp);
+    trig_q24_t sinr_cosp = (trig_q24_t)((w * x + y * z) >> (TRIG_Q_FRAC - 1));
+    trig_q24_t cosr_cosp = TRIG_Q_UM - (trig_q24_t)((x * x + y * y) >> (TRIG_Q_FRAC - 1));
+    float roll = (float)trig_atan2_q24(sinr_cosp, cosr_cosp) / ESCALA;
 
-    // pitch (Y) - rotação interna/externa (clamp [-1,1] para evitar NaN)
-    float sinp = 2.0f * (q.w * q.y - q.z * q.x);
-    sinp = fmaxf(-1.0f, fminf(1.0f, sinp));
-    float pitch = asinf(sinp);
+    // pitch (Y) - rotação interna/externa (trig_asin_q24 satura em [-1,1])
+    trig_q24_t sinp = (trig_q24_t)((w * y - z * x) >> (TRIG_Q_FRAC - 1));
+    float torcao = (float)trig_asin_q24(sinp) / ESCALA;
 
     // yaw (Z) - adução/abdução
-    float siny_cosp = 2.0f * (q.w * q.z + q.x * q.y);
-    float cosy_cosp = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
-    float yaw = atan2f(siny_cosp, cosy_cosp);
+    trig_q24_t siny_cosp = (trig_q24_t)((w * z + x * y) >> (TRIG_Q_FRAC - 1));
+    trig_q24_t cosy_cosp = TRIG_Q_UM - (trig_q24_t)((y * y + z * z) >> (TRIG_Q_FRAC - 1));
+    float aduc = (float)trig_atan2_q24(siny_cosp, cosy_cosp) / ESCALA;
+#endif
+#else
+    componentes_quadril_t c = quaternion_to_hip_components(q);
+    float roll = trig_atan2f(c.flexao_sen, c.flexao_cos);
+#ifdef ANGULOS_SWING_TWIST
+    float aduc = trig_asinf(c.aducao_sen);                              // Elevação de d para fora do plano sagital
+    float torcao = 2.0f * trig_atan2f(c.rotacao_sen, c.rotacao_cos);    // Ângulo da torção em torno de Y
+#else
+    float aduc = trig_atan2f(c.aducao_sen, c.aducao_cos);               // yaw (Z)
+    float torcao = trig_asinf(c.rotacao_sen);                           // pitch (Y), saturado em [-1,1]
+#endif
+#endif
 
     // Mapear para saídas anatômicas:
     // Flexão para frente é POSITIVA (roll positivo => flexão positiva)
     *flexao = -roll;
-    *rotacao = pitch;
-    *aducao = yaw;
+    *rotacao = torcao;
+    *aducao = aduc;
+}
+
+// ----------------------------------------------------------------------
+// Pré-cálculo dos limites articulares
+// ----------------------------------------------------------------------
+void hip_limits_define(limites_quadril_t *limites, float flexao, float aducao, float rotacao)
+{
+#ifdef ANGULOS_SWING_TWIST
+    rotacao *= 0.5f; // A torção é o dobro do ângulo do atan2
+#endif
+    limites->cos_flexao = cosf(flexao);
+    limites->sen_flexao = sinf(flexao);
+    limites->cos_aducao = cosf(aducao);
+    limites->sen_aducao = sinf(aducao);
+    limites->cos_rotacao = cosf(rotacao);
+    limites->sen_rotacao = sinf(rotacao);
+}
+
+// ----------------------------------------------------------------------
+// Teste dos limites no espaço do quaternion
+// ----------------------------------------------------------------------
+
+// atan2(s, c) > L, com L em [0, π): semiplano superior e sen(ângulo - L) > 0
+static inline bool acima_atan2(float s, float c, float cos_l, float sen_l)
+{
+    return (s >= 0.0f) && (s * cos_l - c * sen_l > 0.0f);
+}
+
+bool hip_components_exceed(const componentes_quadril_t *c, const limites_quadril_t *limites, bool excede[3])
+{
+    // flexão = -atan2 > L ⇔ atan2(-s, c) > L (espelha o semiplano)
+    excede[0] = (c->flexao_sen < 0.0f) &&
+                (c->flexao_sen * limites->cos_flexao + c->flexao_cos * limites->sen_flexao < 0.0f);
+
+#ifdef ANGULOS_SWING_TWIST
+    excede[1] = c->aducao_sen > limites->sen_aducao;                         // asin é crescente
+    excede[2] = acima_atan2(c->rotacao_sen, c->rotacao_cos, limites->cos_rotacao, limites->sen_rotacao);
+#else
+    excede[1] = acima_atan2(c->aducao_sen, c->aducao_cos, limites->cos_aducao, limites->sen_aducao);
+    excede[2] = c->rotacao_sen > limites->sen_rotacao;                       // asin é crescente
+#endif
+
+    return excede[0] || excede[1] || excede[2];
 }
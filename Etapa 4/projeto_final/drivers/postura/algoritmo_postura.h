@@ -41,7 +41,11 @@ Quaternion euler_to_quaternion(float roll, float pitch, float yaw);
 // Operações com quaternions
 // ----------------------------------------------------------------------
 /**
- * @brief Multiplica dois quaternions (q1 ⊗ q2).
+ * @brief Multiplica dois quaternions (q1 ⊗ q2), sem renormalizar.
+ *
+ * O produto de dois quaternions unitários é unitário; para acumular produtos
+ * por muitas iterações, normalize o resultado periodicamente.
+ *
  * @param q1 Primeiro quaternion
  * @param q2 Segundo quaternion
  * @return Resultado da multiplicação
@@ -57,30 +61,122 @@ Quaternion quaternion_conjugate(Quaternion q);
 
 /**
  * @brief Calcula o quaternion relativo entre dois segmentos (ex: tronco -> coxa).
- * @param q_tronco Quaternion do tronco
- * @param q_coxa Quaternion da coxa
+ * @param q_tronco Quaternion do tronco (unitário)
+ * @param q_coxa Quaternion da coxa (unitário)
  * @return Quaternion relativo (orientação da coxa em relação ao tronco)
  */
 Quaternion relative_quaternion(Quaternion q_tronco, Quaternion q_coxa);
 
+// ----------------------------------------------------------------------
+// Construção de quaternions a partir de bases e medidas
+// ----------------------------------------------------------------------
+/**
+ * @brief Converte uma matriz de rotação, dada por suas colunas, em quaternion (método de Shepperd).
+ * @param x Primeira coluna (imagem do eixo X)
+ * @param y Segunda coluna (imagem do eixo Y)
+ * @param z Terceira coluna (imagem do eixo Z)
+ * @return Quaternion unitário com parte escalar não negativa
+ */
+Quaternion quaternion_from_axes(const float x[3], const float y[3], const float z[3]);
+
+/**
+ * @brief Calcula a orientação (sensor -> Terra) a partir de uma única amostra em repouso.
+ *
+ * Usa a mesma convenção do filtro de Madgwick: +Z da Terra para cima (gravidade
+ * medida pelo acelerômetro) e norte magnético em +X. Com o magnetômetro zerado o
+ * rumo é arbitrário (eixo X do sensor projetado no plano horizontal).
+ *
+ * @param accel Aceleração [x, y, z] no referencial do sensor (qualquer unidade)
+ * @param mag Campo magnético [x, y, z] no referencial do sensor (qualquer unidade)
+ * @return Quaternion de orientação; identidade se a aceleração for nula
+ */
+Quaternion quaternion_from_accel_mag(const float accel[3], const float mag[3]);
+
 // ----------------------------------------------------------------------
 // Conversão de quaternion para ângulos articulares do quadril
 // ----------------------------------------------------------------------
+// Referencial dos segmentos (ver alinhamento_sensor.h): X = eixo de flexão
+// (médio-lateral), Y = eixo longitudinal (femoral na coxa), Z = ântero-posterior.
+//
+// Dois extratores, escolhidos em compilação:
+//  - Padrão, sequência XYZ: flexão = -roll (X), rotação = pitch (Y), adução = yaw (Z).
+//    O pitch vem de um asin, singular em rotação de ±90°.
+//  - ANGULOS_SWING_TWIST: decompõe q = balanço ⊗ torção em torno do eixo femoral.
+//    A direção do fêmur d = R·Y dá a flexão (ângulo de d no plano sagital) e a
+//    adução (elevação de d para fora desse plano); a torção dá a rotação. Sem
+//    singularidade em toda a amplitude do quadril: só degenera com a coxa
+//    apontando lateralmente (adução de 90°) ou invertida (balanço de 180°).
+// Movimentos em um só plano dão os mesmos ângulos nos dois extratores.
+
+/**
+ * @brief Argumentos de atan2/asin dos ângulos do quadril, antes da trigonometria.
+ *
+ * flexão = -atan2(flexao_sen, flexao_cos) nos dois extratores. Na sequência XYZ,
+ * adução = atan2(aducao_sen, aducao_cos) e rotação = asin(rotacao_sen); no
+ * swing-twist, adução = asin(aducao_sen) e rotação = 2·atan2(rotacao_sen, rotacao_cos).
+ * Os pares sen/cos de cada atan2 têm o mesmo fator de escala (positivo), o que
+ * basta para comparar ângulos.
+ */
+typedef struct {
+    float flexao_sen, flexao_cos;   ///< Flexão/extensão
+    float aducao_sen, aducao_cos;   ///< Adução/abdução (cos não usado no swing-twist)
+    float rotacao_sen, rotacao_cos; ///< Rotação interna/externa (cos não usado na sequência XYZ)
+} componentes_quadril_t;
+
+/**
+ * @brief Limites articulares pré-calculados como seno e cosseno.
+ *
+ * Com eles, "ângulo acima do limite" vira o sinal de um produto escalar:
+ *  - atan2(s, c) > L ⇔ s ≥ 0 e sen(ângulo - L) ∝ s·cos L - c·sen L > 0
+ *  - asin(s) > L ⇔ s > sen L
+ * (no swing-twist, o limite de rotação é guardado pela metade, como o atan2 da torção).
+ * Válido para limites de flexão e adução em [0, π/2) e de rotação em [0, π/2).
+ */
+typedef struct {
+    float cos_flexao, sen_flexao;   ///< Limite de flexão
+    float cos_aducao, sen_aducao;   ///< Limite de adução/abdução
+    float cos_rotacao, sen_rotacao; ///< Limite de rotação
+} limites_quadril_t;
+
+/**
+ * @brief Calcula as componentes dos ângulos do quadril (cerca de 10 multiplicações).
+ * @param q Quaternion relativo (unitário; não é renormalizado)
+ * @return Componentes do extrator selecionado
+ */
+componentes_quadril_t quaternion_to_hip_components(Quaternion q);
+
 /**
  * @brief Converte um quaternion para ângulos articulares do quadril (flexão, adução, rotação).
  *
- * Utiliza sequência XYZ (anatômica corrigida):
- *  - X: flexão para frente(+)/extensão para trás(-)
- *  - Y: rotação interna/externa
- *  - Z: adução/abdução
+ * Usa o extrator selecionado (ver acima) e as aproximações de trig_rapida.h
+ * (erro abaixo de 0,005°): dois atan2 e um asin em qualquer dos extratores. Com
+ * ANGULOS_PONTO_FIXO definido, as versões em ponto fixo Q7.24.
  *
- * @param q Quaternion relativo
+ * @param q Quaternion relativo (unitário; não é renormalizado)
  * @param[out] flexao Ângulo de flexão (rad)
  * @param[out] aducao Ângulo de adução (rad)
  * @param[out] rotacao Ângulo de rotação (rad)
  */
 void quaternion_to_hip_angles(Quaternion q, float *flexao, float *aducao, float *rotacao);
 
+/**
+ * @brief Pré-calcula os limites (chamada única, usa sinf/cosf).
+ * @param[out] limites Limites pré-calculados
+ * @param flexao Limite de flexão (rad)
+ * @param aducao Limite de adução/abdução (rad)
+ * @param rotacao Limite de rotação (rad)
+ */
+void hip_limits_define(limites_quadril_t *limites, float flexao, float aducao, float rotacao);
+
+/**
+ * @brief Testa cada ângulo contra seu limite, sem trigonometria (até 5 multiplicações).
+ * @param c Componentes do quaternion relativo
+ * @param limites Limites pré-calculados
+ * @param[out] excede Ângulo acima do limite, na ordem {flexão, adução, rotação}
+ * @return true se algum ângulo excede o limite
+ */
+bool hip_components_exceed(const componentes_quadril_t *c, const limites_quadril_t *limites, bool excede[3]);
+
 // ----------------------------------------------------------------------
 // Funções auxiliares para debug
 // ----------------------------------------------------------------------
@@ -0,0 +1,128 @@
+// ======================================================================
+//  Arquivo: alinhamento_sensor.c
+//  Descrição: Estimativa do alinhamento sensor-segmento por calibração funcional
+// ======================================================================
+
+#include "alinhamento_sensor.h"
+#include <math.h>   // Funções matemáticas: sqrtf, fabsf
+#include <string.h> // memset
+
+// ----------------------------------------------------------------------
+// Funções internas: álgebra vetorial 3D
+// ----------------------------------------------------------------------
+static float vetor_norma(const float v[3])
+{
+    return sqrtf(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+}
+
+static bool vetor_normalizar(float v[3])
+{
+    float norma = vetor_norma(v);
+    if (norma < 1e-6f) {
+        return false; // Vetor degenerado
+    }
+    float inv = 1.0f / norma;
+    v[0] *= inv; v[1] *= inv; v[2] *= inv;
+    return true;
+}
+
+static void vetor_produto_vetorial(const float a[3], const float b[3], float out[3])
+{
+    out[0] = a[1]*b[2] - a[2]*b[1];
+    out[1] = a[2]*b[0] - a[0]*b[2];
+    out[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+// ----------------------------------------------------------------------
+// Inicialização do estimador
+// ----------------------------------------------------------------------
+void alinhamento_iniciar(alinhamento_estimador_t *est)
+{
+    memset(est, 0, sizeof(*est));
+}
+
+// ----------------------------------------------------------------------
+// Fase 1: acumula a direção da gravidade em repouso
+// ----------------------------------------------------------------------
+void alinhamento_acumular_repouso(alinhamento_estimador_t *est, const float accel[3])
+{
+    est->soma_acel[0] += accel[0];
+    est->soma_acel[1] += accel[1];
+    est->soma_acel[2] += accel[2];
+    est->amostras_repouso++;
+}
+
+// ----------------------------------------------------------------------
+// Fase 2: acumula o eixo de rotação durante a flexão
+// ----------------------------------------------------------------------
+void alinhamento_acumular_flexao(alinhamento_estimador_t *est, const float gyro[3])
+{
+    // Descarta amostras paradas (dominadas por ruído e bias)
+    if (vetor_norma(gyro) < ALINHAMENTO_GIRO_MINIMO_DPS) {
+        return;
+    }
+
+    // O primeiro movimento significativo define o sentido positivo do eixo
+    if (!est->referencia_definida) {
+        est->eixo_referencia[0] = gyro[0];
+        est->eixo_referencia[1] = gyro[1];
+        est->eixo_referencia[2] = gyro[2];
+        est->referencia_definida = true;
+    }
+
+    // A volta à posição neutra gira no sentido oposto: inverte para somar no mesmo eixo
+    float produto = gyro[0]*est->eixo_referencia[0] + gyro[1]*est->eixo_referencia[1] + gyro[2]*est->eixo_referencia[2];
+    float sinal = (produto >= 0.0f) ? 1.0f : -1.0f;
+
+    est->soma_giro[0] += sinal * gyro[0];
+    est->soma_giro[1] += sinal * gyro[1];
+    est->soma_giro[2] += sinal * gyro[2];
+    est->amostras_movimento++;
+}
+
+// ----------------------------------------------------------------------
+// Cálculo do quaternion de alinhamento (segmento -> sensor)
+// ----------------------------------------------------------------------
+bool alinhamento_calcular(const alinhamento_estimador_t *est, float sentido_flexao, Quaternion *q_alinhamento)
+{
+    if (est->amostras_repouso < ALINHAMENTO_AMOSTRAS_MINIMAS ||
+        est->amostras_movimento < ALINHAMENTO_AMOSTRAS_MINIMAS) {
+        return false;
+    }
+
+    // Eixo Y do segmento: longitudinal, vertical em pé (o acelerômetro parado mede +1g para cima)
+    float y[3] = { est->soma_acel[0], est->soma_acel[1], est->soma_acel[2] };
+    if (!vetor_normalizar(y)) {
+        return false;
+    }
+
+    // Eixo X do segmento: flexão é rotação negativa em torno de X
+    // (quaternion_to_hip_angles usa flexao = -roll), logo X = -sentido * ω
+    float x[3] = {
+        -sentido_flexao * est->soma_giro[0],
+        -sentido_flexao * est->soma_giro[1],
+        -sentido_flexao * est->soma_giro[2]
+    };
+    if (!vetor_normalizar(x)) {
+        return false;
+    }
+
+    // Gram-Schmidt: remove de X a componente vertical
+    float projecao = x[0]*y[0] + x[1]*y[1] + x[2]*y[2];
+    x[0] -= projecao * y[0];
+    x[1] -= projecao * y[1];
+    x[2] -= projecao * y[2];
+
+    // Eixo de flexão quase vertical: movimento mal executado, estimativa rejeitada
+    if (vetor_norma(x) < 0.5f) {
+        return false;
+    }
+    vetor_normalizar(x);
+
+    // Eixo Z (ântero-posterior) completa a base dextrogira
+    float z[3];
+    vetor_produto_vetorial(x, y, z);
+
+    *q_alinhamento = quaternion_from_axes(x, y, z);
+    return true;
+}
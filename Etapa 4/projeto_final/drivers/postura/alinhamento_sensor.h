@@ -0,0 +1,100 @@
+// ======================================================================
+//  Arquivo: alinhamento_sensor.h
+//  Descrição: Estimativa do alinhamento sensor-segmento por calibração funcional
+// ======================================================================
+
+#ifndef ALINHAMENTO_SENSOR_H
+#define ALINHAMENTO_SENSOR_H
+
+#include <stdint.h>            // Tipos inteiros padrão
+#include <stdbool.h>           // Tipo booleano padrão
+#include "algoritmo_postura.h" // Estrutura Quaternion
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros da calibração funcional
+// ----------------------------------------------------------------------
+#define ALINHAMENTO_GIRO_MINIMO_DPS   20.0f ///< Velocidade angular mínima para uma amostra contar como movimento (°/s)
+#define ALINHAMENTO_AMOSTRAS_MINIMAS  20    ///< Amostras mínimas em cada fase para aceitar a estimativa
+
+// ----------------------------------------------------------------------
+// Estrutura: alinhamento_estimador_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Acumuladores da calibração funcional de um sensor.
+ *
+ * A calibração tem duas fases:
+ *  - Repouso em pé (postura neutra): a média do acelerômetro fornece o eixo
+ *    longitudinal (vertical) do segmento expresso no referencial do sensor.
+ *  - Movimento de flexão: a soma das velocidades angulares (com sinal alinhado
+ *    ao primeiro movimento) fornece o eixo de flexão do segmento.
+ */
+typedef struct {
+    float soma_acel[3];          ///< Soma das leituras do acelerômetro em repouso
+    uint32_t amostras_repouso;   ///< Número de amostras de repouso acumuladas
+    float soma_giro[3];          ///< Soma das velocidades angulares alinhadas
+    float eixo_referencia[3];    ///< Primeira direção de giro significativa (define o sentido)
+    bool referencia_definida;    ///< true após a primeira amostra de movimento
+    uint32_t amostras_movimento; ///< Número de amostras de movimento acumuladas
+} alinhamento_estimador_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções de calibração
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Zera os acumuladores do estimador.
+ * @param est Estimador a ser inicializado
+ */
+void alinhamento_iniciar(alinhamento_estimador_t *est);
+
+/**
+ * @brief Acumula uma amostra do acelerômetro com o paciente em pé, parado.
+ * @param est Estimador do sensor
+ * @param accel Aceleração [x, y, z] no referencial do sensor (qualquer unidade)
+ */
+void alinhamento_acumular_repouso(alinhamento_estimador_t *est, const float accel[3]);
+
+/**
+ * @brief Acumula uma amostra do giroscópio durante o movimento de flexão.
+ *
+ * Amostras abaixo de ALINHAMENTO_GIRO_MINIMO_DPS são descartadas. O sentido do
+ * eixo é definido pelo primeiro movimento; a volta à posição neutra contribui
+ * com sinal invertido, reforçando o mesmo eixo.
+ *
+ * @param est Estimador do sensor
+ * @param gyro Velocidade angular [x, y, z] no referencial do sensor (°/s)
+ */
+void alinhamento_acumular_flexao(alinhamento_estimador_t *est, const float gyro[3]);
+
+/**
+ * @brief Calcula o quaternion de alinhamento (segmento -> sensor).
+ *
+ * Monta a base ortonormal do segmento no referencial do sensor:
+ *  - Y: eixo longitudinal do segmento, vertical em pé (média do acelerômetro em repouso)
+ *  - X: eixo de flexão, ortogonalizado em relação a Y
+ *  - Z: X x Y (ântero-posterior)
+ *
+ * É o referencial esperado por quaternion_to_hip_angles: flexão em torno de X,
+ * rotação em torno do eixo longitudinal Y, adução em torno de Z.
+ *
+ * O resultado deve ser pós-multiplicado à orientação do sensor:
+ * q_segmento = q_sensor ⊗ q_alinhamento.
+ *
+ * @param est Estimador do sensor
+ * @param sentido_flexao +1 se o primeiro movimento for uma flexão do segmento
+ *                       (coxa); -1 se for no sentido oposto (inclinação do tronco à frente)
+ * @param[out] q_alinhamento Quaternion de alinhamento estimado
+ * @return true se a estimativa é válida; false se faltaram amostras, o movimento
+ *         foi insuficiente ou o eixo de flexão ficou paralelo à vertical
+ */
+bool alinhamento_calcular(const alinhamento_estimador_t *est, float sentido_flexao, Quaternion *q_alinhamento);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALINHAMENTO_SENSOR_H
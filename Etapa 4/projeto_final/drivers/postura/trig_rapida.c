@@ -0,0 +1,144 @@
+// ======================================================================
+//  Arquivo: trig_rapida.c
+//  Descrição: Aproximações polinomiais de atan2 e asin (float e ponto fixo
+//             Q7.24) para a extração dos ângulos do quadril
+// ======================================================================
+//
+// No RP2040 (Cortex-M0+, sem FPU) atan2f e asinf da libm custam dezenas de
+// operações de float emuladas cada. Aqui cada função é uma redução de
+// argumento, um polinômio curto (Horner) e a correção de quadrante.
+
+#include "trig_rapida.h"
+#include <math.h> // sqrtf, fabsf
+
+#define TRIG_PI     3.14159265f
+#define TRIG_PI_2   1.57079633f
+
+// atan(a) ≈ a·(C1 + C3·a² + ... + C11·a¹⁰) em [0, 1] (minimax, erro 2e-6 rad)
+#define ATAN_C1   0.99997726f
+#define ATAN_C3  -0.33262347f
+#define ATAN_C5   0.19354346f
+#define ATAN_C7  -0.11643287f
+#define ATAN_C9   0.05265332f
+#define ATAN_C11 -0.01172120f
+
+// acos(x) ≈ √(1-x)·(A0 + A1·x + A2·x² + A3·x³) em [0, 1] (A&S 4.4.45)
+#define ASIN_A0   1.5707288f
+#define ASIN_A1  -0.2121144f
+#define ASIN_A2   0.0742610f
+#define ASIN_A3  -0.0187293f
+
+// Constantes em Q7.24 (arredondadas)
+#define Q(c) ((trig_q24_t)((c) * (float)TRIG_Q_UM + ((c) >= 0.0f ? 0.5f : -0.5f)))
+
+// ----------------------------------------------------------------------
+// Funções auxiliares (ponto fixo)
+// ----------------------------------------------------------------------
+
+// Produto em Q7.24 com arredondamento
+static inline trig_q24_t q_mul(trig_q24_t a, trig_q24_t b)
+{
+    return (trig_q24_t)(((int64_t)a * b + (1 << (TRIG_Q_FRAC - 1))) >> TRIG_Q_FRAC);
+}
+
+// √(m·2^24) dígito a dígito, só com operações de 32 bits e sem desvios
+// (m ≤ 2^24): os 24 bits baixos do radicando são zero, então os pares de
+// bits vêm todos de m nas 13 primeiras iterações
+static uint32_t raiz_q24(uint32_t m)
+{
+    uint32_t raiz = 0;
+    uint32_t resto = 0; // Sempre < 2·raiz + 1 < 2^26
+    for (int i = 24; i >= 0; i--) {
+        uint32_t par = (i >= 12) ? (m >> (2 * i - 24)) & 3u : 0u;
+        resto = (resto << 2) | par;
+        uint32_t teste = (raiz << 2) | 1u;
+        uint32_t cabe = 0u - (uint32_t)(resto >= teste); // Máscara: todos os bits se o dígito é 1
+        resto -= teste & cabe;
+        raiz = (raiz << 1) | (cabe & 1u);
+    }
+    return raiz;
+}
+
+// ----------------------------------------------------------------------
+// Versões em float
+// ----------------------------------------------------------------------
+float trig_atan2f(float y, float x)
+{
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    float maior = (ax > ay) ? ax : ay;
+    float menor = (ax > ay) ? ay : ax;
+    if (maior == 0.0f) {
+        return 0.0f;
+    }
+
+    float a = menor / maior;
+    float s = a * a;
+    float r = a * (ATAN_C1 + s * (ATAN_C3 + s * (ATAN_C5 + s * (ATAN_C7 + s * (ATAN_C9 + s * ATAN_C11)))));
+
+    if (ay > ax) {
+        r = TRIG_PI_2 - r; // Octante acima da diagonal: atan(y/x) = π/2 - atan(x/y)
+    }
+    if (x < 0.0f) {
+        r = TRIG_PI - r;
+    }
+    return (y < 0.0f) ? -r : r;
+}
+
+float trig_asinf(float x)
+{
+    float ax = fabsf(x);
+    if (ax > 1.0f) {
+        ax = 1.0f;
+    }
+    float r = TRIG_PI_2 - sqrtf(1.0f - ax) * (ASIN_A0 + ax * (ASIN_A1 + ax * (ASIN_A2 + ax * ASIN_A3)));
+    return (x < 0.0f) ? -r : r;
+}
+
+// ----------------------------------------------------------------------
+// Versões em ponto fixo (Q7.24)
+// ----------------------------------------------------------------------
+trig_q24_t trig_atan2_q24(trig_q24_t y, trig_q24_t x)
+{
+    // Módulos em 32 bits sem sinal (cobre INT32_MIN)
+    uint32_t ax = (x < 0) ? (uint32_t)0 - (uint32_t)x : (uint32_t)x;
+    uint32_t ay = (y < 0) ? (uint32_t)0 - (uint32_t)y : (uint32_t)y;
+    uint32_t maior = (ax > ay) ? ax : ay;
+    uint32_t menor = (ax > ay) ? ay : ax;
+    if (maior == 0) {
+        return 0;
+    }
+
+    trig_q24_t a = (trig_q24_t)(((uint64_t)menor << TRIG_Q_FRAC) / maior);
+    trig_q24_t s = q_mul(a, a);
+    trig_q24_t p = Q(ATAN_C9) + q_mul(s, Q(ATAN_C11));
+    p = Q(ATAN_C7) + q_mul(s, p);
+    p = Q(ATAN_C5) + q_mul(s, p);
+    p = Q(ATAN_C3) + q_mul(s, p);
+    p = Q(ATAN_C1) + q_mul(s, p);
+    trig_q24_t r = q_mul(a, p);
+
+    if (ay > ax) {
+        r = Q(TRIG_PI_2) - r;
+    }
+    if (x < 0) {
+        r = Q(TRIG_PI) - r;
+    }
+    return (y < 0) ? -r : r;
+}
+
+trig_q24_t trig_asin_q24(trig_q24_t x)
+{
+    trig_q24_t ax = (x < 0) ? -x : x;
+    if (ax > TRIG_Q_UM) {
+        ax = TRIG_Q_UM;
+    }
+
+    // √(1-|x|) em Q7.24: com m = (1-|x|)·2^24, √(m/2^24)·2^24 = √(m·2^24)
+    trig_q24_t raiz = (trig_q24_t)raiz_q24((uint32_t)(TRIG_Q_UM - ax));
+    trig_q24_t p = Q(ASIN_A2) + q_mul(ax, Q(ASIN_A3));
+    p = Q(ASIN_A1) + q_mul(ax, p);
+    p = Q(ASIN_A0) + q_mul(ax, p);
+    trig_q24_t r = Q(TRIG_PI_2) - q_mul(raiz, p);
+    return (x < 0) ? -r : r;
+}
@@ -0,0 +1,73 @@
+// ======================================================================
+//  Arquivo: trig_rapida.h
+//  Descrição: Aproximações polinomiais de atan2 e asin (float e ponto fixo
+//             Q7.24) para a extração dos ângulos do quadril
+// ======================================================================
+
+#ifndef TRIG_RAPIDA_H
+#define TRIG_RAPIDA_H
+
+#include <stdint.h> // int32_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Formato de ponto fixo
+// ----------------------------------------------------------------------
+// Q7.24 (mesmo formato de MadgwickAHRS_fixo.c): faixa [-128, 128), resolução 6e-8
+#define TRIG_Q_FRAC 24
+#define TRIG_Q_UM   ((trig_q24_t)1 << TRIG_Q_FRAC) ///< 1.0 em Q7.24
+
+typedef int32_t trig_q24_t;
+
+// ----------------------------------------------------------------------
+// Erros máximos (rad), verificados varrendo todo o domínio
+// ----------------------------------------------------------------------
+#define TRIG_ATAN2_ERRO_MAXIMO 2.0e-6f  ///< ~0,0001°: minimax ímpar de grau 11 em [0, 1]
+#define TRIG_ASIN_ERRO_MAXIMO  7.0e-5f  ///< ~0,004°: Abramowitz & Stegun 4.4.45
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief atan2 aproximado: ângulo de (x, y) em [-π, π].
+ *
+ * Reduz o argumento a a = min(|x|,|y|) / max(|x|,|y|) ∈ [0, 1] (uma divisão),
+ * avalia o polinômio minimax e corrige octante e quadrante. atan2(0, 0) = 0.
+ *
+ * @param y Componente vertical (seno)
+ * @param x Componente horizontal (cosseno)
+ * @return Ângulo (rad), erro até TRIG_ATAN2_ERRO_MAXIMO
+ */
+float trig_atan2f(float y, float x);
+
+/**
+ * @brief asin aproximado: asin(x) = π/2 - √(1-|x|)·P(|x|), com o sinal de x.
+ * @param x Seno, saturado em [-1, 1]
+ * @return Ângulo (rad) em [-π/2, π/2], erro até TRIG_ASIN_ERRO_MAXIMO
+ */
+float trig_asinf(float x);
+
+/**
+ * @brief atan2 em ponto fixo, só com inteiros (uma divisão de 64 bits).
+ * @param y Componente vertical, em qualquer escala comum a x
+ * @param x Componente horizontal
+ * @return Ângulo em Q7.24 (rad), mesmo erro da versão float
+ */
+trig_q24_t trig_atan2_q24(trig_q24_t y, trig_q24_t x);
+
+/**
+ * @brief asin em ponto fixo, com raiz quadrada inteira dígito a dígito.
+ * @param x Seno em Q7.24, saturado em [-1, 1]
+ * @return Ângulo em Q7.24 (rad), mesmo erro da versão float
+ */
+trig_q24_t trig_asin_q24(trig_q24_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRIG_RAPIDA_H
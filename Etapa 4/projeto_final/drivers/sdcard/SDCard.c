@@ -54,6 +54,7 @@ static bool sd_mounted = false; // Flag indicando se o SD está montado e pronto
 
 bool init_sd_card(void);    // Inicializa o cartão SD e prepara o sistema de arquivos
 bool add_csv_record(const char* inicio, const char* fim, const char* perna, const char* movimento, float angulo_maximo);  // Adiciona registro no CSV
+bool append_csv_block(const char* arquivo, const char* cabecalho, const char* dados, size_t tamanho);  // Anexa um lote de linhas
 void view_csv_data(void);   // Lê e exibe todos os dados do arquivo CSV
 void get_current_datetime_iso(char* buffer, size_t buffer_size);  // Obtém data/hora atual formatada ISO 8601
 
@@ -197,6 +198,55 @@ bool add_csv_record(const char* inicio, const char* fim, const char* perna, cons
     return true;
 }
 
+// ============================================================================
+// FUNÇÃO: append_csv_block()
+// PROPÓSITO: Anexa um lote de linhas já formatadas com uma única abertura do arquivo
+// PARÂMETROS: arquivo - nome do arquivo, cabecalho - linha para arquivo novo (ou NULL),
+//            dados/tamanho - bloco de linhas terminadas em '\n'
+// RETORNO: true se sucesso, false se erro
+// ============================================================================
+
+bool append_csv_block(const char* arquivo, const char* cabecalho, const char* dados, size_t tamanho)
+{
+    // VERIFICAÇÃO: SD card deve estar montado e pronto
+    if (!sd_mounted)
+    {
+        printf("Erro: SD card não está montado\n");
+        return false;
+    }
+
+    FIL file;
+    FRESULT fr;
+    UINT escritos = 0;
+
+    // PASSO 1: Abrir (ou criar) o arquivo para adicionar dados no final
+    fr = f_open(&file, arquivo, FA_OPEN_APPEND | FA_WRITE);
+    if (fr != FR_OK)
+    {
+        printf("Erro ao abrir %s: %s (%d)\n", arquivo, FRESULT_str(fr), fr);
+        return false;
+    }
+
+    // PASSO 2: Arquivo novo recebe o cabeçalho antes das linhas
+    if (cabecalho != NULL && f_size(&file) == 0)
+    {
+        f_puts(cabecalho, &file);
+    }
+
+    // PASSO 3: Escrever o lote inteiro de uma vez
+    fr = f_write(&file, dados, (UINT)tamanho, &escritos);
+
+    // PASSO 4: Fechar arquivo (grava os setores pendentes)
+    FRESULT fr_fechar = f_close(&file);
+    if (fr != FR_OK || fr_fechar != FR_OK || escritos != tamanho)
+    {
+        printf("Erro ao gravar %s: %s (%d)\n", arquivo, FRESULT_str(fr != FR_OK ? fr : fr_fechar), fr != FR_OK ? fr : fr_fechar);
+        return false;
+    }
+
+    return true;
+}
+
 // ============================================================================
 // FUNÇÃO: register_movement_with_timestamps()
 // PROPÓSITO: Registra um movimento completo com timestamps automáticos
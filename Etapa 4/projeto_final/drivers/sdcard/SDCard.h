@@ -55,6 +55,19 @@ bool init_sd_card(void);
  */
 bool add_csv_record(const char* inicio, const char* fim, const char* perna, const char* movimento, float angulo_maximo);
 
+/**
+ * Anexa um bloco de linhas já formatadas ao final de um arquivo, com uma única
+ * abertura, escrita e fechamento (gravação em lote).
+ * Se o arquivo estiver vazio ou não existir, escreve antes o cabeçalho.
+ *
+ * @param arquivo   Nome do arquivo (ex: "dados.csv")
+ * @param cabecalho Linha de cabeçalho com '\n' (ou NULL para nenhum)
+ * @param dados     Linhas a anexar, cada uma terminada em '\n'
+ * @param tamanho   Quantidade de bytes em dados
+ * @return true se todos os bytes foram gravados, false caso contrário
+ */
+bool append_csv_block(const char* arquivo, const char* cabecalho, const char* dados, size_t tamanho);
+
 /**
  * Lê todo o arquivo CSV e exibe o conteúdo no console.
  * Útil para visualizar todos os dados armazenados no cartão SD.
@@ -0,0 +1,169 @@
+// ======================================================================
+//  Arquivo: supervisor.c
+//  Descrição: Supervisor do watchdog de hardware com batimentos por
+//             núcleo e por tarefa crítica, e registro do culpado nos
+//             registradores de rascunho (scratch) do watchdog
+// ======================================================================
+
+#include "supervisor.h"
+#include "hardware/watchdog.h"  // watchdog_update, watchdog_caused_reboot, watchdog_hw->scratch
+#include "pico/stdlib.h"        // Funções de tempo do Pico SDK
+#include <stdio.h>              // printf
+#include <string.h>             // memset
+
+// ----------------------------------------------------------------------
+// Estado global do supervisor
+// ----------------------------------------------------------------------
+static supervisor_parte_t g_partes[SUPERVISOR_MAXIMO_PARTES]; ///< Partes registradas
+static int g_quantidade = 0;                                  ///< Partes em uso
+static int g_culpado_reinicio = SUPERVISOR_NENHUMA;           ///< Culpado lido no boot
+static uint32_t g_idade_reinicio_ms = 0;                      ///< Idade do batimento do culpado
+
+static uint32_t agora_ms(void)
+{
+    return to_ms_since_boot(get_absolute_time());
+}
+
+// ----------------------------------------------------------------------
+// Inicialização e registro
+// ----------------------------------------------------------------------
+void supervisor_iniciar(void)
+{
+    memset(g_partes, 0, sizeof(g_partes));
+    g_quantidade = 0;
+
+    // Culpado só vale se o reinício foi pelo watchdog (os registradores sobrevivem a ele)
+    g_culpado_reinicio = SUPERVISOR_NENHUMA;
+    g_idade_reinicio_ms = 0;
+    if (watchdog_caused_reboot() && watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == SUPERVISOR_MAGICO)
+    {
+        g_culpado_reinicio = (int)watchdog_hw->scratch[SUPERVISOR_SCRATCH_PARTE];
+        g_idade_reinicio_ms = watchdog_hw->scratch[SUPERVISOR_SCRATCH_IDADE];
+    }
+    watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] = 0;
+}
+
+int supervisor_registrar(const char *nome, uint32_t prazo_ms)
+{
+    if (g_quantidade >= SUPERVISOR_MAXIMO_PARTES)
+    {
+        return SUPERVISOR_NENHUMA;
+    }
+
+    supervisor_parte_t *parte = &g_partes[g_quantidade];
+    parte->nome = nome;
+    parte->prazo_ms = prazo_ms;
+    parte->ultimo_ms = agora_ms();
+    parte->batimentos = 0;
+    parte->maior_intervalo_ms = 0;
+    parte->atrasos = 0;
+
+    return g_quantidade++;
+}
+
+void supervisor_batimento(int parte)
+{
+    if (parte < 0 || parte >= g_quantidade)
+    {
+        return;
+    }
+    g_partes[parte].ultimo_ms = agora_ms();
+    g_partes[parte].batimentos = g_partes[parte].batimentos + 1;
+}
+
+// ----------------------------------------------------------------------
+// Verificação e alimentação
+// ----------------------------------------------------------------------
+int supervisor_verificar(void)
+{
+    uint32_t agora = agora_ms();
+    int culpado = SUPERVISOR_NENHUMA;
+    uint32_t maior_excesso_ms = 0;
+    uint32_t idade_culpado_ms = 0;
+
+    for (int i = 0; i < g_quantidade; i++)
+    {
+        supervisor_parte_t *parte = &g_partes[i];
+
+        // Batimento do outro núcleo posterior a "agora": idade zero, não negativa
+        uint32_t ultimo = parte->ultimo_ms;
+        uint32_t idade_ms = (int32_t)(agora - ultimo) > 0 ? agora - ultimo : 0;
+        if (idade_ms > parte->maior_intervalo_ms)
+        {
+            parte->maior_intervalo_ms = idade_ms;
+        }
+
+        if (idade_ms > parte->prazo_ms)
+        {
+            parte->atrasos++;
+            uint32_t excesso_ms = idade_ms - parte->prazo_ms;
+            if (culpado == SUPERVISOR_NENHUMA || excesso_ms > maior_excesso_ms)
+            {
+                culpado = i;
+                maior_excesso_ms = excesso_ms;
+                idade_culpado_ms = idade_ms;
+            }
+        }
+    }
+
+    // Magic por último: um reinício no meio da gravação não deixa um culpado pela metade
+    if (culpado != SUPERVISOR_NENHUMA)
+    {
+        watchdog_hw->scratch[SUPERVISOR_SCRATCH_PARTE] = (uint32_t)culpado;
+        watchdog_hw->scratch[SUPERVISOR_SCRATCH_IDADE] = idade_culpado_ms;
+        watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] = SUPERVISOR_MAGICO;
+    }
+    return culpado;
+}
+
+int supervisor_alimentar(void)
+{
+    int culpado = supervisor_verificar();
+    if (culpado != SUPERVISOR_NENHUMA)
+    {
+        return culpado; // Sem alimentar: o watchdog de hardware reinicia a placa
+    }
+
+    watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] = 0;
+    watchdog_update();
+    return SUPERVISOR_NENHUMA;
+}
+
+// ----------------------------------------------------------------------
+// Consulta e relatório
+// ----------------------------------------------------------------------
+int supervisor_culpado_reinicio(uint32_t *idade_ms)
+{
+    if (idade_ms != NULL)
+    {
+        *idade_ms = g_idade_reinicio_ms;
+    }
+    return g_culpado_reinicio;
+}
+
+const char *supervisor_nome(int parte)
+{
+    if (parte < 0 || parte >= g_quantidade)
+    {
+        return "?";
+    }
+    return g_partes[parte].nome;
+}
+
+void supervisor_imprimir_estado(void)
+{
+    uint32_t agora = agora_ms();
+
+    printf("=== Supervisor (watchdog) ===\n");
+    printf("%-14s %7s %7s %9s %9s %7s\n", "parte", "prazo", "idade", "batim.", "maior", "atrasos");
+    for (int i = 0; i < g_quantidade; i++)
+    {
+        const supervisor_parte_t *parte = &g_partes[i];
+        uint32_t ultimo = parte->ultimo_ms;
+        uint32_t idade_ms = (int32_t)(agora - ultimo) > 0 ? agora - ultimo : 0;
+        printf("%-14s %7lu %7lu %9lu %9lu %7lu\n", parte->nome, (unsigned long)parte->prazo_ms,
+               (unsigned long)idade_ms, (unsigned long)parte->batimentos,
+               (unsigned long)parte->maior_intervalo_ms, (unsigned long)parte->atrasos);
+    }
+    printf("Tempos em ms\n");
+}
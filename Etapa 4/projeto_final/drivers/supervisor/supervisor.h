@@ -0,0 +1,119 @@
+// ======================================================================
+//  Arquivo: supervisor.h
+//  Descrição: Supervisor do watchdog de hardware com batimentos por
+//             núcleo e por tarefa crítica, e registro do culpado nos
+//             registradores de rascunho (scratch) do watchdog
+// ======================================================================
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdint.h>     // Tipos inteiros padrão
+#include <stdbool.h>    // Tipo booleano padrão
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------
+// Parâmetros
+// ----------------------------------------------------------------------
+#define SUPERVISOR_MAXIMO_PARTES 8          ///< Partes supervisionadas (tabela estática)
+#define SUPERVISOR_NENHUMA       (-1)       ///< Nenhuma parte atrasada / sem reinício pelo supervisor
+#define SUPERVISOR_MAGICO        0x48535744u ///< "HSWD": marca um culpado válido em scratch[0]
+
+// Registradores de rascunho usados (o SDK reserva scratch[4..7] para watchdog_reboot)
+#define SUPERVISOR_SCRATCH_MAGICO 0 ///< SUPERVISOR_MAGICO quando há culpado registrado
+#define SUPERVISOR_SCRATCH_PARTE  1 ///< Identificador da parte atrasada
+#define SUPERVISOR_SCRATCH_IDADE  2 ///< Idade do último batimento da parte ao ser detectada (ms)
+
+// ----------------------------------------------------------------------
+// Estrutura: supervisor_parte_t
+// ----------------------------------------------------------------------
+/**
+ * @brief Parte supervisionada (núcleo ou tarefa crítica) e seu último batimento.
+ *
+ * Cada parte tem um único escritor do batimento (o núcleo onde roda); o
+ * instante é uma palavra de 32 bits, lida sem trava pelo outro núcleo.
+ */
+typedef struct {
+    const char *nome;                 ///< Nome para relatórios
+    uint32_t prazo_ms;                ///< Intervalo máximo entre batimentos
+    volatile uint32_t ultimo_ms;      ///< Instante do último batimento (ms desde o boot)
+    volatile uint32_t batimentos;     ///< Batimentos recebidos
+    uint32_t maior_intervalo_ms;      ///< Maior idade observada numa verificação (aproximada: os dois núcleos verificam)
+    uint32_t atrasos;                 ///< Verificações que encontraram a parte atrasada (idem)
+} supervisor_parte_t;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicializa o supervisor e lê dos registradores de rascunho o culpado
+ *        do reinício anterior, se houver; depois os limpa.
+ *
+ * Deve ser chamada cedo no boot, antes de qualquer registro de parte.
+ */
+void supervisor_iniciar(void);
+
+/**
+ * @brief Registra uma parte supervisionada (só no núcleo 0, antes de lançar o núcleo 1).
+ *
+ * O prazo começa a contar do registro. Os identificadores seguem a ordem de
+ * registro, que deve ser a mesma a cada boot para o relatório do culpado.
+ *
+ * @param nome Nome da parte (deve permanecer válido)
+ * @param prazo_ms Intervalo máximo entre batimentos (ms)
+ * @return Identificador da parte, ou SUPERVISOR_NENHUMA com a tabela cheia
+ */
+int supervisor_registrar(const char *nome, uint32_t prazo_ms);
+
+/**
+ * @brief Registra um batimento da parte (chamada pelo núcleo onde ela roda).
+ * @param parte Identificador retornado por supervisor_registrar
+ */
+void supervisor_batimento(int parte);
+
+/**
+ * @brief Verifica os batimentos (qualquer núcleo).
+ *
+ * Com uma parte atrasada, grava o culpado nos registradores de rascunho: se o
+ * watchdog de hardware reiniciar a placa, o boot seguinte sabe quem parou.
+ *
+ * @return A parte mais atrasada em relação ao prazo, ou SUPERVISOR_NENHUMA
+ */
+int supervisor_verificar(void);
+
+/**
+ * @brief Alimenta o watchdog de hardware só se todos os batimentos estiverem em dia.
+ *
+ * Com todos em dia, também apaga o culpado gravado por uma verificação
+ * anterior (atraso passageiro que não levou ao reinício).
+ *
+ * @return SUPERVISOR_NENHUMA se alimentou; senão, a parte atrasada
+ */
+int supervisor_alimentar(void);
+
+/**
+ * @brief Culpado do reinício anterior, lido por supervisor_iniciar.
+ * @param[out] idade_ms Idade do último batimento da parte ao ser detectada (pode ser NULL)
+ * @return Identificador da parte, ou SUPERVISOR_NENHUMA se o reinício não foi pelo supervisor
+ */
+int supervisor_culpado_reinicio(uint32_t *idade_ms);
+
+/**
+ * @brief Nome de uma parte registrada.
+ * @param parte Identificador da parte
+ * @return Nome, ou "?" se o identificador não estiver registrado
+ */
+const char *supervisor_nome(int parte);
+
+/** @brief Imprime o estado de cada parte supervisionada. */
+void supervisor_imprimir_estado(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SUPERVISOR_H
@@ -7,6 +7,8 @@
 #include "sensor_watchdog.h"      // Header do watchdog de sensores
 #include "hardware/watchdog.h"    // API do watchdog do hardware Pico
 #include "hardware/gpio.h"        // Controle de GPIO para reset de barramento
+#include "hardware/timer.h"       // busy_wait_us (espera sem ceder o núcleo)
+#include "pico/stdlib.h"           // tight_loop_contents
 #include <stdio.h>                 // Funções de entrada/saída padrão
 #include <string.h>                // Manipulação de memória
 #include <math.h>                  // Funções matemáticas
@@ -38,11 +40,11 @@ void sensor_watchdog_init(void)
         g_watchdog.sensors[i].history_index = 0;
     }
 
-    // Detecta se o último reset foi causado pelo watchdog (travamento)
+    // Detecta se o último reset foi causado pelo watchdog; o motivo (a parte sem
+    // batimento) é relatado pelo supervisor em tarefas_nucleo0_iniciar
     if (watchdog_caused_reboot()) 
     {
         printf("*** ATENÇÃO: Sistema foi reiniciado pelo watchdog! ***\n");
-        printf("*** Motivo: Travamento de sensor detectado ***\n");
         printf("*** Sistema reinicializado com sucesso ***\n");
         sleep_ms(1000); // Pausa para destacar a mensagem
     }
@@ -201,60 +203,44 @@ static bool verify_sensor_freeze(uint8_t sensor_id)
 }
 
 /**
- * @brief Atualiza o estado do watchdog, verifica travamentos e executa reset se necessário.
+ * @brief Verifica se algum sensor está travado.
  *
- * Deve ser chamada periodicamente no loop principal do sistema.
+ * Deve ser chamada periodicamente no loop do núcleo 1. Não imprime nem
+ * espera: com um travamento confirmado, o chamador registra o alerta pela
+ * fila de log do núcleo 0 e chama sensor_watchdog_reset_system().
+ *
+ * @return true se há sensor travado confirmado
  */
-void sensor_watchdog_update(void)
+bool sensor_watchdog_update(void)
 {
     if (!g_watchdog.watchdog_enabled) 
     {
-        return;
+        return false;
     }
 
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-
-    // Verifica se algum sensor está travado
-    bool any_frozen = false;
     for (int i = 0; i < MAX_SENSORS; i++) {
         if (g_watchdog.sensors[i].is_initialized && g_watchdog.sensors[i].is_frozen) 
         {
             // Confirma travamento (pode ser expandido para checar desconexão)
             if (verify_sensor_freeze(i)) 
             {
-                any_frozen = true;
-                break;
+                return true;
             }
         }
     }
+    // Sem travamento, o watchdog de hardware é alimentado pelo supervisor (drivers/supervisor),
+    // que também exige amostras novas (parte "sensores") e os demais batimentos
+    return false;
+}
 
-    if (any_frozen) 
-    {
-        printf("\n");
-        printf("************************************************\n");
-        printf("*** ALERTA: SENSOR(ES) TRAVADO(S) DETECTADO(S)! ***\n");
-        printf("************************************************\n");
-
-        // Mostra quais sensores estão travados
-        for (int i = 0; i < MAX_SENSORS; i++) 
-        {
-            if (g_watchdog.sensors[i].is_initialized && g_watchdog.sensors[i].is_frozen) 
-            {
-                printf("*** SENSOR %d TRAVADO! ***\n", i);
-            }
-        }
-
-        sensor_watchdog_print_status();
-
-        printf("Iniciando procedimento de reset do sistema...\n");
-        sleep_ms(2000); // Tempo para ver as mensagens
-        sensor_watchdog_reset_system();
-    } 
-    else 
-    {
-        // Se não há travamento, alimenta o watchdog do hardware
-        watchdog_update();
-    }
+/**
+ * @brief Retorna o instante da última amostra recebida de qualquer sensor.
+ *
+ * @return Instante em ms desde o boot (atualizado por sensor_watchdog_feed)
+ */
+uint32_t sensor_watchdog_last_update_ms(void)
+{
+    return g_watchdog.last_update_time;
 }
 
 /**
@@ -293,11 +279,12 @@ bool sensor_watchdog_any_sensor_frozen(void)
  * @brief Força o reset do barramento I2C antes do reset do sistema.
  *
  * Ajuda a destravar sensores que possam estar travados no barramento I2C.
+ * Roda no núcleo 1 com a captura já parada (captura_parar): toma os pinos do
+ * periférico, que não é mais usado, e espera em laço ocupado, sem ceder a
+ * timers nem a sleep (~1ms no total, dentro do período do laço).
  */
 static void force_i2c_bus_reset(void)
 {
-    printf("Forçando reset do barramento I2C...\n");
-
     // GPIOs usados para I2C1 (ajustar conforme hardware)
     const uint sda_gpio = 2;
     const uint scl_gpio = 3;
@@ -315,58 +302,43 @@ static void force_i2c_bus_reset(void)
     // Força ambas as linhas em nível baixo por um momento
     gpio_put(sda_gpio, 0);
     gpio_put(scl_gpio, 0);
-    sleep_ms(10);
+    busy_wait_us(100);
 
     // Depois força ambas em nível alto para destravar o barramento
     gpio_put(sda_gpio, 1);
     gpio_put(scl_gpio, 1);
-    sleep_ms(50);
+    busy_wait_us(100);
 
     // Gera alguns pulsos de clock para limpar o barramento
     for (int i = 0; i < 9; i++) 
     {
         gpio_put(scl_gpio, 0);
-        sleep_us(10);
+        busy_wait_us(10);
         gpio_put(scl_gpio, 1);
-        sleep_us(10);
+        busy_wait_us(10);
     }
 
     // Mantém ambas as linhas em nível alto
     gpio_put(sda_gpio, 1);
     gpio_put(scl_gpio, 1);
-    sleep_ms(10);
-
-    printf("Reset do barramento I2C concluído.\n");
 }
 
 /**
  * @brief Força o reset do sistema via watchdog, após reset do barramento I2C.
  *
- * Utilizado para recuperar o sistema em caso de travamento de sensores.
+ * Utilizado para recuperar o sistema em caso de travamento de sensores. Não
+ * retorna: o núcleo que a chama deixa de enviar batimentos, o supervisor para
+ * de alimentar o watchdog de hardware e a placa reinicia no prazo dele. O
+ * outro núcleo continua imprimindo as mensagens enfileiradas até lá.
  */
 void sensor_watchdog_reset_system(void)
 {
-    printf("SISTEMA TRAVADO DETECTADO - Forçando reset via watchdog...\n");
-    printf("Aguarde o reinício do sistema...\n");
-
     // Força reset do barramento I2C antes do reset do sistema
     force_i2c_bus_reset();
 
-    printf("Reset em 3 segundos...\n");
-
-    // Aguarda tempo suficiente para garantir envio das mensagens
-    for (int i = 3; i > 0; i--) {
-        printf("Reset em %d segundos...\n", i);
-        sleep_ms(1000);
-    }
-
-    printf("RESETANDO AGORA!\n");
-    sleep_ms(500); // Tempo adicional para enviar a última mensagem
-
-    // Para de alimentar o watchdog, forçando o reset do sistema
     while (1) 
     {
-        sleep_ms(100);
+        tight_loop_contents();
     }
 }
 
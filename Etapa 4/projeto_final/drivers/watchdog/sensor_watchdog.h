@@ -85,8 +85,16 @@ void sensor_watchdog_disable(void);
  */
 void sensor_watchdog_feed(uint8_t sensor_id, mpu9250_raw_data_t *raw_data);
 
-/** @brief Atualiza o estado do watchdog, verifica travamentos e executa reset se necessário. */
-void sensor_watchdog_update(void);
+/**
+ * @brief Verifica se algum sensor está travado (sem imprimir nem esperar).
+ *
+ * Não alimenta o watchdog de hardware: isso cabe ao supervisor (supervisor.h).
+ * @return true se há sensor travado: o chamador avisa e chama sensor_watchdog_reset_system()
+ */
+bool sensor_watchdog_update(void);
+
+/** @brief Instante (ms desde o boot) da última amostra recebida de qualquer sensor. */
+uint32_t sensor_watchdog_last_update_ms(void);
 
 /**
  * @brief Consulta se um sensor específico está travado.
@@ -98,7 +106,7 @@ bool sensor_watchdog_is_sensor_frozen(uint8_t sensor_id);
 /** @brief Consulta se algum sensor monitorado está travado. */
 bool sensor_watchdog_any_sensor_frozen(void);
 
-/** @brief Força o reset do sistema via watchdog, após reset do barramento I2C. */
+/** @brief Reinicia o barramento I2C (com a captura já parada: captura_parar) e para o núcleo que a chama, até o watchdog reiniciar a placa (não retorna). */
 void sensor_watchdog_reset_system(void);
 
 /** @brief Imprime o status atual do watchdog e dos sensores monitorados. */
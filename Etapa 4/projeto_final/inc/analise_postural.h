@@ -21,22 +21,90 @@
  */
 constexpr std::array<int,3> LIMITACOES = {90, 60, 45};
 
+// ----------------------------------------------------------------------
+// Taxas do Pipeline de Processamento
+// ----------------------------------------------------------------------
+// A fusão sensorial integra cada amostra da FIFO dos sensores (taxa de saída
+// do MPU9250); a extração dos ângulos e a análise de risco usam o estado mais
+// recente a uma taxa menor, sem escalar com a taxa da fusão.
+#ifndef TAXA_FUSAO_HZ
+#define TAXA_FUSAO_HZ 500      ///< Taxa de amostragem dos sensores e da fusão (Hz, divisor de 1000)
+#endif
+
+#ifndef TAXA_AVALIACAO_HZ
+#define TAXA_AVALIACAO_HZ 50   ///< Taxa de extração dos ângulos e de dangerCheck() (Hz)
+#endif
+
+// Quadros da captura (captura_sensores.h) retidos pela fusão por vez, ~20 amostras
+// por sensor; entra na conta do pool em pipeline_sensores.cpp
+constexpr size_t MAXIMO_QUADROS_RETIDOS = 8;
+
+// Magnetômetro dos sensores (desabilitado pela opção SEM_MAGNETOMETRO do CMake)
+#ifdef SEM_MAGNETOMETRO
+constexpr bool MAGNETOMETRO_HABILITADO = false;
+#else
+constexpr bool MAGNETOMETRO_HABILITADO = true;
+#endif
+
+static_assert(1000 % TAXA_FUSAO_HZ == 0 && TAXA_FUSAO_HZ >= 4,
+              "TAXA_FUSAO_HZ deve dividir a taxa interna de 1kHz do MPU9250");
+static_assert(TAXA_AVALIACAO_HZ > 0 && TAXA_AVALIACAO_HZ <= TAXA_FUSAO_HZ,
+              "TAXA_AVALIACAO_HZ deve estar entre 1 e TAXA_FUSAO_HZ");
+
 // ----------------------------------------------------------------------
 // Protótipos das Funções Principais de Análise Postural
 // ----------------------------------------------------------------------
 
 /**
- * @brief Realiza a leitura dos sensores, processa os dados e retorna os ângulos articulares.
+ * @brief Lê as amostras acumuladas na FIFO dos sensores e integra cada uma na fusão sensorial.
  * @param mpu_list Array de 2 sensores MPU9250 (tronco e coxa)
- * @return Estrutura Orientacao com ângulos de flexão, abdução e rotação
+ * @return true se todos os sensores trouxeram amostras novas (captura e sensores ativos)
+ */
+bool atualizarFusao(mpu9250_t mpu_list[2]);
+
+/**
+ * @brief Amostras sem par descartadas por atualizarFusao (as mais antigas, acima do limite de pendentes).
+ * @return Total desde o início, só crescente
  */
-Orientacao getPosition(mpu9250_t mpu_list[2]);
+uint32_t amostrasDescartadasFusao(void);
+
+/**
+ * @brief Extrai os ângulos articulares da orientação mais recente da fusão.
+ *
+ * O resultado é anotado no quadro de amostras da última amostra integrada (ver
+ * captura_sensores.h), sem cópia, e vale até a próxima chamada.
+ *
+ * @return Orientacao com ângulos de flexão, abdução e rotação
+ */
+const Orientacao& getPosition(void);
+
+/**
+ * @brief Calibração funcional do alinhamento de montagem dos sensores (postura neutra + flexões).
+ * @param mpu_list Array de 2 sensores MPU9250 (tronco e coxa)
+ */
+void calibrarMontagem(mpu9250_t mpu_list[2]);
 
 /**
  * @brief Analisa a orientação atual, gerencia eventos e alarmes de postura perigosa.
  * @param orientacao Estrutura com ângulos de flexão, abdução e rotação
  */
-void dangerCheck(Orientacao orientacao);
+void dangerCheck(const Orientacao& orientacao);
+
+/**
+ * @brief Habilita os logs detalhados (ângulos periódicos e lista de eventos ativos).
+ *
+ * Desabilitados pelo agendador quando o período estoura o orçamento: a detecção
+ * e o alarme não mudam, só deixam de ser gerados os logs de acompanhamento.
+ *
+ * @param habilitado false para gerar só os logs de eventos e alarme
+ */
+void definirLogDetalhado(bool habilitado);
+
+/**
+ * @brief Nome do tipo de movimento (ex: "FLEXAO"), para logs e gravação.
+ * @param m Tipo de movimento
+ */
+const char* movToStr(TipoMovimento m);
 
 // ----------------------------------------------------------------------
 // Funções de Controle Manual do Alarme Sonoro
@@ -0,0 +1,138 @@
+// ======================================================================
+//  Arquivo: armazenamento.h
+//  Descrição: Gravação assíncrona no SDCard (núcleo 0), com faixas de
+//             prioridade limitadas, gravação em lote e contrapressão
+// ======================================================================
+
+#ifndef ARMAZENAMENTO_H_
+#define ARMAZENAMENTO_H_
+
+#include <cstdint>                  // Tipos inteiros padrão
+#include "estruturas_de_dados.hpp" // RegistroEvento, AmostraPostura
+
+// ----------------------------------------------------------------------
+// Parâmetros das faixas
+// ----------------------------------------------------------------------
+#define ARMAZENAMENTO_CAPACIDADE_EVENTOS      32   ///< Eventos encerrados pendentes (potência de 2)
+#define ARMAZENAMENTO_CAPACIDADE_DIAGNOSTICOS 8    ///< Mensagens de diagnóstico pendentes (potência de 2)
+#define ARMAZENAMENTO_CAPACIDADE_AMOSTRAS     32   ///< Amostras de postura pendentes (potência de 2)
+#define ARMAZENAMENTO_LOTE_EVENTOS            8    ///< Eventos gravados por lote (gravados sem esperar acumular)
+#define ARMAZENAMENTO_LOTE_DIAGNOSTICOS       8    ///< Diagnósticos acumulados antes de uma gravação
+#define ARMAZENAMENTO_LOTE_AMOSTRAS           16   ///< Amostras acumuladas antes de uma gravação
+#define ARMAZENAMENTO_ESPERA_MAXIMA_MS        30000 ///< Espera máxima de diagnósticos e amostras pendentes antes de gravar
+#define ARMAZENAMENTO_PRESSAO_EVENTOS         8    ///< Eventos pendentes a partir dos quais as novas amostras são só resumidas
+#define ARMAZENAMENTO_TAMANHO_DIAGNOSTICO     80   ///< Tamanho máximo de uma mensagem de diagnóstico (com o '\0')
+#define ARMAZENAMENTO_TAMANHO_LOTE            1024 ///< Buffer de formatação de um lote (bytes)
+#define ARMAZENAMENTO_ESPERA_FALHA_MS         100  ///< Espera antes de regravar os eventos após uma falha (dobra a cada falha seguida)
+#define ARMAZENAMENTO_ESPERA_FALHA_MAXIMA_MS  5000 ///< Maior espera entre as tentativas de gravar os eventos
+
+// ----------------------------------------------------------------------
+// Enums
+// ----------------------------------------------------------------------
+/**
+ * @brief Faixas de gravação, em ordem de prioridade (índice nas estatísticas).
+ */
+enum class FaixaArmazenamento : uint8_t {
+    EVENTOS,      ///< Eventos de postura encerrados (dados.csv): nunca resumidos; regravados após uma falha
+    DIAGNOSTICOS, ///< Perdas e estouros do sistema (diagnostico.csv)
+    AMOSTRAS,     ///< Amostras periódicas dos ângulos (amostras.csv): resumidas sob pressão
+    QUANTIDADE
+};
+
+/**
+ * @brief Resultado de um pedido de gravação.
+ */
+enum class ResultadoArmazenamento : uint8_t {
+    ACEITO,    ///< Na faixa, aguardando o lote
+    RESUMIDO,  ///< Faixa cheia ou sob pressão: somado ao resumo (amostras)
+    DESCARTADO ///< Faixa cheia: perdido e contado
+};
+
+// ----------------------------------------------------------------------
+// Estruturas: estatísticas
+// ----------------------------------------------------------------------
+/** @brief Profundidade e destino dos pedidos de uma faixa. */
+typedef struct {
+    uint32_t profundidade;         ///< Pedidos pendentes agora
+    uint32_t profundidade_maxima;  ///< Maior profundidade observada
+    uint32_t aceitos;              ///< Pedidos aceitos na faixa
+    uint32_t resumidos;            ///< Pedidos somados ao resumo (só amostras)
+    uint32_t descartados;          ///< Pedidos perdidos com a faixa cheia
+} EstatisticasFaixa;
+
+/** @brief Contadores do armazenamento. */
+typedef struct {
+    EstatisticasFaixa faixas[(int)FaixaArmazenamento::QUANTIDADE]; ///< Por faixa (índice FaixaArmazenamento)
+    uint32_t lotes;                ///< Gravações (uma abertura de arquivo cada)
+    uint32_t linhas_gravadas;      ///< Linhas gravadas com sucesso
+    uint32_t bytes_gravados;       ///< Bytes gravados com sucesso
+    uint32_t falhas_gravacao;      ///< Lotes que falharam
+    uint32_t linhas_perdidas;      ///< Linhas dos lotes que falharam (diagnósticos e amostras)
+    uint32_t eventos_adiados;      ///< Linhas de eventos mantidas na faixa após uma falha, para nova tentativa
+    uint32_t tempo_lote_maximo_us; ///< Maior duração de um lote (RTC, formatação e SDCard)
+} EstatisticasArmazenamento;
+
+// ----------------------------------------------------------------------
+// Protótipos das funções (todas no núcleo 0)
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Indica se a faixa de eventos tem espaço.
+ *
+ * Sem espaço, o chamador deixa o evento na fila do núcleo 1: a contrapressão
+ * chega à origem, e eventos só são perdidos com as duas filas cheias.
+ */
+bool armazenamento_aceita_evento(void);
+
+/**
+ * @brief Pede a gravação de um evento encerrado.
+ * @param registro Evento encerrado
+ * @return ACEITO, ou DESCARTADO com a faixa cheia
+ */
+ResultadoArmazenamento armazenamento_registrar_evento(const RegistroEvento& registro);
+
+/**
+ * @brief Pede a gravação de uma amostra de postura.
+ *
+ * Com a faixa cheia, ou com ARMAZENAMENTO_PRESSAO_EVENTOS eventos pendentes, a
+ * amostra é somada a um resumo (quantidade, médias, maior incerteza) gravado
+ * como uma linha só.
+ *
+ * @param amostra Amostra periódica dos ângulos
+ * @return ACEITO ou RESUMIDO
+ */
+ResultadoArmazenamento armazenamento_registrar_amostra(const AmostraPostura& amostra);
+
+/**
+ * @brief Pede a gravação de uma mensagem de diagnóstico (formatada como printf, sem '\n').
+ * @return ACEITO, ou DESCARTADO com a faixa cheia
+ */
+ResultadoArmazenamento armazenamento_registrar_diagnostico(const char* formato, ...);
+
+/**
+ * @brief Grava um lote da faixa pronta de maior prioridade.
+ *
+ * Eventos são gravados assim que chegam; diagnósticos e amostras esperam um
+ * lote completo ou ARMAZENAMENTO_ESPERA_MAXIMA_MS. O RTC é lido uma vez por
+ * lote e cada linha recebe a data/hora do seu instante de origem.
+ *
+ * Um lote de eventos só sai da faixa depois de gravado: numa falha ele é
+ * regravado após ARMAZENAMENTO_ESPERA_FALHA_MS, espera que dobra a cada falha
+ * seguida (até ARMAZENAMENTO_ESPERA_FALHA_MAXIMA_MS). Com a faixa cheia, a
+ * contrapressão chega ao núcleo 1 (armazenamento_aceita_evento). Lotes de
+ * diagnósticos e amostras que falham são perdidos e contados.
+ *
+ * @return true se gravou um lote e ainda há outro pronto
+ */
+bool armazenamento_servir(void);
+
+/** @brief Retorna uma cópia dos contadores do armazenamento. */
+EstatisticasArmazenamento armazenamento_estatisticas(void);
+
+/** @brief Imprime profundidade, perdas e tempos de gravação por faixa. */
+void armazenamento_imprimir_estatisticas(void);
+
+/** @brief Reporta os descartes e falhas de gravação desde a última chamada. */
+void armazenamento_reportar(void);
+
+#endif // ARMAZENAMENTO_H_
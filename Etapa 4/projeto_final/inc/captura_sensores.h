@@ -0,0 +1,175 @@
+// ======================================================================
+//  Arquivo: captura_sensores.h
+//  Descrição: Captura dos bytes brutos dos sensores em IRQ (timer e DMA
+//             do I2C) com processamento adiado no laço do núcleo 1
+// ======================================================================
+
+#ifndef CAPTURA_SENSORES_H_
+#define CAPTURA_SENSORES_H_
+
+#include <cstddef>         // size_t
+#include <cstdint>         // Tipos inteiros padrão
+#include "pico/time.h"     // alarm_pool_t
+#include "mpu9250_i2c.h"   // mpu9250_t, mpu9250_fifo_frame_t, MPU9250_FIFO_BYTES_AMOSTRA
+#include "estruturas_de_dados.hpp" // Orientacao
+
+// ----------------------------------------------------------------------
+// Parâmetros da captura
+// ----------------------------------------------------------------------
+#define CAPTURA_PERIODO_US 5000             ///< Disparo da captura pelo timer (~2,5 amostras por sensor a 500Hz)
+#define CAPTURA_AMOSTRAS_POR_QUADRO 8       ///< Amostras lidas da FIFO de cada sensor por captura; o excedente fica para a próxima
+#define CAPTURA_QUADROS 24                  ///< Quadros do pool (capturados, em fusão, em avaliação ou em gravação)
+#define CAPTURA_LIMITE_US 20000             ///< Captura ainda em andamento após este tempo é abortada (sensor sem resposta)
+#define CAPTURA_MAXIMO_SENSORES 2           ///< Sensores no barramento capturado
+#define CAPTURA_SEM_QUADRO 0xFF            ///< Índice que não designa quadro (antes do primeiro, pool esgotado)
+
+// ----------------------------------------------------------------------
+// Estrutura: QuadroAmostras
+// ----------------------------------------------------------------------
+/**
+ * @brief Uma captura de todos os sensores, anotada no lugar por cada estágio.
+ *
+ * O quadro vem do pool da captura e circula só pelo índice: o DMA escreve os
+ * bytes direto nele, a fusão os converte no mesmo espaço (fifo.amostra sobre
+ * fifo.bytes) e marca o que já integrou, a avaliação anota a orientação e a
+ * gravação lê a orientação anotada. Cada estágio que guarda o índice tem uma
+ * referência (captura_reter/captura_liberar); o quadro volta ao pool com a
+ * última. Não é copiável: um estágio que precisa dos dados guarda o índice.
+ */
+struct QuadroAmostras {
+    QuadroAmostras() = default;
+    QuadroAmostras(const QuadroAmostras&) = delete;
+    QuadroAmostras& operator=(const QuadroAmostras&) = delete;
+
+    // --- Captura (IRQ do DMA) ---
+    uint64_t instante_us;    ///< Fim da captura (us desde o boot)
+    bool transbordo;         ///< A FIFO de um sensor transbordou: reiniciar com captura_reiniciar_fifos
+    uint8_t amostras[CAPTURA_MAXIMO_SENSORES];  ///< Amostras completas em fifo, por sensor
+    bool mag_lido[CAPTURA_MAXIMO_SENSORES];     ///< mag contém EXT_SENS_DATA_00..07 (ST1, HX, HY, HZ, ST2)
+    uint8_t mag[CAPTURA_MAXIMO_SENSORES][8];    ///< Bytes do magnetômetro lidos pelo I2C master
+    union {
+        uint8_t bytes[CAPTURA_AMOSTRAS_POR_QUADRO * MPU9250_FIFO_BYTES_AMOSTRA]; ///< Bytes de FIFO_R_W (DMA)
+        mpu9250_fifo_frame_t amostra[CAPTURA_AMOSTRAS_POR_QUADRO];             ///< Amostras convertidas no lugar
+    } fifo[CAPTURA_MAXIMO_SENSORES];
+
+    // --- Fusão (laço do núcleo 1) ---
+    bool convertido;         ///< fifo contém amostras convertidas (mpu9250_fifo_decode no lugar)
+    uint8_t fundidas[CAPTURA_MAXIMO_SENSORES];  ///< Amostras de cada sensor já integradas na fusão
+
+    // --- Avaliação (laço do núcleo 1) ---
+    bool avaliado;           ///< orientacao foi anotada por getPosition
+    bool entregue;           ///< orientacao foi entregue à gravação (núcleo 0) e não é mais reescrita
+    Orientacao orientacao;   ///< Ângulos avaliados com a fusão na última amostra integrada deste quadro
+};
+
+static_assert(sizeof(mpu9250_fifo_frame_t) == MPU9250_FIFO_BYTES_AMOSTRA,
+              "A conversão no lugar exige uma amostra convertida do tamanho da bruta");
+
+// ----------------------------------------------------------------------
+// Estrutura: EstatisticasCaptura
+// ----------------------------------------------------------------------
+/**
+ * @brief Contadores da captura e do pool de quadros (escritos no núcleo 1).
+ */
+typedef struct {
+    uint32_t capturas;           ///< Capturas iniciadas pelo timer
+    uint32_t capturas_adiadas;   ///< Disparos sem quadro livre: as amostras esperam na FIFO do sensor
+    uint32_t transbordos;        ///< Transbordos da FIFO de um sensor (amostras sobrescritas no sensor)
+    uint32_t falhas_barramento;  ///< Capturas abortadas por CAPTURA_LIMITE_US
+    uint32_t quadros_alocados;   ///< Quadros entregues pelo pool
+    uint32_t quadros_devolvidos; ///< Quadros que voltaram ao pool (liberados pelo último dono)
+    uint32_t quadros_maximo_em_uso; ///< Maior número de quadros fora do pool
+} EstatisticasCaptura;
+
+// ----------------------------------------------------------------------
+// Núcleo 1: produtor (IRQ)
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Liga a captura: um timer no pool de alarmes do núcleo 1 dispara, a
+ *        cada CAPTURA_PERIODO_US, uma cadeia de leituras por DMA no barramento
+ *        dos sensores, direto em um quadro do pool; a IRQ de conclusão do DMA
+ *        passa à leitura seguinte e, ao fim do último sensor, carimba o quadro
+ *        e insere o seu índice na fila.
+ *
+ * Por sensor: INT_STATUS, FIFO_COUNT, até CAPTURA_AMOSTRAS_POR_QUADRO amostras
+ * da FIFO e, com o magnetômetro habilitado, EXT_SENS_DATA. Sem quadro livre no
+ * pool o disparo é adiado (as amostras esperam na FIFO do sensor, até 84ms). A
+ * cadeia de leitura não passa pelo laço: um período longo do núcleo 1 não
+ * atrasa a captura.
+ *
+ * As FIFOs só são lidas depois de captura_reiniciar_fifos. Deve ser chamada no
+ * núcleo 1 (as IRQs rodam no núcleo que as habilita), com todos os sensores
+ * no mesmo barramento.
+ *
+ * @param mpu_list Sensores (devem permanecer válidos)
+ * @param quantidade Número de sensores (até CAPTURA_MAXIMO_SENSORES)
+ * @param pool Pool de alarmes do núcleo 1 (o do agendador)
+ * @return false sem timer ou canal de DMA livre
+ */
+bool captura_iniciar(mpu9250_t* mpu_list, size_t quantidade, alarm_pool_t* pool);
+
+// ----------------------------------------------------------------------
+// Núcleo 1: consumidor (laço)
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Retira até max quadros capturados, do mais antigo ao mais novo.
+ *
+ * O chamador recebe a referência da captura de cada índice e a devolve com
+ * captura_liberar.
+ *
+ * @param destino Recebe os índices dos quadros
+ * @param max Capacidade de destino
+ * @return Quantidade retirada (0 se não há quadros)
+ */
+size_t captura_remover_lote(uint8_t* destino, size_t max);
+
+/**
+ * @brief Quadro de um índice recebido da captura (ou de outro estágio).
+ *
+ * O núcleo 0 pode ler um quadro cujo índice recebeu por fila do núcleo 1, mas
+ * não reter nem liberar: devolve o índice ao núcleo 1, que libera.
+ */
+QuadroAmostras& captura_quadro(uint8_t indice);
+
+/** @brief Acrescenta uma referência ao quadro (mais um estágio guarda o índice; núcleo 1). */
+void captura_reter(uint8_t indice);
+
+/** @brief Remove uma referência; o quadro volta ao pool com a última (núcleo 1). */
+void captura_liberar(uint8_t indice);
+
+/**
+ * @brief Pede o barramento para acesso direto (sequências do magnetômetro, FIFOs).
+ *
+ * Nenhuma captura nova começa até captura_devolver_barramento. Não espera:
+ * com uma captura em andamento retorna false e o chamador tenta no período
+ * seguinte (o pedido continua valendo, então ela não se repete).
+ *
+ * @return true se o barramento está livre para o laço
+ */
+bool captura_solicitar_barramento(void);
+
+/** @brief Devolve o barramento à captura. */
+void captura_devolver_barramento(void);
+
+/**
+ * @brief Para a captura de vez: cancela o timer e aborta a cadeia de DMA em
+ *        andamento (núcleo 1).
+ *
+ * Antes de tomar os pinos do barramento para outro uso (reset do I2C antes
+ * do reinício da placa). Não espera: a cadeia abortada não termina.
+ */
+void captura_parar(void);
+
+/**
+ * @brief Esvazia e religa as FIFOs de todos os sensores, libera os quadros
+ *        ainda na fila e volta a ler as FIFOs (após o boot ou um transbordo).
+ * @return false se havia captura em andamento (tentar no próximo período)
+ */
+bool captura_reiniciar_fifos(void);
+
+/** @brief Retorna uma cópia dos contadores da captura. */
+EstatisticasCaptura captura_estatisticas(void);
+
+#endif // CAPTURA_SENSORES_H_
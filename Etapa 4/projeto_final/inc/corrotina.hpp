@@ -0,0 +1,261 @@
+// ======================================================================
+//  Arquivo: corrotina.hpp
+//  Descrição: Corrotinas C++20 para sequências de hardware em etapas
+//             (somente cabeçalho), com quadros alocados de um pool estático
+// ======================================================================
+
+#ifndef CORROTINA_HPP_
+#define CORROTINA_HPP_
+
+#include <coroutine>   // std::coroutine_handle, std::suspend_always
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t, uint64_t
+#include "pico/stdlib.h" // time_us_64, sleep_us, tight_loop_contents
+
+// ----------------------------------------------------------------------
+// Pool de quadros
+// ----------------------------------------------------------------------
+#define CORROTINA_QUADROS        4   ///< Corrotinas vivas ao mesmo tempo
+#define CORROTINA_TAMANHO_QUADRO 384 ///< Bytes por quadro (o maior, o do auto-teste, tem ~300 num host de 64 bits)
+
+/**
+ * @brief Quadros das corrotinas em memória estática, sem heap.
+ *
+ * O compilador pede ao promise_type o tamanho exato do quadro; um pedido
+ * maior que CORROTINA_TAMANHO_QUADRO ou com o pool cheio falha sem exceção e a
+ * corrotina nasce inválida (Corrotina::valida). O maior pedido fica registrado
+ * para dimensionar o pool.
+ *
+ * Não é protegido entre núcleos: as corrotinas são criadas no núcleo 0 durante
+ * o boot e, depois que o núcleo 1 é lançado, apenas por ele.
+ */
+struct QuadrosCorrotina
+{
+    static void* alocar(size_t tamanho) noexcept
+    {
+        if (tamanho > maior_pedido) maior_pedido = (uint32_t)tamanho;
+        if (tamanho <= CORROTINA_TAMANHO_QUADRO)
+        {
+            for (uint32_t i = 0; i < CORROTINA_QUADROS; i++)
+            {
+                if (livres & (1u << i))
+                {
+                    livres &= ~(1u << i);
+                    return memoria[i];
+                }
+            }
+        }
+        falhas++;
+        return nullptr;
+    }
+
+    static void liberar(void* quadro) noexcept
+    {
+        size_t i = (size_t)((uint8_t*)quadro - &memoria[0][0]) / CORROTINA_TAMANHO_QUADRO;
+        livres |= 1u << i;
+    }
+
+    static uint32_t emUso()
+    {
+        uint32_t usados = 0;
+        for (uint32_t i = 0; i < CORROTINA_QUADROS; i++)
+        {
+            if (!(livres & (1u << i))) usados++;
+        }
+        return usados;
+    }
+
+    alignas(8) inline static uint8_t memoria[CORROTINA_QUADROS][CORROTINA_TAMANHO_QUADRO];
+    inline static uint32_t livres = (1u << CORROTINA_QUADROS) - 1; ///< Bit i = quadro i livre
+    inline static uint32_t maior_pedido = 0;                        ///< Maior quadro pedido (bytes)
+    inline static uint32_t falhas = 0;                              ///< Pedidos recusados
+};
+
+static_assert(CORROTINA_QUADROS <= 32, "QuadrosCorrotina: um bit por quadro em uma palavra");
+static_assert(CORROTINA_TAMANHO_QUADRO % 8 == 0, "QuadrosCorrotina: quadros alinhados a 8 bytes");
+
+// ----------------------------------------------------------------------
+// Classe: Corrotina
+// ----------------------------------------------------------------------
+/**
+ * @brief Sequência de hardware que suspende em esperas em vez de dormir.
+ *
+ * A corrotina é criada suspensa e só avança em retomar, chamado pelo laço que
+ * a possui (o núcleo 1 a cada período, por exemplo): se o prazo da espera
+ * atual venceu, ou a condição de E/S esperada foi atendida, ela roda até o
+ * próximo co_await e devolve o controle. Entre uma etapa e outra o laço segue
+ * com o trabalho de tempo real. executar faz o mesmo dormindo entre as
+ * etapas, para o boot.
+ *
+ * O corpo retorna bool (co_return), lido em resultado depois de concluida.
+ * Somente movível; o destrutor libera o quadro, mesmo no meio da sequência.
+ */
+class Corrotina
+{
+public:
+    struct promise_type
+    {
+        uint64_t acordar_us = 0;                ///< Retomar a partir deste instante (prazo da espera)
+        bool (*condicao)(void*) = nullptr;      ///< Condição de E/S esperada (nullptr: só o prazo)
+        void* contexto = nullptr;               ///< Argumento da condição
+        bool condicao_atendida = false;         ///< A última espera terminou pela condição, não pelo prazo
+        bool resultado = false;                 ///< Valor de co_return
+
+        Corrotina get_return_object() { return Corrotina(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        static Corrotina get_return_object_on_allocation_failure() { return Corrotina(); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(bool valor) { resultado = valor; }
+        void unhandled_exception() {} // Firmware compilado sem exceções
+
+        static void* operator new(size_t tamanho) noexcept { return QuadrosCorrotina::alocar(tamanho); }
+        static void operator delete(void* quadro) noexcept { QuadrosCorrotina::liberar(quadro); }
+    };
+    using Alca = std::coroutine_handle<promise_type>;
+
+    Corrotina() = default;
+    explicit Corrotina(Alca alca) : alca(alca) {}
+    Corrotina(Corrotina&& outra) noexcept : alca(outra.alca) { outra.alca = nullptr; }
+    Corrotina& operator=(Corrotina&& outra) noexcept
+    {
+        if (this != &outra)
+        {
+            if (alca) alca.destroy();
+            alca = outra.alca;
+            outra.alca = nullptr;
+        }
+        return *this;
+    }
+    Corrotina(const Corrotina&) = delete;
+    Corrotina& operator=(const Corrotina&) = delete;
+    ~Corrotina() { if (alca) alca.destroy(); }
+
+    /** @brief false se o quadro não pôde ser alocado (ou após ser movida). */
+    bool valida() const { return (bool)alca; }
+
+    /** @brief true depois do co_return (ou se inválida). */
+    bool concluida() const { return !alca || alca.done(); }
+
+    /** @brief Valor de co_return; false enquanto não concluída ou se inválida. */
+    bool resultado() const { return alca && alca.done() && alca.promise().resultado; }
+
+    /** @brief Instante do prazo da espera atual (us desde o boot). */
+    uint64_t proximoUs() const { return alca ? alca.promise().acordar_us : 0; }
+
+    /**
+     * @brief Avança uma etapa se a espera atual terminou.
+     * @param agora_us Instante atual (us desde o boot)
+     * @return true enquanto a sequência não estiver concluída
+     */
+    bool retomar(uint64_t agora_us)
+    {
+        if (concluida()) return false;
+        if (pronta(agora_us)) alca.resume();
+        return !concluida();
+    }
+
+    /**
+     * @brief Executa até concluir, dormindo nas esperas por prazo (bloqueante; para o boot).
+     * @return Resultado da sequência; false se inválida
+     */
+    bool executar()
+    {
+        while (!concluida())
+        {
+            uint64_t agora_us = time_us_64();
+            if (pronta(agora_us))
+            {
+                alca.resume();
+            }
+            else if (alca.promise().condicao == nullptr)
+            {
+                sleep_us(alca.promise().acordar_us - agora_us);
+            }
+            else
+            {
+                tight_loop_contents(); // Condição de E/S: consulta de novo
+            }
+        }
+        return resultado();
+    }
+
+private:
+    /** @brief Prazo vencido ou condição atendida; registra qual dos dois. */
+    bool pronta(uint64_t agora_us)
+    {
+        promise_type& p = alca.promise();
+        if (p.condicao != nullptr && p.condicao(p.contexto))
+        {
+            p.condicao_atendida = true;
+            return true;
+        }
+        if ((int64_t)(agora_us - p.acordar_us) >= 0)
+        {
+            p.condicao_atendida = false;
+            return true;
+        }
+        return false;
+    }
+
+    Alca alca = nullptr;
+};
+
+// ----------------------------------------------------------------------
+// Esperas (co_await)
+// ----------------------------------------------------------------------
+
+/** @brief Espera por tempo: a corrotina só é retomada depois de duracao_us. */
+struct EsperaTempo
+{
+    uint64_t duracao_us;
+
+    bool await_ready() const noexcept { return duracao_us == 0; }
+    void await_suspend(Corrotina::Alca alca) const noexcept
+    {
+        Corrotina::promise_type& p = alca.promise();
+        p.condicao = nullptr;
+        p.acordar_us = time_us_64() + duracao_us;
+    }
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Espera por E/S: retomada quando condicao(contexto) for verdadeira ou
+ *        ao fim de limite_us. co_await retorna true se a condição foi atendida.
+ *
+ * A condição é consultada a cada retomar; deve ser uma leitura curta e sem
+ * efeito colateral (um registrador de status, por exemplo).
+ */
+struct EsperaCondicao
+{
+    bool (*condicao)(void*);
+    void* contexto;
+    uint64_t limite_us;
+    Corrotina::Alca alca = nullptr;
+
+    bool await_ready() const { return condicao(contexto); }
+    void await_suspend(Corrotina::Alca a) noexcept
+    {
+        alca = a;
+        Corrotina::promise_type& p = a.promise();
+        p.condicao = condicao;
+        p.contexto = contexto;
+        p.acordar_us = time_us_64() + limite_us;
+    }
+    bool await_resume() const noexcept
+    {
+        if (!alca) return true; // Já atendida em await_ready
+        Corrotina::promise_type& p = alca.promise();
+        p.condicao = nullptr;
+        return p.condicao_atendida;
+    }
+};
+
+inline EsperaTempo esperarUs(uint64_t duracao_us) { return EsperaTempo{duracao_us}; }
+inline EsperaTempo esperarMs(uint32_t duracao_ms) { return EsperaTempo{(uint64_t)duracao_ms * 1000u}; }
+inline EsperaCondicao esperarCondicao(bool (*condicao)(void*), void* contexto, uint64_t limite_us)
+{
+    return EsperaCondicao{condicao, contexto, limite_us};
+}
+
+#endif // CORROTINA_HPP_
@@ -15,12 +15,19 @@
 // ----------------------------------------------------------------------
 /**
  * @brief Representa os ângulos articulares principais de uma junta monitorada.
- *        Utilizada para armazenar os valores de flexão, rotação e abdução (em graus).
+ *        Utilizada para armazenar os valores de flexão, rotação e abdução (em graus),
+ *        junto com a incerteza da estimativa quando o motor de fusão a fornece.
+ *
+ * Os limites são testados direto no quaternion (excede_limite); os ângulos só
+ * são calculados perto dos limites ou quando o log precisa deles (angulos_validos).
  */
 typedef struct {
-    float flexao;   ///< Ângulo de flexão (graus)
-    float rotacao;  ///< Ângulo de rotação (graus)
-    float abducao;  ///< Ângulo de abdução (graus)
+    float flexao;     ///< Ângulo de flexão (graus), válido se angulos_validos
+    float rotacao;    ///< Ângulo de rotação (graus), válido se angulos_validos
+    float abducao;    ///< Ângulo de abdução (graus), válido se angulos_validos
+    float incerteza;  ///< Desvio padrão estimado da orientação relativa (graus); 0 se o motor não estima
+    bool excede_limite[3]; ///< Ângulo acima de LIMITACOES, na mesma ordem {flexão, abdução, rotação}
+    bool angulos_validos;  ///< true se flexao, rotacao e abducao foram calculados nesta avaliação
 } Orientacao;
 
 // ----------------------------------------------------------------------
@@ -69,20 +76,6 @@ typedef struct {
     float magnetometro[3] = {0.0, 0.0, 0.0};   ///< Campo magnético (uT) nos eixos X, Y, Z
 } sensor_data;
 
-// ----------------------------------------------------------------------
-// Estrutura: Quartenion
-// ----------------------------------------------------------------------
-/**
- * @brief Representa um quaternion para orientação espacial (formato W, X, Y, Z).
- *        Utilizado para cálculos de orientação 3D a partir de sensores inerciais.
- */
-typedef struct {
-    float Q0 = 0.0;   ///< Componente W
-    float Q1 = 0.0;   ///< Componente X
-    float Q2 = 0.0;   ///< Componente Y
-    float Q3 = 0.0;   ///< Componente Z
-} Quartenion;
-
 // ----------------------------------------------------------------------
 // Enum: TipoMovimento
 // ----------------------------------------------------------------------
@@ -109,4 +102,39 @@ enum class LadoCorpo {
     ESQUERDO   ///< Perna esquerda
 };
 
+// ----------------------------------------------------------------------
+// Estrutura: RegistroEvento
+// ----------------------------------------------------------------------
+/**
+ * @brief Evento de postura encerrado, a ser gravado no SDCard.
+ *
+ * Cópia por valor (sem ponteiros): passa do núcleo 1, que detecta e encerra
+ * o evento, para o núcleo 0, que o grava (ver pipeline_sensores.h).
+ */
+typedef struct {
+    TipoMovimento movimento; ///< Tipo de movimento perigoso
+    LadoCorpo lado;          ///< Lado do corpo
+    float angulo_max;        ///< Maior ângulo atingido (graus)
+    int64_t duracao_ms;      ///< Duração do evento (ms)
+    uint32_t fim_ms;         ///< Instante do encerramento (ms desde o boot; convertido em data/hora na gravação)
+} RegistroEvento;
+
+// ----------------------------------------------------------------------
+// Estrutura: AmostraPostura
+// ----------------------------------------------------------------------
+/**
+ * @brief Amostra periódica dos ângulos articulares, para o histórico no SDCard.
+ *
+ * Montada no núcleo 0 a partir do quadro de amostras anotado no núcleo 1
+ * (ver pipeline_publicar_quadro) e guardada por valor na faixa do
+ * armazenamento, que a grava em lote e com prioridade baixa (ver armazenamento.h).
+ */
+typedef struct {
+    uint32_t instante_ms;    ///< Instante da amostra (ms desde o boot)
+    float flexao;            ///< Flexão (graus)
+    float abducao;           ///< Abdução (graus)
+    float rotacao;           ///< Rotação (graus)
+    float incerteza;         ///< Incerteza dos ângulos (graus)
+} AmostraPostura;
+
 #endif // ESTRUTURA_DADOS_HPP_
\ No newline at end of file
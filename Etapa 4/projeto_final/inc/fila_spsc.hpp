@@ -0,0 +1,242 @@
+// ======================================================================
+//  Arquivo: fila_spsc.hpp
+//  Descrição: Fila circular sem trava de um produtor e um consumidor
+//             (somente cabeçalho), entre núcleos ou entre IRQ e laço
+// ======================================================================
+
+#ifndef FILA_SPSC_HPP_
+#define FILA_SPSC_HPP_
+
+#include <atomic>      // std::atomic com ordens acquire/release
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t
+#include <type_traits> // std::is_trivially_copyable
+
+// Separação dos índices: no RP2040 não há cache (basta a palavra); no host
+// a linha de cache evita que produtor e consumidor disputem a mesma linha
+#if defined(__ARM_ARCH_6M__)
+#define FILA_SPSC_ALINHAMENTO 4
+#else
+#define FILA_SPSC_ALINHAMENTO 64
+#endif
+
+// ----------------------------------------------------------------------
+// Classe: FilaSpsc
+// ----------------------------------------------------------------------
+/**
+ * @brief Fila circular de capacidade fixa (potência de 2) para exatamente um
+ *        produtor e um consumidor.
+ *
+ * Cada índice tem um único escritor: o produtor só escreve cabeca e o
+ * consumidor só escreve cauda, então bastam leituras e escritas atômicas de
+ * 32 bits, que o GCC gera em linha no Cortex-M0+ (ldr/str e dmb). Operações
+ * de leitura-modificação-escrita (fetch_add, CAS) não são usadas: o M0+ não
+ * as tem e elas virariam chamadas com trava.
+ *
+ * A escrita do índice é release e a leitura do índice do outro lado é acquire:
+ * os dados do elemento ficam visíveis antes do índice que o publica. Isso vale
+ * entre os dois núcleos do RP2040 (SRAM sem cache; a barreira dmb ordena os
+ * acessos) e entre uma IRQ e o laço no mesmo núcleo (a ordem impede o
+ * compilador de reordenar).
+ *
+ * Os índices correm livres e só são mascarados no acesso ao buffer: cheia
+ * quando cabeca - cauda == N, vazia quando são iguais, sem elemento reservado.
+ * Cada lado guarda uma cópia do índice do outro e só o relê quando a cópia
+ * indica fila cheia (produtor) ou vazia (consumidor). As operações em lote
+ * publicam vários elementos com uma única escrita de índice.
+ *
+ * Nenhuma operação espera: com a fila cheia ou vazia elas retornam false ou 0.
+ *
+ * @tparam T Tipo do elemento (copiado por valor; trivialmente copiável)
+ * @tparam N Capacidade (potência de 2)
+ */
+template <typename T, size_t N>
+class FilaSpsc
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "FilaSpsc: a capacidade deve ser potência de 2");
+    static_assert(N <= (1u << 31), "FilaSpsc: a capacidade deve caber nos índices de 32 bits");
+    static_assert(std::is_trivially_copyable<T>::value, "FilaSpsc: o elemento é copiado por valor");
+
+public:
+    /**
+     * @brief Fila vazia com os índices em indice_inicial (normalmente 0).
+     *
+     * Um valor perto de UINT32_MAX serve só para testar no host a volta dos
+     * índices de 32 bits, que no firmware levaria anos de operação.
+     */
+    constexpr explicit FilaSpsc(uint32_t indice_inicial = 0)
+        : cabeca_{indice_inicial}, cauda_produtor_{indice_inicial},
+          cauda_{indice_inicial}, cabeca_consumidor_{indice_inicial}
+    {
+    }
+
+    /** @brief Capacidade da fila (elementos). */
+    static constexpr size_t capacidade() { return N; }
+
+    //-------------------------------------------------------------------
+    // Produtor
+    //-------------------------------------------------------------------
+
+    /**
+     * @brief Insere um elemento (apenas o produtor).
+     * @param item Elemento a copiar
+     * @return false se a fila estiver cheia
+     */
+    bool inserir(const T& item)
+    {
+        const uint32_t cabeca = cabeca_.load(std::memory_order_relaxed);
+        if (cabeca - cauda_produtor_ == N)
+        {
+            cauda_produtor_ = cauda_.load(std::memory_order_acquire);
+            if (cabeca - cauda_produtor_ == N)
+            {
+                return false;
+            }
+        }
+        buffer_[cabeca & MASCARA] = item;
+        cabeca_.store(cabeca + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Insere até n elementos com uma única publicação (apenas o produtor).
+     * @param itens Elementos a copiar, em ordem
+     * @param n Quantidade oferecida
+     * @return Quantidade inserida (menor que n se a fila encher)
+     */
+    size_t inserirLote(const T* itens, size_t n)
+    {
+        const uint32_t cabeca = cabeca_.load(std::memory_order_relaxed);
+        size_t livres = N - (cabeca - cauda_produtor_);
+        if (livres < n)
+        {
+            cauda_produtor_ = cauda_.load(std::memory_order_acquire);
+            livres = N - (cabeca - cauda_produtor_);
+        }
+        if (n > livres)
+        {
+            n = livres;
+        }
+        for (size_t k = 0; k < n; k++)
+        {
+            buffer_[(cabeca + k) & MASCARA] = itens[k];
+        }
+        if (n > 0)
+        {
+            cabeca_.store(cabeca + (uint32_t)n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    //-------------------------------------------------------------------
+    // Consumidor
+    //-------------------------------------------------------------------
+
+    /**
+     * @brief Remove o elemento mais antigo (apenas o consumidor).
+     * @param item Recebe o elemento removido
+     * @return false se a fila estiver vazia
+     */
+    bool remover(T& item)
+    {
+        const uint32_t cauda = cauda_.load(std::memory_order_relaxed);
+        if (cauda == cabeca_consumidor_)
+        {
+            cabeca_consumidor_ = cabeca_.load(std::memory_order_acquire);
+            if (cauda == cabeca_consumidor_)
+            {
+                return false;
+            }
+        }
+        item = buffer_[cauda & MASCARA];
+        cauda_.store(cauda + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove até max elementos com uma única liberação (apenas o consumidor).
+     * @param destino Recebe os elementos, do mais antigo ao mais novo
+     * @param max Capacidade de destino
+     * @return Quantidade removida (0 se vazia)
+     */
+    size_t removerLote(T* destino, size_t max)
+    {
+        size_t n = espiarLote(destino, max);
+        if (n > 0)
+        {
+            avancar(n);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Copia até max elementos sem removê-los (apenas o consumidor).
+     *
+     * As posições continuam ocupadas até avancar(): o consumidor pode usar os
+     * elementos (uma gravação que pode falhar, por exemplo) e só então liberá-las.
+     *
+     * @param destino Recebe os elementos, do mais antigo ao mais novo
+     * @param max Capacidade de destino
+     * @return Quantidade copiada (0 se vazia)
+     */
+    size_t espiarLote(T* destino, size_t max)
+    {
+        const uint32_t cauda = cauda_.load(std::memory_order_relaxed);
+        size_t disponiveis = cabeca_consumidor_ - cauda;
+        if (disponiveis < max)
+        {
+            cabeca_consumidor_ = cabeca_.load(std::memory_order_acquire);
+            disponiveis = cabeca_consumidor_ - cauda;
+        }
+        if (max > disponiveis)
+        {
+            max = disponiveis;
+        }
+        for (size_t k = 0; k < max; k++)
+        {
+            destino[k] = buffer_[(cauda + k) & MASCARA];
+        }
+        return max;
+    }
+
+    /**
+     * @brief Remove os n elementos mais antigos, já lidos por espiarLote, com
+     *        uma única liberação (apenas o consumidor).
+     * @param n Quantidade a remover (no máximo a devolvida por espiarLote)
+     */
+    void avancar(size_t n)
+    {
+        const uint32_t cauda = cauda_.load(std::memory_order_relaxed);
+        cauda_.store(cauda + (uint32_t)n, std::memory_order_release);
+    }
+
+    //-------------------------------------------------------------------
+    // Consulta (qualquer lado; valor aproximado se o outro lado estiver ativo)
+    //-------------------------------------------------------------------
+
+    /** @brief Quantidade de elementos na fila. */
+    size_t tamanho() const
+    {
+        // Cauda antes da cabeça: as duas só crescem, então o resultado nunca é negativo
+        const uint32_t cauda = cauda_.load(std::memory_order_acquire);
+        return cabeca_.load(std::memory_order_acquire) - cauda;
+    }
+
+    /** @brief true se não há elementos. */
+    bool vazia() const { return tamanho() == 0; }
+
+private:
+    static constexpr uint32_t MASCARA = (uint32_t)(N - 1);
+
+    // Lado do produtor: índice de escrita e última cauda lida
+    alignas(FILA_SPSC_ALINHAMENTO) std::atomic<uint32_t> cabeca_;
+    uint32_t cauda_produtor_;
+
+    // Lado do consumidor: índice de leitura e última cabeça lida
+    alignas(FILA_SPSC_ALINHAMENTO) std::atomic<uint32_t> cauda_;
+    uint32_t cabeca_consumidor_;
+
+    alignas(FILA_SPSC_ALINHAMENTO) T buffer_[N];
+};
+
+#endif // FILA_SPSC_HPP_
@@ -0,0 +1,626 @@
+// ======================================================================
+//  Arquivo: motor_fusao.hpp
+//  Descrição: Motores de fusão sensorial intercambiáveis (Madgwick, Mahony,
+//             complementar, ESKF, articulação) com despacho estático em tempo
+//             de compilação
+// ======================================================================
+
+#ifndef MOTOR_FUSAO_HPP_
+#define MOTOR_FUSAO_HPP_
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <cmath>   // std::sqrt, std::cos, std::sin
+#include "quaternion.hpp" // QuaternionUnitario
+
+// Drivers dos filtros escritos em C
+extern "C" {
+    #include "algoritmo_postura.h" // quaternion_from_accel_mag
+    #include "MadgwickAHRS.h"      // Filtro de Madgwick (versão em lote)
+    #include "mahony.h"            // Filtro de Mahony
+    #include "complementar.h"      // Filtro complementar
+    #include "eskf.h"              // Filtro de Kalman de estado de erro
+    #include "articulacao.h"       // Fusão direta da orientação relativa
+    #include "ganho_adaptativo.h"  // Ganho adaptado à intensidade do movimento
+}
+
+// ----------------------------------------------------------------------
+// Constantes e tipos comuns
+// ----------------------------------------------------------------------
+
+/// Número de sensores fundidos por motor (índice 0 = tronco, 1 = coxa)
+constexpr size_t NUM_SENSORES_FUSAO = 2;
+
+/**
+ * @brief Amostra de um sensor inercial entregue ao motor de fusão.
+ *        Magnetômetro zerado desabilita a correção de rumo.
+ */
+struct AmostraImu {
+    float accel[3]; ///< Aceleração (g)
+    float gyro[3];  ///< Velocidade angular (rad/s)
+    float mag[3];   ///< Campo magnético (uT)
+};
+
+// ----------------------------------------------------------------------
+// Interface: MotorFusao (CRTP)
+// ----------------------------------------------------------------------
+/**
+ * @brief Interface comum dos motores de fusão.
+ *
+ * Cada motor deriva de MotorFusao<Motor> e implementa iniciarImpl(),
+ * atualizarImpl(), orientacaoImpl(), incertezaImpl(), definirOrientacaoImpl(),
+ * girarRumoImpl() e definirEscalaGanhoImpl(). As chamadas são resolvidas em tempo de
+ * compilação (sem tabela virtual) e podem ser inlinadas em getPosition().
+ *
+ * @tparam Motor Classe concreta do motor
+ */
+template <typename Motor>
+class MotorFusao
+{
+public:
+    /**
+     * @brief Inicializa o estado de todos os sensores (orientação identidade).
+     * @param frequencia_hz Frequência nominal de amostragem
+     */
+    void iniciar(float frequencia_hz) { motor().iniciarImpl(frequencia_hz); }
+
+    /**
+     * @brief Atualiza a orientação de todos os sensores com uma amostra de cada.
+     * @param amostras Uma amostra por sensor
+     * @param dt Intervalo de integração (s)
+     */
+    void atualizar(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO], float dt) { motor().atualizarImpl(amostras, dt); }
+
+    /**
+     * @brief Orientação atual de um sensor (sensor -> Terra).
+     *
+     * Cada motor decide se a norma do seu estado já é confiável ou se precisa
+     * de uma normalização; quem consome o resultado não renormaliza.
+     * @param sensor Índice do sensor
+     */
+    QuaternionUnitario orientacao(size_t sensor) const { return motor().orientacaoImpl(sensor); }
+
+    /**
+     * @brief Desvio padrão estimado do erro de atitude de um sensor (rad).
+     *        Motores sem covariância (Madgwick, Mahony, complementar) retornam 0.
+     * @param sensor Índice do sensor
+     */
+    float incerteza(size_t sensor) const { return motor().incertezaImpl(sensor); }
+
+    /**
+     * @brief Define a orientação de cada sensor diretamente da primeira amostra
+     *        (acelerômetro + magnetômetro), em vez de partir da identidade.
+     * @param amostras Uma amostra por sensor, com o paciente parado
+     */
+    void alinharInicial(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO])
+    {
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            // Base ortonormal convertida por Shepperd: já unitário
+            motor().definirOrientacaoImpl(i, QuaternionUnitario::confiarUnitario(quaternion_from_accel_mag(amostras[i].accel, amostras[i].mag)));
+        }
+    }
+
+    /**
+     * @brief Multiplica os ganhos de correção nominais do motor (1 = nominal).
+     * @param escala Fator aplicado sobre os ganhos definidos em iniciar()
+     */
+    void definirEscalaGanho(float escala) { motor().definirEscalaGanhoImpl(escala); }
+
+    /**
+     * @brief Gira a orientação de um sensor em torno da vertical da Terra.
+     *
+     * Só o rumo muda: a inclinação e o restante do estado (bias, covariância)
+     * são mantidos. Usado pela restrição de rumo articular (restricao_rumo.h).
+     * @param sensor Índice do sensor
+     * @param angulo Rotação em torno de +Z da Terra (rad)
+     */
+    void girarRumo(size_t sensor, float angulo)
+    {
+        float meio = 0.5f * angulo;
+        motor().girarRumoImpl(sensor, QuaternionUnitario::confiarUnitario(QuaternionLivre{ std::cos(meio), 0.0f, 0.0f, std::sin(meio) }));
+    }
+
+private:
+    Motor& motor() { return static_cast<Motor&>(*this); }
+    const Motor& motor() const { return static_cast<const Motor&>(*this); }
+};
+
+// ----------------------------------------------------------------------
+// Motor: Madgwick (gradiente descendente, atualização em lote, ganho
+// adaptado por sensor à intensidade do movimento)
+// ----------------------------------------------------------------------
+class MotorMadgwick : public MotorFusao<MotorMadgwick>
+{
+    friend class MotorFusao<MotorMadgwick>;
+
+    AHRS_batch_t lote;    ///< Estado de todos os sensores em estrutura de arrays
+    float beta_nominal;   ///< Ganho definido na inicialização
+    float beta_escalado;  ///< Ganho nominal multiplicado pela escala atual (aquecimento)
+    ganho_adaptativo_t adaptativo[NUM_SENSORES_FUSAO]; ///< Adaptação do ganho por sensor
+
+    void iniciarImpl(float frequencia_hz)
+    {
+        MadgwickAHRSbatchInit(&lote, NUM_SENSORES_FUSAO, frequencia_hz);
+        beta_nominal = lote.beta[0];
+        beta_escalado = beta_nominal;
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            ganho_adaptativo_iniciar(&adaptativo[i], frequencia_hz);
+        }
+    }
+
+    void atualizarImpl(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO], float dt)
+    {
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            lote.ax[i] = amostras[i].accel[0];
+            lote.ay[i] = amostras[i].accel[1];
+            lote.az[i] = amostras[i].accel[2];
+            lote.gx[i] = amostras[i].gyro[0];
+            lote.gy[i] = amostras[i].gyro[1];
+            lote.gz[i] = amostras[i].gyro[2];
+#ifndef SEM_MAGNETOMETRO
+            lote.mx[i] = amostras[i].mag[0];
+            lote.my[i] = amostras[i].mag[1];
+            lote.mz[i] = amostras[i].mag[2];
+#endif
+            float beta = beta_escalado * ganho_adaptativo_fator(&adaptativo[i], amostras[i].accel, amostras[i].gyro);
+            lote.beta[i] = (beta > GANHO_BETA_MAXIMO) ? GANHO_BETA_MAXIMO : beta;
+        }
+        lote.delta_t = dt;
+#ifdef SEM_MAGNETOMETRO
+        // Sem magnetômetro: ramo só com a gravidade (3 resíduos em vez de 6, sem
+        // a referência magnética), em vez de zerar os resíduos magnéticos do ramo completo
+        MadgwickAHRSbatchUpdateIMU(&lote);
+#else
+        MadgwickAHRSbatchUpdate(&lote);
+#endif
+    }
+
+    // A normalização do filtro usa a raiz inversa rápida (erro de norma de até
+    // ~0,2%), então a orientação é normalizada uma vez aqui, por consulta
+    QuaternionUnitario orientacaoImpl(size_t sensor) const
+    {
+        return QuaternionUnitario::normalizar({ lote.q0[sensor], lote.q1[sensor], lote.q2[sensor], lote.q3[sensor] });
+    }
+
+    float incertezaImpl(size_t) const { return 0.0f; }
+
+    void definirOrientacaoImpl(size_t sensor, const QuaternionUnitario& q)
+    {
+        lote.q0[sensor] = q.w();
+        lote.q1[sensor] = q.x();
+        lote.q2[sensor] = q.y();
+        lote.q3[sensor] = q.z();
+    }
+
+    void girarRumoImpl(size_t sensor, const QuaternionUnitario& giro)
+    {
+        definirOrientacaoImpl(sensor, giro * orientacaoImpl(sensor));
+    }
+
+    void definirEscalaGanhoImpl(float escala)
+    {
+        beta_escalado = beta_nominal * escala;
+    }
+};
+
+// ----------------------------------------------------------------------
+// Motor: Mahony (complementar não linear com realimentação PI)
+// ----------------------------------------------------------------------
+class MotorMahony : public MotorFusao<MotorMahony>
+{
+    friend class MotorFusao<MotorMahony>;
+
+    mahony_t filtros[NUM_SENSORES_FUSAO]; ///< Estado de cada sensor
+
+    void iniciarImpl(float)
+    {
+        for (auto& filtro : filtros)
+        {
+            mahony_iniciar(&filtro);
+        }
+    }
+
+    void atualizarImpl(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO], float dt)
+    {
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            mahony_atualizar(&filtros[i], amostras[i].gyro, amostras[i].accel, amostras[i].mag, dt);
+        }
+    }
+
+    QuaternionUnitario orientacaoImpl(size_t sensor) const
+    {
+        const mahony_t& f = filtros[sensor];
+        return QuaternionUnitario::confiarUnitario(QuaternionLivre{ f.q0, f.q1, f.q2, f.q3 }); // Normalizado com sqrtf pelo filtro
+    }
+
+    float incertezaImpl(size_t) const { return 0.0f; }
+
+    void definirOrientacaoImpl(size_t sensor, const QuaternionUnitario& q)
+    {
+        mahony_t& f = filtros[sensor];
+        f.q0 = q.w(); f.q1 = q.x(); f.q2 = q.y(); f.q3 = q.z();
+    }
+
+    void girarRumoImpl(size_t sensor, const QuaternionUnitario& giro)
+    {
+        definirOrientacaoImpl(sensor, giro * orientacaoImpl(sensor));
+    }
+
+    void definirEscalaGanhoImpl(float escala)
+    {
+        for (auto& filtro : filtros)
+        {
+            filtro.kp = MAHONY_KP_PADRAO * escala;
+        }
+    }
+};
+
+// ----------------------------------------------------------------------
+// Motor: Complementar (giroscópio + correções desacopladas de inclinação e rumo)
+// ----------------------------------------------------------------------
+class MotorComplementar : public MotorFusao<MotorComplementar>
+{
+    friend class MotorFusao<MotorComplementar>;
+
+    complementar_t filtros[NUM_SENSORES_FUSAO]; ///< Estado de cada sensor
+
+    void iniciarImpl(float)
+    {
+        for (auto& filtro : filtros)
+        {
+            complementar_iniciar(&filtro);
+        }
+    }
+
+    void atualizarImpl(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO], float dt)
+    {
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            complementar_atualizar(&filtros[i], amostras[i].gyro, amostras[i].accel, amostras[i].mag, dt);
+        }
+    }
+
+    QuaternionUnitario orientacaoImpl(size_t sensor) const
+    {
+        const complementar_t& f = filtros[sensor];
+        return QuaternionUnitario::confiarUnitario(QuaternionLivre{ f.q0, f.q1, f.q2, f.q3 }); // Normalizado com sqrtf pelo filtro
+    }
+
+    float incertezaImpl(size_t) const { return 0.0f; }
+
+    void definirOrientacaoImpl(size_t sensor, const QuaternionUnitario& q)
+    {
+        complementar_t& f = filtros[sensor];
+        f.q0 = q.w(); f.q1 = q.x(); f.q2 = q.y(); f.q3 = q.z();
+    }
+
+    void girarRumoImpl(size_t sensor, const QuaternionUnitario& giro)
+    {
+        definirOrientacaoImpl(sensor, giro * orientacaoImpl(sensor));
+    }
+
+    void definirEscalaGanhoImpl(float escala)
+    {
+        for (auto& filtro : filtros)
+        {
+            filtro.ganho_acel = COMPLEMENTAR_GANHO_ACEL_PADRAO * escala;
+            filtro.ganho_mag = COMPLEMENTAR_GANHO_MAG_PADRAO * escala;
+        }
+    }
+};
+
+// ----------------------------------------------------------------------
+// Motor: ESKF (Kalman de estado de erro: orientação + bias do giroscópio)
+// ----------------------------------------------------------------------
+class MotorEskf : public MotorFusao<MotorEskf>
+{
+    friend class MotorFusao<MotorEskf>;
+
+    eskf_t filtros[NUM_SENSORES_FUSAO]; ///< Estado de cada sensor
+
+    void iniciarImpl(float)
+    {
+        for (auto& filtro : filtros)
+        {
+            eskf_iniciar(&filtro);
+        }
+    }
+
+    void atualizarImpl(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO], float dt)
+    {
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            eskf_atualizar(&filtros[i], amostras[i].gyro, amostras[i].accel, amostras[i].mag, dt);
+        }
+    }
+
+    QuaternionUnitario orientacaoImpl(size_t sensor) const
+    {
+        const eskf_t& f = filtros[sensor];
+        return QuaternionUnitario::confiarUnitario(QuaternionLivre{ f.q0, f.q1, f.q2, f.q3 }); // Normalizado com sqrtf pelo filtro
+    }
+
+    float incertezaImpl(size_t sensor) const
+    {
+        return std::sqrt(eskf_variancia_atitude(&filtros[sensor]));
+    }
+
+    void definirOrientacaoImpl(size_t sensor, const QuaternionUnitario& q)
+    {
+        eskf_definir_orientacao(&filtros[sensor], q.w(), q.x(), q.y(), q.z());
+    }
+
+    // Gira só o estado nominal: definirOrientacaoImpl() reiniciaria a covariância
+    void girarRumoImpl(size_t sensor, const QuaternionUnitario& giro)
+    {
+        QuaternionUnitario q = giro * orientacaoImpl(sensor);
+        eskf_t& f = filtros[sensor];
+        f.q0 = q.w(); f.q1 = q.x(); f.q2 = q.y(); f.q3 = q.z();
+    }
+
+    // O ganho do ESKF vem da covariância: a incerteza inicial já acelera a
+    // convergência, e escalar os ruídos tornaria a covariância inconsistente
+    void definirEscalaGanhoImpl(float) {}
+};
+
+// ----------------------------------------------------------------------
+// Motor: Articulação (orientação relativa tronco -> coxa estimada diretamente)
+// ----------------------------------------------------------------------
+/**
+ * Em vez de dois filtros absolutos, estima só R = q_tronco⁻¹ ⊗ q_coxa pela
+ * diferença dos giroscópios e pelas duas medidas da gravidade (ver articulacao.h).
+ * Distúrbios magnéticos locais não entram como rotação falsa, e os
+ * magnetômetros podem ser dispensados (opção SEM_MAGNETOMETRO).
+ *
+ * Para manter a interface dos demais motores, o tronco é reportado com a
+ * inclinação da sua gravidade filtrada (rumo arbitrário) e a coxa como essa
+ * referência composta com R: o quaternion relativo calculado em getPosition()
+ * é exatamente R, e o monitor de convergência compara a gravidade medida pela
+ * coxa com a do tronco levada por R.
+ *
+ * A gravidade do tronco é propagada pelo giroscópio do tronco e puxada para o
+ * acelerômetro só quando ele mede essencialmente a gravidade (mesmo critério de
+ * articulacao.c), com constante de tempo CONSTANTE_GRAVIDADE_S: uma amostra
+ * ruidosa ou com aceleração linear não move a referência. A referência é
+ * calculada uma vez por atualização e as consultas devolvem o valor guardado.
+ */
+class MotorArticulacao : public MotorFusao<MotorArticulacao>
+{
+    friend class MotorFusao<MotorArticulacao>;
+
+    static constexpr float CONSTANTE_GRAVIDADE_S = 0.5f; ///< Constante de tempo do passa-baixa da gravidade do tronco (s)
+
+    articulacao_t filtro;                            ///< Estado da fusão relativa
+    float gravidade_tronco[3] = {0.0f, 0.0f, 1.0f};  ///< Vertical da Terra no referencial do tronco, filtrada
+    QuaternionUnitario referencia;                   ///< Inclinação do tronco (rumo arbitrário), recalculada por atualização
+    QuaternionUnitario absoluta[NUM_SENSORES_FUSAO];  ///< Orientações iniciais (alinharInicial), identidade por padrão
+
+    void iniciarImpl(float)
+    {
+        articulacao_iniciar(&filtro);
+        gravidade_tronco[0] = 0.0f;
+        gravidade_tronco[1] = 0.0f;
+        gravidade_tronco[2] = 1.0f;
+        referencia = QuaternionUnitario();
+    }
+
+    void atualizarImpl(const AmostraImu (&amostras)[NUM_SENSORES_FUSAO], float dt)
+    {
+        const AmostraImu& tronco = amostras[0];
+        const AmostraImu& coxa = amostras[1];
+        articulacao_atualizar(&filtro, tronco.gyro, tronco.accel, tronco.mag, coxa.gyro, coxa.accel, coxa.mag, dt);
+        filtrarGravidade(tronco, dt);
+    }
+
+    // Propaga a vertical pelo giroscópio (um vetor fixo na Terra gira com -ω no
+    // referencial do sensor: ġ = g × ω) e a corrige pelo acelerômetro quando ele
+    // mede a gravidade; a referência é recalculada uma vez aqui, não por consulta
+    void filtrarGravidade(const AmostraImu& tronco, float dt)
+    {
+        float* g = gravidade_tronco;
+        const float* w = tronco.gyro;
+        float propagada[3] = {
+            g[0] + dt * (g[1] * w[2] - g[2] * w[1]),
+            g[1] + dt * (g[2] * w[0] - g[0] * w[2]),
+            g[2] + dt * (g[0] * w[1] - g[1] * w[0]),
+        };
+
+        const float* a = tronco.accel;
+        float desvio = a[0] * a[0] + a[1] * a[1] + a[2] * a[2] - 1.0f;
+        float alfa = (desvio < ARTICULACAO_DESVIO_ACEL2_MAXIMO && desvio > -ARTICULACAO_DESVIO_ACEL2_MAXIMO)
+                         ? dt / (CONSTANTE_GRAVIDADE_S + dt)
+                         : 0.0f;
+        for (size_t i = 0; i < 3; i++)
+        {
+            g[i] = propagada[i] + alfa * (a[i] - propagada[i]);
+        }
+        recalcularReferencia();
+    }
+
+    void recalcularReferencia()
+    {
+        static const float SEM_MAG[3] = {0.0f, 0.0f, 0.0f};
+        referencia = QuaternionUnitario::confiarUnitario(quaternion_from_accel_mag(gravidade_tronco, SEM_MAG));
+    }
+
+    QuaternionUnitario orientacaoImpl(size_t sensor) const
+    {
+        if (sensor == 0)
+        {
+            return referencia;
+        }
+        return referencia * QuaternionUnitario::confiarUnitario(QuaternionLivre{ filtro.q0, filtro.q1, filtro.q2, filtro.q3 });
+    }
+
+    float incertezaImpl(size_t) const { return 0.0f; }
+
+    // A orientação relativa inicial vem das orientações absolutas dos dois
+    // sensores; a do tronco também dá a vertical inicial do seu filtro (terceira
+    // linha da matriz de rotação), para não partir de +Z
+    void definirOrientacaoImpl(size_t sensor, const QuaternionUnitario& q)
+    {
+        absoluta[sensor] = q;
+        QuaternionUnitario r = relativo(absoluta[0], absoluta[1]);
+        filtro.q0 = r.w(); filtro.q1 = r.x(); filtro.q2 = r.y(); filtro.q3 = r.z();
+        if (sensor == 0)
+        {
+            gravidade_tronco[0] = 2.0f * (q.x() * q.z() - q.w() * q.y());
+            gravidade_tronco[1] = 2.0f * (q.w() * q.x() + q.y() * q.z());
+            gravidade_tronco[2] = q.w() * q.w() - q.x() * q.x() - q.y() * q.y() + q.z() * q.z();
+            recalcularReferencia();
+        }
+    }
+
+    // A coxa é reportada como referencia ⊗ R: girá-la em torno da vertical da
+    // Terra equivale a R' = referencia⁻¹ ⊗ giro ⊗ referencia ⊗ R. O tronco é a
+    // própria referência, de rumo arbitrário: girá-lo não muda nada.
+    void girarRumoImpl(size_t sensor, const QuaternionUnitario& giro)
+    {
+        if (sensor == 0)
+        {
+            return;
+        }
+        QuaternionUnitario r = orientacaoImpl(0).inverso() * giro * orientacaoImpl(1);
+        filtro.q0 = r.w(); filtro.q1 = r.x(); filtro.q2 = r.y(); filtro.q3 = r.z();
+    }
+
+    void definirEscalaGanhoImpl(float escala)
+    {
+        filtro.kp = ARTICULACAO_KP_PADRAO * escala;
+        filtro.kp_mag = ARTICULACAO_KP_MAG_PADRAO * escala;
+    }
+};
+
+// ----------------------------------------------------------------------
+// Classe: MonitorConvergencia
+// ----------------------------------------------------------------------
+/**
+ * @brief Decide quando a estimativa de orientação convergiu após o boot.
+ *
+ * Métrica: seno² do ângulo entre a gravidade medida (acelerômetro) e a prevista
+ * pelo quaternion de cada sensor, |â × v|², filtrada por um passa-baixa de
+ * primeira ordem. Só amostras quase estáticas (|a| perto de 1 g e giro lento)
+ * contam: em movimento o acelerômetro não mede só a gravidade e a métrica
+ * concordaria com uma estimativa errada. Converge quando o valor filtrado de todos
+ * os sensores fica abaixo de sen²(2°) após AMOSTRAS_MINIMAS amostras quase
+ * estáticas consecutivas; uma vez convergido, permanece.
+ * Usa apenas normas ao quadrado e comparações (sem raiz nem trigonometria).
+ */
+class MonitorConvergencia
+{
+public:
+    static constexpr float LIMIAR_SEN2 = 0.00122f;   ///< sen²(2°): erro de inclinação aceito
+    static constexpr float ALFA_FILTRO = 0.2f;       ///< Coeficiente do passa-baixa
+    static constexpr uint32_t AMOSTRAS_MINIMAS = 10; ///< Amostras quase estáticas consecutivas exigidas
+    static constexpr float DESVIO_ACEL2_MAXIMO = 0.1f; ///< |‖a‖² - 1| máximo (g²), cerca de 5% da norma
+    static constexpr float GIRO2_MAXIMO = 0.12f;     ///< ‖ω‖² máximo ((rad/s)²), cerca de 20°/s
+
+    /** @brief Reinicia o monitor (nova fase de aquecimento). */
+    void reiniciar()
+    {
+        amostras = 0;
+        convergiu = false;
+    }
+
+    /**
+     * @brief Atualiza a métrica com a orientação atual do motor e a amostra usada.
+     * @param motor Motor de fusão já atualizado com as amostras
+     * @param amostras_sensores Amostra de cada sensor
+     * @return true se a estimativa convergiu
+     */
+    template <typename Motor>
+    bool atualizar(const MotorFusao<Motor>& motor, const AmostraImu (&amostras_sensores)[NUM_SENSORES_FUSAO])
+    {
+        if (convergiu)
+        {
+            return true;
+        }
+
+        // Descarta a janela se algum sensor estiver em movimento
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            if (!quaseEstatico(amostras_sensores[i]))
+            {
+                amostras = 0;
+                return false;
+            }
+        }
+
+        bool todos_abaixo = true;
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            float erro = erroInclinacaoSen2(motor.orientacao(i), amostras_sensores[i].accel);
+
+            // Primeira amostra inicializa o filtro com o próprio valor
+            erro_filtrado[i] = (amostras == 0) ? erro : erro_filtrado[i] + ALFA_FILTRO * (erro - erro_filtrado[i]);
+            todos_abaixo = todos_abaixo && (erro_filtrado[i] < LIMIAR_SEN2);
+        }
+        amostras++;
+
+        convergiu = todos_abaixo && (amostras >= AMOSTRAS_MINIMAS);
+        return convergiu;
+    }
+
+    /** @brief true após a convergência. */
+    bool convergido() const { return convergiu; }
+
+    /** @brief Erro de inclinação filtrado de um sensor, como seno² do ângulo. */
+    float erroFiltrado(size_t sensor) const { return erro_filtrado[sensor]; }
+
+    /** @brief Aceleração perto de 1 g e velocidade angular baixa. */
+    static bool quaseEstatico(const AmostraImu& amostra)
+    {
+        const float* a = amostra.accel;
+        const float* g = amostra.gyro;
+        float desvio = a[0] * a[0] + a[1] * a[1] + a[2] * a[2] - 1.0f;
+        float giro2 = g[0] * g[0] + g[1] * g[1] + g[2] * g[2];
+        return (desvio < DESVIO_ACEL2_MAXIMO) && (desvio > -DESVIO_ACEL2_MAXIMO) && (giro2 < GIRO2_MAXIMO);
+    }
+
+private:
+    float erro_filtrado[NUM_SENSORES_FUSAO] = {}; ///< sen² do erro de inclinação, filtrado
+    uint32_t amostras = 0;                        ///< Amostras quase estáticas consecutivas
+    bool convergiu = false;                       ///< Convergência atingida
+
+    // sen² do ângulo entre a aceleração medida e a gravidade prevista por q (sensor -> Terra)
+    static float erroInclinacaoSen2(const QuaternionUnitario& q, const float accel[3])
+    {
+        // Gravidade prevista no referencial do sensor: terceira linha da matriz de rotação
+        float vx = 2.0f * (q.x() * q.z() - q.w() * q.y());
+        float vy = 2.0f * (q.w() * q.x() + q.y() * q.z());
+        float vz = q.w() * q.w() - q.x() * q.x() - q.y() * q.y() + q.z() * q.z();
+
+        float cx = accel[1] * vz - accel[2] * vy;
+        float cy = accel[2] * vx - accel[0] * vz;
+        float cz = accel[0] * vy - accel[1] * vx;
+        float norma2 = accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2];
+        if (norma2 <= 0.0f)
+        {
+            return 1.0f; // Sem medida: não permite convergir
+        }
+        return (cx * cx + cy * cy + cz * cz) / norma2;
+    }
+};
+
+// ----------------------------------------------------------------------
+// Seleção do motor em tempo de compilação (opção MOTOR_FUSAO do CMake)
+// ----------------------------------------------------------------------
+#if defined(MOTOR_FUSAO_MAHONY)
+using MotorFusaoSelecionado = MotorMahony;
+#elif defined(MOTOR_FUSAO_COMPLEMENTAR)
+using MotorFusaoSelecionado = MotorComplementar;
+#elif defined(MOTOR_FUSAO_ESKF)
+using MotorFusaoSelecionado = MotorEskf;
+#elif defined(MOTOR_FUSAO_ARTICULACAO)
+using MotorFusaoSelecionado = MotorArticulacao;
+#elif defined(MOTOR_FUSAO_MADGWICK)
+using MotorFusaoSelecionado = MotorMadgwick;
+#else
+#error "MOTOR_FUSAO desconhecido: use MADGWICK, MAHONY, COMPLEMENTAR, ESKF ou ARTICULACAO"
+#endif
+
+#endif // MOTOR_FUSAO_HPP_
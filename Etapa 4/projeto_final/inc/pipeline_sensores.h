@@ -0,0 +1,164 @@
+// ======================================================================
+//  Arquivo: pipeline_sensores.h
+//  Descrição: Divisão do sistema entre os dois núcleos do RP2040:
+//             tempo real (sensores, fusão, detecção, alarme) no núcleo 1,
+//             E/S (SDCard, logs, botões) no núcleo 0
+// ======================================================================
+
+#ifndef PIPELINE_SENSORES_H_
+#define PIPELINE_SENSORES_H_
+
+#include <cstdint>                  // Tipos inteiros padrão
+#include "estruturas_de_dados.hpp" // RegistroEvento
+#include "mpu9250_i2c.h"           // Interface do sensor MPU9250
+
+// ----------------------------------------------------------------------
+// Parâmetros do pipeline
+// ----------------------------------------------------------------------
+#define PIPELINE_PERIODO_LEITURA_US 10000 ///< Leitura da FIFO no núcleo 1 a cada 10ms (~5 amostras; a FIFO comporta 84ms)
+#define PIPELINE_ORCAMENTO_PERCENTUAL 70  ///< Trabalho por período (% do período) acima do qual os logs detalhados são pulados
+#define PIPELINE_INTERVALO_RELATORIO_MS 5000 ///< Intervalo mínimo entre relatórios de atraso/estouro no núcleo 0
+#define PIPELINE_PRAZO_NUCLEO1_MS 200     ///< Supervisor: intervalo máximo entre períodos do laço do núcleo 1
+#define PIPELINE_PRAZO_SENSORES_MS 500    ///< Supervisor: intervalo máximo sem amostras novas dos sensores
+#define PIPELINE_CAPACIDADE_REGISTROS 16  ///< Registros (eventos encerrados) pendentes de gravação no SDCard (potência de 2)
+#define PIPELINE_CAPACIDADE_AMOSTRAS 8    ///< Quadros com amostras dos ângulos em posse do núcleo 0 (potência de 2)
+#define PIPELINE_CAPACIDADE_LOG 32        ///< Mensagens de log pendentes de impressão (potência de 2)
+#define PIPELINE_CAPACIDADE_COMANDOS 4    ///< Comandos do usuário pendentes para o núcleo 1 (potência de 2)
+#define PIPELINE_TAMANHO_MENSAGEM 96      ///< Tamanho máximo de uma mensagem de log (com o '\0')
+#define PIPELINE_PILHA_NUCLEO1_BYTES 8192 ///< Pilha do núcleo 1 (a padrão do SDK, 2KB, não comporta vsnprintf com float)
+
+// ----------------------------------------------------------------------
+// Enum: ComandoPipeline
+// ----------------------------------------------------------------------
+/**
+ * @brief Comandos da interface (núcleo 0) para o núcleo 1, dono do estado do alarme.
+ */
+enum class ComandoPipeline : uint8_t {
+    ALTERNAR_SILENCIO ///< Botão A: silencia ou desilencia o alarme, se ativo
+};
+
+// ----------------------------------------------------------------------
+// Estrutura: EstatisticasPipeline
+// ----------------------------------------------------------------------
+/**
+ * @brief Contadores do núcleo 1, escritos só por ele e lidos pelo núcleo 0.
+ *
+ * Os de cadência vêm do agendador (drivers/agendador/agendador.h) e os de
+ * captura de captura_sensores.h; ambos são copiados ao fim de cada período.
+ */
+typedef struct {
+    uint32_t periodos;            ///< Períodos executados (uma leitura da FIFO cada)
+    uint32_t periodos_perdidos;   ///< Períodos liberados pelo timer com o laço ainda ocupado
+    uint32_t estouros;            ///< Períodos com trabalho acima do orçamento
+    uint32_t periodos_degradados; ///< Períodos executados sem os logs detalhados
+    uint32_t atraso_maximo_us;    ///< Maior atraso do início de um período em relação ao timer
+    uint32_t atraso_medio_us;     ///< Atraso médio do início dos períodos
+    uint32_t trabalho_maximo_us;  ///< Maior duração de um período
+    uint32_t registros_perdidos;  ///< Eventos encerrados descartados com a fila cheia
+    uint32_t logs_perdidos;       ///< Mensagens de log descartadas com a fila cheia
+    uint32_t amostras_perdidas;   ///< Amostras dos ângulos descartadas com a fila cheia
+    uint32_t recuperacoes_mag;    ///< Sequências de recuperação do magnetômetro saturado iniciadas
+    uint32_t amostras_sem_par;    ///< Amostras sem par descartadas pela fusão (acima das pendentes mantidas)
+
+    // Captura em IRQ (captura_sensores.h), copiados ao fim de cada período
+    uint32_t capturas_adiadas;    ///< Disparos da captura sem quadro livre no pool (amostras esperam no sensor)
+    uint32_t transbordos_fifo;    ///< Transbordos da FIFO de um sensor (amostras sobrescritas)
+    uint32_t falhas_captura;      ///< Capturas abortadas (sensor sem resposta no barramento)
+    uint32_t quadros_alocados;    ///< Quadros de amostras entregues pelo pool da captura
+    uint32_t quadros_devolvidos;  ///< Quadros que voltaram ao pool (todos os estágios os liberaram)
+    uint32_t quadros_maximo_em_uso; ///< Maior número de quadros fora do pool
+} EstatisticasPipeline;
+
+// ----------------------------------------------------------------------
+// Núcleo 0: inicialização e E/S
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Inicia o laço de tempo real no núcleo 1 (fusão, avaliação, alarme e watchdog).
+ *
+ * Registra no supervisor (supervisor.h) as partes "nucleo1" e "sensores"
+ * antes de lançar o núcleo: deve ser chamada depois de supervisor_iniciar.
+ *
+ * Cada período é liberado por um timer de hardware no próprio núcleo 1, a
+ * taxa fixa; acima do orçamento, os estágios de baixa prioridade (logs
+ * detalhados) são pulados até a carga voltar ao normal.
+ *
+ * As amostras são capturadas em IRQ no núcleo 1 (timer e DMA do I2C, ver
+ * captura_sensores.h) e convertidas e fundidas pelo laço, em lotes; os quadros
+ * passam entre os estágios só pelo índice.
+ *
+ * A partir daqui os sensores, o motor de fusão, os eventos ativos e o buzzer
+ * pertencem ao núcleo 1; o núcleo 0 só os acessa pelas filas.
+ *
+ * @param mpu_list Array de 2 sensores MPU9250 (deve permanecer válido)
+ */
+void pipeline_lancar_nucleo1(mpu9250_t mpu_list[2]);
+
+/**
+ * @brief Imprime as mensagens de log vindas do núcleo 1 (em lotes, até esvaziar a fila).
+ * @return true se havia mensagens
+ */
+bool pipeline_servir_logs(void);
+
+/**
+ * @brief Passa os eventos encerrados e as amostras do núcleo 1 para as faixas
+ *        do armazenamento (ver armazenamento.h), sem gravar.
+ *
+ * Eventos só são retirados com espaço na faixa de eventos; sem ele ficam na
+ * fila do núcleo 1, que os descarta e conta apenas quando ela também encher.
+ *
+ * @return true se algo foi encaminhado
+ */
+bool pipeline_encaminhar_armazenamento(void);
+
+/**
+ * @brief Reporta perdas nas filas e estouros de cadência do núcleo 1 desde a última chamada.
+ *
+ * Os relatórios de cadência são limitados a um por PIPELINE_INTERVALO_RELATORIO_MS.
+ */
+void pipeline_reportar(void);
+
+/** @brief Imprime a contabilidade de cadência do núcleo 1 (agendador). */
+void pipeline_imprimir_estatisticas(void);
+
+/**
+ * @brief Envia um comando da interface ao núcleo 1 (sem bloquear).
+ * @param comando Comando do usuário
+ * @return false se a fila de comandos estiver cheia
+ */
+bool pipeline_enviar_comando(ComandoPipeline comando);
+
+/** @brief Retorna uma cópia dos contadores do núcleo 1. */
+EstatisticasPipeline pipeline_estatisticas(void);
+
+// ----------------------------------------------------------------------
+// Núcleo 1: saída para o núcleo 0 (nunca bloqueiam)
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Formata uma mensagem (como printf) e a envia para impressão no núcleo 0.
+ *
+ * O núcleo 1 não chama printf: com USB sem leitor, a saída padrão pode bloquear.
+ * Com a fila cheia a mensagem é descartada e contada em logs_perdidos.
+ */
+void pipeline_log(const char* formato, ...);
+
+/**
+ * @brief Envia ao histórico no SDCard o quadro com os ângulos anotados por getPosition.
+ *
+ * Só o índice segue: o núcleo 0 lê os ângulos do quadro e devolve o índice
+ * por outra fila, e o núcleo 1 libera a referência tomada aqui.
+ *
+ * @param indice Quadro com a orientação anotada (marcado como entregue: não é mais reescrita)
+ * @return false se o núcleo 0 já tem PIPELINE_CAPACIDADE_AMOSTRAS quadros (amostra descartada e contada)
+ */
+bool pipeline_publicar_quadro(uint8_t indice);
+
+/**
+ * @brief Envia um evento encerrado para gravação no SDCard.
+ * @param registro Evento encerrado
+ * @return false se a fila estiver cheia (registro descartado e contado)
+ */
+bool pipeline_publicar_evento(const RegistroEvento& registro);
+
+#endif // PIPELINE_SENSORES_H_
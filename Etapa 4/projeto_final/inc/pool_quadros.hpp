@@ -0,0 +1,122 @@
+// ======================================================================
+//  Arquivo: pool_quadros.hpp
+//  Descrição: Pool de quadros de tamanho fixo com contagem de referências
+//             (somente cabeçalho); os quadros circulam entre estágios por
+//             índice, sem cópia
+// ======================================================================
+
+#ifndef POOL_QUADROS_HPP_
+#define POOL_QUADROS_HPP_
+
+#include <cstddef>         // size_t
+#include <cstdint>         // uint8_t, uint32_t
+#include <type_traits>     // std::is_copy_constructible
+#include "hardware/sync.h" // save_and_disable_interrupts
+
+// ----------------------------------------------------------------------
+// Classe: PoolQuadros
+// ----------------------------------------------------------------------
+/**
+ * @brief Quadros em memória estática, entregues por índice e devolvidos ao
+ *        pool quando o último dono os libera.
+ *
+ * alocar entrega um quadro com uma referência (a do estágio que o preenche).
+ * Cada estágio que passa a guardar o índice chama reter, e cada um que deixa
+ * de usá-lo chama liberar. O quadro volta ao pool quando a contagem zera. O
+ * índice cabe em um byte e é o que atravessa as filas; o quadro nunca é
+ * copiado (T não pode ser copiável).
+ *
+ * As operações mascaram as interrupções do núcleo: valem entre uma IRQ e o
+ * laço do mesmo núcleo. Outro núcleo só pode ler um quadro recebido por uma
+ * fila e deve devolver o índice ao núcleo dono para a liberação (no M0+ não
+ * há operação atômica de leitura-modificação-escrita entre núcleos).
+ *
+ * Os contadores (alocações, falhas, devoluções ao pool, maior ocupação) servem
+ * para dimensionar o pool e para verificar, em teste no host, que todo quadro
+ * alocado volta ao pool.
+ *
+ * @tparam T Tipo do quadro (não copiável)
+ * @tparam N Quantidade de quadros (até 32: um bit por quadro livre)
+ */
+template <typename T, size_t N>
+class PoolQuadros
+{
+    static_assert(N >= 1 && N <= 32, "PoolQuadros: um bit por quadro em uma palavra");
+    static_assert(!std::is_copy_constructible<T>::value, "PoolQuadros: os quadros passam por índice, nunca por cópia");
+
+public:
+    static constexpr uint8_t NENHUM = 0xFF; ///< Índice inválido (pool esgotado, sem quadro)
+
+    /** @brief Quantidade de quadros do pool. */
+    static constexpr size_t capacidade() { return N; }
+
+    /**
+     * @brief Reserva um quadro livre, com uma referência.
+     * @return Índice do quadro, ou NENHUM com o pool esgotado
+     */
+    uint8_t alocar()
+    {
+        uint32_t estado = save_and_disable_interrupts();
+        uint8_t indice = NENHUM;
+        if (livres_ != 0)
+        {
+            indice = (uint8_t)__builtin_ctz(livres_);
+            livres_ &= ~(1u << indice);
+            referencias_[indice] = 1;
+            alocacoes_++;
+            uint32_t em_uso = (uint32_t)N - (uint32_t)__builtin_popcount(livres_);
+            if (em_uso > maximo_em_uso_) maximo_em_uso_ = em_uso;
+        }
+        else
+        {
+            falhas_++;
+        }
+        restore_interrupts(estado);
+        return indice;
+    }
+
+    /** @brief Acrescenta um dono ao quadro (o índice foi guardado por mais um estágio). */
+    void reter(uint8_t indice)
+    {
+        uint32_t estado = save_and_disable_interrupts();
+        referencias_[indice]++;
+        restore_interrupts(estado);
+    }
+
+    /** @brief Remove um dono; o quadro volta ao pool quando não resta nenhum. */
+    void liberar(uint8_t indice)
+    {
+        uint32_t estado = save_and_disable_interrupts();
+        if (--referencias_[indice] == 0)
+        {
+            livres_ |= 1u << indice;
+            devolucoes_++;
+        }
+        restore_interrupts(estado);
+    }
+
+    /** @brief Quadro de um índice entregue por alocar. */
+    T& operator[](uint8_t indice) { return quadros_[indice]; }
+    const T& operator[](uint8_t indice) const { return quadros_[indice]; }
+
+    //-------------------------------------------------------------------
+    // Contadores
+    //-------------------------------------------------------------------
+    uint32_t emUso() const { return (uint32_t)N - (uint32_t)__builtin_popcount(livres_); }
+    uint32_t maximoEmUso() const { return maximo_em_uso_; }
+    uint32_t alocacoes() const { return alocacoes_; }   ///< Quadros entregues por alocar
+    uint32_t devolucoes() const { return devolucoes_; } ///< Quadros que voltaram ao pool
+    uint32_t falhas() const { return falhas_; }         ///< Pedidos com o pool esgotado
+
+private:
+    T quadros_[N];
+    uint8_t referencias_[N] = {};
+    uint32_t livres_ = N == 32 ? 0xFFFFFFFFu : (1u << N) - 1; ///< Bit i = quadro i livre
+
+    uint32_t alocacoes_ = 0;
+    uint32_t devolucoes_ = 0;
+    uint32_t falhas_ = 0;
+    uint32_t maximo_em_uso_ = 0;
+};
+
+#endif // POOL_QUADROS_HPP_
@@ -0,0 +1,218 @@
+// ======================================================================
+//  Arquivo: quaternion.hpp
+//  Descrição: Vetores e quaternions constexpr (somente cabeçalho) com a
+//             normalização registrada no tipo
+// ======================================================================
+
+#ifndef QUATERNION_HPP_
+#define QUATERNION_HPP_
+
+#include <cmath>       // std::sqrt
+#include <type_traits> // std::is_same, std::is_convertible (testes em tempo de compilação)
+
+extern "C" {
+    #include "algoritmo_postura.h" // Estrutura Quaternion (interface com os drivers em C)
+}
+
+// ----------------------------------------------------------------------
+// Estrutura: Vetor3
+// ----------------------------------------------------------------------
+/**
+ * @brief Vetor 3D com as operações usadas pela fusão e pela análise postural.
+ */
+struct Vetor3 {
+    float x; ///< Componente X
+    float y; ///< Componente Y
+    float z; ///< Componente Z
+};
+
+constexpr Vetor3 operator+(const Vetor3& a, const Vetor3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+constexpr Vetor3 operator-(const Vetor3& a, const Vetor3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+constexpr Vetor3 operator*(const Vetor3& v, float k) { return { v.x * k, v.y * k, v.z * k }; }
+constexpr Vetor3 operator*(float k, const Vetor3& v) { return v * k; }
+
+/** @brief Produto escalar a · b. */
+constexpr float produtoEscalar(const Vetor3& a, const Vetor3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+/** @brief Produto vetorial a × b. */
+constexpr Vetor3 produtoVetorial(const Vetor3& a, const Vetor3& b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+// ----------------------------------------------------------------------
+// Estrutura: QuaternionLivre
+// ----------------------------------------------------------------------
+/**
+ * @brief Quaternion sem garantia de norma (w, x, y, z).
+ *
+ * Resultado de somas, integrações ou dados externos. Só vira
+ * QuaternionUnitario por normalizar() (uma raiz e uma divisão) ou por
+ * confiarUnitario(), quando quem produziu o valor já garante a norma.
+ */
+struct QuaternionLivre {
+    float w; ///< Componente escalar
+    float x; ///< Componente X
+    float y; ///< Componente Y
+    float z; ///< Componente Z
+
+    /** @brief Norma ao quadrado. */
+    constexpr float norma2() const { return w * w + x * x + y * y + z * z; }
+
+    /** @brief Conjugado (w, -x, -y, -z). */
+    constexpr QuaternionLivre conjugado() const { return { w, -x, -y, -z }; }
+
+    /** @brief Converte da estrutura Quaternion dos drivers em C. */
+    static constexpr QuaternionLivre deC(const Quaternion& q) { return { q.w, q.x, q.y, q.z }; }
+
+    /** @brief Converte para a estrutura Quaternion dos drivers em C. */
+    constexpr Quaternion paraC() const { return { w, x, y, z }; }
+};
+
+/** @brief Produto de Hamilton a ⊗ b. */
+constexpr QuaternionLivre operator*(const QuaternionLivre& a, const QuaternionLivre& b)
+{
+    return {
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w
+    };
+}
+
+// ----------------------------------------------------------------------
+// Classe: QuaternionUnitario
+// ----------------------------------------------------------------------
+/**
+ * @brief Quaternion de norma unitária (rotação), garantida pelo tipo.
+ *
+ * As operações que preservam a norma (produto entre unitários, inverso,
+ * quaternion relativo) devolvem QuaternionUnitario sem renormalizar: o erro
+ * de arredondamento de cada produto é da ordem de 1e-7, desprezível numa
+ * cadeia curta recalculada a cada avaliação. Assim a raiz quadrada só roda
+ * onde a norma realmente pode ter se desviado (ver normalizar()).
+ */
+class QuaternionUnitario
+{
+public:
+    /** @brief Identidade (sem rotação). */
+    constexpr QuaternionUnitario() : q{ 1.0f, 0.0f, 0.0f, 0.0f } {}
+
+    /**
+     * @brief Normaliza um quaternion qualquer (uma raiz e uma divisão).
+     * @param livre Quaternion de norma qualquer; nulo resulta na identidade
+     */
+    static QuaternionUnitario normalizar(const QuaternionLivre& livre)
+    {
+        float norma2 = livre.norma2();
+        if (norma2 <= 0.0f)
+        {
+            return QuaternionUnitario();
+        }
+        float inv = 1.0f / std::sqrt(norma2);
+        return QuaternionUnitario({ livre.w * inv, livre.x * inv, livre.y * inv, livre.z * inv });
+    }
+
+    /**
+     * @brief Aceita um quaternion já unitário, sem custo.
+     *
+     * Para valores normalizados com raiz exata pelo produtor (filtros em C,
+     * quaternion_from_axes) ou unitários por construção.
+     */
+    static constexpr QuaternionUnitario confiarUnitario(const QuaternionLivre& livre) { return QuaternionUnitario(livre); }
+
+    /** @copydoc confiarUnitario(const QuaternionLivre&) */
+    static constexpr QuaternionUnitario confiarUnitario(const Quaternion& q) { return QuaternionUnitario(QuaternionLivre::deC(q)); }
+
+    constexpr float w() const { return q.w; } ///< Componente escalar
+    constexpr float x() const { return q.x; } ///< Componente X
+    constexpr float y() const { return q.y; } ///< Componente Y
+    constexpr float z() const { return q.z; } ///< Componente Z
+
+    /** @brief Valor sem a garantia de norma (para operações gerais). */
+    constexpr const QuaternionLivre& livre() const { return q; }
+
+    /** @brief Converte para a estrutura Quaternion dos drivers em C. */
+    constexpr Quaternion paraC() const { return q.paraC(); }
+
+    /** @brief Inverso: o conjugado, já que a norma é 1. */
+    constexpr QuaternionUnitario inverso() const { return QuaternionUnitario(q.conjugado()); }
+
+    /**
+     * @brief Rotaciona um vetor: q ⊗ v ⊗ q*.
+     *
+     * Forma expandida v + 2w(u × v) + 2u × (u × v), com u = (x, y, z).
+     */
+    constexpr Vetor3 rotacionar(const Vetor3& v) const
+    {
+        Vetor3 u{ q.x, q.y, q.z };
+        Vetor3 t = produtoVetorial(u, v) * 2.0f;
+        return v + t * q.w + produtoVetorial(u, t);
+    }
+
+    /** @brief Rotação inversa: q* ⊗ v ⊗ q. */
+    constexpr Vetor3 rotacionarInverso(const Vetor3& v) const { return inverso().rotacionar(v); }
+
+private:
+    constexpr explicit QuaternionUnitario(const QuaternionLivre& livre) : q(livre) {}
+
+    QuaternionLivre q; ///< Componentes (norma 1)
+};
+
+/** @brief Produto de unitários: unitário, sem renormalização. */
+constexpr QuaternionUnitario operator*(const QuaternionUnitario& a, const QuaternionUnitario& b)
+{
+    return QuaternionUnitario::confiarUnitario(a.livre() * b.livre());
+}
+
+/**
+ * @brief Quaternion relativo entre dois segmentos: q_tronco⁻¹ ⊗ q_coxa.
+ * @param q_tronco Orientação do segmento proximal
+ * @param q_coxa Orientação do segmento distal
+ * @return Orientação da coxa em relação ao tronco
+ */
+constexpr QuaternionUnitario relativo(const QuaternionUnitario& q_tronco, const QuaternionUnitario& q_coxa)
+{
+    return q_tronco.inverso() * q_coxa;
+}
+
+// ----------------------------------------------------------------------
+// Testes em tempo de compilação
+// ----------------------------------------------------------------------
+// Avaliados pelo compilador em cada unidade que inclui este cabeçalho; não
+// geram código. Usam quaternions com componentes exatas em float (0,5) ou
+// comparação com tolerância.
+namespace quaternion_testes {
+
+constexpr float modulo(float v) { return v < 0.0f ? -v : v; }
+constexpr bool perto(float a, float b) { return modulo(a - b) < 1e-6f; }
+constexpr bool perto(const Vetor3& a, const Vetor3& b) { return perto(a.x, b.x) && perto(a.y, b.y) && perto(a.z, b.z); }
+constexpr bool perto(const QuaternionUnitario& a, const QuaternionUnitario& b)
+{
+    return perto(a.w(), b.w()) && perto(a.x(), b.x()) && perto(a.y(), b.y()) && perto(a.z(), b.z());
+}
+
+// 120° em torno de (1, 1, 1): permuta os eixos X -> Y -> Z -> X
+constexpr QuaternionUnitario CICLO = QuaternionUnitario::confiarUnitario(QuaternionLivre{ 0.5f, 0.5f, 0.5f, 0.5f });
+// 90° em torno de Z
+constexpr QuaternionUnitario GIRO_Z = QuaternionUnitario::confiarUnitario(QuaternionLivre{ 0.70710678f, 0.0f, 0.0f, 0.70710678f });
+constexpr QuaternionUnitario IDENTIDADE{};
+
+static_assert(perto(produtoVetorial({ 1, 0, 0 }, { 0, 1, 0 }), { 0, 0, 1 }), "X × Y = Z");
+static_assert(produtoEscalar({ 1, 2, 3 }, { 4, -5, 6 }) == 12.0f, "produto escalar");
+static_assert(perto(IDENTIDADE * CICLO, CICLO) && perto(CICLO * IDENTIDADE, CICLO), "identidade neutra");
+static_assert(perto(CICLO * CICLO.inverso(), IDENTIDADE), "q ⊗ q⁻¹ = 1");
+static_assert(perto(CICLO * CICLO * CICLO, QuaternionUnitario::confiarUnitario(QuaternionLivre{ -1, 0, 0, 0 })), "três giros de 120° = 360° (-1)");
+static_assert(perto(CICLO.rotacionar({ 1, 0, 0 }), { 0, 1, 0 }) && perto(CICLO.rotacionar({ 0, 0, 1 }), { 1, 0, 0 }), "ciclo dos eixos");
+static_assert(perto(GIRO_Z.rotacionar({ 1, 0, 0 }), { 0, 1, 0 }), "90° em Z leva X em Y");
+static_assert(perto(GIRO_Z.rotacionarInverso(GIRO_Z.rotacionar({ 0.3f, -0.2f, 0.9f })), { 0.3f, -0.2f, 0.9f }), "rotação inversa");
+static_assert(perto((CICLO * GIRO_Z).rotacionar({ 1, 0, 0 }), CICLO.rotacionar(GIRO_Z.rotacionar({ 1, 0, 0 }))), "composição");
+static_assert(perto(relativo(CICLO, CICLO), IDENTIDADE), "relativo de iguais = identidade");
+static_assert(perto(CICLO * relativo(CICLO, GIRO_Z), GIRO_Z), "q_tronco ⊗ q_rel = q_coxa");
+static_assert(std::is_same<decltype(CICLO * GIRO_Z), QuaternionUnitario>::value, "unitário ⊗ unitário é unitário");
+static_assert(std::is_same<decltype(CICLO.livre() * GIRO_Z.livre()), QuaternionLivre>::value, "produto geral é livre");
+static_assert(!std::is_convertible<QuaternionLivre, QuaternionUnitario>::value, "livre não vira unitário implicitamente");
+
+} // namespace quaternion_testes
+
+#endif // QUATERNION_HPP_
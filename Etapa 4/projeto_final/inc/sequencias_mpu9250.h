@@ -0,0 +1,55 @@
+// ======================================================================
+//  Arquivo: sequencias_mpu9250.h
+//  Descrição: Procedimentos longos do MPU9250 (habilitação e recuperação
+//             do magnetômetro, auto-teste) como corrotinas em etapas
+// ======================================================================
+
+#ifndef SEQUENCIAS_MPU9250_H_
+#define SEQUENCIAS_MPU9250_H_
+
+#include "corrotina.hpp"   // Corrotina, esperas por tempo e por E/S
+
+extern "C" {
+    #include "mpu9250_i2c.h" // mpu9250_t e acesso de baixo nível
+}
+
+// ----------------------------------------------------------------------
+// Prazos das esperas por E/S
+// ----------------------------------------------------------------------
+#define SEQUENCIA_LIMITE_DADO_MAG_US 100000 ///< Espera máxima pela primeira leitura do AK8963 pelo I2C master
+
+// ----------------------------------------------------------------------
+// Sequências
+// ----------------------------------------------------------------------
+// Cada uma é criada suspensa e avança em Corrotina::retomar (no laço do
+// núcleo 1) ou em Corrotina::executar (no boot). As que usam o bypass expõem
+// o AK8963 no endereço 0x0C do barramento principal: duas delas não podem
+// rodar ao mesmo tempo em sensores do mesmo barramento.
+
+/**
+ * @brief Habilita o magnetômetro: lê a calibração de fábrica (ASA) pelo bypass,
+ *        entra em modo contínuo a 100Hz/16 bits e passa a leitura automática
+ *        para o I2C master. co_return false se o AK8963 não responder.
+ * @param mpu Sensor já iniciado por mpu9250_init (deve permanecer válido)
+ */
+Corrotina sequenciaHabilitarMagnetometro(mpu9250_t* mpu);
+
+/**
+ * @brief Recupera o magnetômetro saturado (mag_overflow): reinicia o modo
+ *        contínuo pelo bypass, restaura o I2C master e espera uma leitura sem
+ *        transbordo. Ao terminar, limpa mag_overflow. co_return false se a
+ *        leitura não chegou no prazo (o transbordo será detectado de novo).
+ * @param mpu Sensor com mag_overflow (deve permanecer válido)
+ */
+Corrotina sequenciaRecuperarMagnetometro(mpu9250_t* mpu);
+
+/**
+ * @brief Auto-teste do acelerômetro e do giroscópio conforme o datasheet:
+ *        médias de 200 amostras sem e com a excitação interna. Reconfigura o
+ *        sensor durante o teste (não rodar com a FIFO em uso) e restaura a
+ *        configuração, inclusive a do I2C master. co_return true se passou.
+ * @param mpu Sensor a testar (deve permanecer válido)
+ */
+Corrotina sequenciaAutoTeste(mpu9250_t* mpu);
+
+#endif // SEQUENCIAS_MPU9250_H_
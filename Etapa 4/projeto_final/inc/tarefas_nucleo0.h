@@ -0,0 +1,57 @@
+// ======================================================================
+//  Arquivo: tarefas_nucleo0.h
+//  Descrição: Tarefas de E/S do núcleo 0 (botões, logs, armazenamento, relatórios
+//             e depuração) sobre o escalonador cooperativo
+// ======================================================================
+
+#ifndef TAREFAS_NUCLEO0_H_
+#define TAREFAS_NUCLEO0_H_
+
+// ----------------------------------------------------------------------
+// Períodos, prioridades (0 = mais alta) e orçamentos das tarefas
+// ----------------------------------------------------------------------
+#define TAREFA_SUPERVISOR_PERIODO_US 100000  ///< Supervisor: batimento do núcleo 0 e alimentação do watchdog
+#define TAREFA_SUPERVISOR_ORCAMENTO_US 500
+#define TAREFA_BOTOES_PERIODO_US     10000   ///< Botões: leitura das flags da IRQ a cada 10ms
+#define TAREFA_BOTOES_ORCAMENTO_US   1000
+#define TAREFA_LOGS_PERIODO_US       5000    ///< Logs do núcleo 1: impressão a cada 5ms
+#define TAREFA_LOGS_ORCAMENTO_US     5000
+#define TAREFA_COLETA_PERIODO_US     20000   ///< Eventos e amostras do núcleo 1 para as faixas do armazenamento
+#define TAREFA_COLETA_ORCAMENTO_US   1000
+#define TAREFA_ARMAZENAMENTO_PERIODO_US   100000 ///< SDCard: um lote por execução; com outro pronto, reagenda-se por evento
+#define TAREFA_ARMAZENAMENTO_ORCAMENTO_US 300000 ///< Abrir, anexar e fechar o CSV leva centenas de ms
+#define TAREFA_RELATORIO_PERIODO_US  1000000 ///< Perdas nas filas e cadência do núcleo 1
+#define TAREFA_RELATORIO_ORCAMENTO_US 5000
+#define TAREFA_CONSOLE_PERIODO_US    50000   ///< Comandos de depuração pela serial
+#define TAREFA_CONSOLE_ORCAMENTO_US  1000
+#define TAREFA_DEPURACAO_ORCAMENTO_US 50000  ///< Impressão da tabela de estatísticas (só por evento)
+
+// Prazos do supervisor para as partes do núcleo 0 (ms sem batimento)
+#define TAREFA_PRAZO_NUCLEO0_MS        1000  ///< Laço do escalonador (tarefa do supervisor)
+#define TAREFA_PRAZO_ARMAZENAMENTO_MS  2000  ///< Tarefa de armazenamento (um lote pode levar centenas de ms)
+
+// Comandos da serial (um caractere)
+#define CONSOLE_COMANDO_ESTATISTICAS 'e' ///< Imprime as estatísticas das tarefas, do núcleo 1, do armazenamento e do supervisor (também o botão B)
+#define CONSOLE_COMANDO_ZERAR        'z' ///< Zera as estatísticas das tarefas (e os tempos por etapa)
+#define CONSOLE_COMANDO_TEMPOS       't' ///< Imprime os tempos por etapa do pipeline (build com MEDIR_TEMPOS)
+
+// ----------------------------------------------------------------------
+// Protótipos das funções
+// ----------------------------------------------------------------------
+
+/**
+ * @brief Registra as tarefas de E/S do núcleo 0 no escalonador.
+ *
+ * Deve ser chamada depois de pipeline_lancar_nucleo1: as tarefas consomem as
+ * filas do núcleo 1. Registra no supervisor as partes "nucleo0" e
+ * "armazenamento" e reporta o culpado do reinício anterior, se houver.
+ */
+void tarefas_nucleo0_iniciar(void);
+
+/**
+ * @brief Laço do núcleo 0: executa as tarefas prontas por prioridade e dorme
+ *        (WFE) até o próximo vencimento. Não retorna.
+ */
+void tarefas_nucleo0_executar(void);
+
+#endif // TAREFAS_NUCLEO0_H_
@@ -18,11 +18,16 @@
  *
  * Lógica do Programa:
  *   1. Inicializa todos os periféricos do sistema (sensores, botões, buzzer, RTC, SD Card, watchdog).
- *   2. Entra no loop principal, onde:
- *      - Lê a orientação dos sensores inerciais (getPosition)
- *      - Verifica se a posição é perigosa (dangerCheck)
- *      - Gerencia eventos e alarme
- *      - Atualiza o watchdog
+ *   2. Divide o trabalho entre os dois núcleos (ver pipeline_sensores.h):
+ *      - Núcleo 1, em cadência fixa: integra as amostras da FIFO dos sensores na fusão
+ *        sensorial (atualizarFusao, 500Hz); a uma taxa menor (TAXA_AVALIACAO_HZ), extrai
+ *        os ângulos (getPosition), verifica se a posição é perigosa (dangerCheck),
+ *        gerencia eventos e alarme; manda batimentos ao supervisor do watchdog
+ *      - Núcleo 0: botões, impressão dos logs e gravação dos eventos no SD Card,
+ *        recebidos do núcleo 1 por filas (um SD Card lento não atrasa o alarme),
+ *        como tarefas de um escalonador cooperativo com prioridades
+ *        (ver tarefas_nucleo0.h); a tarefa do supervisor só alimenta o watchdog
+ *        de hardware com os dois núcleos, os sensores e o armazenamento em dia
  */
 
 
@@ -31,6 +36,9 @@
 #include "analise_postural.h"      // Funções e estruturas para análise postural e controle do alarme
 #include "evento.h"                // Definição e manipulação de eventos do sistema
 #include "estruturas_de_dados.hpp" // Estruturas de dados auxiliares (ex: Orientacao, Evento)
+#include "pipeline_sensores.h"     // Laço de tempo real no núcleo 1 e filas entre os núcleos
+#include "tarefas_nucleo0.h"       // Tarefas de E/S do núcleo 0 (escalonador cooperativo)
+#include "sequencias_mpu9250.h"    // Procedimentos longos do MPU9250 como corrotinas
 #include <iostream>                // Biblioteca padrão C++ para entrada/saída (usada para debug)
 #include "pico/stdlib.h"           // Funções utilitárias da Raspberry Pi Pico (delay, inicialização, etc)
 #include "hardware/i2c.h"          // Controle do barramento I2C (comunicação com sensores)
@@ -44,14 +52,12 @@ extern "C" {
     #include "buzzer.h"            // Driver para controle do buzzer (alarme sonoro)
     #include "rtc_utils.h"         // Driver para o RTC DS3231 (relógio de tempo real)
     #include "sensor_watchdog.h"   // Driver do sistema watchdog (monitoramento de travamentos)
+    #include "supervisor.h"        // Batimentos por núcleo/tarefa e alimentação do watchdog de hardware
 }
 
 
 // ================== DEFINIÇÕES E VARIÁVEIS GLOBAIS ==================
 
-// Variável global para flag do botão A (definida em button.c)
-extern volatile bool button_a_pressed;
-
 // Endereços I2C dos sensores MPU6050/MPU9250
 #define MPU6050_ADDR_0 0x68 // Endereço padrão do MPU9250
 #define MPU6050_ADDR_1 0x69 // Endereço alternativo do MPU9250 (AD0 conectado ao VCC)
@@ -78,6 +84,9 @@ int main()
     printf("=== HIPSAFE v1 - Sistema de Monitoramento Postural ===\n");
     printf("Iniciando sistema...\n");
 
+    // Lê o culpado de um reinício pelo watchdog antes que algo mais use os registradores
+    supervisor_iniciar();
+
     // --- Configuração dos sensores MPU9250 ---
     // Cada estrutura representa um sensor inercial conectado ao sistema
 
@@ -102,8 +111,8 @@ int main()
         .accel_range = MPU9250_ACCEL_RANGE_2G,      // Faixa do acelerômetro: ±2g
         .gyro_range = MPU9250_GYRO_RANGE_250DPS,    // Faixa do giroscópio: ±250°/s
         .dlpf_filter = MPU9250_DLPF_41HZ,           // Filtro passa-baixa: 41Hz
-        .sample_rate_divider = 9,                   // Taxa de amostragem: 100Hz (1000/(1+9))
-        .enable_magnetometer = true                 // Habilita magnetômetro
+        .sample_rate_divider = 1000 / TAXA_FUSAO_HZ - 1, // Taxa de amostragem: TAXA_FUSAO_HZ (1000/(1+divisor))
+        .enable_magnetometer = MAGNETOMETRO_HABILITADO // Magnetômetro (opção SEM_MAGNETOMETRO)
     };
 
     mpu9250_t mpu_list[] = {mpu_0, mpu_1}; // Lista de sensores conectados
@@ -126,12 +135,23 @@ int main()
     for(auto& mpu : mpu_list) 
     {
         mpu9250_init(&mpu, &config); // Inicializa cada sensor com a configuração padrão
+
+        // Magnetômetro: sequência em etapas, aqui executada até o fim (um sensor por
+        // vez: no bypass os dois AK8963 teriam o mesmo endereço no barramento)
+        if (config.enable_magnetometer && !sequenciaHabilitarMagnetometro(&mpu).executar()) 
+        {
+            printf("ERRO: magnetômetro do sensor %d não habilitado\n", mpu.id);
+        }
         sleep_ms(1000);              // Aguarda estabilização
     }
     printf("MPU9250s configurados: ±2g, ±250°/s\n");
 
+    // --- Calibração do alinhamento dos sensores nos segmentos ---
+    printf("Calibrando alinhamento de montagem dos sensores...\n");
+    calibrarMontagem(mpu_list);
+
     printf("Sistema inicializado com sucesso!\n");
-    printf("Configuração: Taxa de amostragem 100Hz (período = 10ms)\n");
+    printf("Configuração: fusão a %dHz, avaliação postural a %dHz\n", TAXA_FUSAO_HZ, TAXA_AVALIACAO_HZ);
     printf("Iniciando monitoramento postural...\n\n");
 
     // ================== WATCHDOG ==================
@@ -160,49 +180,18 @@ int main()
     sensor_watchdog_enable(); // Ativa o watchdog
     printf("=== WATCHDOG ATIVADO - Sistema monitorado ===\n\n");
 
-    // ================== LOOP PRINCIPAL ==================
+    // ================== NÚCLEO 1: TEMPO REAL ==================
 
-    while (true) 
-    {
-        // --- Gerenciamento do botão A ---
-        // Permite ao usuário silenciar/desilenciar o alarme via botão físico
-        if (button_a_pressed) 
-        {
-            printf("Botão A pressionado\n");
-
-            if (alarme_esta_ligado()) 
-            {
-                if (alarme_esta_silenciado()) 
-                {
-                    printf("  -> Desilenciando alarme\n");
-                    desilenciar_alarme();
-                } 
-                else 
-                {
-                    printf("  -> Silenciando alarme\n");
-                    silenciar_alarme();
-                }
-            } 
-            else 
-            {
-                printf("  -> Alarme não está ativo no momento\n");
-            }
-
-            button_a_pressed = false; // Reseta a flag do botão
-        }
+    // Fusão, avaliação postural, alarme e watchdog passam para o núcleo 1;
+    // a partir daqui o núcleo 0 não acessa os sensores nem o buzzer
+    pipeline_lancar_nucleo1(mpu_list);
 
-        // --- Aquisição da orientação postural ---
-        // Lê os sensores e retorna os ângulos de rotação, abdução e flexão
-        Orientacao orientacao = getPosition(mpu_list);
+    // ================== LOOP PRINCIPAL (NÚCLEO 0: E/S) ==================
 
-        // --- Verificação de postura perigosa ---
-        // Analisa a orientação e executa ações: gera eventos, ativa/desativa alarme, grava no SD
-        dangerCheck(orientacao);
-
-        // --- Atualização do watchdog ---
-        // Garante que o sistema não travou; reinicia o temporizador do watchdog
-        sensor_watchdog_update();
-    }
+    // Botões, logs, gravação no SD Card, relatórios e depuração como tarefas
+    // cooperativas com prioridade e orçamento de tempo (ver tarefas_nucleo0.h)
+    tarefas_nucleo0_iniciar();
+    tarefas_nucleo0_executar();
 
     // Esta linha nunca será alcançada devido ao loop infinito
     std::cout << "Nunca alcança essa linha\n";
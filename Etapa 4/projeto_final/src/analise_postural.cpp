@@ -1,7 +1,6 @@
 #include "analise_postural.h"   // Declarações das funções e estruturas principais de análise postural
 #include "evento.h"             // Definição da classe Evento para controle de eventos de postura
 #include <vector>                // STL: Estrutura de dados dinâmica para lista de eventos
-#include <memory>                // STL: Gerenciamento automático de memória (smart pointers)
 #include <ctime>                 // Funções de data e hora padrão C/C++
 #include <cmath>                 // Funções matemáticas padrão (ex: trigonometria)
 #include "pico/time.h"          // Funções de tempo específicas do Pico SDK
@@ -21,32 +20,107 @@ static float deg_to_rad(float degrees) {
 
 // Inclusão de módulos C para integração com hardware e algoritmos externos
 extern "C" {
-    #include "SDCard.h"           // Manipulação do SDCard para salvar eventos
     #include "sensor_watchdog.h"  // Watchdog para monitoramento dos sensores
     #include "buzzer.h"           // Controle do buzzer (alarme sonoro)
     #include "algoritmo_postura.h"// Algoritmo de análise postural
-    #include "MadgwickAHRS.h"     // Filtro Madgwick para orientação
+    #include "alinhamento_sensor.h"// Calibração do alinhamento sensor-segmento
+    #include "restricao_rumo.h"   // Rumo relativo limitado pela articulação (sem magnetômetro)
+    #include "medicao.h"          // Tempos por etapa (só com MEDIR_TEMPOS)
 }
+#include "motor_fusao.hpp"        // Motores de fusão sensorial (Madgwick, Mahony, complementar, ESKF, articulação)
+#include "quaternion.hpp"         // Quaternions unitários (sem renormalizações redundantes)
+#include "pipeline_sensores.h"    // Logs e eventos enviados ao núcleo 0 (sem bloquear o núcleo 1)
+#include "captura_sensores.h"     // Quadros capturados em IRQ (estágio adiado: conversão e fusão no lugar)
 
 // ===============================
 // Variáveis Globais de Estado
 // ===============================
 
-// Lista de eventos ativos (eventos de postura perigosa em andamento)
-static std::vector<std::unique_ptr<Evento>> eventos_ativos;
+// Lista de eventos ativos (eventos de postura perigosa em andamento), guardados por
+// valor: com a capacidade reservada na inicialização, o núcleo 1 não usa o heap
+// (o malloc é compartilhado com o núcleo 0, que o usa no SDCard e nos logs)
+static std::vector<Evento> eventos_ativos;
+static const size_t MAXIMO_EVENTOS_ATIVOS = 3; // Um por tipo de movimento (flexão, abdução, rotação)
 
 // Estrutura global para controle do estado do alarme
 static Alarme alarme_global = {false, false};
 
-// Controle do período de estabilização dos sensores após inicialização
+// Controle do aquecimento da fusão sensorial após inicialização
+// A proteção começa quando a estimativa converge (tipicamente bem abaixo de 1 s)
 static bool sistema_inicializado = false;
+static bool fusao_convergida = false;
 static uint32_t tempo_inicio_ms = 0;
-static const uint32_t TEMPO_ESTABILIZACAO_MS = 5000; // 5 segundos
+static const uint32_t TEMPO_MAXIMO_AQUECIMENTO_MS = 5000; // Limite: ativa a proteção mesmo sem convergir
+static const float ESCALA_GANHO_AQUECIMENTO = 5.0f;       // Ganho de correção durante o aquecimento
+
+// Beep de início da proteção, desligado por atualizarFusao (sem sleep no laço de tempo real)
+static const uint32_t DURACAO_BIP_PROTECAO_MS = 200;
+static bool bip_protecao_ativo = false;
+static absolute_time_t fim_bip_protecao;
+
+// Incerteza acima da qual a orientação não é usada para abrir ou encerrar eventos
+// (só motores com covariância, como o ESKF, reportam incerteza)
+static const float LIMIAR_INCERTEZA_GRAUS = 5.0f;
+
+// Alinhamento de montagem de cada sensor (segmento -> sensor), identidade até a calibração
+static QuaternionUnitario alinhamento_tronco;
+static QuaternionUnitario alinhamento_coxa;
+
+// Aquisição pela FIFO dos sensores: cada amostra é integrada com o período nominal
+static const float INTERVALO_AMOSTRA_S = 1.0f / TAXA_FUSAO_HZ;
+static const uint16_t MAXIMO_AMOSTRAS_PENDENTES = 4;   // Amostras sem par mantidas entre leituras
+static const float INTERVALO_MAXIMO_S = 0.300f;        // Limite da lacuna integrada após transbordo da FIFO
+static uint32_t transbordos_fifo = 0;                  // Contador de transbordos da FIFO
+static uint32_t amostras_descartadas = 0;              // Amostras sem par descartadas acima de MAXIMO_AMOSTRAS_PENDENTES
+
+// Quadros da captura retidos pela fusão, do mais antigo ao mais novo (com
+// amostras ainda sem par), e o da última amostra integrada, que getPosition
+// anota; cada um com uma referência (ver captura_sensores.h)
+static uint8_t quadros_retidos[MAXIMO_QUADROS_RETIDOS];
+static size_t num_retidos = 0;
+static uint8_t quadro_recente = CAPTURA_SEM_QUADRO;
+static bool avaliacao_pendente = false; // A fusão mudou desde a última avaliação
+
+// Limites articulares testados direto no quaternion relativo (ver getPosition).
+// Os ângulos exatos só são extraídos a menos de MARGEM_PROXIMIDADE_GRAUS de algum
+// limite, ou a cada AVALIACOES_POR_LOG avaliações para o log de acompanhamento
+static const float MARGEM_PROXIMIDADE_GRAUS = 5.0f;
+static const uint32_t AVALIACOES_POR_LOG = TAXA_AVALIACAO_HZ; // Um log e uma amostra por segundo (perto dos limites, log a cada avaliação)
+static uint32_t avaliacoes_sem_log = 0;
+
+// Logs detalhados (ângulos periódicos, eventos ativos): baixa prioridade, pulados
+// pelo agendador do núcleo 1 quando o período estoura o orçamento
+static bool log_detalhado = true;
+
+// Motor de fusão escolhido em tempo de compilação e monitor do aquecimento
+static MotorFusaoSelecionado motor_fusao;
+static MonitorConvergencia convergencia;
+
+// Sem magnetômetro, limita a deriva do rumo relativo entre tronco e coxa
+static restricao_rumo_t restricao_rumo;
+
+// Parâmetros da calibração funcional de montagem
+static const uint32_t CALIBRACAO_DURACAO_FASE_MS = 3000; // Duração de cada fase
+static const uint32_t CALIBRACAO_PERIODO_MS      = 10;   // Período de amostragem (100Hz)
 
 // ===============================
 // Funções Auxiliares de Conversão
 // ===============================
 
+// Limites de LIMITACOES reduzidos de uma margem (graus), em seno/cosseno
+static limites_quadril_t criarLimites(float margem_graus) {
+    limites_quadril_t limites;
+    hip_limits_define(&limites,
+                      deg_to_rad(LIMITACOES[static_cast<int>(TipoMovimento::FLEXAO)] - margem_graus),
+                      deg_to_rad(LIMITACOES[static_cast<int>(TipoMovimento::ABDUCAO)] - margem_graus),
+                      deg_to_rad(LIMITACOES[static_cast<int>(TipoMovimento::ROTACAO)] - margem_graus));
+    return limites;
+}
+
+// Limites em seno/cosseno, calculados uma única vez: risco (LIMITACOES) e proximidade
+static const limites_quadril_t limites_risco = criarLimites(0.0f);
+static const limites_quadril_t limites_proximidade = criarLimites(MARGEM_PROXIMIDADE_GRAUS);
+
 // Converte enum LadoCorpo para string
 static const char* ladoToStr(LadoCorpo l) {
     switch(l){
@@ -56,8 +130,8 @@ static const char* ladoToStr(LadoCorpo l) {
     }
 }
 
-// Converte enum TipoMovimento para string
-static const char* movToStr(TipoMovimento m) {
+// Converte enum TipoMovimento para string (também usada na gravação, ver analise_postural.h)
+const char* movToStr(TipoMovimento m) {
     switch(m){
         case TipoMovimento::FLEXAO:   return "FLEXAO";
         case TipoMovimento::ABDUCAO:  return "ABDUCAO";
@@ -88,13 +162,13 @@ static bool isEventOpen(LadoCorpo perna, TipoMovimento perigo)
     for (const auto& evento : eventos_ativos) 
     {
         // Verifica se o evento corresponde à perna analisada
-        if (evento->getLado() == perna) 
+        if (evento.getLado() == perna) 
         {
             // Se o evento ainda está em situação de perigo (diferente de NORMAL)
-            if (evento->getPerigo() != TipoMovimento::NORMAL) 
+            if (evento.getPerigo() != TipoMovimento::NORMAL) 
             {
                 // Verifica se o tipo de perigo é o mesmo solicitado
-                if (evento->getPerigo() == perigo) 
+                if (evento.getPerigo() == perigo) 
                 {
                     // Já existe evento aberto para esta perna e perigo
                     return true;
@@ -113,159 +187,542 @@ static bool isEventOpen(LadoCorpo perna, TipoMovimento perigo)
 }
 
 // ===============================
-// Função Principal: getPosition
+// Função Auxiliar: converterAmostra
+// ===============================
+/**
+ * @brief Converte uma amostra bruta da FIFO para unidades da fusão (g, rad/s).
+ * @param mpu Sensor de origem (fatores de sensibilidade)
+ * @param frame Amostra bruta
+ * @param mag Última leitura do magnetômetro (µT)
+ * @param amostra Amostra de saída
+ */
+static void converterAmostra(const mpu9250_t& mpu, const mpu9250_fifo_frame_t& frame, 
+                             const float mag[3], AmostraImu& amostra)
+{
+    for (int eixo = 0; eixo < 3; eixo++) 
+    {
+        amostra.accel[eixo] = (float)frame.accel[eixo] / mpu.accel_sensitivity;
+        amostra.gyro[eixo]  = deg_to_rad((float)frame.gyro[eixo] / mpu.gyro_sensitivity); // Converte para rad/s
+        amostra.mag[eixo]   = mag[eixo];
+    }
+}
+
+// ===============================
+// Funções Auxiliares: quadros retidos
+// ===============================
+
+// Todas as amostras do quadro já foram integradas (ou descartadas sem par)
+static bool quadroFundido(const QuadroAmostras& quadro)
+{
+    for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+    {
+        if (quadro.fundidas[i] < quadro.amostras[i]) 
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Devolve à captura os quadros retidos, do primeiro ao último
+static void liberarRetidos(void)
+{
+    for (size_t k = 0; k < num_retidos; k++) 
+    {
+        captura_liberar(quadros_retidos[k]);
+    }
+    num_retidos = 0;
+}
+
+// Próximo quadro retido, a partir de posicao, com amostra do sensor ainda sem fusão
+static size_t proximaAmostra(size_t sensor, size_t posicao)
+{
+    while (posicao < num_retidos) 
+    {
+        const QuadroAmostras& quadro = captura_quadro(quadros_retidos[posicao]);
+        if (quadro.fundidas[sensor] < quadro.amostras[sensor]) 
+        {
+            break;
+        }
+        posicao++;
+    }
+    return posicao;
+}
+
+// ===============================
+// Função Principal: atualizarFusao
 // ===============================
 /**
- * @brief Realiza a leitura dos sensores, processa os dados e retorna a orientação (ângulos) da articulação monitorada.
+ * @brief Processa os quadros capturados dos sensores e integra cada amostra na fusão sensorial.
  *
- * Esta função executa toda a cadeia de processamento dos sensores inerciais:
- *  - Lê dados brutos dos sensores MPU9250 (tronco e coxa)
- *  - Alimenta o watchdog para detecção de travamentos
- *  - Lê dados processados dos sensores
- *  - Aplica o filtro Madgwick para obter orientação em quaternion
- *  - Calcula o quaternion relativo entre tronco e coxa
- *  - Extrai ângulos articulares (flexão, abdução, rotação)
- *  - Converte para graus e retorna na estrutura Orientacao
+ * Estágio adiado da captura (ver captura_sensores.h): as IRQs do timer e do DMA
+ * já puseram os bytes das FIFOs e do magnetômetro em quadros do pool; aqui, na
+ * taxa do laço, sem copiar os quadros (só os seus índices):
+ *  - Retém os quadros capturados e converte os bytes no lugar (big endian da
+ *    FIFO; o little endian do AK8963 vai direto para a última leitura em µT)
+ *  - Pareia as amostras dos dois sensores na ordem de chegada, mesmo em quadros
+ *    diferentes; amostras sem par (relógios dos sensores independentes) ficam
+ *    no quadro, retido até a próxima leitura
+ *  - Integra cada par no motor de fusão com o período nominal 1/TAXA_FUSAO_HZ,
+ *    marcando o avanço em cada quadro (fundidas)
+ *  - Devolve à captura os quadros já integrados e guarda o da última amostra
+ *    para a anotação de getPosition
+ *  - Alimenta o watchdog e o monitor de convergência uma vez por leitura
+ *  - Sem magnetômetro, aplica a restrição de rumo articular uma vez por leitura
+ *
+ * Roda no núcleo 1 (ver pipeline_sensores.h): não imprime nem espera, os logs
+ * saem por pipeline_log.
+ *
+ * O magnetômetro tem taxa própria (100Hz) e não passa pela FIFO: a leitura mais
+ * recente é usada para todas as amostras da FIFO. Se uma FIFO transbordou (captura
+ * adiada por mais de ~84ms sem quadro livre no pool), ambas são esvaziadas e a
+ * lacuna é integrada em um único passo com a última amostra, limitado a INTERVALO_MAXIMO_S.
  *
  * @param mpu_list Array de 2 sensores MPU9250 (mpu_list[0]=tronco, mpu_list[1]=coxa)
- * @return Estrutura Orientacao com ângulos de flexão, abdução e rotação em graus
+ * @return true se todos os sensores trouxeram amostras novas nos quadros desta
+ *         chamada (batimento da parte "sensores" do supervisor)
  */
-Orientacao getPosition(mpu9250_t mpu_list[2]) 
+bool atualizarFusao(mpu9250_t mpu_list[2])
 {
-    Orientacao orientacao = {0}; // Inicializa estrutura de retorno zerada
+    static mpu9250_raw_data_t ultimo_bruto[NUM_SENSORES_FUSAO] = {};
+    static float ultimo_mag[NUM_SENSORES_FUSAO][3] = {};
+    static AmostraImu amostras[NUM_SENSORES_FUSAO];
+    static uint64_t ultima_leitura_us = 0;
+    static bool reiniciar_fifos = true;
+
+    // As FIFOs só são ligadas aqui (durante a calibração e a espera do watchdog elas
+    // transbordariam) e religadas após um transbordo; com uma captura em andamento
+    // no barramento, tenta de novo no próximo período
+    if (reiniciar_fifos) 
+    {
+        if (captura_reiniciar_fifos()) 
+        {
+            ultima_leitura_us = time_us_64();
+            reiniciar_fifos = false;
+        }
+        return false;
+    }
 
-    // === 1. Leitura dos dados brutos dos sensores ===
-    mpu9250_raw_data_t raw_data_tronco, raw_data_coxa;
-    mpu9250_read_raw(&mpu_list[0], &raw_data_tronco); // Lê dados do sensor do tronco
-    mpu9250_read_raw(&mpu_list[1], &raw_data_coxa);   // Lê dados do sensor da coxa
+    // === 1. Conversão no lugar dos quadros capturados (FIFOs e magnetômetro) ===
+    // Só são retirados os que cabem na lista de retidos; o restante espera na
+    // fila da captura até o próximo período
+    MEDICAO_INICIO(MEDICAO_LEITURA_SENSORES);
+    bool transbordou = false;
+    bool amostras_novas[NUM_SENSORES_FUSAO] = {};
+    uint64_t agora_us = ultima_leitura_us;
+
+    size_t primeiro_novo = num_retidos;
+    num_retidos += captura_remover_lote(&quadros_retidos[num_retidos], MAXIMO_QUADROS_RETIDOS - num_retidos);
+    for (size_t k = primeiro_novo; k < num_retidos; k++) 
+    {
+        QuadroAmostras& quadro = captura_quadro(quadros_retidos[k]);
+        agora_us = quadro.instante_us;
+        if (quadro.transbordo) 
+        {
+            transbordou = true; // Os quadros seguintes são descartados pelo reinício das FIFOs
+            break;
+        }
 
-    // Alimenta o watchdog para ambos sensores (detecção de travamento)
-    sensor_watchdog_feed(mpu_list[0].id, &raw_data_tronco);
-    sensor_watchdog_feed(mpu_list[1].id, &raw_data_coxa);
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+        {
+            if (!quadro.convertido) 
+            {
+                mpu9250_fifo_decode(quadro.fifo[i].bytes, quadro.amostras[i], quadro.fifo[i].amostra);
+            }
+
+            // Watchdog: última amostra lida (sem amostra nova, repete a anterior,
+            // de modo que uma FIFO parada é detectada como sensor travado)
+            if (quadro.amostras[i] > 0) 
+            {
+                amostras_novas[i] = true;
+                const mpu9250_fifo_frame_t& f = quadro.fifo[i].amostra[quadro.amostras[i] - 1];
+                for (int eixo = 0; eixo < 3; eixo++) 
+                {
+                    ultimo_bruto[i].accel[eixo] = f.accel[eixo];
+                    ultimo_bruto[i].gyro[eixo]  = f.gyro[eixo];
+                }
+            }
+
+            // Magnetômetro sem dado novo retorna false: mantém a última leitura válida
+            // (desabilitado, não é capturado e permanece zerado: os motores usam só a gravidade)
+            int16_t mag_bruto[3];
+            if (quadro.mag_lido[i] && mpu9250_mag_decode(&mpu_list[i], quadro.mag[i], mag_bruto)) 
+            {
+                for (int eixo = 0; eixo < 3; eixo++) 
+                {
+                    ultimo_mag[i][eixo] = (float)mag_bruto[eixo] * mpu_list[i].mag_asa[eixo] * MAG_SENS;
+                }
+            }
+        }
+        quadro.convertido = true;
+    }
+
+    for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+    {
+        sensor_watchdog_feed(mpu_list[i].id, &ultimo_bruto[i]);
+    }
+    MEDICAO_FIM(MEDICAO_LEITURA_SENSORES);
+    bool sensores_ativos = true;
+    for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+    {
+        sensores_ativos &= amostras_novas[i];
+    }
+
+    // === 2. Transbordo: descarta o que restou e integra a lacuna em um passo ===
+    if (transbordou) 
+    {
+        transbordos_fifo++;
+        float lacuna_s = (float)(agora_us - ultima_leitura_us) * 1e-6f;
+        if (lacuna_s > INTERVALO_MAXIMO_S) lacuna_s = INTERVALO_MAXIMO_S;
+        pipeline_log("Aviso: FIFO transbordou (lacuna de %.1f ms) - integrada com a última amostra (total: %lu)\n",
+               lacuna_s * 1000.0f, (unsigned long)transbordos_fifo);
+
+        liberarRetidos();
+        reiniciar_fifos = !captura_reiniciar_fifos();
+        if (sistema_inicializado) 
+        {
+            motor_fusao.atualizar(amostras, lacuna_s);
+            avaliacao_pendente = true;
+        }
+        ultima_leitura_us = agora_us;
+        return sensores_ativos;
+    }
+    ultima_leitura_us = agora_us;
+
+    // === 3. Fusão sensorial de cada par de amostras, direto dos quadros ===
+    uint16_t pares = 0;
+    size_t posicao[NUM_SENSORES_FUSAO] = {};
+    size_t posicao_ultimo_par = 0;
+    while (true) 
+    {
+        bool completo = true;
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+        {
+            posicao[i] = proximaAmostra(i, posicao[i]);
+            completo &= posicao[i] < num_retidos;
+        }
+        if (!completo) 
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+        {
+            QuadroAmostras& quadro = captura_quadro(quadros_retidos[posicao[i]]);
+            converterAmostra(mpu_list[i], quadro.fifo[i].amostra[quadro.fundidas[i]], ultimo_mag[i], amostras[i]);
+            quadro.fundidas[i]++;
+            if (posicao[i] > posicao_ultimo_par) posicao_ultimo_par = posicao[i];
+        }
+
+        if (!sistema_inicializado) 
+        {
+            // Parte da orientação medida na primeira amostra (e não da identidade),
+            // com ganho elevado até a métrica de convergência estabilizar
+            motor_fusao.iniciar((float)TAXA_FUSAO_HZ);
+            motor_fusao.alinharInicial(amostras);
+            motor_fusao.definirEscalaGanho(ESCALA_GANHO_AQUECIMENTO);
+            convergencia.reiniciar();
+            restricao_rumo_iniciar(&restricao_rumo);
+            eventos_ativos.reserve(MAXIMO_EVENTOS_ATIVOS);
+
+            tempo_inicio_ms = to_ms_since_boot(get_absolute_time());
+            sistema_inicializado = true;
+            pipeline_log("Sistema iniciado - aguardando convergência da fusão sensorial\n");
+        }
+
+        MEDICAO_INICIO(MEDICAO_FUSAO);
+        motor_fusao.atualizar(amostras, INTERVALO_AMOSTRA_S);
+        MEDICAO_FIM(MEDICAO_FUSAO);
+        pares++;
+    }
+
+    // O quadro da última amostra integrada passa a ser o anotado por getPosition
+    if (pares > 0) 
+    {
+        uint8_t indice = quadros_retidos[posicao_ultimo_par];
+        if (indice != quadro_recente) 
+        {
+            captura_reter(indice);
+            if (quadro_recente != CAPTURA_SEM_QUADRO) captura_liberar(quadro_recente);
+            quadro_recente = indice;
+        }
+        avaliacao_pendente = true;
+    }
+
+    // Mantém só as amostras sem par mais recentes: as mais antigas são marcadas como
+    // consumidas a partir do primeiro quadro
+    for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++) 
+    {
+        uint16_t resto = 0;
+        for (size_t k = 0; k < num_retidos; k++) 
+        {
+            const QuadroAmostras& quadro = captura_quadro(quadros_retidos[k]);
+            resto += quadro.amostras[i] - quadro.fundidas[i];
+        }
+        for (size_t k = 0; k < num_retidos && resto > MAXIMO_AMOSTRAS_PENDENTES; k++) 
+        {
+            QuadroAmostras& quadro = captura_quadro(quadros_retidos[k]);
+            uint16_t descartar = quadro.amostras[i] - quadro.fundidas[i];
+            if (descartar > resto - MAXIMO_AMOSTRAS_PENDENTES) descartar = resto - MAXIMO_AMOSTRAS_PENDENTES;
+            quadro.fundidas[i] += descartar;
+            amostras_descartadas += descartar;
+            resto -= descartar;
+        }
+    }
+
+    // Devolve os quadros já integrados do início da lista; com a lista cheia
+    // (quadros sem amostra entre as pendentes), devolve também o mais antigo
+    size_t integrados = 0;
+    while (integrados < num_retidos &&
+           (quadroFundido(captura_quadro(quadros_retidos[integrados])) ||
+            num_retidos - integrados == MAXIMO_QUADROS_RETIDOS)) 
+    {
+        captura_liberar(quadros_retidos[integrados]);
+        integrados++;
+    }
+    for (size_t k = integrados; k < num_retidos; k++) 
+    {
+        quadros_retidos[k - integrados] = quadros_retidos[k];
+    }
+    num_retidos -= integrados;
+
+    // === 4. Sem magnetômetro: rumo relativo limitado pela articulação ===
+    // O giro é aplicado à coxa em torno da vertical da Terra (ver restricao_rumo.h)
+    if (!MAGNETOMETRO_HABILITADO && pares > 0 && fusao_convergida) 
+    {
+        bool parado = MonitorConvergencia::quaseEstatico(amostras[0]) && MonitorConvergencia::quaseEstatico(amostras[1]);
+        QuaternionUnitario q_tronco = motor_fusao.orientacao(0) * alinhamento_tronco;
+        QuaternionUnitario q_coxa   = motor_fusao.orientacao(1) * alinhamento_coxa;
+        float correcao = restricao_rumo_calcular(&restricao_rumo, q_tronco.paraC(), q_coxa.paraC(),
+                                                 parado, pares * INTERVALO_AMOSTRA_S);
+        if (correcao != 0.0f) 
+        {
+            motor_fusao.girarRumo(1, correcao);
+        }
+    }
+
+    // === 5. Aquecimento: volta ao ganho nominal e libera a proteção quando convergir ===
+    if (pares > 0 && !fusao_convergida) 
+    {
+        uint32_t tempo_decorrido_ms = to_ms_since_boot(get_absolute_time()) - tempo_inicio_ms;
+        if (convergencia.atualizar(motor_fusao, amostras)) 
+        {
+            pipeline_log("Fusão convergida em %lu ms - sistema ativo!\n", (unsigned long)tempo_decorrido_ms);
+            fusao_convergida = true;
+        } 
+        else if (tempo_decorrido_ms >= TEMPO_MAXIMO_AQUECIMENTO_MS) 
+        {
+            // Paciente em movimento no boot: não adia a proteção indefinidamente
+            pipeline_log("Aviso: fusão não convergiu em %lu ms - ativando proteção assim mesmo\n", 
+                   (unsigned long)TEMPO_MAXIMO_AQUECIMENTO_MS);
+            fusao_convergida = true;
+        }
+
+        if (fusao_convergida) 
+        {
+            motor_fusao.definirEscalaGanho(1.0f);
+            buzzer_alarm_on(); // Sinaliza o início da proteção
+            fim_bip_protecao = make_timeout_time_ms(DURACAO_BIP_PROTECAO_MS);
+            bip_protecao_ativo = true;
+        }
+    }
+
+    // === 6. Fim do beep de início da proteção ===
+    // Se o alarme ligou durante o beep, o buzzer continua com ele
+    if (bip_protecao_ativo && time_reached(fim_bip_protecao)) 
+    {
+        bip_protecao_ativo = false;
+        if (!alarme_global.ligado || alarme_global.silenciado) 
+        {
+            buzzer_alarm_off();
+        }
+    }
+    return sensores_ativos;
+}
+
+uint32_t amostrasDescartadasFusao(void)
+{
+    return amostras_descartadas;
+}
+
+// ===============================
+// Função Principal: getPosition
+// ===============================
+/**
+ * @brief Extrai a orientação (ângulos) da articulação monitorada a partir do estado mais recente da fusão.
+ *
+ * Roda a TAXA_AVALIACAO_HZ, independente da taxa da fusão (ver atualizarFusao),
+ * e anota o resultado no próprio quadro da última amostra integrada:
+ *  - Sem amostra nova desde a última avaliação, retorna a avaliação anterior
+ *  - Obtém a orientação em quaternion de cada sensor do motor de fusão
+ *  - Aplica o alinhamento de montagem e calcula o quaternion relativo entre tronco e coxa
+ *  - Testa os limites de LIMITACOES direto nas componentes do quaternion (sem trigonometria)
+ *  - Só perto de algum limite (ou quando o log precisa) extrai os ângulos articulares
+ *    (flexão, abdução, rotação) e os converte para graus
+ *  - A amostra periódica do histórico entrega o índice do quadro ao armazenamento,
+ *    que lê dele os ângulos anotados; a partir daí a anotação não é reescrita (com
+ *    amostras do mesmo quadro integradas depois, a reavaliação vai para fora dele)
+ *
+ * @return Orientacao anotada no quadro (com os limites excedidos e, se angulos_validos,
+ *         os ângulos em graus), válida até a próxima chamada
+ */
+const Orientacao& getPosition(void) 
+{
+    static const Orientacao sem_quadro = {}; // Antes da primeira amostra integrada: orientação zerada
+    static Orientacao reavaliacao;           // Quadro recente já entregue à gravação
+    static const Orientacao* ultima = &sem_quadro;
+    if (quadro_recente == CAPTURA_SEM_QUADRO || !avaliacao_pendente) 
+    {
+        return *ultima;
+    }
+    avaliacao_pendente = false;
+
+    QuadroAmostras& quadro = captura_quadro(quadro_recente);
+    Orientacao& orientacao = quadro.entregue ? reavaliacao : quadro.orientacao;
+    orientacao = Orientacao{};
+    quadro.avaliado = true;
+    ultima = &orientacao;
+
+    // === 1. Calcula o quaternion relativo (tronco -> coxa) ===
+    // Orientação de cada sensor fornecida pelo motor de fusão, já unitária;
+    // produtos e inverso de unitários dispensam novas normalizações.
+    // Aplica o alinhamento de montagem: q_segmento = q_sensor ⊗ q_alinhamento
+    QuaternionUnitario q_tronco = motor_fusao.orientacao(0) * alinhamento_tronco;
+    QuaternionUnitario q_coxa   = motor_fusao.orientacao(1) * alinhamento_coxa;
 
-    // === 2. Leitura dos dados processados dos sensores ===
-    mpu9250_data_t data_tronco, data_coxa;
-    mpu9250_read_data(&mpu_list[0], &data_tronco); // Dados filtrados do tronco
-    mpu9250_read_data(&mpu_list[1], &data_coxa);   // Dados filtrados da coxa
-
-    // === 3. Processamento dos dados com o filtro Madgwick (quaternion) ===
-    // Estruturas estáticas para manter estado do filtro entre chamadas
-    static AHRS_data_t imu_tronco, imu_coxa;
-    static bool initialized = false;
-    if (!initialized) 
-    {
-        // Inicializa o filtro Madgwick para ambos sensores (100Hz)
-        MadgwickAHRSinit(&imu_tronco, 100.0f);
-        MadgwickAHRSinit(&imu_coxa, 100.0f);
-        initialized = true;
-    }
-
-    // Preenche estrutura do filtro Madgwick com dados do tronco
-    imu_tronco.accel[0] = data_tronco.accel[0];
-    imu_tronco.accel[1] = data_tronco.accel[1];
-    imu_tronco.accel[2] = data_tronco.accel[2];
-    imu_tronco.gyro[0] = deg_to_rad(data_tronco.gyro[0]); // Converte para rad/s
-    imu_tronco.gyro[1] = deg_to_rad(data_tronco.gyro[1]);
-    imu_tronco.gyro[2] = deg_to_rad(data_tronco.gyro[2]);
-    imu_tronco.mag[0] = data_tronco.mag[0];
-    imu_tronco.mag[1] = data_tronco.mag[1];
-    imu_tronco.mag[2] = data_tronco.mag[2];
-
-    // Preenche estrutura do filtro Madgwick com dados da coxa
-    imu_coxa.accel[0] = data_coxa.accel[0];
-    imu_coxa.accel[1] = data_coxa.accel[1];
-    imu_coxa.accel[2] = data_coxa.accel[2];
-    imu_coxa.gyro[0] = deg_to_rad(data_coxa.gyro[0]);
-    imu_coxa.gyro[1] = deg_to_rad(data_coxa.gyro[1]);
-    imu_coxa.gyro[2] = deg_to_rad(data_coxa.gyro[2]);
-    imu_coxa.mag[0] = data_coxa.mag[0];
-    imu_coxa.mag[1] = data_coxa.mag[1];
-    imu_coxa.mag[2] = data_coxa.mag[2];
-
-    // Atualiza o filtro Madgwick para ambos sensores
-    MadgwickAHRSupdate(&imu_tronco);
-    MadgwickAHRSupdate(&imu_coxa);
-
-    // === 4. Calcula o quaternion relativo (tronco -> coxa) ===
-    // Constrói quaternions a partir dos dados do filtro
-    Quaternion q_tronco = { 
-        .w = imu_tronco.orientation.q0, 
-        .x = imu_tronco.orientation.q1, 
-        .y = imu_tronco.orientation.q2, 
-        .z = imu_tronco.orientation.q3 
-    };
-    Quaternion q_coxa = { 
-        .w = imu_coxa.orientation.q0, 
-        .x = imu_coxa.orientation.q1, 
-        .y = imu_coxa.orientation.q2, 
-        .z = imu_coxa.orientation.q3 
-    };
     // Calcula o quaternion relativo entre tronco e coxa
-    Quaternion q_rel = relative_quaternion(q_tronco, q_coxa);
+    QuaternionUnitario q_rel = relativo(q_tronco, q_coxa);
+
+    // === 2. Testa os limites no espaço do quaternion ===
+    componentes_quadril_t componentes = quaternion_to_hip_components(q_rel.paraC());
+    bool proximo[3];
+    bool perto_do_limite = hip_components_exceed(&componentes, &limites_proximidade, proximo);
+    hip_components_exceed(&componentes, &limites_risco, orientacao.excede_limite);
+
+    // Incerteza do ângulo relativo: erros dos dois sensores somados em quadratura
+    float incerteza_tronco = motor_fusao.incerteza(0);
+    float incerteza_coxa   = motor_fusao.incerteza(1);
+    const float RAD2DEG = 180.0f / M_PI_F;
+    orientacao.incerteza = sqrtf(incerteza_tronco * incerteza_tronco + incerteza_coxa * incerteza_coxa) * RAD2DEG;
 
-    // === 5. Extrai ângulos articulares relativos (flexão, abdução, rotação) ===
+    // Longe de todos os limites e sem amostra periódica pendente: os ângulos não são necessários
+    avaliacoes_sem_log++;
+    bool amostra_periodica = log_detalhado && avaliacoes_sem_log >= AVALIACOES_POR_LOG;
+    if (!perto_do_limite && !amostra_periodica)
+    {
+        return orientacao;
+    }
+
+    // === 3. Extrai ângulos articulares relativos (flexão, abdução, rotação) ===
     float flexao_rad, aducao_rad, rotacao_rad;
     
     // Função quaternion_to_hip_angles extrai os ângulos articulares principais a partir do quaternion relativo
-    quaternion_to_hip_angles(q_rel, &flexao_rad, &aducao_rad, &rotacao_rad);
+    quaternion_to_hip_angles(q_rel.paraC(), &flexao_rad, &aducao_rad, &rotacao_rad);
 
-    // === 6. Converte ângulos para graus e preenche estrutura de retorno ===
-    const float RAD2DEG = 180.0f / M_PI_F;
+    // === 4. Converte ângulos para graus e preenche estrutura de retorno ===
     orientacao.flexao   =  flexao_rad * RAD2DEG; 
     orientacao.rotacao  =  rotacao_rad * RAD2DEG;
     orientacao.abducao  =  aducao_rad * RAD2DEG; 
+    orientacao.angulos_validos = true;
 
     // Log dos ângulos para depuração e acompanhamento em tempo real
-    printf("Ângulos: Flexão=%.2f° | Adução=%.2f° | Rotação=%.2f°\n", 
-           orientacao.flexao, orientacao.abducao, orientacao.rotacao);
+    if (log_detalhado) 
+    {
+        pipeline_log("Ângulos: Flexão=%.2f° | Adução=%.2f° | Rotação=%.2f°\n", 
+               orientacao.flexao, orientacao.abducao, orientacao.rotacao);
+    }
 
-    // === 7. Inicializa controle de tempo na primeira chamada ===
-    if (!sistema_inicializado) 
+    // Amostra periódica para o histórico no SDCard (gravação de baixa prioridade no núcleo 0):
+    // segue o índice do quadro, que o núcleo 0 lê e devolve (ver pipeline_publicar_quadro)
+    if (amostra_periodica && !quadro.entregue) 
     {
-        tempo_inicio_ms = to_ms_since_boot(get_absolute_time());
-        sistema_inicializado = true;
-        printf("Sistema iniciado - período de estabilização de %d segundos\n", TEMPO_ESTABILIZACAO_MS / 1000);
+        avaliacoes_sem_log = 0;
+        quadro.entregue = pipeline_publicar_quadro(quadro_recente);
     }
 
     return orientacao;
 }
 
 // ===============================
-// Função Auxiliar: salvarEventoSDCard
+// Função Principal: calibrarMontagem
 // ===============================
 /**
- * @brief Salva um evento encerrado no SDCard, registrando lado, tipo de movimento e ângulo máximo.
- * @param evento Ponteiro para o evento a ser salvo
- */
-/**
- * @brief Salva um evento de postura no SDCard, registrando lado, tipo de movimento e ângulo máximo.
+ * @brief Executa a calibração funcional do alinhamento dos sensores nos segmentos.
+ *
+ * O procedimento tem três fases de CALIBRACAO_DURACAO_FASE_MS cada, sinalizadas por beeps:
+ *  1. Paciente em pé, parado (postura neutra): ambos os sensores medem a vertical
+ *  2. Flexão do quadril (elevar a coxa à frente e voltar): eixo de flexão da coxa
+ *  3. Inclinação do tronco à frente e volta: eixo de flexão do tronco
  *
- * Esta função converte os enums do evento para strings legíveis, chama a função de registro
- * (que já gera os timestamps automaticamente) e faz o log do sucesso ou falha da operação.
+ * O alinhamento estimado de cada sensor é aplicado em getPosition() com uma única
+ * multiplicação de quaternion por avaliação. Se a estimativa de um sensor falhar,
+ * ele mantém o alinhamento identidade (sensor considerado alinhado ao segmento).
  *
- * @param evento Ponteiro único para o evento a ser salvo
+ * @param mpu_list Array de 2 sensores MPU9250 (mpu_list[0]=tronco, mpu_list[1]=coxa)
  */
-static void salvarEventoSDCard(const std::unique_ptr<Evento>& evento) 
+void calibrarMontagem(mpu9250_t mpu_list[2])
 {
-    // Determina o lado do corpo como string para registro
-    const char* lado_str = (evento->getLado() == LadoCorpo::DIREITO) ? "direita" : "esquerda";
+    alinhamento_estimador_t est_tronco, est_coxa;
+    alinhamento_iniciar(&est_tronco);
+    alinhamento_iniciar(&est_coxa);
 
-    // Converte o tipo de movimento perigoso para string
-    const char* movimento_str = movToStr(evento->getPerigo());
+    mpu9250_data_t data_tronco, data_coxa;
+    const uint32_t amostras_por_fase = CALIBRACAO_DURACAO_FASE_MS / CALIBRACAO_PERIODO_MS;
 
-    // Chama a função de registro, que salva o evento no SDCard e gera timestamps automaticamente
-    bool sucesso = register_movement_with_timestamps(lado_str, movimento_str, evento->getMaxAngulo());
+    // === Fase 1: postura neutra ===
+    printf("[CALIBRACAO] Fique em pé, parado, em postura neutra...\n");
+    buzzer_beep();
+    for (uint32_t i = 0; i < amostras_por_fase; i++)
+    {
+        mpu9250_read_data(&mpu_list[0], &data_tronco);
+        mpu9250_read_data(&mpu_list[1], &data_coxa);
+        alinhamento_acumular_repouso(&est_tronco, data_tronco.accel);
+        alinhamento_acumular_repouso(&est_coxa, data_coxa.accel);
+        sleep_ms(CALIBRACAO_PERIODO_MS);
+    }
 
-    // Loga o resultado da operação para depuração e acompanhamento
-    if (sucesso) 
+    // === Fase 2: flexão do quadril (apenas a coxa se move) ===
+    printf("[CALIBRACAO] Eleve a coxa à frente e volte, devagar...\n");
+    buzzer_beep();
+    for (uint32_t i = 0; i < amostras_por_fase; i++)
     {
-        printf("[SDCard] Evento salvo: Lado=%s, Movimento=%s, Ângulo=%.2f°, Duração=%lld ms\n", 
-               lado_str, movimento_str, evento->getMaxAngulo(), evento->getDuracaoMS());
-    } 
-    else 
+        mpu9250_read_data(&mpu_list[1], &data_coxa);
+        alinhamento_acumular_flexao(&est_coxa, data_coxa.gyro);
+        sleep_ms(CALIBRACAO_PERIODO_MS);
+    }
+
+    // === Fase 3: inclinação do tronco à frente (apenas o tronco se move) ===
+    printf("[CALIBRACAO] Incline o tronco à frente e volte, devagar...\n");
+    buzzer_beep();
+    for (uint32_t i = 0; i < amostras_por_fase; i++)
     {
-        printf("[SDCard] ERRO ao salvar evento: Lado=%s, Movimento=%s, Ângulo=%.2f°\n", 
-               lado_str, movimento_str, evento->getMaxAngulo());
+        mpu9250_read_data(&mpu_list[0], &data_tronco);
+        alinhamento_acumular_flexao(&est_tronco, data_tronco.gyro);
+        sleep_ms(CALIBRACAO_PERIODO_MS);
+    }
+    buzzer_beep();
+
+    // === Cálculo dos alinhamentos ===
+    // A coxa gira no sentido da flexão; o tronco inclinando à frente gira no sentido oposto
+    Quaternion q;
+    if (alinhamento_calcular(&est_coxa, 1.0f, &q))
+    {
+        alinhamento_coxa = QuaternionUnitario::confiarUnitario(q); // Base ortonormal (Shepperd)
+        printf("[CALIBRACAO] Coxa: q_alinhamento = [%.3f, %.3f, %.3f, %.3f]\n", q.w, q.x, q.y, q.z);
+    }
+    else
+    {
+        printf("[CALIBRACAO] Coxa: movimento insuficiente, mantendo alinhamento identidade\n");
+    }
+
+    if (alinhamento_calcular(&est_tronco, -1.0f, &q))
+    {
+        alinhamento_tronco = QuaternionUnitario::confiarUnitario(q);
+        printf("[CALIBRACAO] Tronco: q_alinhamento = [%.3f, %.3f, %.3f, %.3f]\n", q.w, q.x, q.y, q.z);
+    }
+    else
+    {
+        printf("[CALIBRACAO] Tronco: movimento insuficiente, mantendo alinhamento identidade\n");
     }
 }
 
@@ -298,7 +755,7 @@ static void gerenciarAlarme(bool ligar)
         {
             buzzer_alarm_on();              // Ativa o buzzer
         }
-        printf("[ALARME] LIGADO - Postura perigosa detectada!\n");
+        pipeline_log("[ALARME] LIGADO - Postura perigosa detectada!\n");
     }
 
     // Caso 2: Solicitação para ligar, já está ligado, mas pode ter sido desilenciado
@@ -316,7 +773,7 @@ static void gerenciarAlarme(bool ligar)
             alarme_global.ligado = false;
             alarme_global.silenciado = false;
             buzzer_alarm_off();
-            printf("[ALARME] DESLIGADO - Postura normalizada\n");
+            pipeline_log("[ALARME] DESLIGADO - Postura normalizada\n");
         }
     }
 
@@ -331,68 +788,59 @@ static void gerenciarAlarme(bool ligar)
 // Função Principal: dangerCheck
 // ===============================
 /**
- * @brief Verifica se a postura está em situação de risco, gerencia alarmes e eventos, e salva eventos no SDCard.
+ * @brief Verifica se a postura está em situação de risco, gerencia alarmes e eventos, e envia os encerrados para o SDCard.
  * @param orientacao Estrutura com ângulos de flexão, abdução e rotação
  */
 /**
  * @brief Analisa a orientação atual e gerencia eventos e alarmes de postura perigosa.
  *
  * Esta função executa a lógica principal de detecção de risco postural:
- *  - Aguarda o período de estabilização dos sensores antes de iniciar a análise
+ *  - Aguarda a convergência da fusão sensorial (ver atualizarFusao) antes de iniciar a análise
+ *  - Ignora amostras com incerteza acima de LIMIAR_INCERTEZA_GRAUS: eventos e alarme
+ *    mantêm o estado atual até a estimativa voltar a ser confiável
  *  - Para cada tipo de movimento relevante (flexão, abdução, rotação):
- *      - Verifica se o ângulo atual ultrapassa o limite seguro
+ *      - Verifica se o ângulo atual ultrapassa o limite seguro (teste feito no quaternion, em getPosition)
  *      - Se sim, abre ou atualiza um evento e liga o alarme
- *      - Se não, encerra o evento (se houver) e salva no SDCard
+ *      - Se não, encerra o evento (se houver) e o envia ao núcleo 0 para gravação no SDCard
  *  - Ao final, exibe o status dos eventos ativos para depuração
  *
  * @param orientacao Estrutura com ângulos de flexão, abdução e rotação
  */
-void dangerCheck(Orientacao orientacao) 
+void dangerCheck(const Orientacao& orientacao) 
 {
-    // === 1. Aguarda estabilização dos sensores após inicialização ===
-    if (sistema_inicializado) 
+    // === 1. Aguarda a convergência da fusão sensorial após inicialização ===
+    if (!fusao_convergida) 
     {
-        uint32_t tempo_atual_ms = to_ms_since_boot(get_absolute_time());
-        uint32_t tempo_decorrido_ms = tempo_atual_ms - tempo_inicio_ms;
-
-        // Se ainda está no período de estabilização, exibe tempo restante e retorna
-        if (tempo_decorrido_ms < TEMPO_ESTABILIZACAO_MS) 
-        {
-            uint32_t tempo_restante_ms = TEMPO_ESTABILIZACAO_MS - tempo_decorrido_ms;
-            printf("Estabilizando sensores... %d.%d segundos restantes\n", 
-                   tempo_restante_ms / 1000, (tempo_restante_ms % 1000) / 100);
-            return;
-        }
+        return;
+    }
 
-        // Primeira vez após estabilização: sinaliza sistema ativo
-        else if (tempo_decorrido_ms == TEMPO_ESTABILIZACAO_MS || (tempo_decorrido_ms > TEMPO_ESTABILIZACAO_MS && tempo_decorrido_ms < TEMPO_ESTABILIZACAO_MS + 1000)) 
-        {
-            printf("Período de estabilização concluído - sistema ativo!\n");
-            buzzer_beep();
-        }
+    // === 2. Estimativa pouco confiável: não abre nem encerra eventos ===
+    if (orientacao.incerteza > LIMIAR_INCERTEZA_GRAUS) 
+    {
+        pipeline_log("Incerteza da orientação alta (%.1f°) - mantendo estado dos eventos\n", orientacao.incerteza);
+        return;
     }
 
-    // === 2. Verifica cada tipo de movimento relevante (exceto NORMAL) ===
+    // === 3. Verifica cada tipo de movimento relevante (exceto NORMAL) ===
+    // O risco vem do teste no quaternion (excede_limite); um limite excedido
+    // implica ângulos válidos, pois a margem de proximidade o inclui
     TipoMovimento tipos_movimento[] = {TipoMovimento::FLEXAO, TipoMovimento::ABDUCAO, TipoMovimento::ROTACAO};
     for (TipoMovimento tipo : tipos_movimento) 
     {
-        bool posicao_perigosa = false;
+        bool posicao_perigosa = orientacao.excede_limite[static_cast<int>(tipo)];
         float angulo_atual = 0.0f;
 
-        // Determina o ângulo atual e se está em situação perigosa
+        // Determina o ângulo atual
         switch (tipo) 
         {
             case TipoMovimento::FLEXAO:
                 angulo_atual = orientacao.flexao;
-                posicao_perigosa = (angulo_atual > LIMITACOES[static_cast<int>(TipoMovimento::FLEXAO)]);
                 break;
             case TipoMovimento::ABDUCAO:
                 angulo_atual = orientacao.abducao;
-                posicao_perigosa = (angulo_atual > LIMITACOES[static_cast<int>(TipoMovimento::ABDUCAO)]);
                 break;
             case TipoMovimento::ROTACAO:
                 angulo_atual = orientacao.rotacao;
-                posicao_perigosa = (angulo_atual > LIMITACOES[static_cast<int>(TipoMovimento::ROTACAO)]);
                 break;
             default:
                 continue;
@@ -407,10 +855,9 @@ void dangerCheck(Orientacao orientacao)
             // Se não há evento aberto para este tipo, cria novo evento e liga o alarme
             if (!isEventOpen(perna_atual, tipo)) 
             {
-                auto novo_evento = std::make_unique<Evento>(tipo, perna_atual, angulo_atual);
-                eventos_ativos.push_back(std::move(novo_evento));
+                eventos_ativos.emplace_back(tipo, perna_atual, angulo_atual);
                 gerenciarAlarme(true);
-                printf("NOVO EVENTO CRIADO: %s - %s (%.2f graus)\n", 
+                pipeline_log("NOVO EVENTO CRIADO: %s - %s (%.2f graus)\n", 
                        ladoToStr(perna_atual), movToStr(tipo), angulo_atual);
             } 
             else 
@@ -418,9 +865,9 @@ void dangerCheck(Orientacao orientacao)
                 // Se já existe evento aberto, apenas atualiza o ângulo máximo
                 for (auto& evento : eventos_ativos) 
                 {
-                    if (evento->getLado() == perna_atual && evento->getPerigo() == tipo) 
+                    if (evento.getLado() == perna_atual && evento.getPerigo() == tipo) 
                     {
-                        evento->setAngulo(angulo_atual);
+                        evento.setAngulo(angulo_atual);
                         break;
                     }
                 }
@@ -432,13 +879,17 @@ void dangerCheck(Orientacao orientacao)
             auto it = eventos_ativos.begin();
             while (it != eventos_ativos.end()) 
             {
-                if ((*it)->getLado() == perna_atual && (*it)->getPerigo() == tipo) 
+                if (it->getLado() == perna_atual && it->getPerigo() == tipo) 
                 {
-                    (*it)->closeEvent();
-                    salvarEventoSDCard(*it);
-                    printf("EVENTO ENCERRADO: %s - %s (%.2f graus max, %lld ms)\n", 
-                           ladoToStr((*it)->getLado()), movToStr((*it)->getPerigo()), 
-                           (*it)->getMaxAngulo(), (*it)->getDuracaoMS());
+                    it->closeEvent();
+                    // A gravação fica com o núcleo 0: um SDCard lento não atrasa esta avaliação
+                    // (com a fila cheia o registro é perdido e o núcleo 0 reporta a perda)
+                    RegistroEvento registro = {it->getPerigo(), it->getLado(), it->getMaxAngulo(), it->getDuracaoMS(),
+                                               to_ms_since_boot(get_absolute_time())};
+                    pipeline_publicar_evento(registro);
+                    pipeline_log("EVENTO ENCERRADO: %s - %s (%.2f graus max, %lld ms)\n", 
+                           ladoToStr(it->getLado()), movToStr(it->getPerigo()), 
+                           it->getMaxAngulo(), it->getDuracaoMS());
                     it = eventos_ativos.erase(it);
                     gerenciarAlarme(false);
                     break;
@@ -451,19 +902,33 @@ void dangerCheck(Orientacao orientacao)
         }
     }
 
-    // === 3. Log de eventos ativos para depuração e acompanhamento ===
-    if (!eventos_ativos.empty()) 
+    // === 4. Log de eventos ativos para depuração e acompanhamento ===
+    if (log_detalhado && !eventos_ativos.empty()) 
     {
-        printf("Eventos ativos: %zu\n", eventos_ativos.size());
+        pipeline_log("Eventos ativos: %zu\n", eventos_ativos.size());
         for (const auto& evento : eventos_ativos) 
         {
-            printf("  - %s %s: %.2f graus, %lld ms\n", 
-                   ladoToStr(evento->getLado()), movToStr(evento->getPerigo()),
-                   evento->getMaxAngulo(), evento->getDuracaoMS());
+            pipeline_log("  - %s %s: %.2f graus, %lld ms\n", 
+                   ladoToStr(evento.getLado()), movToStr(evento.getPerigo()),
+                   evento.getMaxAngulo(), evento.getDuracaoMS());
         }
     }
 }
 
+/**
+ * @brief Habilita ou desabilita os logs detalhados (ângulos periódicos e eventos ativos).
+ *
+ * Chamada pelo laço do núcleo 1 a cada avaliação, conforme o agendador: em
+ * modo degradado os ângulos só são extraídos perto dos limites, onde a
+ * detecção precisa deles.
+ *
+ * @param habilitado false para gerar só os logs de eventos e alarme
+ */
+void definirLogDetalhado(bool habilitado) 
+{
+    log_detalhado = habilitado;
+}
+
 // -------------------------------------------------------------------
 // Funções de Controle Manual do Alarme Sonoro (Buzzer)
 // -------------------------------------------------------------------
@@ -482,7 +947,7 @@ void silenciar_alarme(void)
     // Garante que o buzzer está desligado fisicamente
     buzzer_alarm_off();
     // Log para depuração e rastreabilidade
-    printf("[ALARME] Silenciado manualmente pelo usuário\n");
+    pipeline_log("[ALARME] Silenciado manualmente pelo usuário\n");
 }
 
 /**
@@ -499,7 +964,7 @@ void desilenciar_alarme(void)
     if (alarme_global.ligado) 
     {
         buzzer_alarm_on();
-        printf("[ALARME] Desilenciado - buzzer religado\n");
+        pipeline_log("[ALARME] Desilenciado - buzzer religado\n");
     }
 }
 
@@ -0,0 +1,459 @@
+// ======================================================================
+//  Arquivo: armazenamento.cpp
+//  Descrição: Gravação assíncrona no SDCard (núcleo 0), com faixas de
+//             prioridade limitadas, gravação em lote e contrapressão
+// ======================================================================
+
+#include "armazenamento.h"
+#include "analise_postural.h"   // movToStr
+#include "fila_spsc.hpp"        // Faixas de capacidade fixa
+#include <cstdarg>              // va_list para armazenamento_registrar_diagnostico
+#include <cstdio>               // snprintf, printf
+#include <ctime>                // mktime, gmtime_r, strftime
+#include "pico/stdlib.h"        // Funções de tempo do Pico SDK
+
+extern "C" {
+    #include "SDCard.h"         // append_csv_block
+    #include "rtc_utils.h"      // rtc_update_datetime
+    #include "medicao.h"        // Tempos por etapa (só com MEDIR_TEMPOS)
+}
+
+// ===============================
+// Arquivos
+// ===============================
+static const char* const ARQUIVO_EVENTOS = "dados.csv";
+static const char* const CABECALHO_EVENTOS = "Inicio,Fim,Perna,Movimento,AnguloMaximo\n";
+static const char* const ARQUIVO_DIAGNOSTICOS = "diagnostico.csv";
+static const char* const CABECALHO_DIAGNOSTICOS = "Instante,Mensagem\n";
+static const char* const ARQUIVO_AMOSTRAS = "amostras.csv";
+static const char* const CABECALHO_AMOSTRAS = "Instante,Tipo,Amostras,Flexao,Abducao,Rotacao,Incerteza\n";
+
+// Maior linha formatada de cada faixa: o lote para antes de retirar um pedido que não caberia
+static const size_t LINHA_MAXIMA_EVENTO = 96;
+static const size_t LINHA_MAXIMA_DIAGNOSTICO = 24 + ARMAZENAMENTO_TAMANHO_DIAGNOSTICO;
+static const size_t LINHA_MAXIMA_AMOSTRA = 80;
+
+// ===============================
+// Faixas
+// ===============================
+
+// Mensagem de diagnóstico com o instante em que foi registrada
+typedef struct {
+    uint32_t instante_ms;
+    char texto[ARMAZENAMENTO_TAMANHO_DIAGNOSTICO];
+} MensagemDiagnostico;
+
+// Amostras somadas sob pressão, gravadas como uma linha "resumo"
+typedef struct {
+    uint32_t quantidade;
+    uint32_t fim_ms;
+    float soma_flexao;
+    float soma_abducao;
+    float soma_rotacao;
+    float incerteza_maxima;
+} ResumoAmostras;
+
+// Produtor e consumidor no núcleo 0 (tarefas diferentes do escalonador cooperativo)
+static FilaSpsc<RegistroEvento, ARMAZENAMENTO_CAPACIDADE_EVENTOS> faixa_eventos;
+static FilaSpsc<MensagemDiagnostico, ARMAZENAMENTO_CAPACIDADE_DIAGNOSTICOS> faixa_diagnosticos;
+static FilaSpsc<AmostraPostura, ARMAZENAMENTO_CAPACIDADE_AMOSTRAS> faixa_amostras;
+static ResumoAmostras resumo = {};
+
+// Instante em que cada faixa deixou de estar vazia (espera máxima até o lote)
+static uint32_t pendente_desde_ms[(int)FaixaArmazenamento::QUANTIDADE] = {};
+
+// Última falha ao gravar eventos e a espera até a próxima tentativa (0: sem falha pendente)
+static uint32_t falha_eventos_ms = 0;
+static uint32_t espera_eventos_ms = 0;
+
+static EstatisticasArmazenamento estatisticas = {};
+
+// Buffer de formatação do lote em andamento
+static char lote[ARMAZENAMENTO_TAMANHO_LOTE];
+
+// ===============================
+// Funções auxiliares
+// ===============================
+static EstatisticasFaixa& contadores(FaixaArmazenamento faixa)
+{
+    return estatisticas.faixas[(int)faixa];
+}
+
+// Conta um pedido aceito e a nova profundidade da faixa
+static void contarAceito(FaixaArmazenamento faixa, size_t profundidade, bool estava_vazia)
+{
+    EstatisticasFaixa& c = contadores(faixa);
+    c.aceitos++;
+    if (profundidade > c.profundidade_maxima)
+    {
+        c.profundidade_maxima = (uint32_t)profundidade;
+    }
+    if (estava_vazia)
+    {
+        pendente_desde_ms[(int)faixa] = to_ms_since_boot(get_absolute_time());
+    }
+}
+
+// Pedidos pendentes de uma faixa (o resumo conta como uma linha de amostras)
+static size_t pendentes(FaixaArmazenamento faixa)
+{
+    switch (faixa)
+    {
+        case FaixaArmazenamento::EVENTOS:      return faixa_eventos.tamanho();
+        case FaixaArmazenamento::DIAGNOSTICOS: return faixa_diagnosticos.tamanho();
+        case FaixaArmazenamento::AMOSTRAS:     return faixa_amostras.tamanho() + (resumo.quantidade > 0 ? 1 : 0);
+        default:                               return 0;
+    }
+}
+
+// Faixa pronta de maior prioridade: eventos sem esperar (salvo após uma falha); as
+// demais por lote completo ou espera máxima
+static bool proximaFaixaPronta(uint32_t agora_ms, FaixaArmazenamento& faixa)
+{
+    if (pendentes(FaixaArmazenamento::EVENTOS) > 0 &&
+        (espera_eventos_ms == 0 || agora_ms - falha_eventos_ms >= espera_eventos_ms))
+    {
+        faixa = FaixaArmazenamento::EVENTOS;
+        return true;
+    }
+
+    const FaixaArmazenamento acumuladas[] = {FaixaArmazenamento::DIAGNOSTICOS, FaixaArmazenamento::AMOSTRAS};
+    const size_t lotes[] = {ARMAZENAMENTO_LOTE_DIAGNOSTICOS, ARMAZENAMENTO_LOTE_AMOSTRAS};
+    for (size_t i = 0; i < 2; i++)
+    {
+        size_t n = pendentes(acumuladas[i]);
+        if (n >= lotes[i] || (n > 0 && agora_ms - pendente_desde_ms[(int)acumuladas[i]] >= ARMAZENAMENTO_ESPERA_MAXIMA_MS))
+        {
+            faixa = acumuladas[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Lê o RTC uma vez e retorna a data/hora atual (s desde 1970, UTC).
+ *
+ * Sem RTC, usa a mesma data padrão de get_current_datetime_iso.
+ */
+static time_t lerRelogio(void)
+{
+    struct tm data = {};
+    ds3231_data_t dt;
+    if (rtc_update_datetime(&dt))
+    {
+        data.tm_year = (dt.century ? 2000 : 1900) + dt.year - 1900;
+        data.tm_mon = dt.month - 1;
+        data.tm_mday = dt.date;
+        data.tm_hour = dt.hours;
+        data.tm_min = dt.minutes;
+        data.tm_sec = dt.seconds;
+    }
+    else
+    {
+        data.tm_year = 2025 - 1900;
+        data.tm_mday = 1;
+        printf("Aviso: Não foi possível ler do RTC, usando data padrão\n");
+    }
+    return mktime(&data);
+}
+
+/**
+ * @brief Formata em ISO 8601 a data/hora de um instante passado (ms desde o boot).
+ * @param instante_ms Instante de origem do registro
+ * @param relogio_s Data/hora lida do RTC no início do lote
+ * @param agora_ms Instante da leitura do RTC (ms desde o boot)
+ * @param destino Buffer de pelo menos 21 bytes
+ * @param tamanho Tamanho do buffer
+ */
+static void formatarInstante(uint32_t instante_ms, time_t relogio_s, uint32_t agora_ms, char* destino, size_t tamanho)
+{
+    time_t instante_s = relogio_s - (time_t)((agora_ms - instante_ms + 500) / 1000);
+    struct tm data;
+    gmtime_r(&instante_s, &data);
+    strftime(destino, tamanho, "%Y-%m-%dT%H:%M:%SZ", &data);
+}
+
+// ===============================
+// Formatação dos lotes
+// ===============================
+// Os eventos são só lidos: saem da faixa depois de gravados (faixa_eventos.avancar)
+static uint32_t formatarEventos(time_t relogio_s, uint32_t agora_ms, size_t& tamanho)
+{
+    RegistroEvento registros[ARMAZENAMENTO_LOTE_EVENTOS];
+    size_t lidos = faixa_eventos.espiarLote(registros, ARMAZENAMENTO_LOTE_EVENTOS);
+    uint32_t linhas = 0;
+    while (linhas < lidos && sizeof(lote) - tamanho > LINHA_MAXIMA_EVENTO)
+    {
+        const RegistroEvento& registro = registros[linhas];
+        char inicio[25], fim[25];
+        uint32_t inicio_ms = registro.fim_ms - (uint32_t)registro.duracao_ms;
+        formatarInstante(inicio_ms, relogio_s, agora_ms, inicio, sizeof(inicio));
+        formatarInstante(registro.fim_ms, relogio_s, agora_ms, fim, sizeof(fim));
+
+        // Mesmo formato de add_csv_record: Inicio,Fim,Perna,Movimento,AnguloMaximo
+        tamanho += snprintf(lote + tamanho, sizeof(lote) - tamanho, "%s,%s,%s,%s,%.2f\n",
+                            inicio, fim, registro.lado == LadoCorpo::DIREITO ? "direita" : "esquerda",
+                            movToStr(registro.movimento), registro.angulo_max);
+        linhas++;
+    }
+    return linhas;
+}
+
+static uint32_t formatarDiagnosticos(time_t relogio_s, uint32_t agora_ms, size_t& tamanho)
+{
+    uint32_t linhas = 0;
+    MensagemDiagnostico mensagem;
+    while (linhas < ARMAZENAMENTO_LOTE_DIAGNOSTICOS && sizeof(lote) - tamanho > LINHA_MAXIMA_DIAGNOSTICO &&
+           faixa_diagnosticos.remover(mensagem))
+    {
+        char instante[25];
+        formatarInstante(mensagem.instante_ms, relogio_s, agora_ms, instante, sizeof(instante));
+        tamanho += snprintf(lote + tamanho, sizeof(lote) - tamanho, "%s,\"%s\"\n", instante, mensagem.texto);
+        linhas++;
+    }
+    return linhas;
+}
+
+static uint32_t formatarAmostras(time_t relogio_s, uint32_t agora_ms, size_t& tamanho)
+{
+    uint32_t linhas = 0;
+    char instante[25];
+    AmostraPostura amostra;
+    while (linhas < ARMAZENAMENTO_LOTE_AMOSTRAS && sizeof(lote) - tamanho > 2 * LINHA_MAXIMA_AMOSTRA &&
+           faixa_amostras.remover(amostra))
+    {
+        formatarInstante(amostra.instante_ms, relogio_s, agora_ms, instante, sizeof(instante));
+        tamanho += snprintf(lote + tamanho, sizeof(lote) - tamanho, "%s,amostra,1,%.2f,%.2f,%.2f,%.2f\n",
+                            instante, amostra.flexao, amostra.abducao, amostra.rotacao, amostra.incerteza);
+        linhas++;
+    }
+
+    // O resumo vai no mesmo lote (espaço reservado acima), depois das amostras individuais
+    if (resumo.quantidade > 0)
+    {
+        float n = (float)resumo.quantidade;
+        formatarInstante(resumo.fim_ms, relogio_s, agora_ms, instante, sizeof(instante));
+        tamanho += snprintf(lote + tamanho, sizeof(lote) - tamanho, "%s,resumo,%lu,%.2f,%.2f,%.2f,%.2f\n",
+                            instante, (unsigned long)resumo.quantidade, resumo.soma_flexao / n,
+                            resumo.soma_abducao / n, resumo.soma_rotacao / n, resumo.incerteza_maxima);
+        resumo = {};
+        linhas++;
+    }
+    return linhas;
+}
+
+// ===============================
+// Pedidos de gravação
+// ===============================
+bool armazenamento_aceita_evento(void)
+{
+    return faixa_eventos.tamanho() < faixa_eventos.capacidade();
+}
+
+ResultadoArmazenamento armazenamento_registrar_evento(const RegistroEvento& registro)
+{
+    bool estava_vazia = faixa_eventos.vazia();
+    if (!faixa_eventos.inserir(registro))
+    {
+        contadores(FaixaArmazenamento::EVENTOS).descartados++;
+        return ResultadoArmazenamento::DESCARTADO;
+    }
+    contarAceito(FaixaArmazenamento::EVENTOS, faixa_eventos.tamanho(), estava_vazia);
+    return ResultadoArmazenamento::ACEITO;
+}
+
+ResultadoArmazenamento armazenamento_registrar_amostra(const AmostraPostura& amostra)
+{
+    bool estava_vazia = pendentes(FaixaArmazenamento::AMOSTRAS) == 0;
+
+    // Sob pressão de eventos a faixa de amostras não cresce: o SDCard fica para os eventos
+    bool pressao = faixa_eventos.tamanho() >= ARMAZENAMENTO_PRESSAO_EVENTOS;
+    if (!pressao && faixa_amostras.inserir(amostra))
+    {
+        contarAceito(FaixaArmazenamento::AMOSTRAS, pendentes(FaixaArmazenamento::AMOSTRAS), estava_vazia);
+        return ResultadoArmazenamento::ACEITO;
+    }
+
+    resumo.quantidade++;
+    resumo.fim_ms = amostra.instante_ms;
+    resumo.soma_flexao += amostra.flexao;
+    resumo.soma_abducao += amostra.abducao;
+    resumo.soma_rotacao += amostra.rotacao;
+    if (amostra.incerteza > resumo.incerteza_maxima)
+    {
+        resumo.incerteza_maxima = amostra.incerteza;
+    }
+    contadores(FaixaArmazenamento::AMOSTRAS).resumidos++;
+    if (estava_vazia)
+    {
+        pendente_desde_ms[(int)FaixaArmazenamento::AMOSTRAS] = to_ms_since_boot(get_absolute_time());
+    }
+    return ResultadoArmazenamento::RESUMIDO;
+}
+
+ResultadoArmazenamento armazenamento_registrar_diagnostico(const char* formato, ...)
+{
+    MensagemDiagnostico mensagem;
+    mensagem.instante_ms = to_ms_since_boot(get_absolute_time());
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(mensagem.texto, sizeof(mensagem.texto), formato, args);
+    va_end(args);
+
+    bool estava_vazia = faixa_diagnosticos.vazia();
+    if (!faixa_diagnosticos.inserir(mensagem))
+    {
+        contadores(FaixaArmazenamento::DIAGNOSTICOS).descartados++;
+        return ResultadoArmazenamento::DESCARTADO;
+    }
+    contarAceito(FaixaArmazenamento::DIAGNOSTICOS, faixa_diagnosticos.tamanho(), estava_vazia);
+    return ResultadoArmazenamento::ACEITO;
+}
+
+// ===============================
+// Gravação
+// ===============================
+bool armazenamento_servir(void)
+{
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    FaixaArmazenamento faixa;
+    if (!proximaFaixaPronta(agora_ms, faixa))
+    {
+        return false;
+    }
+
+    uint64_t inicio_us = time_us_64();
+    time_t relogio_s = lerRelogio(); // Uma leitura do RTC por lote
+    size_t tamanho = 0;
+    uint32_t linhas = 0;
+    const char* arquivo = ARQUIVO_EVENTOS;
+    const char* cabecalho = CABECALHO_EVENTOS;
+
+    switch (faixa)
+    {
+        case FaixaArmazenamento::EVENTOS:
+            linhas = formatarEventos(relogio_s, agora_ms, tamanho);
+            break;
+        case FaixaArmazenamento::DIAGNOSTICOS:
+            linhas = formatarDiagnosticos(relogio_s, agora_ms, tamanho);
+            arquivo = ARQUIVO_DIAGNOSTICOS;
+            cabecalho = CABECALHO_DIAGNOSTICOS;
+            break;
+        default:
+            linhas = formatarAmostras(relogio_s, agora_ms, tamanho);
+            arquivo = ARQUIVO_AMOSTRAS;
+            cabecalho = CABECALHO_AMOSTRAS;
+            break;
+    }
+
+    // Uma abertura, escrita e fechamento para o lote inteiro
+    MEDICAO_INICIO(MEDICAO_GRAVACAO_SD);
+    bool sucesso = append_csv_block(arquivo, cabecalho, lote, tamanho);
+    MEDICAO_FIM(MEDICAO_GRAVACAO_SD);
+    uint32_t duracao_us = (uint32_t)(time_us_64() - inicio_us);
+
+    estatisticas.lotes++;
+    if (duracao_us > estatisticas.tempo_lote_maximo_us)
+    {
+        estatisticas.tempo_lote_maximo_us = duracao_us;
+    }
+    if (sucesso)
+    {
+        estatisticas.linhas_gravadas += linhas;
+        estatisticas.bytes_gravados += (uint32_t)tamanho;
+        if (faixa == FaixaArmazenamento::EVENTOS)
+        {
+            faixa_eventos.avancar(linhas);
+            espera_eventos_ms = 0;
+            printf("[SDCard] %lu evento(s) gravado(s) em %s (%lu us)\n",
+                   (unsigned long)linhas, arquivo, (unsigned long)duracao_us);
+        }
+    }
+    else if (faixa == FaixaArmazenamento::EVENTOS)
+    {
+        // Os eventos continuam na faixa: nova tentativa depois da espera, que dobra a cada falha seguida
+        estatisticas.falhas_gravacao++;
+        estatisticas.eventos_adiados += linhas;
+        falha_eventos_ms = agora_ms;
+        espera_eventos_ms = espera_eventos_ms == 0 ? ARMAZENAMENTO_ESPERA_FALHA_MS : 2 * espera_eventos_ms;
+        if (espera_eventos_ms > ARMAZENAMENTO_ESPERA_FALHA_MAXIMA_MS)
+        {
+            espera_eventos_ms = ARMAZENAMENTO_ESPERA_FALHA_MAXIMA_MS;
+        }
+    }
+    else
+    {
+        estatisticas.falhas_gravacao++;
+        estatisticas.linhas_perdidas += linhas;
+    }
+
+    // O que sobrou na faixa volta a contar a espera a partir de agora
+    if (pendentes(faixa) > 0)
+    {
+        pendente_desde_ms[(int)faixa] = agora_ms;
+    }
+
+    return proximaFaixaPronta(agora_ms, faixa);
+}
+
+// ===============================
+// Estatísticas
+// ===============================
+EstatisticasArmazenamento armazenamento_estatisticas(void)
+{
+    EstatisticasArmazenamento copia = estatisticas;
+    for (int i = 0; i < (int)FaixaArmazenamento::QUANTIDADE; i++)
+    {
+        copia.faixas[i].profundidade = (uint32_t)pendentes((FaixaArmazenamento)i);
+    }
+    return copia;
+}
+
+void armazenamento_imprimir_estatisticas(void)
+{
+    static const char* const NOMES[] = {"eventos", "diagnosticos", "amostras"};
+    static const uint32_t CAPACIDADES[] = {ARMAZENAMENTO_CAPACIDADE_EVENTOS, ARMAZENAMENTO_CAPACIDADE_DIAGNOSTICOS,
+                                           ARMAZENAMENTO_CAPACIDADE_AMOSTRAS};
+
+    EstatisticasArmazenamento atual = armazenamento_estatisticas();
+    printf("=== Armazenamento ===\n");
+    printf("%-12s %5s %5s %8s %8s %8s\n", "faixa", "prof.", "max", "aceitos", "resumid.", "descart.");
+    for (int i = 0; i < (int)FaixaArmazenamento::QUANTIDADE; i++)
+    {
+        const EstatisticasFaixa& f = atual.faixas[i];
+        printf("%-12s %2lu/%-2lu %5lu %8lu %8lu %8lu\n", NOMES[i], (unsigned long)f.profundidade,
+               (unsigned long)CAPACIDADES[i], (unsigned long)f.profundidade_maxima, (unsigned long)f.aceitos,
+               (unsigned long)f.resumidos, (unsigned long)f.descartados);
+    }
+    printf("Lotes: %lu | linhas: %lu (%lu bytes) | falhas: %lu (%lu linhas perdidas, %lu eventos adiados) | lote máx: %lu us\n",
+           (unsigned long)atual.lotes, (unsigned long)atual.linhas_gravadas, (unsigned long)atual.bytes_gravados,
+           (unsigned long)atual.falhas_gravacao, (unsigned long)atual.linhas_perdidas,
+           (unsigned long)atual.eventos_adiados, (unsigned long)atual.tempo_lote_maximo_us);
+}
+
+void armazenamento_reportar(void)
+{
+    // Perdas reportadas uma vez por aumento do contador
+    static uint32_t descartados_reportados[(int)FaixaArmazenamento::QUANTIDADE] = {};
+    static uint32_t falhas_reportadas = 0;
+    static const char* const NOMES[] = {"evento(s)", "diagnóstico(s)", "amostra(s)"};
+
+    for (int i = 0; i < (int)FaixaArmazenamento::QUANTIDADE; i++)
+    {
+        uint32_t descartados = estatisticas.faixas[i].descartados;
+        if (descartados != descartados_reportados[i])
+        {
+            printf("[SDCard] %lu %s descartado(s) - faixa cheia\n",
+                   (unsigned long)(descartados - descartados_reportados[i]), NOMES[i]);
+            descartados_reportados[i] = descartados;
+        }
+    }
+    if (estatisticas.falhas_gravacao != falhas_reportadas)
+    {
+        printf("[SDCard] ERRO: %lu lote(s) não gravado(s), %lu linha(s) perdida(s) no total, %lu evento(s) aguardando nova tentativa\n",
+               (unsigned long)(estatisticas.falhas_gravacao - falhas_reportadas),
+               (unsigned long)estatisticas.linhas_perdidas, (unsigned long)faixa_eventos.tamanho());
+        falhas_reportadas = estatisticas.falhas_gravacao;
+    }
+}
@@ -0,0 +1,413 @@
+// ======================================================================
+//  Arquivo: captura_sensores.cpp
+//  Descrição: Captura dos bytes brutos dos sensores em IRQ (timer e DMA
+//             do I2C) com processamento adiado no laço do núcleo 1
+// ======================================================================
+
+#include "captura_sensores.h"
+#include "fila_spsc.hpp"     // Fila sem trava entre a IRQ e o laço
+#include "pool_quadros.hpp"  // Quadros entregues por índice, com contagem de referências
+#include "pico/stdlib.h"     // time_us_64
+#include "hardware/dma.h"    // Canais de DMA do I2C
+#include "hardware/i2c.h"    // Registradores do I2C (IC_DATA_CMD)
+#include "hardware/irq.h"    // IRQ de conclusão do DMA
+#include "hardware/sync.h"   // save_and_disable_interrupts
+
+extern "C" {
+    #include "mpu9250_regs.h" // INT_STATUS, FIFO_COUNT, FIFO_R_W, EXT_SENS_DATA
+}
+
+// ===============================
+// Estado (núcleo 1)
+// ===============================
+
+// Leitura em andamento dentro da captura de um sensor
+enum class EtapaCaptura : uint8_t {
+    STATUS,   ///< INT_STATUS (transbordo da FIFO)
+    CONTAGEM, ///< FIFO_COUNTH/L
+    FIFO,     ///< Amostras de FIFO_R_W
+    MAG       ///< EXT_SENS_DATA_00..07
+};
+
+// Quadros da captura e índices dos capturados, da IRQ (produtor) para o laço
+// (consumidor), no mesmo núcleo. A fila comporta todos os quadros do pool:
+// a inserção nunca falha e a contrapressão fica na alocação
+static PoolQuadros<QuadroAmostras, CAPTURA_QUADROS> quadros;
+static FilaSpsc<uint8_t, 32> fila_quadros;
+static_assert(decltype(fila_quadros)::capacidade() >= CAPTURA_QUADROS, "A fila de índices deve comportar o pool inteiro");
+static_assert(decltype(quadros)::NENHUM == CAPTURA_SEM_QUADRO, "Índice inválido do pool e da interface");
+
+static mpu9250_t* sensores = nullptr;
+static size_t quantidade = 0;
+static i2c_inst_t* barramento = nullptr;
+static bool fifo_valida[CAPTURA_MAXIMO_SENSORES] = {}; // false até captura_reiniciar_fifos e após um transbordo
+
+// Canais de DMA: comandos para IC_DATA_CMD (TX) e bytes recebidos (RX)
+static int canal_tx = -1;
+static int canal_rx = -1;
+static dma_channel_config config_tx;
+static dma_channel_config config_rx;
+static uint32_t comandos[1 + CAPTURA_AMOSTRAS_POR_QUADRO * MPU9250_FIFO_BYTES_AMOSTRA]; // Registrador e um comando de leitura por byte
+
+static repeating_timer_t timer;
+
+// Cadeia em andamento (escrita pelas IRQs; o laço só lê ocupada e escreve pausada)
+static volatile bool ocupada = false;   // Há leitura por DMA em andamento
+static volatile bool pausada = false;   // O laço pediu o barramento
+static uint64_t inicio_captura_us = 0;
+static size_t sensor_atual = 0;
+static EtapaCaptura etapa = EtapaCaptura::STATUS;
+static uint8_t status_int = 0;
+static uint8_t contagem[2] = {0, 0};
+static uint8_t quadro_atual = CAPTURA_SEM_QUADRO; // Quadro sendo preenchido pelo DMA
+
+// Contadores escritos só pelas IRQs (palavras de 32 bits: leitura atômica no núcleo 0)
+static volatile EstatisticasCaptura estatisticas = {};
+
+// ===============================
+// IRQ: leitura por DMA
+// ===============================
+/**
+ * @brief Inicia a leitura de n bytes a partir de um registrador do sensor atual.
+ *
+ * O DMA de TX escreve em IC_DATA_CMD o endereço do registrador e n comandos de
+ * leitura (RESTART no primeiro, STOP no último); o de RX copia os bytes
+ * recebidos e, ao terminar, gera a IRQ que avança a cadeia.
+ */
+static void ler(uint8_t registrador, uint8_t* destino, uint16_t n)
+{
+    i2c_hw_t* hw = i2c_get_hw(barramento);
+    hw->enable = 0;
+    hw->tar = sensores[sensor_atual].addr;
+    hw->enable = 1;
+
+    comandos[0] = registrador;
+    for (uint16_t k = 0; k < n; k++)
+    {
+        comandos[1 + k] = I2C_IC_DATA_CMD_CMD_BITS;
+    }
+    comandos[1] |= I2C_IC_DATA_CMD_RESTART_BITS;
+    comandos[n] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    dma_channel_configure(canal_rx, &config_rx, destino, &hw->data_cmd, n, true);
+    dma_channel_configure(canal_tx, &config_tx, &hw->data_cmd, comandos, n + 1u, true);
+}
+
+/**
+ * @brief Encerra a cadeia: carimba o quadro e insere o seu índice na fila ou,
+ *        sem nada capturado, devolve-o ao pool.
+ */
+static void concluirQuadro(void)
+{
+    QuadroAmostras& quadro = quadros[quadro_atual];
+    quadro.instante_us = time_us_64();
+
+    bool capturou = quadro.transbordo;
+    for (size_t i = 0; i < quantidade; i++)
+    {
+        capturou |= quadro.amostras[i] > 0 || quadro.mag_lido[i];
+    }
+    if (capturou)
+    {
+        fila_quadros.inserir(quadro_atual); // A referência da alocação passa ao laço
+    }
+    else
+    {
+        quadros.liberar(quadro_atual);
+    }
+    quadro_atual = CAPTURA_SEM_QUADRO;
+    ocupada = false;
+}
+
+/**
+ * @brief Começa a captura do próximo sensor com FIFO válida a partir de i;
+ *        sem nenhum, encerra a cadeia.
+ */
+static void iniciarSensor(size_t i)
+{
+    while (i < quantidade && !fifo_valida[i])
+    {
+        i++;
+    }
+    if (i >= quantidade)
+    {
+        concluirQuadro();
+        return;
+    }
+
+    sensor_atual = i;
+    etapa = EtapaCaptura::STATUS;
+    ler(MPU9250_INT_STATUS, &status_int, 1);
+}
+
+/**
+ * @brief Lê o magnetômetro do sensor atual, se habilitado e sem transbordo;
+ *        senão passa ao próximo sensor.
+ */
+static void lerMagnetometro(void)
+{
+    const mpu9250_t& mpu = sensores[sensor_atual];
+    if (mpu.mag_enabled && !mpu.mag_overflow)
+    {
+        etapa = EtapaCaptura::MAG;
+        ler(MPU9250_EXT_SENS_DATA_00, quadros[quadro_atual].mag[sensor_atual], sizeof(QuadroAmostras::mag[0]));
+        return;
+    }
+    iniciarSensor(sensor_atual + 1);
+}
+
+/**
+ * @brief IRQ de conclusão do DMA de RX: passa à leitura seguinte da cadeia.
+ */
+static void aoConcluirDma(void)
+{
+    dma_channel_acknowledge_irq1(canal_rx);
+    QuadroAmostras& quadro = quadros[quadro_atual];
+
+    switch (etapa)
+    {
+        case EtapaCaptura::STATUS:
+            if (status_int & INT_FIFO_OFLOW)
+            {
+                // Conteúdo desalinhado: a FIFO deixa de ser lida até captura_reiniciar_fifos,
+                // que descarta também o restante desta captura
+                quadro.transbordo = true;
+                fifo_valida[sensor_atual] = false;
+                estatisticas.transbordos = estatisticas.transbordos + 1;
+                concluirQuadro();
+                return;
+            }
+            etapa = EtapaCaptura::CONTAGEM;
+            ler(MPU9250_FIFO_COUNTH, contagem, sizeof(contagem));
+            return;
+
+        case EtapaCaptura::CONTAGEM:
+        {
+            uint16_t bytes = (uint16_t)(((contagem[0] & 0x1F) << 8) | contagem[1]);
+            uint16_t amostras = bytes / MPU9250_FIFO_BYTES_AMOSTRA;
+            if (amostras > CAPTURA_AMOSTRAS_POR_QUADRO) amostras = CAPTURA_AMOSTRAS_POR_QUADRO;
+            quadro.amostras[sensor_atual] = (uint8_t)amostras;
+            if (amostras > 0)
+            {
+                etapa = EtapaCaptura::FIFO;
+                ler(MPU9250_FIFO_R_W, quadro.fifo[sensor_atual].bytes, (uint16_t)(amostras * MPU9250_FIFO_BYTES_AMOSTRA));
+                return;
+            }
+            lerMagnetometro();
+            return;
+        }
+
+        case EtapaCaptura::FIFO:
+            lerMagnetometro();
+            return;
+
+        case EtapaCaptura::MAG:
+            quadro.mag_lido[sensor_atual] = true;
+            iniciarSensor(sensor_atual + 1);
+            return;
+    }
+}
+
+/**
+ * @brief Aborta a cadeia parada (sensor sem resposta: o RX nunca completa).
+ */
+static void abortarCaptura(void)
+{
+    dma_channel_set_irq1_enabled(canal_rx, false);
+    dma_channel_abort(canal_tx);
+    dma_channel_abort(canal_rx);
+    dma_channel_acknowledge_irq1(canal_rx);
+    dma_channel_set_irq1_enabled(canal_rx, true);
+
+    i2c_hw_t* hw = i2c_get_hw(barramento);
+    (void)hw->clr_tx_abrt;
+    while (hw->rxflr)
+    {
+        (void)hw->data_cmd;
+    }
+
+    // O DMA parou: o quadro incompleto volta ao pool
+    quadros.liberar(quadro_atual);
+    quadro_atual = CAPTURA_SEM_QUADRO;
+    estatisticas.falhas_barramento = estatisticas.falhas_barramento + 1;
+    ocupada = false;
+}
+
+// ===============================
+// IRQ: disparo pelo timer
+// ===============================
+static bool aoDispararCaptura(repeating_timer_t*)
+{
+    if (ocupada)
+    {
+        if (time_us_64() - inicio_captura_us > CAPTURA_LIMITE_US)
+        {
+            abortarCaptura();
+        }
+        return true;
+    }
+    if (pausada)
+    {
+        return true;
+    }
+
+    bool alguma_valida = false;
+    for (size_t i = 0; i < quantidade; i++)
+    {
+        alguma_valida |= fifo_valida[i];
+    }
+    if (!alguma_valida)
+    {
+        return true;
+    }
+
+    // Contrapressão: sem quadro livre (estágios ainda com os anteriores), as
+    // amostras esperam na FIFO do sensor
+    quadro_atual = quadros.alocar();
+    if (quadro_atual == CAPTURA_SEM_QUADRO)
+    {
+        estatisticas.capturas_adiadas = estatisticas.capturas_adiadas + 1;
+        return true;
+    }
+    QuadroAmostras& quadro = quadros[quadro_atual];
+    quadro.transbordo = false;
+    quadro.convertido = false;
+    quadro.avaliado = false;
+    quadro.entregue = false;
+    for (size_t i = 0; i < CAPTURA_MAXIMO_SENSORES; i++)
+    {
+        quadro.amostras[i] = 0;
+        quadro.mag_lido[i] = false;
+        quadro.fundidas[i] = 0;
+    }
+
+    ocupada = true;
+    inicio_captura_us = time_us_64();
+    estatisticas.capturas = estatisticas.capturas + 1;
+    iniciarSensor(0);
+    return true;
+}
+
+// ===============================
+// Inicialização (núcleo 1)
+// ===============================
+bool captura_iniciar(mpu9250_t* mpu_list, size_t n, alarm_pool_t* pool)
+{
+    sensores = mpu_list;
+    quantidade = n < CAPTURA_MAXIMO_SENSORES ? n : CAPTURA_MAXIMO_SENSORES;
+    barramento = mpu_list[0].i2c;
+
+    canal_tx = dma_claim_unused_channel(false);
+    canal_rx = dma_claim_unused_channel(false);
+    if (canal_tx < 0 || canal_rx < 0 || pool == nullptr)
+    {
+        return false;
+    }
+
+    // TX: palavras de comando da memória para IC_DATA_CMD, no ritmo do I2C
+    config_tx = dma_channel_get_default_config(canal_tx);
+    channel_config_set_transfer_data_size(&config_tx, DMA_SIZE_32);
+    channel_config_set_read_increment(&config_tx, true);
+    channel_config_set_write_increment(&config_tx, false);
+    channel_config_set_dreq(&config_tx, i2c_get_dreq(barramento, true));
+
+    // RX: bytes de IC_DATA_CMD direto para o quadro
+    config_rx = dma_channel_get_default_config(canal_rx);
+    channel_config_set_transfer_data_size(&config_rx, DMA_SIZE_8);
+    channel_config_set_read_increment(&config_rx, false);
+    channel_config_set_write_increment(&config_rx, true);
+    channel_config_set_dreq(&config_rx, i2c_get_dreq(barramento, false));
+
+    // DMA_IRQ_1 neste núcleo (o SDCard, no núcleo 0, usa a DMA_IRQ_0)
+    dma_channel_set_irq1_enabled(canal_rx, true);
+    irq_set_exclusive_handler(DMA_IRQ_1, aoConcluirDma);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // Atraso negativo: taxa fixa, como o agendador
+    return alarm_pool_add_repeating_timer_us(pool, -(int64_t)CAPTURA_PERIODO_US, aoDispararCaptura, nullptr, &timer);
+}
+
+// ===============================
+// Laço do núcleo 1
+// ===============================
+size_t captura_remover_lote(uint8_t* destino, size_t max)
+{
+    return fila_quadros.removerLote(destino, max);
+}
+
+QuadroAmostras& captura_quadro(uint8_t indice)
+{
+    return quadros[indice];
+}
+
+void captura_reter(uint8_t indice)
+{
+    quadros.reter(indice);
+}
+
+void captura_liberar(uint8_t indice)
+{
+    quadros.liberar(indice);
+}
+
+bool captura_solicitar_barramento(void)
+{
+    // Mesmo núcleo das IRQs: depois de pausada, nenhuma cadeia nova começa
+    pausada = true;
+    return !ocupada;
+}
+
+void captura_devolver_barramento(void)
+{
+    pausada = false;
+}
+
+void captura_parar(void)
+{
+    // Com as IRQs mascaradas a IRQ do DMA não avança a cadeia durante o aborto
+    uint32_t estado = save_and_disable_interrupts();
+    cancel_repeating_timer(&timer);
+    pausada = true;
+    if (ocupada)
+    {
+        abortarCaptura();
+    }
+    restore_interrupts(estado);
+}
+
+bool captura_reiniciar_fifos(void)
+{
+    if (!captura_solicitar_barramento())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < quantidade; i++)
+    {
+        mpu9250_fifo_enable(&sensores[i], true);
+        fifo_valida[i] = true;
+    }
+
+    // Quadros anteriores ao reinício não se pareiam com as amostras novas
+    uint8_t descartado;
+    while (fila_quadros.remover(descartado))
+    {
+        quadros.liberar(descartado);
+    }
+
+    captura_devolver_barramento();
+    return true;
+}
+
+EstatisticasCaptura captura_estatisticas(void)
+{
+    EstatisticasCaptura copia;
+    copia.capturas = estatisticas.capturas;
+    copia.capturas_adiadas = estatisticas.capturas_adiadas;
+    copia.transbordos = estatisticas.transbordos;
+    copia.falhas_barramento = estatisticas.falhas_barramento;
+    copia.quadros_alocados = quadros.alocacoes();
+    copia.quadros_devolvidos = quadros.devolucoes();
+    copia.quadros_maximo_em_uso = quadros.maximoEmUso();
+    return copia;
+}
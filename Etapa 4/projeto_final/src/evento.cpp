@@ -18,8 +18,8 @@ Evento::Evento(TipoMovimento movimento, LadoCorpo lado, float anguloInicial)
       lado_(lado),                      //     nas variáveis do objeto
       angulo_(anguloInicial),            
       inicio_(std::chrono::system_clock::now()),  
-      start_(std::chrono::steady_clock::now()),
-      fim_()
+      fim_(),
+      start_(std::chrono::steady_clock::now())
 { 
 
 }
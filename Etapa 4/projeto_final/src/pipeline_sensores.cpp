@@ -0,0 +1,535 @@
+// ======================================================================
+//  Arquivo: pipeline_sensores.cpp
+//  Descrição: Laço de tempo real no núcleo 1 e filas de comunicação com
+//             o laço de E/S do núcleo 0
+// ======================================================================
+
+#include "pipeline_sensores.h"
+#include "analise_postural.h"   // atualizarFusao, getPosition, dangerCheck, controle do alarme
+#include <cstdarg>              // va_list para pipeline_log
+#include <cstdio>               // vsnprintf, printf
+#include "pico/stdlib.h"        // Funções de tempo do Pico SDK
+#include "pico/multicore.h"     // Lançamento do núcleo 1
+#include "fila_spsc.hpp"        // Filas sem trava entre os núcleos
+#include "armazenamento.h"      // Faixas de gravação no SDCard (núcleo 0)
+#include "sequencias_mpu9250.h" // Recuperação do magnetômetro em etapas
+#include "captura_sensores.h"   // Captura dos sensores em IRQ e posse do barramento
+
+extern "C" {
+    #include "sensor_watchdog.h" // Detecção de sensores travados, verificada pelo laço de tempo real
+    #include "supervisor.h"      // Batimentos do núcleo 1 e dos sensores para o watchdog de hardware
+    #include "agendador.h"       // Liberação dos períodos por timer e contabilidade de estouros
+    #include "medicao.h"         // Tempos por etapa (só com MEDIR_TEMPOS)
+}
+
+// ===============================
+// Estado compartilhado entre os núcleos
+// ===============================
+
+// Mensagem de log formatada no núcleo 1 e impressa no núcleo 0
+typedef struct {
+    char texto[PIPELINE_TAMANHO_MENSAGEM];
+} MensagemLog;
+
+// Filas de um produtor e um consumidor: nenhum núcleo espera pelo outro
+static FilaSpsc<RegistroEvento, PIPELINE_CAPACIDADE_REGISTROS> fila_registros; // Núcleo 1 -> núcleo 0: eventos encerrados para o SDCard
+static FilaSpsc<uint8_t, PIPELINE_CAPACIDADE_AMOSTRAS> fila_amostras;        // Núcleo 1 -> núcleo 0: quadros com os ângulos da amostra periódica
+static FilaSpsc<uint8_t, PIPELINE_CAPACIDADE_AMOSTRAS> fila_devolucoes;      // Núcleo 0 -> núcleo 1: quadros já lidos, para liberar
+static FilaSpsc<MensagemLog, PIPELINE_CAPACIDADE_LOG> fila_log;                // Núcleo 1 -> núcleo 0: mensagens de log
+static FilaSpsc<ComandoPipeline, PIPELINE_CAPACIDADE_COMANDOS> fila_comandos;  // Núcleo 0 -> núcleo 1: comandos do usuário
+
+// Quadros fora do pool no pior caso: os retidos pela fusão, o recente anotado por
+// getPosition, os em posse do núcleo 0 e os capturados desde o último período
+static_assert(MAXIMO_QUADROS_RETIDOS + 1 + PIPELINE_CAPACIDADE_AMOSTRAS +
+                  PIPELINE_PERIODO_LEITURA_US / CAPTURA_PERIODO_US <= CAPTURA_QUADROS,
+              "Os estágios do pipeline não cabem no pool de quadros da captura");
+
+// Mensagens de log retiradas por vez no núcleo 0 (uma liberação de índice por lote)
+static const size_t LOTE_LOG = 4;
+
+// Quadros entregues ao núcleo 0 e ainda não devolvidos (só o núcleo 1 escreve): limitados
+// à capacidade da fila de devoluções, que assim nunca enche
+static uint32_t quadros_no_nucleo0 = 0;
+
+// Contadores escritos pelo núcleo 1 (palavras de 32 bits: leitura atômica no núcleo 0)
+static volatile EstatisticasPipeline estatisticas = {};
+
+// Sensores usados pelo núcleo 1 (os 2 de pipeline_lancar_nucleo1) e sua pilha própria
+static const size_t NUM_SENSORES = 2;
+static mpu9250_t* sensores = nullptr;
+static uint32_t pilha_nucleo1[PIPELINE_PILHA_NUCLEO1_BYTES / sizeof(uint32_t)];
+
+// Recuperação do magnetômetro em andamento: uma por vez, pois no bypass os dois
+// AK8963 ficariam no mesmo endereço do barramento
+static Corrotina recuperacao_mag;
+
+// ===============================
+// Núcleo 1: sequências de hardware
+// ===============================
+/**
+ * @brief Avança a recuperação do magnetômetro em andamento ou inicia a de um
+ *        sensor saturado. Cada etapa é uma ou duas transações I2C curtas; as
+ *        esperas passam entre os períodos, sem atrasar a fusão.
+ */
+static void avancarRecuperacaoMagnetometro(void)
+{
+    if (recuperacao_mag.retomar(time_us_64()))
+    {
+        return;
+    }
+    recuperacao_mag = Corrotina(); // Libera o quadro da anterior antes de criar outra
+
+    for (size_t i = 0; i < NUM_SENSORES; i++)
+    {
+        if (sensores[i].mag_overflow)
+        {
+            recuperacao_mag = sequenciaRecuperarMagnetometro(&sensores[i]);
+            if (recuperacao_mag.valida())
+            {
+                estatisticas.recuperacoes_mag = estatisticas.recuperacoes_mag + 1;
+                pipeline_log("Magnetômetro do sensor %u saturado - recuperando em etapas\n", (unsigned)sensores[i].id);
+                recuperacao_mag.retomar(time_us_64());
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Roda a recuperação do magnetômetro com o barramento tomado da captura.
+ *
+ * Só pede o barramento quando há sequência em andamento ou sensor saturado;
+ * com uma captura em andamento, a etapa fica para o próximo período (o pedido
+ * segue valendo e a condição não muda até lá).
+ */
+static void servirRecuperacaoMagnetometro(void)
+{
+    bool saturado = false;
+    for (size_t i = 0; i < NUM_SENSORES; i++)
+    {
+        saturado |= sensores[i].mag_overflow;
+    }
+    if (recuperacao_mag.concluida() && !saturado)
+    {
+        return;
+    }
+
+    if (captura_solicitar_barramento())
+    {
+        avancarRecuperacaoMagnetometro();
+        captura_devolver_barramento();
+    }
+}
+
+/**
+ * @brief Avisa, pela fila de log, quais sensores travaram antes do reinício.
+ *        O núcleo 0 imprime as mensagens enquanto o watchdog não dispara.
+ */
+static void avisarSensoresTravados(void)
+{
+    pipeline_log("*** ALERTA: SENSOR(ES) TRAVADO(S) DETECTADO(S)! ***\n");
+    for (size_t i = 0; i < NUM_SENSORES; i++)
+    {
+        if (sensor_watchdog_is_sensor_frozen(sensores[i].id))
+        {
+            pipeline_log("*** SENSOR %u TRAVADO! ***\n", (unsigned)sensores[i].id);
+        }
+    }
+    pipeline_log("Reiniciando o barramento I2C; a placa reinicia pelo watchdog\n");
+}
+
+// ===============================
+// Núcleo 1: comandos do usuário
+// ===============================
+/**
+ * @brief Executa um comando vindo da interface no núcleo 1, que é dono do estado do alarme.
+ * @param comando Comando recebido
+ */
+static void executarComando(ComandoPipeline comando)
+{
+    switch (comando)
+    {
+        case ComandoPipeline::ALTERNAR_SILENCIO:
+            if (!alarme_esta_ligado())
+            {
+                pipeline_log("Botão A: alarme não está ativo no momento\n");
+            }
+            else if (alarme_esta_silenciado())
+            {
+                desilenciar_alarme();
+            }
+            else
+            {
+                silenciar_alarme();
+            }
+            break;
+    }
+}
+
+// ===============================
+// Núcleo 1: laço de tempo real
+// ===============================
+
+// Um período por leitura da FIFO; a avaliação postural roda a cada n períodos
+static constexpr uint32_t PERIODO_AVALIACAO_US = 1000000 / TAXA_AVALIACAO_HZ;
+static constexpr uint32_t PERIODO_US = PERIODO_AVALIACAO_US < PIPELINE_PERIODO_LEITURA_US ? PERIODO_AVALIACAO_US : PIPELINE_PERIODO_LEITURA_US;
+static constexpr uint32_t PERIODOS_POR_AVALIACAO = PERIODO_AVALIACAO_US / PERIODO_US;
+static constexpr uint32_t ORCAMENTO_US = PERIODO_US * PIPELINE_ORCAMENTO_PERCENTUAL / 100;
+static_assert(PERIODO_AVALIACAO_US % PERIODO_US == 0,
+              "O período de avaliação deve ser múltiplo do período de leitura");
+
+// Agendador do núcleo 1 (timer, atraso e estouros)
+static agendador_t agendador;
+
+// Partes do supervisor: o laço do núcleo 1 e a chegada de amostras dos sensores
+static int parte_nucleo1 = SUPERVISOR_NENHUMA;
+static int parte_sensores = SUPERVISOR_NENHUMA;
+
+/**
+ * @brief Libera os quadros que o núcleo 0 já leu (a contagem de referências só
+ *        muda no núcleo 1: o M0+ não tem operação atômica entre núcleos).
+ */
+static void liberarQuadrosDevolvidos(void)
+{
+    uint8_t indice;
+    while (fila_devolucoes.remover(indice))
+    {
+        captura_liberar(indice);
+        quadros_no_nucleo0--;
+    }
+}
+
+/**
+ * @brief Copia a contabilidade do agendador para os contadores lidos pelo núcleo 0.
+ */
+static void publicarEstatisticas(void)
+{
+    estatisticas.periodos = agendador.periodos;
+    estatisticas.periodos_perdidos = agendador.periodos_perdidos;
+    estatisticas.estouros = agendador.estouros;
+    estatisticas.periodos_degradados = agendador.periodos_degradados;
+    estatisticas.atraso_maximo_us = agendador.atraso_maximo_us;
+    estatisticas.atraso_medio_us = agendador.periodos > 0 ? (uint32_t)(agendador.atraso_total_us / agendador.periodos) : 0;
+    estatisticas.trabalho_maximo_us = agendador.trabalho_maximo_us;
+    estatisticas.amostras_sem_par = amostrasDescartadasFusao();
+
+    EstatisticasCaptura captura = captura_estatisticas();
+    estatisticas.capturas_adiadas = captura.capturas_adiadas;
+    estatisticas.transbordos_fifo = captura.transbordos;
+    estatisticas.falhas_captura = captura.falhas_barramento;
+    estatisticas.quadros_alocados = captura.quadros_alocados;
+    estatisticas.quadros_devolvidos = captura.quadros_devolvidos;
+    estatisticas.quadros_maximo_em_uso = captura.quadros_maximo_em_uso;
+}
+
+/**
+ * @brief Laço do núcleo 1: fusão na cadência da FIFO, avaliação postural e watchdog.
+ *
+ * Cada período é liberado por um timer de hardware do próprio núcleo 1, a taxa
+ * fixa (PIPELINE_PERIODO_LEITURA_US, avaliação a TAXA_AVALIACAO_HZ); entre os
+ * períodos o núcleo dorme em WFE. Os bytes dos sensores chegam por outro timer
+ * e pelo DMA, em IRQ (captura_sensores.h), em quadros de um pool: o laço só
+ * converte e funde o que foi capturado, no próprio quadro, então um período
+ * longo não perde amostras. Períodos atrasados não são recuperados: o
+ * laço atende o mais recente e conta os perdidos. Um período acima do
+ * orçamento desliga os logs detalhados até a carga voltar ao normal; a fusão,
+ * a detecção, o alarme e o watchdog rodam sempre.
+ *
+ * Nada aqui espera pelo núcleo 0: logs e eventos saem por filas sem trava e o
+ * buzzer é acionado diretamente por dangerCheck. O watchdog de hardware só é
+ * alimentado (pelo supervisor, no núcleo 0) enquanto este laço e os sensores
+ * mandam batimentos.
+ */
+static void nucleo1_principal(void)
+{
+    agendador_iniciar(&agendador, PERIODO_US, ORCAMENTO_US, time_us_64());
+    if (!agendador_iniciar_timer(&agendador))
+    {
+        // Sem alarme de hardware livre: nada libera os períodos e o watchdog reinicia a placa
+        pipeline_log("[PIPELINE] ERRO: sem alarme de hardware para o agendador do núcleo 1\n");
+    }
+    if (!captura_iniciar(sensores, NUM_SENSORES, agendador.pool))
+    {
+        // Sem captura nenhum quadro traz amostras: atualizarFusao não confirma amostras novas,
+        // a parte "sensores" fica sem batimento e o supervisor deixa o watchdog reiniciar a placa
+        pipeline_log("[PIPELINE] ERRO: sem timer ou canal de DMA para a captura dos sensores\n");
+    }
+
+    uint32_t ultimo_periodo_avaliado = 0;
+    bool primeira_avaliacao = true;
+
+    while (true)
+    {
+        // --- Espera a liberação do próximo período pelo timer ---
+        agendador_aguardar(&agendador);
+        uint32_t periodo = agendador_comecar_periodo(&agendador, time_us_64());
+        MEDICAO_INICIO(MEDICAO_PERIODO_NUCLEO1);
+
+        // --- Comandos do usuário (núcleo 0) ---
+        ComandoPipeline comando;
+        while (fila_comandos.remover(comando))
+        {
+            executarComando(comando);
+        }
+
+        // --- Quadros devolvidos pelo núcleo 0 e fusão sensorial na taxa dos sensores ---
+        liberarQuadrosDevolvidos();
+        bool amostras_novas = atualizarFusao(sensores);
+
+        // --- Sequências de hardware longas, uma etapa por período ---
+        servirRecuperacaoMagnetometro();
+
+        // --- Avaliação postural na taxa menor (sem recuperar as perdidas) ---
+        if (primeira_avaliacao || periodo - ultimo_periodo_avaliado >= PERIODOS_POR_AVALIACAO)
+        {
+            primeira_avaliacao = false;
+            ultimo_periodo_avaliado = periodo;
+            definirLogDetalhado(agendador_baixa_prioridade(&agendador));
+            MEDICAO_INICIO(MEDICAO_GET_POSITION);
+            const Orientacao& orientacao = getPosition();
+            MEDICAO_FIM(MEDICAO_GET_POSITION);
+
+            MEDICAO_INICIO(MEDICAO_DANGER_CHECK);
+            dangerCheck(orientacao);
+            MEDICAO_FIM(MEDICAO_DANGER_CHECK);
+
+            // Verificação pelo outro núcleo: um núcleo 0 parado fica registrado antes do reinício
+            supervisor_verificar();
+        }
+
+        // --- Sensores travados (reinicia a placa) e batimentos para o supervisor ---
+        if (sensor_watchdog_update())
+        {
+            avisarSensoresTravados();
+            captura_parar(); // Sem DMA no barramento enquanto o reset toma os pinos do I2C
+            sensor_watchdog_reset_system(); // Não retorna: sem batimentos, o supervisor deixa o watchdog reiniciar
+        }
+        supervisor_batimento(parte_nucleo1);
+        if (amostras_novas)
+        {
+            supervisor_batimento(parte_sensores); // Só com amostras novas de todos os sensores neste período
+        }
+
+        MEDICAO_FIM(MEDICAO_PERIODO_NUCLEO1);
+        agendador_terminar_periodo(&agendador, time_us_64());
+        publicarEstatisticas();
+    }
+}
+
+// ===============================
+// Inicialização (núcleo 0)
+// ===============================
+void pipeline_lancar_nucleo1(mpu9250_t mpu_list[2])
+{
+    sensores = mpu_list;
+    parte_nucleo1 = supervisor_registrar("nucleo1", PIPELINE_PRAZO_NUCLEO1_MS);
+    parte_sensores = supervisor_registrar("sensores", PIPELINE_PRAZO_SENSORES_MS);
+    multicore_launch_core1_with_stack(nucleo1_principal, pilha_nucleo1, sizeof(pilha_nucleo1));
+}
+
+// ===============================
+// E/S (núcleo 0)
+// ===============================
+bool pipeline_servir_logs(void)
+{
+    bool processou = false;
+
+    MensagemLog mensagens[LOTE_LOG];
+    size_t lidas;
+    while ((lidas = fila_log.removerLote(mensagens, LOTE_LOG)) > 0)
+    {
+        for (size_t i = 0; i < lidas; i++)
+        {
+            printf("%s", mensagens[i].texto);
+        }
+        processou = true;
+    }
+    return processou;
+}
+
+bool pipeline_encaminhar_armazenamento(void)
+{
+    bool encaminhou = false;
+
+    // Eventos só saem da fila do núcleo 1 com espaço na faixa: a contrapressão chega à origem
+    RegistroEvento registro;
+    while (armazenamento_aceita_evento() && fila_registros.remover(registro))
+    {
+        armazenamento_registrar_evento(registro);
+        encaminhou = true;
+    }
+
+    // Amostras sempre saem: sob pressão o armazenamento as resume. Os ângulos são
+    // lidos do quadro anotado pelo núcleo 1, que recebe o índice de volta para liberá-lo
+    uint8_t indice;
+    while (fila_amostras.remover(indice))
+    {
+        const QuadroAmostras& quadro = captura_quadro(indice);
+        AmostraPostura amostra = {(uint32_t)(quadro.instante_us / 1000), quadro.orientacao.flexao,
+                                  quadro.orientacao.abducao, quadro.orientacao.rotacao, quadro.orientacao.incerteza};
+        fila_devolucoes.inserir(indice);
+        armazenamento_registrar_amostra(amostra);
+        encaminhou = true;
+    }
+    return encaminhou;
+}
+
+void pipeline_reportar(void)
+{
+    // Perdas reportadas uma vez por aumento do contador
+    static uint32_t registros_perdidos_reportados = 0;
+    static uint32_t logs_perdidos_reportados = 0;
+    static uint32_t amostras_perdidas_reportadas = 0;
+    static uint32_t falhas_captura_reportadas = 0;
+    static uint32_t amostras_sem_par_reportadas = 0;
+    EstatisticasPipeline atual = pipeline_estatisticas();
+    if (atual.registros_perdidos != registros_perdidos_reportados)
+    {
+        printf("[PIPELINE] ERRO: %lu evento(s) encerrado(s) perdido(s) - fila de gravação cheia\n",
+               (unsigned long)(atual.registros_perdidos - registros_perdidos_reportados));
+        armazenamento_registrar_diagnostico("%lu evento(s) perdido(s) na fila do núcleo 1",
+                                            (unsigned long)(atual.registros_perdidos - registros_perdidos_reportados));
+        registros_perdidos_reportados = atual.registros_perdidos;
+    }
+    if (atual.logs_perdidos != logs_perdidos_reportados)
+    {
+        printf("[PIPELINE] %lu mensagem(ns) de log descartada(s)\n",
+               (unsigned long)(atual.logs_perdidos - logs_perdidos_reportados));
+        logs_perdidos_reportados = atual.logs_perdidos;
+    }
+    if (atual.amostras_perdidas != amostras_perdidas_reportadas)
+    {
+        printf("[PIPELINE] %lu amostra(s) descartada(s) na fila do núcleo 1\n",
+               (unsigned long)(atual.amostras_perdidas - amostras_perdidas_reportadas));
+        amostras_perdidas_reportadas = atual.amostras_perdidas;
+    }
+    if (atual.falhas_captura != falhas_captura_reportadas)
+    {
+        printf("[PIPELINE] %lu captura(s) abortada(s) - sensor sem resposta no barramento\n",
+               (unsigned long)(atual.falhas_captura - falhas_captura_reportadas));
+        armazenamento_registrar_diagnostico("%lu captura(s) abortada(s) no barramento dos sensores",
+                                            (unsigned long)(atual.falhas_captura - falhas_captura_reportadas));
+        falhas_captura_reportadas = atual.falhas_captura;
+    }
+    if (atual.amostras_sem_par != amostras_sem_par_reportadas)
+    {
+        printf("[PIPELINE] %lu amostra(s) sem par descartada(s) na fusão\n",
+               (unsigned long)(atual.amostras_sem_par - amostras_sem_par_reportadas));
+        armazenamento_registrar_diagnostico("%lu amostra(s) sem par descartada(s) na fusão",
+                                            (unsigned long)(atual.amostras_sem_par - amostras_sem_par_reportadas));
+        amostras_sem_par_reportadas = atual.amostras_sem_par;
+    }
+
+    // Cadência do núcleo 1: relatório a cada novo estouro ou período perdido,
+    // no máximo um por PIPELINE_INTERVALO_RELATORIO_MS
+    static uint32_t estouros_reportados = 0;
+    static uint32_t perdidos_reportados = 0;
+    static absolute_time_t proximo_relatorio = nil_time;
+    if ((atual.estouros != estouros_reportados || atual.periodos_perdidos != perdidos_reportados) &&
+        time_reached(proximo_relatorio))
+    {
+        pipeline_imprimir_estatisticas();
+        armazenamento_registrar_diagnostico("núcleo 1: %lu estouro(s), %lu período(s) perdido(s), atraso máx %lu us",
+                                            (unsigned long)atual.estouros, (unsigned long)atual.periodos_perdidos,
+                                            (unsigned long)atual.atraso_maximo_us);
+        estouros_reportados = atual.estouros;
+        perdidos_reportados = atual.periodos_perdidos;
+        proximo_relatorio = make_timeout_time_ms(PIPELINE_INTERVALO_RELATORIO_MS);
+    }
+}
+
+void pipeline_imprimir_estatisticas(void)
+{
+    EstatisticasPipeline atual = pipeline_estatisticas();
+    printf("[PIPELINE] Núcleo 1: %lu estouro(s), %lu período(s) perdido(s), %lu degradado(s) de %lu | "
+           "atraso máx %luus, médio %luus | trabalho máx %luus (orçamento %luus) | "
+           "%lu recuperação(ões) do magnetômetro, quadros de corrotina: maior %lu de %u bytes, %lu falha(s)\n"
+           "[PIPELINE] Captura: quadros em uso máx %lu de %u (%lu alocado(s), %lu devolvido(s)), %lu adiada(s), "
+           "%lu transbordo(s) de FIFO, %lu abortada(s), %lu amostra(s) sem par descartada(s)\n",
+           (unsigned long)atual.estouros, (unsigned long)atual.periodos_perdidos,
+           (unsigned long)atual.periodos_degradados, (unsigned long)atual.periodos,
+           (unsigned long)atual.atraso_maximo_us, (unsigned long)atual.atraso_medio_us,
+           (unsigned long)atual.trabalho_maximo_us, (unsigned long)ORCAMENTO_US,
+           (unsigned long)atual.recuperacoes_mag, (unsigned long)QuadrosCorrotina::maior_pedido,
+           (unsigned)CORROTINA_TAMANHO_QUADRO, (unsigned long)QuadrosCorrotina::falhas,
+           (unsigned long)atual.quadros_maximo_em_uso, (unsigned)CAPTURA_QUADROS,
+           (unsigned long)atual.quadros_alocados, (unsigned long)atual.quadros_devolvidos,
+           (unsigned long)atual.capturas_adiadas, (unsigned long)atual.transbordos_fifo,
+           (unsigned long)atual.falhas_captura, (unsigned long)atual.amostras_sem_par);
+}
+
+bool pipeline_enviar_comando(ComandoPipeline comando)
+{
+    return fila_comandos.inserir(comando);
+}
+
+EstatisticasPipeline pipeline_estatisticas(void)
+{
+    EstatisticasPipeline copia;
+    copia.periodos = estatisticas.periodos;
+    copia.periodos_perdidos = estatisticas.periodos_perdidos;
+    copia.estouros = estatisticas.estouros;
+    copia.periodos_degradados = estatisticas.periodos_degradados;
+    copia.atraso_maximo_us = estatisticas.atraso_maximo_us;
+    copia.atraso_medio_us = estatisticas.atraso_medio_us;
+    copia.trabalho_maximo_us = estatisticas.trabalho_maximo_us;
+    copia.registros_perdidos = estatisticas.registros_perdidos;
+    copia.logs_perdidos = estatisticas.logs_perdidos;
+    copia.amostras_perdidas = estatisticas.amostras_perdidas;
+    copia.recuperacoes_mag = estatisticas.recuperacoes_mag;
+    copia.amostras_sem_par = estatisticas.amostras_sem_par;
+    copia.capturas_adiadas = estatisticas.capturas_adiadas;
+    copia.transbordos_fifo = estatisticas.transbordos_fifo;
+    copia.falhas_captura = estatisticas.falhas_captura;
+    copia.quadros_alocados = estatisticas.quadros_alocados;
+    copia.quadros_devolvidos = estatisticas.quadros_devolvidos;
+    copia.quadros_maximo_em_uso = estatisticas.quadros_maximo_em_uso;
+    return copia;
+}
+
+// ===============================
+// Saída do núcleo 1
+// ===============================
+void pipeline_log(const char* formato, ...)
+{
+    MensagemLog mensagem;
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(mensagem.texto, sizeof(mensagem.texto), formato, args);
+    va_end(args);
+
+    if (!fila_log.inserir(mensagem))
+    {
+        estatisticas.logs_perdidos = estatisticas.logs_perdidos + 1;
+    }
+}
+
+bool pipeline_publicar_evento(const RegistroEvento& registro)
+{
+    if (!fila_registros.inserir(registro))
+    {
+        estatisticas.registros_perdidos = estatisticas.registros_perdidos + 1;
+        return false;
+    }
+    return true;
+}
+
+bool pipeline_publicar_quadro(uint8_t indice)
+{
+    if (quadros_no_nucleo0 >= fila_devolucoes.capacidade())
+    {
+        estatisticas.amostras_perdidas = estatisticas.amostras_perdidas + 1;
+        return false;
+    }
+
+    // A referência do núcleo 0 é tomada aqui e devolvida por fila_devolucoes
+    captura_reter(indice);
+    if (!fila_amostras.inserir(indice))
+    {
+        captura_liberar(indice);
+        estatisticas.amostras_perdidas = estatisticas.amostras_perdidas + 1;
+        return false;
+    }
+    quadros_no_nucleo0++;
+    return true;
+}
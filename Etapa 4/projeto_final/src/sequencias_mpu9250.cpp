@@ -0,0 +1,280 @@
+// ======================================================================
+//  Arquivo: sequencias_mpu9250.cpp
+//  Descrição: Procedimentos longos do MPU9250 (habilitação e recuperação
+//             do magnetômetro, auto-teste) como corrotinas em etapas
+// ======================================================================
+
+#include "sequencias_mpu9250.h"
+#include <cstdio>               // printf
+#include <cstdlib>              // labs
+
+extern "C" {
+    #include "mpu9250_regs.h"   // Mapa de registradores do MPU9250 e do AK8963
+}
+
+// Modo contínuo 2 (100Hz) com saída de 16 bits
+static const uint8_t AK8963_MODO_CONTINUO = AK8963_CONTINUOUS_100HZ | AK8963_BIT_16;
+
+// Amostras de cada fase do auto-teste (uma por ms)
+static const int AMOSTRAS_AUTO_TESTE = 200;
+
+// Configuração salva e restaurada pelo auto-teste, incluindo o I2C master
+// (CRÍTICO: preserva a leitura automática do magnetômetro)
+static const uint8_t REGISTRADORES_PRESERVADOS[] = {
+    MPU9250_SMPLRT_DIV, MPU9250_CONFIG, MPU9250_GYRO_CONFIG, MPU9250_ACCEL_CONFIG,
+    MPU9250_ACCEL_CONFIG2, MPU9250_USER_CTRL, MPU9250_I2C_MST_CTRL,
+    MPU9250_I2C_SLV0_ADDR, MPU9250_I2C_SLV0_REG, MPU9250_I2C_SLV0_CTRL
+};
+static const size_t NUM_PRESERVADOS = sizeof(REGISTRADORES_PRESERVADOS) / sizeof(REGISTRADORES_PRESERVADOS[0]);
+
+// ===============================
+// Condições de E/S
+// ===============================
+
+/**
+ * @brief Leitura nova e sem transbordo do AK8963 nos registradores EXT_SENS_DATA,
+ *        copiada pelo I2C master (ST1 no primeiro byte, ST2 no oitavo).
+ */
+static bool magnetometroComDado(void* contexto)
+{
+    mpu9250_t* mpu = static_cast<mpu9250_t*>(contexto);
+    uint8_t dado[8];
+    mpu9250_read_regs(mpu, MPU9250_EXT_SENS_DATA_00, dado, sizeof(dado));
+    return (dado[0] & AK8963_ST1_DRDY) && !(dado[7] & AK8963_ST2_HOFL);
+}
+
+// ===============================
+// Sequências
+// ===============================
+
+Corrotina sequenciaHabilitarMagnetometro(mpu9250_t* mpu)
+{
+    printf("Starting magnetometer initialization...\n");
+
+    // 1. Desabilita I2C master e ativa bypass para acesso direto ao magnetômetro
+    // Isso permite comunicação direta com o AK8963 temporariamente
+    mpu9250_write_reg_nowait(mpu, MPU9250_USER_CTRL, 0x00);
+    co_await esperarMs(10);
+    uint8_t int_pin_cfg = mpu9250_read_reg(mpu, MPU9250_INT_PIN_CFG);
+    mpu9250_write_reg_nowait(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg | BYPASS_EN);
+    co_await esperarMs(100);
+
+    // 2. Testa conexão com magnetômetro via bypass (sem ele, desfaz o bypass:
+    //    outro AK8963 no mesmo barramento usa o mesmo endereço)
+    if (!mpu9250_test_mag_connection(mpu))
+    {
+        printf("ERROR: Magnetometer not detected!\n");
+        mpu9250_write_reg_nowait(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
+        co_return false;
+    }
+    printf("Magnetometer detected successfully\n");
+
+    // 3. Reset do magnetômetro para estado conhecido
+    mpu9250_write_mag_reg_nowait(mpu, AK8963_CNTL2, 0x01);
+    co_await esperarMs(100);
+
+    // 4. Entra no modo FUSE ROM para ler valores de calibração de fábrica
+    // Os valores ASA (Adjustment Sensitivity Adjustment) compensam variações de fabricação
+    mpu9250_write_mag_reg_nowait(mpu, AK8963_CNTL1, AK8963_FUSE_ROM);
+    co_await esperarMs(100);
+
+    // 5. Lê valores de calibração ASA, únicos para cada chip
+    uint8_t asa_data[3];
+    mpu9250_read_mag_regs(mpu, AK8963_ASAX, asa_data, 3);
+    for (int i = 0; i < 3; i++)
+    {
+        // Fórmula do datasheet: ASA = (valor_lido - 128)/256 + 1
+        mpu->mag_asa[i] = ((float)asa_data[i] - 128.0f) / 256.0f + 1.0f;
+    }
+    printf("ASA values: X=%.3f, Y=%.3f, Z=%.3f\n", mpu->mag_asa[0], mpu->mag_asa[1], mpu->mag_asa[2]);
+
+    // 6. Power down antes de configurar modo contínuo (transição obrigatória)
+    mpu9250_write_mag_reg_nowait(mpu, AK8963_CNTL1, AK8963_POWER_DOWN);
+    co_await esperarMs(100);
+
+    // 7. Configura magnetômetro para modo contínuo 2 (100Hz) com resolução 16-bit
+    mpu9250_write_mag_reg_nowait(mpu, AK8963_CNTL1, AK8963_MODO_CONTINUO);
+    co_await esperarMs(100);
+
+    // 8. Verifica se entrou corretamente no modo contínuo
+    uint8_t cntl1;
+    mpu9250_read_mag_regs(mpu, AK8963_CNTL1, &cntl1, 1);
+    printf("AK8963 CNTL1: 0x%02X (Expected: 0x%02X)\n", cntl1, AK8963_MODO_CONTINUO);
+
+    // 9. Desativa bypass - volta para comunicação via I2C master
+    mpu9250_write_reg_nowait(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
+    co_await esperarMs(10);
+
+    // 10. Primeiro desabilita todas as slaves I2C (limpeza preventiva)
+    for (int i = 0; i < 4; i++)
+    {
+        mpu9250_write_reg_nowait(mpu, MPU9250_I2C_SLV0_CTRL + i * 3, 0x00);
+        co_await esperarUs(MPU9250_ESPERA_ESCRITA_US);
+    }
+    co_await esperarMs(10);
+
+    // 11. Configura clock do I2C master ANTES de habilitar (0x0D = ~400kHz)
+    mpu9250_write_reg_nowait(mpu, MPU9250_I2C_MST_CTRL, 0x0D);
+    co_await esperarMs(10);
+
+    // 12. Configura Slave 0 para leitura automática de 8 bytes a partir de ST1
+    // (ST1 + 6 bytes dados + ST2), com o endereço do AK8963 e o bit de leitura
+    mpu9250_write_reg_nowait(mpu, MPU9250_I2C_SLV0_ADDR, AK8963_ADDR | I2C_READ_FLAG);
+    co_await esperarMs(5);
+    mpu9250_write_reg_nowait(mpu, MPU9250_I2C_SLV0_REG, AK8963_ST1);
+    co_await esperarMs(5);
+    mpu9250_write_reg_nowait(mpu, MPU9250_I2C_SLV0_CTRL, I2C_SLV0_EN | 8);
+    co_await esperarMs(10);
+
+    // 13. Habilita I2C master e espera a primeira leitura automática chegar
+    mpu9250_write_reg_nowait(mpu, MPU9250_USER_CTRL, I2C_MST_EN);
+    if (!co_await esperarCondicao(magnetometroComDado, mpu, SEQUENCIA_LIMITE_DADO_MAG_US))
+    {
+        printf("WARNING: no magnetometer data through the I2C master yet\n");
+    }
+
+    // 14. Verificação final da configuração
+    printf("Final verification:\n");
+    printf("  I2C_SLV0_ADDR: 0x%02X (Expected: 0x8C)\n", mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_ADDR));
+    printf("  I2C_SLV0_REG: 0x%02X (Expected: 0x02)\n", mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_REG));
+    printf("  I2C_SLV0_CTRL: 0x%02X (Expected: 0x88)\n", mpu9250_read_reg(mpu, MPU9250_I2C_SLV0_CTRL));
+    printf("  USER_CTRL: 0x%02X (Expected: 0x20)\n", mpu9250_read_reg(mpu, MPU9250_USER_CTRL));
+
+    mpu->mag_enabled = true;
+    mpu->mag_overflow = false;
+    printf("Magnetometer initialization completed\n");
+    co_return true;
+}
+
+Corrotina sequenciaRecuperarMagnetometro(mpu9250_t* mpu)
+{
+    // Bypass exige o I2C master desligado; só esse bit muda, e a FIFO segue gravando
+    uint8_t user_ctrl = mpu9250_read_reg(mpu, MPU9250_USER_CTRL);
+    uint8_t int_pin_cfg = mpu9250_read_reg(mpu, MPU9250_INT_PIN_CFG);
+    mpu9250_write_reg_nowait(mpu, MPU9250_USER_CTRL, user_ctrl & ~I2C_MST_EN);
+    co_await esperarUs(MPU9250_ESPERA_ESCRITA_US);
+    mpu9250_write_reg_nowait(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg | BYPASS_EN);
+    co_await esperarMs(10);
+
+    // Reset e reconfigura magnetômetro
+    mpu9250_write_mag_reg_nowait(mpu, AK8963_CNTL1, AK8963_POWER_DOWN);
+    co_await esperarMs(10);
+    mpu9250_write_mag_reg_nowait(mpu, AK8963_CNTL1, AK8963_MODO_CONTINUO);
+    co_await esperarMs(10);
+
+    // Restaura modo I2C master e espera uma leitura nova sem transbordo
+    mpu9250_write_reg_nowait(mpu, MPU9250_INT_PIN_CFG, int_pin_cfg & ~BYPASS_EN);
+    co_await esperarUs(MPU9250_ESPERA_ESCRITA_US);
+    mpu9250_write_reg_nowait(mpu, MPU9250_USER_CTRL, user_ctrl);
+    bool recuperado = co_await esperarCondicao(magnetometroComDado, mpu, SEQUENCIA_LIMITE_DADO_MAG_US);
+
+    mpu->mag_overflow = false;
+    co_return recuperado;
+}
+
+Corrotina sequenciaAutoTeste(mpu9250_t* mpu)
+{
+    // Leitura dos códigos de fábrica de self-test
+    // Estes valores são únicos para cada chip e definem a resposta esperada
+    uint8_t st_gyro[3], st_accel[3];
+    st_gyro[0]  = mpu9250_read_reg(mpu, SELF_TEST_X_GYRO);
+    st_gyro[1]  = mpu9250_read_reg(mpu, SELF_TEST_Y_GYRO);
+    st_gyro[2]  = mpu9250_read_reg(mpu, SELF_TEST_Z_GYRO);
+    st_accel[0] = mpu9250_read_reg(mpu, SELF_TEST_X_ACCEL);
+    st_accel[1] = mpu9250_read_reg(mpu, SELF_TEST_Y_ACCEL);
+    st_accel[2] = mpu9250_read_reg(mpu, SELF_TEST_Z_ACCEL);
+
+    printf("Factory self-test codes (Accel: %02X %02X %02X, Gyro: %02X %02X %02X)\n",
+           st_accel[0], st_accel[1], st_accel[2], st_gyro[0], st_gyro[1], st_gyro[2]);
+
+    // Salva configuração atual incluindo registradores do I2C master
+    uint8_t salvos[NUM_PRESERVADOS];
+    for (size_t i = 0; i < NUM_PRESERVADOS; i++)
+    {
+        salvos[i] = mpu9250_read_reg(mpu, REGISTRADORES_PRESERVADOS[i]);
+    }
+
+    printf("Starting MPU9250 self-test...\n");
+
+    // Configura para self-test conforme datasheet
+    static const uint8_t CONFIGURACAO_TESTE[][2] = {
+        {MPU9250_SMPLRT_DIV, 0x00},    // Taxa de amostragem = 1kHz
+        {MPU9250_CONFIG, 0x02},        // DLPF = 92Hz
+        {MPU9250_GYRO_CONFIG, 0x00},   // ±250 dps, sem self-test
+        {MPU9250_ACCEL_CONFIG, 0x00},  // ±2g, sem self-test
+        {MPU9250_ACCEL_CONFIG2, 0x02}, // DLPF = 92Hz
+    };
+    for (const auto& escrita : CONFIGURACAO_TESTE)
+    {
+        mpu9250_write_reg_nowait(mpu, escrita[0], escrita[1]);
+        co_await esperarUs(MPU9250_ESPERA_ESCRITA_US);
+    }
+    co_await esperarMs(50); // Aguarda estabilização das configurações
+
+    // Amostras sem e com self-test, uma por ms; fase 1 habilita a excitação interna
+    int32_t accel_sum[2][3] = {}, gyro_sum[2][3] = {};
+    for (int fase = 0; fase < 2; fase++)
+    {
+        if (fase == 1)
+        {
+            mpu9250_write_reg_nowait(mpu, MPU9250_GYRO_CONFIG, 0xE0);  // Enable XYZ self-test, ±250 dps
+            co_await esperarUs(MPU9250_ESPERA_ESCRITA_US);
+            mpu9250_write_reg_nowait(mpu, MPU9250_ACCEL_CONFIG, 0xE0); // Enable XYZ self-test, ±2g
+            co_await esperarMs(50); // Wait for self-test to stabilize
+        }
+
+        for (int amostra = 0; amostra < AMOSTRAS_AUTO_TESTE; amostra++)
+        {
+            int16_t accel_raw[3], gyro_raw[3], temp_raw;
+            mpu9250_read_raw_motion(mpu, accel_raw, gyro_raw, &temp_raw);
+            for (int i = 0; i < 3; i++)
+            {
+                accel_sum[fase][i] += accel_raw[i];
+                gyro_sum[fase][i] += gyro_raw[i];
+            }
+            co_await esperarMs(1);
+        }
+    }
+
+    // Restore original configuration including I2C master settings
+    for (size_t i = 0; i < NUM_PRESERVADOS; i++)
+    {
+        mpu9250_write_reg_nowait(mpu, REGISTRADORES_PRESERVADOS[i], salvos[i]);
+        co_await esperarUs(MPU9250_ESPERA_ESCRITA_US);
+    }
+    co_await esperarMs(10); // Give time for I2C master to restart
+
+    // Self-test response = self-test output - normal output (médias)
+    bool test_passed = true;
+    printf("Self-test results:\n");
+    for (int i = 0; i < 3; i++)
+    {
+        long accel_str = (long)(accel_sum[1][i] / AMOSTRAS_AUTO_TESTE - accel_sum[0][i] / AMOSTRAS_AUTO_TESTE);
+        long gyro_str = (long)(gyro_sum[1][i] / AMOSTRAS_AUTO_TESTE - gyro_sum[0][i] / AMOSTRAS_AUTO_TESTE);
+        printf("Axis %d - Accel STR: %ld, Gyro STR: %ld\n", i, accel_str, gyro_str);
+
+        // Check factory self-test codes for validity
+        if (st_accel[i] == 0 || st_gyro[i] == 0)
+        {
+            printf("Self-test axis %d returned invalid factory code\n", i);
+            test_passed = false;
+        }
+
+        // Accelerometer: should have significant response (>1000 LSB change for ±2g range)
+        if (labs(accel_str) < 1000 || labs(accel_str) > 14000)
+        {
+            printf("Accelerometer axis %d failed: STR = %ld\n", i, accel_str);
+            test_passed = false;
+        }
+
+        // Gyroscope: typical self-test response between 50-32000 LSB for ±250dps range
+        if (labs(gyro_str) < 50 || labs(gyro_str) > 32000)
+        {
+            printf("Gyroscope axis %d failed: STR = %ld\n", i, gyro_str);
+            test_passed = false;
+        }
+    }
+
+    printf("Self-test %s\n", test_passed ? "PASSED" : "FAILED");
+    co_return test_passed;
+}
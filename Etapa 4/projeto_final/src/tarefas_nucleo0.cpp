@@ -0,0 +1,223 @@
+// ======================================================================
+//  Arquivo: tarefas_nucleo0.cpp
+//  Descrição: Tarefas de E/S do núcleo 0 (botões, logs, armazenamento, relatórios
+//             e depuração) sobre o escalonador cooperativo
+// ======================================================================
+
+#include "tarefas_nucleo0.h"
+#include "pipeline_sensores.h"  // Filas e comandos do núcleo 1
+#include "armazenamento.h"      // Gravação em lote no SDCard
+#include <cstdio>               // printf
+#include "pico/stdlib.h"        // getchar_timeout_us
+
+extern "C" {
+    #include "button.h"         // Flags dos botões A e B (IRQ)
+    #include "escalonador.h"    // Escalonador cooperativo
+    #include "supervisor.h"     // Batimentos e alimentação do watchdog de hardware
+    #include "sensor_watchdog.h" // WATCHDOG_TIMEOUT_MS
+    #include "medicao.h"        // Tempos por etapa (só com MEDIR_TEMPOS)
+}
+
+// O atraso precisa ser detectado (e o culpado gravado) antes do reinício pelo hardware
+static_assert(TAREFA_PRAZO_ARMAZENAMENTO_MS + TAREFA_SUPERVISOR_PERIODO_US / 1000 < WATCHDOG_TIMEOUT_MS &&
+              TAREFA_PRAZO_NUCLEO0_MS + TAREFA_SUPERVISOR_PERIODO_US / 1000 < WATCHDOG_TIMEOUT_MS,
+              "Prazos do supervisor devem vencer antes do timeout do watchdog de hardware");
+
+// ===============================
+// Estado
+// ===============================
+static escalonador_t escalonador;
+static int tarefa_armazenamento = -1;
+static int tarefa_depuracao = -1;
+#ifdef MEDIR_TEMPOS
+static int tarefa_tempos = -1;
+#endif
+static int parte_nucleo0 = SUPERVISOR_NENHUMA;
+static int parte_armazenamento = SUPERVISOR_NENHUMA;
+
+// ===============================
+// Tarefas
+// ===============================
+
+/**
+ * @brief Batimento do núcleo 0 e alimentação do watchdog, só com todas as partes em dia.
+ *
+ * Com uma parte atrasada o watchdog deixa de ser alimentado e reinicia a placa
+ * em até WATCHDOG_TIMEOUT_MS; o culpado fica nos registradores de rascunho.
+ */
+static void tarefaSupervisor(void*)
+{
+    static int culpado_reportado = SUPERVISOR_NENHUMA;
+
+    supervisor_batimento(parte_nucleo0);
+    int culpado = supervisor_alimentar();
+    if (culpado != SUPERVISOR_NENHUMA && culpado != culpado_reportado)
+    {
+        printf("[SUPERVISOR] '%s' sem batimento no prazo - watchdog não alimentado\n", supervisor_nome(culpado));
+    }
+    culpado_reportado = culpado;
+}
+
+/**
+ * @brief Botão A: silencia/desilencia o alarme (executado pelo núcleo 1, dono do alarme).
+ *        Botão B: imprime as estatísticas das tarefas.
+ */
+static void tarefaBotoes(void*)
+{
+    if (button_a_pressed)
+    {
+        button_a_pressed = false; // Reseta a flag antes: um novo toque durante o envio não se perde
+        printf("Botão A pressionado\n");
+        if (!pipeline_enviar_comando(ComandoPipeline::ALTERNAR_SILENCIO))
+        {
+            printf("  -> Comando descartado (fila cheia)\n");
+        }
+    }
+
+    if (button_b_pressed)
+    {
+        button_b_pressed = false;
+        escalonador_sinalizar(&escalonador, tarefa_depuracao);
+    }
+}
+
+/** @brief Imprime os logs vindos do núcleo 1. */
+static void tarefaLogs(void*)
+{
+    pipeline_servir_logs();
+}
+
+/** @brief Passa eventos e amostras do núcleo 1 para as faixas do armazenamento. */
+static void tarefaColeta(void*)
+{
+    if (pipeline_encaminhar_armazenamento())
+    {
+        escalonador_sinalizar(&escalonador, tarefa_armazenamento);
+    }
+}
+
+/**
+ * @brief Grava um lote no SDCard; com outro pronto, volta a ficar pronta sem
+ *        esperar o período, mas atrás das tarefas de maior prioridade.
+ */
+static void tarefaArmazenamento(void*)
+{
+    supervisor_batimento(parte_armazenamento);
+    if (armazenamento_servir())
+    {
+        escalonador_sinalizar(&escalonador, tarefa_armazenamento);
+    }
+}
+
+/** @brief Reporta perdas nas filas e no armazenamento e estouros de cadência do núcleo 1. */
+static void tarefaRelatorio(void*)
+{
+    pipeline_reportar();
+    armazenamento_reportar();
+}
+
+/** @brief Lê comandos de depuração da serial, sem bloquear. */
+static void tarefaConsole(void*)
+{
+    int caractere;
+    while ((caractere = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT)
+    {
+        switch (caractere)
+        {
+            case CONSOLE_COMANDO_ESTATISTICAS:
+                escalonador_sinalizar(&escalonador, tarefa_depuracao);
+                break;
+            case CONSOLE_COMANDO_ZERAR:
+                escalonador_zerar_estatisticas(&escalonador);
+#ifdef MEDIR_TEMPOS
+                medicao_zerar();
+#endif
+                printf("Estatísticas das tarefas zeradas\n");
+                break;
+            case CONSOLE_COMANDO_TEMPOS:
+#ifdef MEDIR_TEMPOS
+                escalonador_sinalizar(&escalonador, tarefa_tempos);
+#else
+                printf("Tempos por etapa desabilitados (compile com -DMEDIR_TEMPOS=ON)\n");
+#endif
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/** @brief Imprime as estatísticas de tempo das tarefas, a cadência do núcleo 1 e as faixas do armazenamento. */
+static void tarefaDepuracao(void*)
+{
+    escalonador_imprimir_estatisticas(&escalonador);
+    pipeline_imprimir_estatisticas();
+    armazenamento_imprimir_estatisticas();
+    supervisor_imprimir_estado();
+}
+
+#ifdef MEDIR_TEMPOS
+/** @brief Imprime a tabela de tempos por etapa (mínimo, média, máximo e histograma). */
+static void tarefaTempos(void*)
+{
+    medicao_imprimir();
+}
+#endif
+
+// ===============================
+// Inicialização e laço
+// ===============================
+void tarefas_nucleo0_iniciar(void)
+{
+    escalonador_iniciar(&escalonador);
+
+    parte_nucleo0 = supervisor_registrar("nucleo0", TAREFA_PRAZO_NUCLEO0_MS);
+    parte_armazenamento = supervisor_registrar("armazenamento", TAREFA_PRAZO_ARMAZENAMENTO_MS);
+
+    escalonador_registrar(&escalonador, "supervisor", tarefaSupervisor, nullptr, 0,
+                          TAREFA_SUPERVISOR_PERIODO_US, TAREFA_SUPERVISOR_ORCAMENTO_US);
+    escalonador_registrar(&escalonador, "botoes", tarefaBotoes, nullptr, 0,
+                          TAREFA_BOTOES_PERIODO_US, TAREFA_BOTOES_ORCAMENTO_US);
+    escalonador_registrar(&escalonador, "logs", tarefaLogs, nullptr, 1,
+                          TAREFA_LOGS_PERIODO_US, TAREFA_LOGS_ORCAMENTO_US);
+    escalonador_registrar(&escalonador, "coleta", tarefaColeta, nullptr, 1,
+                          TAREFA_COLETA_PERIODO_US, TAREFA_COLETA_ORCAMENTO_US);
+    tarefa_armazenamento = escalonador_registrar(&escalonador, "armazenamento", tarefaArmazenamento, nullptr, 2,
+                                                 TAREFA_ARMAZENAMENTO_PERIODO_US, TAREFA_ARMAZENAMENTO_ORCAMENTO_US);
+    escalonador_registrar(&escalonador, "relatorio", tarefaRelatorio, nullptr, 3,
+                          TAREFA_RELATORIO_PERIODO_US, TAREFA_RELATORIO_ORCAMENTO_US);
+    escalonador_registrar(&escalonador, "console", tarefaConsole, nullptr, 3,
+                          TAREFA_CONSOLE_PERIODO_US, TAREFA_CONSOLE_ORCAMENTO_US);
+    tarefa_depuracao = escalonador_registrar(&escalonador, "depuracao", tarefaDepuracao, nullptr, 4,
+                                             ESCALONADOR_SEM_PERIODO, TAREFA_DEPURACAO_ORCAMENTO_US);
+#ifdef MEDIR_TEMPOS
+    tarefa_tempos = escalonador_registrar(&escalonador, "tempos", tarefaTempos, nullptr, 4,
+                                          ESCALONADOR_SEM_PERIODO, TAREFA_DEPURACAO_ORCAMENTO_US);
+#endif
+
+    // Reinício anterior causado por uma parte sem batimento: fica também no diagnóstico do SDCard
+    uint32_t idade_ms = 0;
+    int culpado = supervisor_culpado_reinicio(&idade_ms);
+    if (culpado != SUPERVISOR_NENHUMA)
+    {
+        printf("*** Reinício pelo supervisor: '%s' sem batimento há %lu ms ***\n",
+               supervisor_nome(culpado), (unsigned long)idade_ms);
+        armazenamento_registrar_diagnostico("reinício pelo supervisor: %s sem batimento há %lu ms",
+                                            supervisor_nome(culpado), (unsigned long)idade_ms);
+    }
+
+    printf("Núcleo 0: %u tarefas registradas ('%c' ou botão B: estatísticas, '%c': tempos por etapa, '%c': zerar)\n",
+           (unsigned)escalonador.quantidade, CONSOLE_COMANDO_ESTATISTICAS, CONSOLE_COMANDO_TEMPOS, CONSOLE_COMANDO_ZERAR);
+}
+
+void tarefas_nucleo0_executar(void)
+{
+    while (true)
+    {
+        // Uma tarefa por vez, sempre a pronta de maior prioridade; espera só sem nenhuma pronta
+        if (!escalonador_executar(&escalonador))
+        {
+            escalonador_aguardar(&escalonador);
+        }
+    }
+}
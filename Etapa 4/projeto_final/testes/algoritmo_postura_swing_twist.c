@@ -0,0 +1,21 @@
+// ======================================================================
+//  Arquivo: algoritmo_postura_swing_twist.c
+//  Descrição: algoritmo_postura.c com o extrator swing-twist e os símbolos
+//             públicos renomeados, para que os dois extratores convivam no
+//             mesmo teste
+// ======================================================================
+
+#define ANGULOS_SWING_TWIST
+
+#define euler_to_quaternion swing_twist_euler_to_quaternion
+#define quaternion_multiply swing_twist_quaternion_multiply
+#define quaternion_conjugate swing_twist_quaternion_conjugate
+#define quaternion_from_axes swing_twist_quaternion_from_axes
+#define quaternion_from_accel_mag swing_twist_quaternion_from_accel_mag
+#define relative_quaternion swing_twist_relative_quaternion
+#define quaternion_to_hip_components swing_twist_quaternion_to_hip_components
+#define quaternion_to_hip_angles swing_twist_quaternion_to_hip_angles
+#define hip_limits_define swing_twist_hip_limits_define
+#define hip_components_exceed swing_twist_hip_components_exceed
+
+#include "algoritmo_postura.c"
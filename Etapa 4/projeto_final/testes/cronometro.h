@@ -0,0 +1,32 @@
+// ======================================================================
+//  Arquivo: cronometro.h
+//  Descrição: Tempo de parede para as medições de desempenho dos testes de
+//             host. No host (com FPU e cache) os tempos só comparam as
+//             variantes entre si; os tempos no RP2040 vêm de medicao.h
+// ======================================================================
+
+#ifndef CRONOMETRO_H
+#define CRONOMETRO_H
+
+#include <stdint.h>
+#include <time.h>
+
+/** @brief Instante monotônico em nanossegundos. */
+static inline uint64_t cronometro_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief Consome um resultado para que o otimizador não descarte o cálculo
+ *        medido.
+ */
+static inline void cronometro_consumir(float valor)
+{
+    volatile float sorvedouro = valor;
+    (void)sorvedouro;
+}
+
+#endif // CRONOMETRO_H
@@ -0,0 +1,14 @@
+// ======================================================================
+//  Arquivo: madgwick_fixo.c
+//  Descrição: MadgwickAHRS_fixo.c com os símbolos públicos renomeados, para que
+//             as versões em float e em Q7.24 convivam no mesmo teste
+// ======================================================================
+
+#define MadgwickAHRSinit fixo_MadgwickAHRSinit
+#define MadgwickAHRSupdate fixo_MadgwickAHRSupdate
+#define MadgwickAHRSupdateIMU fixo_MadgwickAHRSupdateIMU
+#define MadgwickAHRSbatchInit fixo_MadgwickAHRSbatchInit
+#define MadgwickAHRSbatchUpdate fixo_MadgwickAHRSbatchUpdate
+#define MadgwickAHRSbatchUpdateIMU fixo_MadgwickAHRSbatchUpdateIMU
+
+#include "MadgwickAHRS_fixo.c"
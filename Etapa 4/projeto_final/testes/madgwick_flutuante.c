@@ -0,0 +1,14 @@
+// ======================================================================
+//  Arquivo: madgwick_flutuante.c
+//  Descrição: MadgwickAHRS.c com os símbolos públicos renomeados, para que
+//             as versões em float e em Q7.24 convivam no mesmo teste
+// ======================================================================
+
+#define MadgwickAHRSinit flutuante_MadgwickAHRSinit
+#define MadgwickAHRSupdate flutuante_MadgwickAHRSupdate
+#define MadgwickAHRSupdateIMU flutuante_MadgwickAHRSupdateIMU
+#define MadgwickAHRSbatchInit flutuante_MadgwickAHRSbatchInit
+#define MadgwickAHRSbatchUpdate flutuante_MadgwickAHRSbatchUpdate
+#define MadgwickAHRSbatchUpdateIMU flutuante_MadgwickAHRSbatchUpdateIMU
+
+#include "MadgwickAHRS.c"
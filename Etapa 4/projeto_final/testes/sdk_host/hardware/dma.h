@@ -0,0 +1,44 @@
+// ======================================================================
+//  Arquivo: hardware/dma.h (host)
+//  Descrição: Declarações de DMA usadas pela captura dos sensores; o
+//             teste define as funções e faz o papel do controlador
+// ======================================================================
+
+#ifndef SDK_HOST_HARDWARE_DMA_H
+#define SDK_HOST_HARDWARE_DMA_H
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    volatile uint32_t ints0, ints1;
+} dma_hw_t;
+
+extern dma_hw_t *dma_hw;
+
+int dma_claim_unused_channel(bool required);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_abort(uint channel);
+void dma_channel_set_irq1_enabled(uint channel, bool enabled);
+void dma_channel_acknowledge_irq1(uint channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_HARDWARE_DMA_H
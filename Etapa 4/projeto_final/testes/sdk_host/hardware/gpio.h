@@ -0,0 +1,35 @@
+// ======================================================================
+//  Arquivo: hardware/gpio.h (host)
+//  Descrição: Declarações de GPIO usadas pelos cabeçalhos do firmware
+// ======================================================================
+
+#ifndef SDK_HOST_HARDWARE_GPIO_H
+#define SDK_HOST_HARDWARE_GPIO_H
+
+#include "pico/types.h"
+
+#define GPIO_OUT 1
+#define GPIO_IN  0
+#define GPIO_IRQ_EDGE_FALL 0x4u
+#define GPIO_IRQ_EDGE_RISE 0x8u
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum gpio_function { GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4, GPIO_FUNC_SIO = 5 };
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+enum gpio_function gpio_get_function(uint gpio);
+void gpio_pull_up(uint gpio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_HARDWARE_GPIO_H
@@ -0,0 +1,36 @@
+// ======================================================================
+//  Arquivo: hardware/i2c.h (host)
+//  Descrição: Declarações de I2C usadas pelos cabeçalhos do firmware
+// ======================================================================
+
+#ifndef SDK_HOST_HARDWARE_I2C_H
+#define SDK_HOST_HARDWARE_I2C_H
+
+#include "pico/types.h"
+
+#define I2C_IC_DATA_CMD_CMD_BITS     0x00000100u
+#define I2C_IC_DATA_CMD_STOP_BITS    0x00000200u
+#define I2C_IC_DATA_CMD_RESTART_BITS 0x00000400u
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct i2c_inst i2c_inst_t;
+typedef struct {
+    volatile uint32_t enable, tar, data_cmd, clr_tx_abrt, rxflr, tx_abrt_source;
+} i2c_hw_t;
+
+extern i2c_inst_t *i2c0, *i2c1;
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c);
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_HARDWARE_I2C_H
@@ -0,0 +1,27 @@
+// ======================================================================
+//  Arquivo: hardware/irq.h (host)
+//  Descrição: Registro de tratadores de IRQ; o teste guarda o tratador e
+//             o chama no lugar do hardware
+// ======================================================================
+
+#ifndef SDK_HOST_HARDWARE_IRQ_H
+#define SDK_HOST_HARDWARE_IRQ_H
+
+#include "pico/types.h"
+
+#define DMA_IRQ_1 12
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_HARDWARE_IRQ_H
@@ -0,0 +1,25 @@
+// ======================================================================
+//  Arquivo: hardware/sync.h (host)
+//  Descrição: Eventos e máscara de interrupções (sem IRQ no host: as
+//             seções críticas não precisam mascarar nada)
+// ======================================================================
+
+#ifndef SDK_HOST_HARDWARE_SYNC_H
+#define SDK_HOST_HARDWARE_SYNC_H
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void __wfe(void);
+void __sev(void);
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_HARDWARE_SYNC_H
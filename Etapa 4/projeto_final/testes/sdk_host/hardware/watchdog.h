@@ -0,0 +1,35 @@
+// ======================================================================
+//  Arquivo: hardware/watchdog.h (host)
+//  Descrição: Watchdog de hardware (o teste define watchdog_hw e as
+//             funções, para contar as alimentações e simular o reinício)
+// ======================================================================
+
+#ifndef SDK_HOST_HARDWARE_WATCHDOG_H
+#define SDK_HOST_HARDWARE_WATCHDOG_H
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t load;
+    volatile uint32_t reason;
+    volatile uint32_t scratch[8];
+    volatile uint32_t tick;
+} watchdog_hw_t;
+
+extern watchdog_hw_t *watchdog_hw;
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_update(void);
+bool watchdog_caused_reboot(void);
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_HARDWARE_WATCHDOG_H
@@ -0,0 +1,23 @@
+// ======================================================================
+//  Arquivo: pico/multicore.h (host)
+//  Descrição: Lançamento do núcleo 1 (o teste decide como simulá-lo)
+// ======================================================================
+
+#ifndef SDK_HOST_PICO_MULTICORE_H
+#define SDK_HOST_PICO_MULTICORE_H
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_launch_core1_with_stack(void (*entry)(void), uint32_t *stack_bottom, size_t stack_size_bytes);
+uint get_core_num(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_PICO_MULTICORE_H
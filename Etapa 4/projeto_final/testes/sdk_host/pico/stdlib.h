@@ -0,0 +1,29 @@
+// ======================================================================
+//  Arquivo: pico/stdlib.h (host)
+//  Descrição: Subconjunto de pico/stdlib.h usado pelo firmware
+// ======================================================================
+
+#ifndef SDK_HOST_PICO_STDLIB_H
+#define SDK_HOST_PICO_STDLIB_H
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_ERROR_GENERIC (-2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+void tight_loop_contents(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_PICO_STDLIB_H
@@ -0,0 +1,56 @@
+// ======================================================================
+//  Arquivo: pico/time.h (host)
+//  Descrição: Tempo do pico-sdk sobre o relógio simulado de sdk_host.h
+// ======================================================================
+
+#ifndef SDK_HOST_PICO_TIME_H
+#define SDK_HOST_PICO_TIME_H
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const absolute_time_t nil_time;
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+absolute_time_t get_absolute_time(void);
+absolute_time_t from_us_since_boot(uint64_t us);
+uint32_t to_ms_since_boot(absolute_time_t t);
+uint64_t to_us_since_boot(absolute_time_t t);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us);
+absolute_time_t make_timeout_time_us(uint64_t us);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+bool time_reached(absolute_time_t t);
+
+// As esperas avançam o relógio simulado em vez de dormir
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+// Timers: o teste que precisar deles dispara o callback por conta própria
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer {
+    int64_t delay_us;
+    void *user_data;
+    repeating_timer_callback_t callback;
+    int alarm_id;
+};
+typedef struct alarm_pool alarm_pool_t;
+
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers);
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback,
+                                       void *user_data, repeating_timer_t *out);
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_PICO_TIME_H
@@ -0,0 +1,16 @@
+// ======================================================================
+//  Arquivo: pico/types.h (host)
+//  Descrição: Tipos básicos do pico-sdk para os testes de host
+// ======================================================================
+
+#ifndef SDK_HOST_PICO_TYPES_H
+#define SDK_HOST_PICO_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t; // Forma não opaca do SDK: us desde o boot
+
+#endif // SDK_HOST_PICO_TYPES_H
@@ -0,0 +1,61 @@
+// ======================================================================
+//  Arquivo: sdk_host.c
+//  Descrição: Tempo, esperas e sincronização do pico-sdk para os testes
+//             de host, sobre um relógio simulado
+// ======================================================================
+
+#include <sched.h>         // sched_yield
+#include <stdatomic.h>     // Relógio lido por mais de uma thread
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+#include "sdk_host.h"
+
+static _Atomic uint64_t relogio_us;
+
+const absolute_time_t nil_time = 0;
+
+void sdk_host_definir_us(uint64_t agora_us) { atomic_store(&relogio_us, agora_us); }
+void sdk_host_avancar_us(uint64_t us) { atomic_fetch_add(&relogio_us, us); }
+
+// ----------------------------------------------------------------------
+// Tempo
+// ----------------------------------------------------------------------
+uint64_t time_us_64(void) { return atomic_load(&relogio_us); }
+uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+absolute_time_t get_absolute_time(void) { return time_us_64(); }
+absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + 1000ull * ms; }
+bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+
+// ----------------------------------------------------------------------
+// Esperas: avançam o relógio
+// ----------------------------------------------------------------------
+void sleep_us(uint64_t us) { sdk_host_avancar_us(us); }
+void sleep_ms(uint32_t ms) { sdk_host_avancar_us(1000ull * ms); }
+
+void sleep_until(absolute_time_t t)
+{
+    uint64_t agora = time_us_64();
+    if (t > agora) sdk_host_avancar_us(t - agora);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp)
+{
+    sleep_until(timeout_timestamp);
+    return true;
+}
+
+void tight_loop_contents(void) {}
+
+// ----------------------------------------------------------------------
+// Sincronização: sem IRQ no host; WFE cede o processador à outra thread
+// ----------------------------------------------------------------------
+void __wfe(void) { sched_yield(); }
+void __sev(void) {}
+uint32_t save_and_disable_interrupts(void) { return 0; }
+void restore_interrupts(uint32_t status) { (void)status; }
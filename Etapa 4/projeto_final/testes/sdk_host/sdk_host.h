@@ -0,0 +1,30 @@
+// ======================================================================
+//  Arquivo: sdk_host.h
+//  Descrição: Controle do relógio simulado dos testes de host
+// ======================================================================
+
+#ifndef SDK_HOST_H
+#define SDK_HOST_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Define o instante atual (us desde o boot).
+ *
+ * O relógio só anda por esta função, por sdk_host_avancar_us e pelas esperas
+ * do SDK (sleep_*, best_effort_wfe_or_timeout), que o avançam em vez de dormir.
+ */
+void sdk_host_definir_us(uint64_t agora_us);
+
+/** @brief Avança o relógio simulado. */
+void sdk_host_avancar_us(uint64_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SDK_HOST_H
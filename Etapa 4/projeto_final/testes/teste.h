@@ -0,0 +1,26 @@
+// ======================================================================
+//  Arquivo: teste.h
+//  Descrição: Verificação mínima dos testes de host (independe de NDEBUG)
+// ======================================================================
+
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Encerra o teste com falha, indicando arquivo e linha, se a condição
+ *        for falsa.
+ */
+#define VERIFICAR(cond)                                                          \
+    do                                                                           \
+    {                                                                            \
+        if (!(cond))                                                             \
+        {                                                                        \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);  \
+            exit(1);                                                             \
+        }                                                                        \
+    } while (0)
+
+#endif // TESTE_H
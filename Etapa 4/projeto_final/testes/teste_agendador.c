@@ -0,0 +1,206 @@
+// ======================================================================
+//  Arquivo: teste_agendador.c
+//  Descrição: Taxa fixa, atraso, períodos perdidos e estouro de orçamento
+//             do agendador, com o relógio e o timer simulados
+// ======================================================================
+
+#include <stdio.h>
+#include "agendador.h"
+#include "sdk_host.h"
+#include "teste.h"
+
+#define PERIODO_US   10000
+#define ORCAMENTO_US 7000
+#define INICIO_US    123456 // Instante em que o timer é iniciado
+
+// ----------------------------------------------------------------------
+// Pool de alarmes simulado: guarda o timer, que o teste dispara
+// ----------------------------------------------------------------------
+static bool pool_disponivel = true;
+static repeating_timer_t *timer_ativo = NULL;
+static uint32_t disparos = 0; // Liberações já disparadas
+
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers)
+{
+    static int pool;
+    (void)max_timers;
+    return pool_disponivel ? (alarm_pool_t *)&pool : NULL;
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback,
+                                       void *user_data, repeating_timer_t *out)
+{
+    (void)pool;
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    timer_ativo = out;
+    disparos = 0;
+    return true;
+}
+
+/**
+ * Leva o relógio até agora_us, disparando o callback em cada liberação
+ * nominal até lá (INICIO_US + k·PERIODO_US, como o timer de taxa fixa).
+ */
+static void avancar_ate(uint64_t agora_us)
+{
+    while (INICIO_US + (uint64_t)(disparos + 1) * PERIODO_US <= agora_us)
+    {
+        disparos++;
+        sdk_host_definir_us(INICIO_US + (uint64_t)disparos * PERIODO_US);
+        VERIFICAR(timer_ativo->callback(timer_ativo));
+    }
+    sdk_host_definir_us(agora_us);
+}
+
+/** Instante nominal da liberação k. */
+static uint64_t nominal(uint32_t k) { return INICIO_US + (uint64_t)k * PERIODO_US; }
+
+static void iniciar(agendador_t *agendador)
+{
+    sdk_host_definir_us(INICIO_US);
+    agendador_iniciar(agendador, PERIODO_US, ORCAMENTO_US, 0);
+    VERIFICAR(agendador_iniciar_timer(agendador));
+}
+
+/**
+ * Roda um período: espera a liberação, começa atraso_us depois da nominal e
+ * trabalha trabalho_us. Retorna o índice do período.
+ */
+static uint32_t rodar_periodo(agendador_t *agendador, uint32_t atraso_us, uint32_t trabalho_us)
+{
+    avancar_ate(nominal(disparos + 1) + atraso_us);
+    agendador_aguardar(agendador); // Período pendente: retorna sem esperar
+    uint32_t periodo = agendador_comecar_periodo(agendador, time_us_64());
+    avancar_ate(time_us_64() + trabalho_us);
+    agendador_terminar_periodo(agendador, time_us_64());
+    return periodo;
+}
+
+// ----------------------------------------------------------------------
+// Testes
+// ----------------------------------------------------------------------
+
+// O timer parte de agora, com atraso negativo (taxa fixa, sem deriva)
+static void testar_iniciar_timer(void)
+{
+    agendador_t agendador;
+    iniciar(&agendador);
+    VERIFICAR(agendador.inicio_us == INICIO_US);
+    VERIFICAR(timer_ativo == &agendador.timer);
+    VERIFICAR(agendador.timer.delay_us == -PERIODO_US);
+    VERIFICAR(agendador.pool != NULL);
+    VERIFICAR(!agendador_periodo_pendente(&agendador));
+
+    pool_disponivel = false;
+    VERIFICAR(!agendador_iniciar_timer(&agendador));
+    VERIFICAR(agendador.pool == NULL);
+    pool_disponivel = true;
+    printf("iniciar_timer: ok\n");
+}
+
+// Atrasos variados não se acumulam: cada período é medido pela liberação nominal
+static void testar_taxa_fixa(void)
+{
+    agendador_t agendador;
+    iniciar(&agendador);
+
+    uint32_t estado = 7;
+    uint64_t soma_atrasos = 0;
+    uint32_t maior_atraso = 0;
+    for (uint32_t k = 1; k <= 1000; k++)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        uint32_t atraso_us = (estado >> 8) % 2000;
+        uint32_t trabalho_us = 1000 + (estado >> 4) % 5000; // Dentro do orçamento e do período
+        VERIFICAR(rodar_periodo(&agendador, atraso_us, trabalho_us) == k);
+        VERIFICAR(agendador.atraso_us == atraso_us);
+        VERIFICAR(agendador.trabalho_us == trabalho_us);
+        soma_atrasos += atraso_us;
+        if (atraso_us > maior_atraso) maior_atraso = atraso_us;
+    }
+
+    VERIFICAR(agendador.periodos == 1000);
+    VERIFICAR(agendador.periodos_perdidos == 0);
+    VERIFICAR(agendador.estouros == 0 && agendador.periodos_degradados == 0);
+    VERIFICAR(agendador.atraso_total_us == soma_atrasos);
+    VERIFICAR(agendador.atraso_maximo_us == maior_atraso);
+    VERIFICAR(agendador_baixa_prioridade(&agendador));
+    printf("taxa fixa: 1000 períodos, atraso máximo %u us: ok\n", (unsigned)maior_atraso);
+}
+
+// Um período longo deixa liberações pendentes: o laço pula para a mais recente
+static void testar_periodos_perdidos(void)
+{
+    agendador_t agendador;
+    iniciar(&agendador);
+
+    VERIFICAR(rodar_periodo(&agendador, 0, 1000) == 1);
+
+    // Trabalho de 3,5 períodos: as liberações 2, 3 e 4 chegam com o laço ocupado
+    uint32_t periodo = rodar_periodo(&agendador, 0, 35000);
+    VERIFICAR(periodo == 2);
+    VERIFICAR(agendador_periodo_pendente(&agendador));
+    VERIFICAR(agendador.liberados == 5);
+
+    agendador_aguardar(&agendador);
+    periodo = agendador_comecar_periodo(&agendador, time_us_64());
+    VERIFICAR(periodo == 5);
+    VERIFICAR(agendador.periodos_perdidos == 2);                  // 3 e 4
+    VERIFICAR(agendador.atraso_us == time_us_64() - nominal(5)); // Medido pela liberação atendida
+    VERIFICAR(agendador.atraso_us == 5000);
+    agendador_terminar_periodo(&agendador, time_us_64() + 1000);
+
+    // Retomada normal na taxa fixa
+    VERIFICAR(!agendador_periodo_pendente(&agendador));
+    VERIFICAR(rodar_periodo(&agendador, 10, 1000) == 6);
+    VERIFICAR(agendador.periodos_perdidos == 2);
+    VERIFICAR(agendador.periodos == 4);
+    VERIFICAR(agendador.atraso_maximo_us == 5000);
+    printf("períodos perdidos: ok\n");
+}
+
+// Estouro degrada o próximo período; a volta exige uma sequência dentro do orçamento
+static void testar_estouro_e_recuperacao(void)
+{
+    agendador_t agendador;
+    iniciar(&agendador);
+
+    rodar_periodo(&agendador, 0, ORCAMENTO_US); // No limite: não é estouro
+    VERIFICAR(agendador.estouros == 0 && agendador_baixa_prioridade(&agendador));
+
+    rodar_periodo(&agendador, 0, ORCAMENTO_US + 1);
+    VERIFICAR(agendador.estouros == 1);
+    VERIFICAR(!agendador_baixa_prioridade(&agendador));
+    VERIFICAR(agendador.trabalho_maximo_us == ORCAMENTO_US + 1);
+
+    // Um estouro no meio da recuperação recomeça a contagem
+    for (uint32_t i = 0; i < AGENDADOR_PERIODOS_RECUPERACAO - 1; i++) rodar_periodo(&agendador, 0, 1000);
+    VERIFICAR(!agendador_baixa_prioridade(&agendador));
+    rodar_periodo(&agendador, 0, 9000);
+    VERIFICAR(agendador.estouros == 2);
+
+    for (uint32_t i = 0; i < AGENDADOR_PERIODOS_RECUPERACAO - 1; i++)
+    {
+        rodar_periodo(&agendador, 0, 1000);
+        VERIFICAR(!agendador_baixa_prioridade(&agendador));
+    }
+    rodar_periodo(&agendador, 0, 1000);
+    VERIFICAR(agendador_baixa_prioridade(&agendador));
+
+    // Degradados: do período seguinte ao primeiro estouro até o último da recuperação
+    VERIFICAR(agendador.periodos_degradados == 2 * AGENDADOR_PERIODOS_RECUPERACAO);
+    VERIFICAR(agendador.trabalho_maximo_us == 9000);
+    VERIFICAR(agendador.periodos_perdidos == 0);
+    printf("estouro e recuperação: ok\n");
+}
+
+int main(void)
+{
+    testar_iniciar_timer();
+    testar_taxa_fixa();
+    testar_periodos_perdidos();
+    testar_estouro_e_recuperacao();
+    return 0;
+}
@@ -0,0 +1,186 @@
+// ======================================================================
+//  Arquivo: teste_alinhamento.c
+//  Descrição: Calibração funcional de montagem sobre traços sintéticos de
+//             um sensor desalinhado: repouso e flexões com volta (sinal do
+//             giro invertido), com ruído e bias, na coxa e no tronco
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "alinhamento_sensor.h"
+#include "teste.h"
+
+#define GRAU (M_PI / 180.0)
+#define AMOSTRAS_FASE 300        // 3s por fase a 100Hz (CALIBRACAO_DURACAO_FASE_MS, CALIBRACAO_PERIODO_MS)
+#define TOLERANCIA_GRAUS 2.0     // Erro aceito no alinhamento estimado
+
+static uint32_t semente = 11;
+
+/** Uniforme em [-1, 1). */
+static double aleatorio(void)
+{
+    semente = semente * 1664525u + 1013904223u;
+    return (double)(semente >> 8) / (double)(1u << 23) - 1.0;
+}
+
+/** Rotação de v pelo quaternion unitário q (v' = q v q*). */
+static void rotacionar(Quaternion q, const double v[3], double saida[3])
+{
+    double tx = 2.0 * (q.y * v[2] - q.z * v[1]);
+    double ty = 2.0 * (q.z * v[0] - q.x * v[2]);
+    double tz = 2.0 * (q.x * v[1] - q.y * v[0]);
+    saida[0] = v[0] + q.w * tx + (q.y * tz - q.z * ty);
+    saida[1] = v[1] + q.w * ty + (q.z * tx - q.x * tz);
+    saida[2] = v[2] + q.w * tz + (q.x * ty - q.y * tx);
+}
+
+/** Montagem ao acaso: quaternion unitário (segmento -> sensor) uniforme. */
+static Quaternion montagem_aleatoria(void)
+{
+    double w = aleatorio(), x = aleatorio(), y = aleatorio(), z = aleatorio();
+    double n = sqrt(w * w + x * x + y * y + z * z);
+    Quaternion q = {(float)(w / n), (float)(x / n), (float)(y / n), (float)(z / n)};
+    return q;
+}
+
+/** Ângulo entre duas orientações (graus), sem distinguir q de -q. */
+static double distancia_graus(Quaternion a, Quaternion b)
+{
+    double produto = fabs((double)a.w * b.w + (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z);
+    if (produto > 1.0) produto = 1.0;
+    return 2.0 * acos(produto) / GRAU;
+}
+
+/**
+ * Calibração simulada de um sensor montado com a rotação q_montagem.
+ *
+ * Repouso: o acelerômetro mede +1g no eixo longitudinal (Y do segmento), com
+ * ruído. Movimento: ciclos de ida e volta em torno do eixo de flexão (X do
+ * segmento), com perfil senoidal de velocidade (as amostras lentas perto da
+ * inversão são descartadas pelo limiar), ruído, bias do giroscópio e um
+ * balanço fora do eixo. A flexão é rotação negativa em torno de X; com
+ * sentido_flexao = -1 (tronco) o primeiro movimento é o oposto.
+ *
+ * @param eixo_movimento Eixo do movimento no referencial do segmento (X para a flexão)
+ */
+static bool calibrar(Quaternion q_montagem, float sentido_flexao, const double eixo_movimento[3],
+                     Quaternion *q_estimado)
+{
+    alinhamento_estimador_t est;
+    alinhamento_iniciar(&est);
+
+    static const double Y[3] = {0.0, 1.0, 0.0};
+    static const double Z[3] = {0.0, 0.0, 1.0};
+    double vertical[3], eixo[3], balanco[3];
+    rotacionar(q_montagem, Y, vertical);
+    rotacionar(q_montagem, eixo_movimento, eixo);
+    rotacionar(q_montagem, Z, balanco);
+
+    for (int k = 0; k < AMOSTRAS_FASE; k++)
+    {
+        float accel[3];
+        for (int i = 0; i < 3; i++) accel[i] = (float)(vertical[i] + 0.02 * aleatorio());
+        alinhamento_acumular_repouso(&est, accel);
+    }
+
+    const double bias[3] = {0.8, -0.5, 0.3}; // °/s no referencial do sensor
+    for (int k = 0; k < AMOSTRAS_FASE; k++)
+    {
+        // Dois ciclos de ida e volta, pico de 90°/s; o balanço fora do eixo tem 10% do pico
+        double fase = 2.0 * M_PI * 2.0 * k / AMOSTRAS_FASE;
+        double velocidade = -sentido_flexao * 90.0 * sin(fase);
+        double oscilacao = 9.0 * sin(2.0 * fase);
+        float gyro[3];
+        for (int i = 0; i < 3; i++)
+        {
+            gyro[i] = (float)(velocidade * eixo[i] + oscilacao * balanco[i] + bias[i] + 1.5 * aleatorio());
+        }
+        alinhamento_acumular_flexao(&est, gyro);
+    }
+    return alinhamento_calcular(&est, sentido_flexao, q_estimado);
+}
+
+// ----------------------------------------------------------------------
+// Testes
+// ----------------------------------------------------------------------
+static const double EIXO_FLEXAO[3] = {1.0, 0.0, 0.0};
+
+// Montagens ao acaso: o alinhamento estimado recupera a montagem, na coxa e no tronco
+static void testar_recupera_montagem(float sentido_flexao, const char *segmento)
+{
+    double pior = 0.0;
+    for (int n = 0; n < 200; n++)
+    {
+        Quaternion q_montagem = montagem_aleatoria();
+        Quaternion q_estimado;
+        VERIFICAR(calibrar(q_montagem, sentido_flexao, EIXO_FLEXAO, &q_estimado));
+        double erro = distancia_graus(q_montagem, q_estimado);
+        if (erro > pior) pior = erro;
+    }
+    printf("%s: 200 montagens, pior erro %.2f°: ok\n", segmento, pior);
+    VERIFICAR(pior < TOLERANCIA_GRAUS);
+}
+
+// O sentido errado espelha o eixo de flexão: a estimativa sai a 180° da montagem
+static void testar_sentido_trocado(void)
+{
+    Quaternion q_montagem = montagem_aleatoria();
+    Quaternion q_estimado;
+    VERIFICAR(calibrar(q_montagem, +1.0f, EIXO_FLEXAO, &q_estimado));
+    VERIFICAR(distancia_graus(q_montagem, q_estimado) < TOLERANCIA_GRAUS);
+
+    Quaternion q_trocado;
+    static const double EIXO_OPOSTO[3] = {-1.0, 0.0, 0.0};
+    VERIFICAR(calibrar(q_montagem, +1.0f, EIXO_OPOSTO, &q_trocado));
+    VERIFICAR(distancia_graus(q_montagem, q_trocado) > 180.0 - TOLERANCIA_GRAUS);
+    printf("sentido trocado: ok\n");
+}
+
+// Movimento em torno da vertical (ou quase): o eixo de flexão não se separa de Y
+static void testar_rejeita_eixo_vertical(void)
+{
+    static const double QUASE_VERTICAL[3] = {0.2, 1.0, 0.1}; // ~13° da vertical
+    static const double EIXO_45[3] = {1.0, 1.0, 0.0};        // 45°: ainda aceito
+    Quaternion q_montagem = montagem_aleatoria();
+    Quaternion q_estimado;
+    VERIFICAR(!calibrar(q_montagem, +1.0f, QUASE_VERTICAL, &q_estimado));
+    VERIFICAR(calibrar(q_montagem, +1.0f, EIXO_45, &q_estimado));
+    VERIFICAR(distancia_graus(q_montagem, q_estimado) < TOLERANCIA_GRAUS);
+    printf("eixo de flexão quase vertical rejeitado: ok\n");
+}
+
+// Sem movimento (só ruído e bias abaixo do limiar) ou sem repouso: estimativa inválida
+static void testar_amostras_insuficientes(void)
+{
+    alinhamento_estimador_t est;
+    Quaternion q;
+    alinhamento_iniciar(&est);
+    for (int k = 0; k < AMOSTRAS_FASE; k++)
+    {
+        float accel[3] = {0.0f, 1.0f, 0.0f};
+        float gyro[3] = {(float)(2.0 * aleatorio()), 1.0f, (float)(2.0 * aleatorio())};
+        alinhamento_acumular_repouso(&est, accel);
+        alinhamento_acumular_flexao(&est, gyro);
+    }
+    VERIFICAR(est.amostras_movimento == 0);
+    VERIFICAR(!alinhamento_calcular(&est, 1.0f, &q));
+
+    alinhamento_iniciar(&est);
+    for (int k = 0; k < AMOSTRAS_FASE; k++)
+    {
+        float gyro[3] = {-60.0f, 0.0f, 0.0f};
+        alinhamento_acumular_flexao(&est, gyro);
+    }
+    VERIFICAR(!alinhamento_calcular(&est, 1.0f, &q));
+    printf("amostras insuficientes: ok\n");
+}
+
+int main(void)
+{
+    testar_recupera_montagem(+1.0f, "coxa (sentido +1)");
+    testar_recupera_montagem(-1.0f, "tronco (sentido -1)");
+    testar_sentido_trocado();
+    testar_rejeita_eixo_vertical();
+    testar_amostras_insuficientes();
+    return 0;
+}
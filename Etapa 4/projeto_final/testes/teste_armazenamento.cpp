@@ -0,0 +1,165 @@
+// ======================================================================
+//  Arquivo: teste_armazenamento.cpp
+//  Descrição: Falhas do SDCard simuladas: os eventos ficam na faixa e são
+//             regravados com espera crescente, sem perda nem duplicação;
+//             diagnósticos e amostras que falham são perdidos e contados
+// ======================================================================
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "analise_postural.h"
+#include "armazenamento.h"
+#include "sdk_host.h"
+extern "C" {
+#include "SDCard.h"
+}
+#include "teste.h"
+
+// ----------------------------------------------------------------------
+// SDCard e RTC simulados
+// ----------------------------------------------------------------------
+static uint32_t falhas_restantes = 0; // Próximas gravações que falham
+static uint32_t gravacoes = 0;        // Chamadas de append_csv_block
+static std::string dados_csv, diagnostico_csv;
+
+bool append_csv_block(const char* arquivo, const char*, const char* dados, size_t tamanho)
+{
+    gravacoes++;
+    if (falhas_restantes > 0)
+    {
+        falhas_restantes--;
+        return false;
+    }
+    std::string& destino = strcmp(arquivo, "dados.csv") == 0 ? dados_csv : diagnostico_csv;
+    destino.append(dados, tamanho);
+    return true;
+}
+
+bool rtc_update_datetime(ds3231_data_t* dt)
+{
+    *dt = {};
+    dt->century = 1;
+    dt->year = 25;
+    dt->month = 1;
+    dt->date = 1;
+    return true;
+}
+
+const char* movToStr(TipoMovimento) { return "Flexao"; }
+
+static void avancar_ms(uint32_t ms) { sdk_host_avancar_us((uint64_t)ms * 1000u); }
+
+static uint32_t linhas(const std::string& texto)
+{
+    uint32_t n = 0;
+    for (char c : texto) n += c == '\n';
+    return n;
+}
+
+static void registrar_eventos(uint32_t quantidade, uint32_t primeiro)
+{
+    for (uint32_t k = 0; k < quantidade; k++)
+    {
+        RegistroEvento registro = {};
+        registro.angulo_max = (float)(primeiro + k);
+        VERIFICAR(armazenamento_registrar_evento(registro) == ResultadoArmazenamento::ACEITO);
+    }
+}
+
+// ----------------------------------------------------------------------
+// Testes
+// ----------------------------------------------------------------------
+// Três falhas seguidas: nenhuma tentativa antes da espera (100, 200, 400 ms), e
+// os eventos saem gravados uma vez, em ordem
+static void testar_eventos_regravados(void)
+{
+    registrar_eventos(5, 0);
+    falhas_restantes = 3;
+
+    const uint32_t esperas[] = {ARMAZENAMENTO_ESPERA_FALHA_MS, 2 * ARMAZENAMENTO_ESPERA_FALHA_MS,
+                                4 * ARMAZENAMENTO_ESPERA_FALHA_MS};
+    armazenamento_servir();
+    VERIFICAR(gravacoes == 1);
+    for (uint32_t espera : esperas)
+    {
+        avancar_ms(espera - 1);
+        armazenamento_servir();
+        VERIFICAR(armazenamento_estatisticas().faixas[(int)FaixaArmazenamento::EVENTOS].profundidade == 5);
+        uint32_t antes = gravacoes;
+        avancar_ms(1);
+        armazenamento_servir();
+        VERIFICAR(gravacoes == antes + 1);
+    }
+
+    EstatisticasArmazenamento e = armazenamento_estatisticas();
+    VERIFICAR(e.falhas_gravacao == 3 && e.eventos_adiados == 15 && e.linhas_perdidas == 0);
+    VERIFICAR(e.faixas[(int)FaixaArmazenamento::EVENTOS].profundidade == 0);
+    VERIFICAR(linhas(dados_csv) == 5);
+    size_t anterior = 0;
+    for (int k = 0; k < 5; k++)
+    {
+        char angulo[16];
+        snprintf(angulo, sizeof(angulo), ",%d.00\n", k);
+        size_t posicao = dados_csv.find(angulo);
+        VERIFICAR(posicao != std::string::npos && (k == 0 || posicao > anterior));
+        anterior = posicao;
+    }
+
+    // Depois do sucesso a espera recomeça: um evento novo é gravado na hora
+    registrar_eventos(1, 5);
+    armazenamento_servir();
+    VERIFICAR(linhas(dados_csv) == 6);
+    printf("eventos regravados após 3 falhas, sem perda nem duplicação: ok\n");
+}
+
+// A espera dobra a cada falha seguida até ARMAZENAMENTO_ESPERA_FALHA_MAXIMA_MS
+static void testar_espera_limitada(void)
+{
+    registrar_eventos(1, 100);
+    falhas_restantes = 12;
+    uint32_t ultima_ms = 0, maior_intervalo = 0;
+    armazenamento_servir();
+    for (uint32_t t = 10; armazenamento_estatisticas().faixas[(int)FaixaArmazenamento::EVENTOS].profundidade > 0; t += 10)
+    {
+        VERIFICAR(t < 60000);
+        avancar_ms(10);
+        uint32_t antes = gravacoes;
+        armazenamento_servir();
+        if (gravacoes != antes)
+        {
+            if (t - ultima_ms > maior_intervalo) maior_intervalo = t - ultima_ms;
+            ultima_ms = t;
+        }
+    }
+    VERIFICAR(falhas_restantes == 0);
+    VERIFICAR(maior_intervalo == ARMAZENAMENTO_ESPERA_FALHA_MAXIMA_MS);
+    printf("espera entre tentativas limitada a %u ms: ok\n", (unsigned)maior_intervalo);
+}
+
+// Um lote de diagnósticos que falha não volta: perdido e contado
+static void testar_diagnosticos_perdidos(void)
+{
+    EstatisticasArmazenamento antes = armazenamento_estatisticas();
+    for (int k = 0; k < ARMAZENAMENTO_LOTE_DIAGNOSTICOS; k++)
+    {
+        armazenamento_registrar_diagnostico("diagnostico %d", k);
+    }
+    falhas_restantes = 1;
+    armazenamento_servir();
+    EstatisticasArmazenamento depois = armazenamento_estatisticas();
+    VERIFICAR(depois.linhas_perdidas - antes.linhas_perdidas == ARMAZENAMENTO_LOTE_DIAGNOSTICOS);
+    VERIFICAR(depois.eventos_adiados == antes.eventos_adiados);
+    VERIFICAR(depois.faixas[(int)FaixaArmazenamento::DIAGNOSTICOS].profundidade == 0);
+    VERIFICAR(diagnostico_csv.empty());
+    printf("lote de diagnósticos perdido na falha e contado: ok\n");
+}
+
+int main(void)
+{
+    sdk_host_definir_us(1000000);
+    testar_eventos_regravados();
+    testar_espera_limitada();
+    testar_diagnosticos_perdidos();
+    return 0;
+}
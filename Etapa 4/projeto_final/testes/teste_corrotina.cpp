@@ -0,0 +1,344 @@
+// ======================================================================
+//  Arquivo: teste_corrotina.cpp
+//  Descrição: Corrotinas com relógio simulado: esperas por tempo e por
+//             condição, falha de alocação, liberação do quadro na destruição
+//             no meio da sequência e as sequências do MPU9250 sobre um
+//             barramento I2C simulado
+// ======================================================================
+
+#include <cstdio>
+#include <cstring>
+#include "corrotina.hpp"
+#include "sdk_host.h"
+#include "sequencias_mpu9250.h"
+extern "C" {
+#include "mpu9250_regs.h"
+}
+#include "teste.h"
+
+// ----------------------------------------------------------------------
+// Barramento I2C simulado: registradores do MPU9250 e do AK8963 (via bypass)
+// ----------------------------------------------------------------------
+struct i2c_inst {
+    int id;
+};
+static i2c_inst barramento = {1};
+i2c_inst_t *i2c0 = &barramento, *i2c1 = &barramento;
+
+static uint8_t registradores_mpu[256];
+static uint8_t registradores_mag[256];
+static uint8_t ponteiro_mpu, ponteiro_mag;
+static bool excitacao_auto_teste = false;     // GYRO_CONFIG com self-test: os eixos respondem
+static uint64_t dado_mag_em_us = UINT64_MAX;  // O I2C master entrega uma leitura sem transbordo a partir daqui
+
+extern "C" {
+uint i2c_init(i2c_inst_t*, uint baudrate) { return baudrate; }
+void gpio_init(uint) {}
+void gpio_set_dir(uint, bool) {}
+void gpio_put(uint, bool) {}
+void gpio_set_function(uint, enum gpio_function) {}
+void gpio_pull_up(uint) {}
+
+int i2c_write_blocking(i2c_inst_t*, uint8_t endereco, const uint8_t* origem, size_t tamanho, bool)
+{
+    if (endereco == AK8963_ADDR)
+    {
+        if (!(registradores_mpu[MPU9250_INT_PIN_CFG] & BYPASS_EN)) return PICO_ERROR_GENERIC; // Sem bypass, o AK8963 não aparece
+        ponteiro_mag = origem[0];
+        if (tamanho > 1) registradores_mag[origem[0]] = origem[1];
+        return (int)tamanho;
+    }
+    ponteiro_mpu = origem[0];
+    if (tamanho > 1)
+    {
+        registradores_mpu[origem[0]] = origem[1];
+        if (origem[0] == MPU9250_GYRO_CONFIG) excitacao_auto_teste = origem[1] == 0xE0;
+    }
+    return (int)tamanho;
+}
+
+int i2c_read_blocking(i2c_inst_t*, uint8_t endereco, uint8_t* destino, size_t tamanho, bool)
+{
+    if (endereco == AK8963_ADDR)
+    {
+        if (!(registradores_mpu[MPU9250_INT_PIN_CFG] & BYPASS_EN)) return PICO_ERROR_GENERIC;
+        memcpy(destino, &registradores_mag[ponteiro_mag], tamanho);
+        return (int)tamanho;
+    }
+    if (ponteiro_mpu == MPU9250_EXT_SENS_DATA_00 && time_us_64() >= dado_mag_em_us &&
+        (registradores_mpu[MPU9250_USER_CTRL] & I2C_MST_EN))
+    {
+        registradores_mpu[MPU9250_EXT_SENS_DATA_00] = AK8963_ST1_DRDY;
+        registradores_mpu[MPU9250_EXT_SENS_DATA_00 + 7] = 0;
+    }
+    if (ponteiro_mpu == MPU9250_ACCEL_XOUT_H)
+    {
+        // Acelerômetro nos bytes 0..5 e giroscópio nos 8..13, maiores com a excitação ligada
+        int16_t aceleracao = excitacao_auto_teste ? 6000 : 1000;
+        int16_t giro = excitacao_auto_teste ? 900 : 10;
+        for (size_t i = 0; i + 1 < tamanho; i += 2)
+        {
+            int16_t valor = i < 6 ? aceleracao : (i >= 8 ? giro : 0);
+            destino[i] = (uint8_t)(valor >> 8);
+            destino[i + 1] = (uint8_t)valor;
+        }
+        return (int)tamanho;
+    }
+    memcpy(destino, &registradores_mpu[ponteiro_mpu], tamanho);
+    return (int)tamanho;
+}
+}
+
+// ----------------------------------------------------------------------
+// Corrotinas de teste
+// ----------------------------------------------------------------------
+static int etapas = 0;
+static int destruidos = 0;
+static bool condicao_ligada = false;
+static bool resultado_espera = false;
+
+static bool condicao(void* contexto) { return *static_cast<bool*>(contexto); }
+
+// Conta a destruição das variáveis locais do quadro
+struct Sentinela {
+    ~Sentinela() { destruidos++; }
+};
+
+static Corrotina esperarTempo(uint64_t duracao_us)
+{
+    Sentinela sentinela;
+    etapas++;
+    co_await esperarUs(duracao_us);
+    etapas++;
+    co_await esperarUs(duracao_us);
+    etapas++;
+    co_return true;
+}
+
+static Corrotina esperarPelaCondicao(uint64_t limite_us)
+{
+    resultado_espera = co_await esperarCondicao(condicao, &condicao_ligada, limite_us);
+    co_return resultado_espera;
+}
+
+// Quadro maior que CORROTINA_TAMANHO_QUADRO: o bloco atravessa a suspensão
+static Corrotina quadroGrande(uint8_t* saida)
+{
+    uint8_t bloco[CORROTINA_TAMANHO_QUADRO];
+    for (size_t i = 0; i < sizeof(bloco); i++) bloco[i] = (uint8_t)i;
+    co_await esperarUs(10);
+    *saida = bloco[sizeof(bloco) - 1];
+    co_return true;
+}
+
+// ----------------------------------------------------------------------
+// Testes
+// ----------------------------------------------------------------------
+
+// retomar não avança antes do prazo, e avança exatamente nele
+static void testar_espera_tempo(void)
+{
+    etapas = 0;
+    Corrotina c = esperarTempo(1000);
+    VERIFICAR(c.valida() && !c.concluida());
+    VERIFICAR(etapas == 0); // Criada suspensa
+
+    uint64_t agora = time_us_64();
+    VERIFICAR(c.retomar(agora));
+    VERIFICAR(etapas == 1);
+    VERIFICAR(c.proximoUs() == agora + 1000);
+
+    for (uint64_t t = agora; t < agora + 1000; t += 111)
+    {
+        sdk_host_definir_us(t);
+        VERIFICAR(c.retomar(t));
+        VERIFICAR(etapas == 1);
+    }
+    VERIFICAR(c.retomar(agora + 999) && etapas == 1);
+    sdk_host_definir_us(agora + 1000);
+    VERIFICAR(c.retomar(agora + 1000));
+    VERIFICAR(etapas == 2);
+
+    // A segunda espera conta a partir da retomada
+    VERIFICAR(c.proximoUs() == agora + 2000);
+    sdk_host_definir_us(agora + 1999);
+    VERIFICAR(c.retomar(agora + 1999) && etapas == 2);
+    sdk_host_definir_us(agora + 2000);
+    VERIFICAR(!c.retomar(agora + 2000));
+    VERIFICAR(etapas == 3 && c.concluida() && c.resultado());
+    VERIFICAR(!c.retomar(agora + 3000)); // Concluída: nada mais a fazer
+    printf("espera por tempo: ok\n");
+}
+
+// EsperaCondicao: true na condição (antes do prazo), false no prazo; já atendida não suspende
+static void testar_espera_condicao(void)
+{
+    const uint64_t LIMITE_US = 50000;
+
+    condicao_ligada = false;
+    Corrotina atendida = esperarPelaCondicao(LIMITE_US);
+    uint64_t inicio = time_us_64();
+    VERIFICAR(atendida.retomar(inicio));
+    VERIFICAR(atendida.retomar(inicio + 10000)); // Condição desligada, prazo longe
+    condicao_ligada = true;
+    VERIFICAR(!atendida.retomar(inicio + 10001));
+    VERIFICAR(atendida.resultado() && resultado_espera);
+
+    condicao_ligada = false;
+    Corrotina vencida = esperarPelaCondicao(LIMITE_US);
+    inicio = time_us_64();
+    VERIFICAR(vencida.retomar(inicio));
+    VERIFICAR(vencida.retomar(inicio + LIMITE_US - 1));
+    VERIFICAR(!vencida.retomar(inicio + LIMITE_US));
+    VERIFICAR(vencida.concluida() && !vencida.resultado() && !resultado_espera);
+
+    condicao_ligada = true;
+    Corrotina pronta = esperarPelaCondicao(LIMITE_US);
+    VERIFICAR(!pronta.retomar(time_us_64())); // await_ready: conclui na primeira etapa
+    VERIFICAR(pronta.resultado());
+    printf("espera por condição: ok\n");
+}
+
+// Pool esgotado ou quadro grande demais: corrotina inválida, sem exceção
+static void testar_falha_alocacao(void)
+{
+    uint32_t falhas = QuadrosCorrotina::falhas;
+    {
+        Corrotina vivas[CORROTINA_QUADROS];
+        for (Corrotina& c : vivas)
+        {
+            c = esperarTempo(1000);
+            VERIFICAR(c.valida());
+        }
+        VERIFICAR(QuadrosCorrotina::emUso() == CORROTINA_QUADROS);
+
+        Corrotina extra = esperarTempo(1000);
+        VERIFICAR(!extra.valida());
+        VERIFICAR(extra.concluida() && !extra.resultado());
+        VERIFICAR(!extra.retomar(time_us_64()) && !extra.executar());
+        VERIFICAR(QuadrosCorrotina::falhas == falhas + 1);
+    }
+    VERIFICAR(QuadrosCorrotina::emUso() == 0);
+
+    uint8_t saida = 0;
+    Corrotina grande = quadroGrande(&saida);
+    VERIFICAR(!grande.valida());
+    VERIFICAR(QuadrosCorrotina::falhas == falhas + 2);
+    VERIFICAR(QuadrosCorrotina::maior_pedido > CORROTINA_TAMANHO_QUADRO);
+    VERIFICAR(QuadrosCorrotina::emUso() == 0);
+    printf("falha de alocação: pool esgotado e quadro de %u bytes: ok\n", (unsigned)QuadrosCorrotina::maior_pedido);
+}
+
+// Destruída no meio da sequência: o quadro volta ao pool e as locais são destruídas
+static void testar_destruicao_no_meio(void)
+{
+    destruidos = 0;
+    {
+        Corrotina c = esperarTempo(1000);
+        VERIFICAR(c.retomar(time_us_64()));
+        VERIFICAR(QuadrosCorrotina::emUso() == 1);
+    }
+    VERIFICAR(QuadrosCorrotina::emUso() == 0);
+    VERIFICAR(destruidos == 1);
+
+    // Atribuição por movimento sobre uma corrotina viva libera a antiga
+    Corrotina c = esperarTempo(1000);
+    VERIFICAR(c.retomar(time_us_64()));
+    c = esperarTempo(1000);
+    VERIFICAR(QuadrosCorrotina::emUso() == 1);
+    VERIFICAR(destruidos == 2);
+    Corrotina movida = static_cast<Corrotina&&>(c);
+    VERIFICAR(!c.valida() && movida.valida());
+    VERIFICAR(QuadrosCorrotina::emUso() == 1);
+    movida = Corrotina();
+    VERIFICAR(QuadrosCorrotina::emUso() == 0);
+    printf("destruição no meio da sequência: ok\n");
+}
+
+/** Retoma a sequência a cada 2ms, como o laço do núcleo 1, até concluir. */
+static bool rodar(Corrotina& c)
+{
+    VERIFICAR(c.valida());
+    while (c.retomar(time_us_64())) sdk_host_avancar_us(2000);
+    return c.resultado();
+}
+
+static void testar_sequencias_mpu9250(mpu9250_t* mpu)
+{
+    registradores_mag[AK8963_WHO_AM_I] = AK8963_ID;
+    registradores_mag[AK8963_ASAX] = 128;
+    registradores_mag[AK8963_ASAX + 1] = 160;
+    registradores_mag[AK8963_ASAX + 2] = 96;
+
+    // Habilitação em etapas: termina no I2C master, sem bypass, com o ajuste de fábrica
+    dado_mag_em_us = time_us_64() + 600000;
+    Corrotina habilitar = sequenciaHabilitarMagnetometro(mpu);
+    VERIFICAR(rodar(habilitar));
+    VERIFICAR(mpu->mag_enabled);
+    VERIFICAR(registradores_mpu[MPU9250_I2C_SLV0_CTRL] == (I2C_SLV0_EN | 8));
+    VERIFICAR(registradores_mpu[MPU9250_USER_CTRL] == I2C_MST_EN);
+    VERIFICAR(!(registradores_mpu[MPU9250_INT_PIN_CFG] & BYPASS_EN));
+    VERIFICAR(registradores_mag[AK8963_CNTL1] == (AK8963_CONTINUOUS_100HZ | AK8963_BIT_16));
+    VERIFICAR(mpu->mag_asa[0] == 1.0f && mpu->mag_asa[1] == 1.125f && mpu->mag_asa[2] == 0.875f);
+    habilitar = Corrotina();
+
+    // Recuperação do transbordo: a FIFO continua ligada durante toda a sequência
+    registradores_mpu[MPU9250_USER_CTRL] = I2C_MST_EN | USER_FIFO_EN;
+    registradores_mpu[MPU9250_EXT_SENS_DATA_00 + 7] = AK8963_ST2_HOFL;
+    mpu->mag_overflow = true;
+    dado_mag_em_us = time_us_64() + 40000;
+    Corrotina recuperar = sequenciaRecuperarMagnetometro(mpu);
+    while (recuperar.retomar(time_us_64()))
+    {
+        VERIFICAR(registradores_mpu[MPU9250_USER_CTRL] & USER_FIFO_EN);
+        sdk_host_avancar_us(2000);
+    }
+    VERIFICAR(recuperar.resultado() && !mpu->mag_overflow);
+    VERIFICAR(registradores_mpu[MPU9250_USER_CTRL] == (I2C_MST_EN | USER_FIFO_EN));
+
+    // Sem leitura nova: a espera por E/S vence e a sequência termina com false
+    registradores_mpu[MPU9250_EXT_SENS_DATA_00 + 7] = AK8963_ST2_HOFL;
+    mpu->mag_overflow = true;
+    dado_mag_em_us = UINT64_MAX;
+    uint64_t inicio = time_us_64();
+    recuperar = sequenciaRecuperarMagnetometro(mpu);
+    VERIFICAR(!rodar(recuperar));
+    VERIFICAR(!mpu->mag_overflow);
+    VERIFICAR(time_us_64() - inicio >= SEQUENCIA_LIMITE_DADO_MAG_US);
+    recuperar = Corrotina();
+
+    // Auto-teste bloqueante: a configuração original volta ao fim
+    registradores_mpu[MPU9250_SMPLRT_DIV] = 1;
+    registradores_mpu[MPU9250_CONFIG] = 3;
+    const uint8_t codigos[] = {SELF_TEST_X_GYRO, SELF_TEST_Y_GYRO, SELF_TEST_Z_GYRO,
+                               SELF_TEST_X_ACCEL, SELF_TEST_Y_ACCEL, SELF_TEST_Z_ACCEL};
+    for (uint8_t r : codigos) registradores_mpu[r] = 0x55;
+    VERIFICAR(sequenciaAutoTeste(mpu).executar());
+    VERIFICAR(registradores_mpu[MPU9250_SMPLRT_DIV] == 1 && registradores_mpu[MPU9250_CONFIG] == 3);
+    VERIFICAR(registradores_mpu[MPU9250_GYRO_CONFIG] != 0xE0);
+    VERIFICAR(registradores_mpu[MPU9250_I2C_SLV0_CTRL] == (I2C_SLV0_EN | 8));
+
+    // Todas as sequências cabem no quadro, e nenhum ficou preso
+    VERIFICAR(QuadrosCorrotina::maior_pedido <= CORROTINA_TAMANHO_QUADRO);
+    VERIFICAR(QuadrosCorrotina::falhas == 0);
+    VERIFICAR(QuadrosCorrotina::emUso() == 0);
+    printf("sequências do MPU9250: maior quadro %u de %u bytes: ok\n", (unsigned)QuadrosCorrotina::maior_pedido,
+           (unsigned)CORROTINA_TAMANHO_QUADRO);
+}
+
+int main(void)
+{
+    sdk_host_definir_us(1000000);
+
+    // As sequências (e seus printf) primeiro: o maior pedido ainda é o delas
+    static mpu9250_t mpu = {};
+    mpu.i2c = i2c1;
+    mpu.addr = 0x68;
+    testar_sequencias_mpu9250(&mpu);
+
+    testar_espera_tempo();
+    testar_espera_condicao();
+    testar_falha_alocacao();
+    testar_destruicao_no_meio();
+    return 0;
+}
@@ -0,0 +1,276 @@
+// ======================================================================
+//  Arquivo: teste_eskf.c
+//  Descrição: Covariância do ESKF simétrica e positiva definida ao longo
+//             de uma trajetória sintética com e sem magnetômetro, e o
+//             tempo por atualização comparado ao Madgwick em lote
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "MadgwickAHRS.h"
+#include "cronometro.h"
+#include "eskf.h"
+#include "teste.h"
+
+#define DT 0.01
+#define AMOSTRAS 60000 // 10 minutos a 100 Hz
+
+typedef struct
+{
+    double w, x, y, z;
+} quat_t;
+
+static quat_t multiplicar(quat_t a, quat_t b)
+{
+    quat_t r = {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z, a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x, a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+    return r;
+}
+
+/** Vetor da Terra no referencial do sensor (q* ⊗ v ⊗ q). */
+static void para_sensor(quat_t q, const double v[3], double saida[3])
+{
+    quat_t conjugado = {q.w, -q.x, -q.y, -q.z};
+    quat_t p = {0.0, v[0], v[1], v[2]};
+    quat_t r = multiplicar(multiplicar(conjugado, p), q);
+    saida[0] = r.x;
+    saida[1] = r.y;
+    saida[2] = r.z;
+}
+
+/** Ruído gaussiano (Box-Muller sobre um LCG), reprodutível em qualquer libc. */
+static double gaussiano(void)
+{
+    static uint32_t estado = 2024;
+    double u[2];
+    for (int i = 0; i < 2; i++)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        u[i] = ((estado >> 8) + 0.5) / (double)(1u << 24);
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+/** Simetria relativa ao maior termo e decomposição de Cholesky com todos os pivôs positivos. */
+static void verificar_covariancia(const eskf_t *filtro)
+{
+    double maior = 0.0;
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < 6; j++)
+            if (fabs(filtro->P[i][j]) > maior) maior = fabs(filtro->P[i][j]);
+    VERIFICAR(maior > 0.0 && isfinite(maior));
+
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < i; j++)
+            VERIFICAR(fabs(filtro->P[i][j] - filtro->P[j][i]) <= 1e-5 * maior);
+
+    double L[6][6] = {{0}};
+    for (int j = 0; j < 6; j++)
+    {
+        double pivo = filtro->P[j][j];
+        for (int k = 0; k < j; k++) pivo -= L[j][k] * L[j][k];
+        VERIFICAR(pivo > 0.0);
+        L[j][j] = sqrt(pivo);
+        for (int i = j + 1; i < 6; i++)
+        {
+            double soma = 0.5 * (filtro->P[i][j] + filtro->P[j][i]);
+            for (int k = 0; k < j; k++) soma -= L[i][k] * L[j][k];
+            L[i][j] = soma / L[j][j];
+        }
+    }
+}
+
+/** Ângulo (rad) entre a orientação estimada e a verdadeira. */
+static double erro_atitude(const eskf_t *filtro, quat_t verdade)
+{
+    double d = fabs(filtro->q0 * verdade.w + filtro->q1 * verdade.x + filtro->q2 * verdade.y + filtro->q3 * verdade.z);
+    return 2.0 * acos(d > 1.0 ? 1.0 : d);
+}
+
+/**
+ * Giro senoidal em três eixos com bias constante, aceleração linear em
+ * rajadas e o magnetômetro desligado no segundo terço da trajetória (só
+ * acelerômetro: rumo e bias vertical ficam não observáveis e sua variância
+ * cresce sem limite, o caso em que a simetria costuma se perder).
+ */
+static void testar_trajetoria(void)
+{
+    const double gravidade[3] = {0.0, 0.0, 1.0};
+    const double campo[3] = {0.4, 0.0, -0.9};
+    const double bias[3] = {0.015, -0.01, 0.02};
+
+    eskf_t filtro;
+    eskf_iniciar(&filtro);
+    verificar_covariancia(&filtro);
+
+    quat_t verdade = {1.0, 0.0, 0.0, 0.0};
+    double maior_erro_final = 0.0;
+    for (int k = 0; k < AMOSTRAS; k++)
+    {
+        double t = k * DT;
+        double w[3] = {1.2 * sin(2.0 * M_PI * 0.3 * t), 0.5 * sin(2.0 * M_PI * 0.55 * t + 1.0), 0.4 * sin(2.0 * M_PI * 0.2 * t + 2.0)};
+        double norma = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        if (norma > 0.0)
+        {
+            double meio = 0.5 * norma * DT, s = sin(meio) / norma;
+            quat_t passo = {cos(meio), w[0] * s, w[1] * s, w[2] * s};
+            verdade = multiplicar(verdade, passo);
+        }
+
+        double a[3], m[3];
+        para_sensor(verdade, gravidade, a);
+        para_sensor(verdade, campo, m);
+        int sem_mag = k >= AMOSTRAS / 3 && k < 2 * AMOSTRAS / 3;
+        int rajada = (k % 1000) < 100;
+
+        float giro[3], acel[3], mag[3];
+        for (int i = 0; i < 3; i++)
+        {
+            giro[i] = (float)(w[i] + bias[i] + 0.004 * gaussiano());
+            acel[i] = (float)(a[i] + 0.01 * gaussiano() + (rajada ? 0.3 * sin(3.0 * t + i) : 0.0));
+            mag[i] = sem_mag ? 0.0f : (float)(50.0 * (m[i] + 0.01 * gaussiano()));
+        }
+        eskf_atualizar(&filtro, giro, acel, mag, (float)DT);
+        verificar_covariancia(&filtro);
+
+        if (k >= AMOSTRAS - 1000)
+        {
+            double erro = erro_atitude(&filtro, verdade);
+            if (erro > maior_erro_final) maior_erro_final = erro;
+        }
+    }
+
+    // Com o magnetômetro de volta, atitude e bias reconvergem
+    printf("erro de atitude no último segundo: %.2f°, σ = %.2f°\n", maior_erro_final * 180.0 / M_PI,
+           sqrt(eskf_variancia_atitude(&filtro)) * 180.0 / M_PI);
+    VERIFICAR(maior_erro_final < 2.0 * M_PI / 180.0);
+    for (int i = 0; i < 3; i++) VERIFICAR(fabs(filtro.bias[i] - bias[i]) < 0.005);
+}
+
+/** Reiniciar a orientação recoloca a covariância inicial (diagonal). */
+static void testar_definir_orientacao(void)
+{
+    eskf_t filtro;
+    eskf_iniciar(&filtro);
+    const float giro[3] = {0.1f, 0.0f, 0.0f}, acel[3] = {0.0f, 0.0f, 1.0f}, mag[3] = {20.0f, 0.0f, -45.0f};
+    for (int k = 0; k < 100; k++) eskf_atualizar(&filtro, giro, acel, mag, (float)DT);
+
+    eskf_definir_orientacao(&filtro, 1.0f, 0.0f, 0.0f, 0.0f);
+    verificar_covariancia(&filtro);
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < 6; j++)
+            if (i != j) VERIFICAR(filtro.P[i][j] == 0.0f);
+}
+
+// ----------------------------------------------------------------------
+// Desempenho: as mesmas entradas no ESKF e no Madgwick em lote
+// ----------------------------------------------------------------------
+#define AMOSTRAS_MEDIDAS 4096
+#define REPETICOES 50
+
+typedef struct
+{
+    float giro[3], acel[3], mag[3];
+} entrada_t;
+
+static entrada_t entradas[AMOSTRAS_MEDIDAS];
+
+/** Tempo médio, em ns por sensor, do ESKF (um filtro por sensor, dois sensores). */
+static double medir_eskf(void)
+{
+    eskf_t filtros[2];
+    eskf_iniciar(&filtros[0]);
+    eskf_iniciar(&filtros[1]);
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+    {
+        for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+        {
+            for (int s = 0; s < 2; s++)
+            {
+                const entrada_t *e = &entradas[(k + 1000 * s) % AMOSTRAS_MEDIDAS];
+                eskf_atualizar(&filtros[s], e->giro, e->acel, e->mag, (float)DT);
+            }
+        }
+    }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(filtros[0].q0 + filtros[1].q0);
+    return (double)decorrido / (2.0 * REPETICOES * AMOSTRAS_MEDIDAS);
+}
+
+/** Tempo médio, em ns por sensor, do lote de dois sensores (MotorMadgwick). */
+static double medir_madgwick(void (*atualizar)(AHRS_batch_t *))
+{
+    AHRS_batch_t lote;
+    MadgwickAHRSbatchInit(&lote, 2, (float)(1.0 / DT));
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+    {
+        for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+        {
+            for (unsigned s = 0; s < 2; s++)
+            {
+                const entrada_t *e = &entradas[(k + 1000 * (int)s) % AMOSTRAS_MEDIDAS];
+                lote.gx[s] = e->giro[0];
+                lote.gy[s] = e->giro[1];
+                lote.gz[s] = e->giro[2];
+                lote.ax[s] = e->acel[0];
+                lote.ay[s] = e->acel[1];
+                lote.az[s] = e->acel[2];
+                lote.mx[s] = e->mag[0];
+                lote.my[s] = e->mag[1];
+                lote.mz[s] = e->mag[2];
+            }
+            atualizar(&lote);
+        }
+    }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(lote.q0[0] + lote.q0[1]);
+    return (double)decorrido / (2.0 * REPETICOES * AMOSTRAS_MEDIDAS);
+}
+
+/**
+ * Só informativo: no host a FPU esconde boa parte do custo das operações
+ * matriciais 6x6 do ESKF; os tempos no RP2040 vêm de medicao.h.
+ */
+static void medir_desempenho(void)
+{
+    const double gravidade[3] = {0.0, 0.0, 1.0};
+    const double campo[3] = {0.4, 0.0, -0.9};
+    quat_t verdade = {1.0, 0.0, 0.0, 0.0};
+    for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+    {
+        double t = k * DT;
+        double w[3] = {1.2 * sin(2.0 * M_PI * 0.3 * t), 0.5 * sin(2.0 * M_PI * 0.55 * t + 1.0), 0.4 * sin(2.0 * M_PI * 0.2 * t + 2.0)};
+        double norma = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        if (norma > 0.0)
+        {
+            double meio = 0.5 * norma * DT, s = sin(meio) / norma;
+            quat_t passo = {cos(meio), w[0] * s, w[1] * s, w[2] * s};
+            verdade = multiplicar(verdade, passo);
+        }
+        double a[3], m[3];
+        para_sensor(verdade, gravidade, a);
+        para_sensor(verdade, campo, m);
+        for (int i = 0; i < 3; i++)
+        {
+            entradas[k].giro[i] = (float)(w[i] + 0.004 * gaussiano());
+            entradas[k].acel[i] = (float)(a[i] + 0.01 * gaussiano());
+            entradas[k].mag[i] = (float)(50.0 * (m[i] + 0.01 * gaussiano()));
+        }
+    }
+
+    double eskf = medir_eskf();
+    double madgwick = medir_madgwick(MadgwickAHRSbatchUpdate);
+    printf("ns por atualização de um sensor no host | ESKF %.1f | Madgwick em lote: AHRS %.1f, IMU %.1f | "
+           "ESKF/Madgwick %.1fx\n",
+           eskf, madgwick, medir_madgwick(MadgwickAHRSbatchUpdateIMU), eskf / madgwick);
+}
+
+int main(void)
+{
+    testar_trajetoria();
+    testar_definir_orientacao();
+    medir_desempenho();
+    return 0;
+}
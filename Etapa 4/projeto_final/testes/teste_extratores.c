@@ -0,0 +1,248 @@
+// ======================================================================
+//  Arquivo: teste_extratores.c
+//  Descrição: Os dois extratores dos ângulos do quadril (sequência XYZ e
+//             swing-twist) sobre as mesmas poses: concordância nos
+//             movimentos de um só plano, diferença nos combinados,
+//             condicionamento perto da rotação de 90° e tempo por chamada
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "algoritmo_postura.h"
+#include "cronometro.h"
+#include "teste.h"
+
+// algoritmo_postura_swing_twist.c
+componentes_quadril_t swing_twist_quaternion_to_hip_components(Quaternion q);
+void swing_twist_quaternion_to_hip_angles(Quaternion q, float *flexao, float *aducao, float *rotacao);
+void swing_twist_hip_limits_define(limites_quadril_t *limites, float flexao, float aducao, float rotacao);
+bool swing_twist_hip_components_exceed(const componentes_quadril_t *c, const limites_quadril_t *limites, bool excede[3]);
+
+#define GRAU (M_PI / 180.0)
+#define TOLERANCIA_GRAUS 0.01 // Erro das aproximações de trig_rapida.h mais o arredondamento em float
+
+typedef void (*extrator_t)(Quaternion q, float *flexao, float *aducao, float *rotacao);
+
+typedef struct
+{
+    double w, x, y, z;
+} quat_t;
+
+static quat_t multiplicar(quat_t a, quat_t b)
+{
+    quat_t r = {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z, a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x, a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+    return r;
+}
+
+static quat_t eixo_angulo(double ax, double ay, double az, double angulo)
+{
+    double n = sqrt(ax * ax + ay * ay + az * az);
+    double s = sin(angulo / 2.0) / n;
+    quat_t q = {cos(angulo / 2.0), ax * s, ay * s, az * s};
+    return q;
+}
+
+static Quaternion para_float(quat_t q)
+{
+    Quaternion r = {(float)q.w, (float)q.x, (float)q.y, (float)q.z};
+    return r;
+}
+
+/** Pose de um só plano (graus): q = Rz(adução) ⊗ Ry(rotação) ⊗ Rx(-flexão) com dois ângulos nulos. */
+static Quaternion pose_plano(double flexao, double aducao, double rotacao)
+{
+    return para_float(multiplicar(multiplicar(eixo_angulo(0.0, 0.0, 1.0, aducao * GRAU), eixo_angulo(0.0, 1.0, 0.0, rotacao * GRAU)),
+                                  eixo_angulo(1.0, 0.0, 0.0, -flexao * GRAU)));
+}
+
+/**
+ * Pose anatômica (graus): o fêmur (Y) aponta para d, com flexão no plano
+ * sagital e adução para fora dele, seguido da rotação em torno do fêmur (a
+ * mesma definição de teste_swing_twist.c). Mantém o fêmur longe da lateral
+ * em toda a amplitude do quadril, ao contrário de compor ângulos XYZ grandes.
+ */
+static Quaternion pose(double flexao, double aducao, double rotacao)
+{
+    double roll = -flexao * GRAU, a = aducao * GRAU;
+    double d[3] = {-sin(a), cos(a) * cos(roll), cos(a) * sin(roll)};
+    double angulo = acos(fmax(-1.0, fmin(1.0, d[1])));
+    if (angulo < 1e-12) return para_float(eixo_angulo(0.0, 1.0, 0.0, rotacao * GRAU));
+    return para_float(multiplicar(eixo_angulo(d[2], 0.0, -d[0], angulo), eixo_angulo(0.0, 1.0, 0.0, rotacao * GRAU)));
+}
+
+static void angulos_graus(extrator_t extrator, Quaternion q, double saida[3])
+{
+    float flexao, aducao, rotacao;
+    extrator(q, &flexao, &aducao, &rotacao);
+    VERIFICAR(isfinite(flexao) && isfinite(aducao) && isfinite(rotacao));
+    saida[0] = flexao / GRAU;
+    saida[1] = aducao / GRAU;
+    saida[2] = rotacao / GRAU;
+}
+
+static double volta(double a)
+{
+    while (a > 180.0) a -= 360.0;
+    while (a < -180.0) a += 360.0;
+    return a;
+}
+
+static uint32_t semente = 39;
+static double aleatorio(void)
+{
+    semente = semente * 1664525u + 1013904223u;
+    return (semente >> 8) / 8388608.0 - 1.0;
+}
+
+/** Maior variação de ângulo (graus) por grau de perturbação aleatória de 0,1° em torno da pose. */
+static double ganho_perturbacao(extrator_t extrator, Quaternion q)
+{
+    double base[3], maior = 0.0;
+    angulos_graus(extrator, q, base);
+    quat_t qd = {q.w, q.x, q.y, q.z};
+    for (int t = 0; t < 50; t++)
+    {
+        double a[3];
+        angulos_graus(extrator, para_float(multiplicar(qd, eixo_angulo(aleatorio(), aleatorio(), aleatorio(), 0.1 * GRAU))), a);
+        for (int j = 0; j < 3; j++)
+        {
+            double g = fabs(volta(a[j] - base[j])) / 0.1;
+            if (g > maior) maior = g;
+        }
+    }
+    return maior;
+}
+
+// Movimentos de um só plano: os dois extratores dão os mesmos ângulos
+static void testar_plano_unico(void)
+{
+    for (double angulo = -80.0; angulo <= 120.0; angulo += 1.0)
+    {
+        const double v[3][3] = {{angulo, 0.0, 0.0}, {0.0, fmax(-80.0, fmin(80.0, angulo)), 0.0},
+                                {0.0, 0.0, fmax(-80.0, fmin(80.0, angulo))}};
+        for (int plano = 0; plano < 3; plano++)
+        {
+            double xyz[3], st[3];
+            Quaternion q = pose_plano(v[plano][0], v[plano][1], v[plano][2]);
+            angulos_graus(quaternion_to_hip_angles, q, xyz);
+            angulos_graus(swing_twist_quaternion_to_hip_angles, q, st);
+            for (int j = 0; j < 3; j++)
+            {
+                VERIFICAR(fabs(xyz[j] - v[plano][j]) < TOLERANCIA_GRAUS);
+                VERIFICAR(fabs(st[j] - v[plano][j]) < TOLERANCIA_GRAUS);
+            }
+        }
+    }
+    printf("um só plano (flexão, adução ou rotação): extratores iguais: ok\n");
+}
+
+/**
+ * Varredura da amplitude do quadril com os três ângulos combinados: diferença
+ * entre os extratores (cada um tem sua convenção, então ela é esperada) e o
+ * pior condicionamento de cada um. Perto da rotação de 90° o asin da
+ * sequência XYZ amplifica a perturbação; o swing-twist não.
+ */
+static void testar_varredura(void)
+{
+    const double flexoes[] = {-20.0, 0.0, 30.0, 60.0, 90.0, 120.0};
+    printf("flexão | maior diferença XYZ - swing-twist (flexão, adução, rotação) | ganho de perturbação XYZ, swing-twist\n");
+    double pior_st = 0.0, pior_xyz = 0.0;
+    for (int f = 0; f < 6; f++)
+    {
+        double diferenca[3] = {0.0, 0.0, 0.0}, ganho_xyz = 0.0, ganho_st = 0.0;
+        for (double aducao = -40.0; aducao <= 40.0; aducao += 10.0)
+            for (double rotacao = -89.0; rotacao <= 89.0; rotacao += 1.0)
+            {
+                double xyz[3], st[3];
+                Quaternion q = pose(flexoes[f], aducao, rotacao);
+                angulos_graus(quaternion_to_hip_angles, q, xyz);
+                angulos_graus(swing_twist_quaternion_to_hip_angles, q, st);
+                for (int j = 0; j < 3; j++)
+                {
+                    double d = fabs(volta(xyz[j] - st[j]));
+                    if (d > diferenca[j]) diferenca[j] = d;
+                }
+                if (fabs(rotacao) >= 80.0 && fmod(aducao, 20.0) == 0.0)
+                {
+                    double g = ganho_perturbacao(quaternion_to_hip_angles, q);
+                    if (g > ganho_xyz) ganho_xyz = g;
+                    g = ganho_perturbacao(swing_twist_quaternion_to_hip_angles, q);
+                    if (g > ganho_st) ganho_st = g;
+                }
+            }
+        printf("%6.0f° | %6.1f° %6.1f° %6.1f° | %6.1f %4.1f\n", flexoes[f], diferenca[0], diferenca[1], diferenca[2],
+               ganho_xyz, ganho_st);
+        if (ganho_st > pior_st) pior_st = ganho_st;
+        if (ganho_xyz > pior_xyz) pior_xyz = ganho_xyz;
+    }
+    VERIFICAR(pior_st < 2.5);          // Mesma ordem de grandeza da perturbação em toda a amplitude
+    VERIFICAR(pior_xyz > 5.0 * pior_st);
+}
+
+// ----------------------------------------------------------------------
+// Desempenho: as mesmas poses nos dois extratores
+// ----------------------------------------------------------------------
+#define POSES_MEDIDAS 4096
+#define REPETICOES 200
+
+static Quaternion poses[POSES_MEDIDAS];
+
+static double medir_angulos(extrator_t extrator)
+{
+    float soma = 0.0f;
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int k = 0; k < POSES_MEDIDAS; k++)
+        {
+            float flexao, aducao, rotacao;
+            extrator(poses[k], &flexao, &aducao, &rotacao);
+            soma += flexao + aducao + rotacao;
+        }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(soma);
+    return (double)decorrido / ((double)REPETICOES * POSES_MEDIDAS);
+}
+
+static double medir_limites(componentes_quadril_t (*componentes)(Quaternion),
+                            bool (*excede)(const componentes_quadril_t *, const limites_quadril_t *, bool[3]),
+                            const limites_quadril_t *limites)
+{
+    uint32_t alarmes = 0;
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int k = 0; k < POSES_MEDIDAS; k++)
+        {
+            componentes_quadril_t c = componentes(poses[k]);
+            bool por_angulo[3];
+            alarmes += excede(&c, limites, por_angulo);
+        }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir((float)alarmes);
+    return (double)decorrido / ((double)REPETICOES * POSES_MEDIDAS);
+}
+
+/** Só informativo: os tempos no RP2040 vêm de medicao.h. */
+static void medir_desempenho(void)
+{
+    for (int k = 0; k < POSES_MEDIDAS; k++)
+    {
+        poses[k] = pose(aleatorio() * 70.0 + 50.0, aleatorio() * 40.0, aleatorio() * 80.0);
+    }
+    limites_quadril_t limites_xyz, limites_st;
+    hip_limits_define(&limites_xyz, (float)(90.0 * GRAU), (float)(30.0 * GRAU), (float)(45.0 * GRAU));
+    swing_twist_hip_limits_define(&limites_st, (float)(90.0 * GRAU), (float)(30.0 * GRAU), (float)(45.0 * GRAU));
+
+    printf("ns por pose no host | ângulos: XYZ %.1f, swing-twist %.1f | limites sem trigonometria: XYZ %.1f, swing-twist %.1f\n",
+           medir_angulos(quaternion_to_hip_angles), medir_angulos(swing_twist_quaternion_to_hip_angles),
+           medir_limites(quaternion_to_hip_components, hip_components_exceed, &limites_xyz),
+           medir_limites(swing_twist_quaternion_to_hip_components, swing_twist_hip_components_exceed, &limites_st));
+}
+
+int main(void)
+{
+    testar_plano_unico();
+    testar_varredura();
+    medir_desempenho();
+    return 0;
+}
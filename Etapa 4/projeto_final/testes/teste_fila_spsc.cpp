@@ -0,0 +1,239 @@
+// ======================================================================
+//  Arquivo: teste_fila_spsc.cpp
+//  Descrição: FilaSpsc com produtor e consumidor em duas threads, nas
+//             operações unitárias e em lote, com os índices começando perto
+//             de UINT32_MAX para atravessar a volta dos 32 bits, a leitura
+//             sem remoção (espiarLote/avancar) e a vazão das operações
+//             unitárias e em lote
+// ======================================================================
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include "cronometro.h"
+#include "fila_spsc.hpp"
+#include "teste.h"
+
+// Índices iniciais: a volta de 2^32 acontece logo no começo do estresse
+static const uint32_t PERTO_DA_VOLTA = UINT32_MAX - 100;
+
+// Elemento de 64 bytes: uma cópia rasgada (parte antiga, parte nova) não confere
+struct Elemento {
+    uint32_t sequencia;
+    uint32_t conferencia[15];
+};
+
+static Elemento montar(uint32_t sequencia)
+{
+    Elemento e;
+    e.sequencia = sequencia;
+    for (uint32_t i = 0; i < 15; i++) e.conferencia[i] = sequencia * 2654435761u + i;
+    return e;
+}
+
+static bool integro(const Elemento& e)
+{
+    for (uint32_t i = 0; i < 15; i++)
+    {
+        if (e.conferencia[i] != e.sequencia * 2654435761u + i) return false;
+    }
+    return true;
+}
+
+static uint32_t aleatorio(uint32_t* estado)
+{
+    *estado = *estado * 1664525u + 1013904223u;
+    return *estado >> 8;
+}
+
+// Modos de cada lado: unitário, em lote ou alternando os dois ao acaso
+enum Modo { UNITARIO, LOTE, MISTO };
+
+/**
+ * @brief Passa total elementos numerados do produtor ao consumidor e confere,
+ *        no consumidor, a ordem (nada perdido nem duplicado) e a integridade.
+ */
+template <size_t N>
+static void estresse(uint32_t total, Modo modo, uint32_t indice_inicial, const char* nome)
+{
+    static FilaSpsc<Elemento, N> fila(indice_inicial);
+    std::atomic<bool> erro{false};
+
+    std::thread produtor([&] {
+        uint32_t estado = 1;
+        Elemento lote[N];
+        uint32_t enviados = 0;
+        while (enviados < total && !erro)
+        {
+            bool em_lote = modo == LOTE || (modo == MISTO && aleatorio(&estado) % 2);
+            size_t n;
+            if (em_lote)
+            {
+                size_t pedido = 1 + aleatorio(&estado) % N;
+                if (pedido > total - enviados) pedido = total - enviados;
+                for (size_t k = 0; k < pedido; k++) lote[k] = montar(enviados + (uint32_t)k);
+                n = fila.inserirLote(lote, pedido);
+            }
+            else
+            {
+                n = fila.inserir(montar(enviados)) ? 1 : 0;
+            }
+            enviados += (uint32_t)n;
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    uint32_t estado = 2;
+    Elemento lote[N];
+    uint32_t recebidos = 0;
+    while (recebidos < total && !erro)
+    {
+        bool em_lote = modo == LOTE || (modo == MISTO && aleatorio(&estado) % 2);
+        size_t n = em_lote ? fila.removerLote(lote, 1 + aleatorio(&estado) % N) : (fila.remover(lote[0]) ? 1 : 0);
+        for (size_t k = 0; k < n; k++)
+        {
+            if (lote[k].sequencia != recebidos + k || !integro(lote[k])) erro = true;
+        }
+        recebidos += (uint32_t)n;
+        if (n == 0) std::this_thread::yield();
+    }
+    produtor.join();
+
+    printf("%-34s %u elementos %s\n", nome, (unsigned)recebidos, erro ? "FALHA" : "ok");
+    VERIFICAR(!erro);
+    VERIFICAR(recebidos == total);
+    VERIFICAR(fila.vazia());
+}
+
+// Cheia, vazia e tamanho com os índices atravessando a volta (uma thread)
+static void testar_limites_na_volta(void)
+{
+    FilaSpsc<uint32_t, 4> fila(UINT32_MAX - 1);
+    uint32_t itens[4] = {10, 11, 12, 13};
+    uint32_t saida[4];
+    uint32_t item;
+
+    VERIFICAR(fila.vazia() && !fila.remover(item) && fila.removerLote(saida, 4) == 0);
+    VERIFICAR(fila.inserirLote(itens, 3) == 3);  // cabeça passa de UINT32_MAX para 1
+    VERIFICAR(fila.tamanho() == 3);
+    VERIFICAR(fila.inserir(14));
+    VERIFICAR(!fila.inserir(15) && fila.inserirLote(itens, 4) == 0); // cheia: cabeça - cauda == N
+    VERIFICAR(fila.removerLote(saida, 4) == 4);
+    VERIFICAR(saida[0] == 10 && saida[1] == 11 && saida[2] == 12 && saida[3] == 14);
+    VERIFICAR(fila.vazia());
+
+    // Lote maior que o espaço livre: insere só o que cabe
+    VERIFICAR(fila.inserir(20));
+    VERIFICAR(fila.inserirLote(itens, 4) == 3);
+    VERIFICAR(fila.remover(item) && item == 20);
+    VERIFICAR(fila.removerLote(saida, 2) == 2 && saida[0] == 10 && saida[1] == 11);
+    VERIFICAR(fila.tamanho() == 1);
+    printf("limites com os índices na volta de 2^32: ok\n");
+}
+
+// Espiar não libera as posições: o produtor só as reutiliza depois de avancar
+static void testar_espiar_e_avancar(void)
+{
+    FilaSpsc<uint32_t, 4> fila(UINT32_MAX - 1);
+    uint32_t itens[4] = {30, 31, 32, 33};
+    uint32_t saida[4];
+
+    VERIFICAR(fila.espiarLote(saida, 4) == 0);
+    VERIFICAR(fila.inserirLote(itens, 4) == 4);
+    VERIFICAR(fila.espiarLote(saida, 2) == 2 && saida[0] == 30 && saida[1] == 31);
+    VERIFICAR(fila.espiarLote(saida, 4) == 4 && saida[0] == 30 && saida[3] == 33); // Releitura: os mesmos
+    VERIFICAR(fila.tamanho() == 4 && !fila.inserir(34));
+    fila.avancar(3);
+    VERIFICAR(fila.tamanho() == 1 && fila.inserirLote(itens, 4) == 3);
+    VERIFICAR(fila.removerLote(saida, 4) == 4 && saida[0] == 33 && saida[1] == 30 && saida[3] == 32);
+    printf("espiar sem remover e avançar, na volta de 2^32: ok\n");
+}
+
+// ----------------------------------------------------------------------
+// Vazão: ns por elemento, unitário contra lote
+// ----------------------------------------------------------------------
+static const uint32_t ELEMENTOS_MEDIDOS = 2000000;
+
+/** Uma thread: enche e esvazia a fila, sem disputa de cache entre núcleos (custo das operações). */
+template <size_t N>
+static double medir_uma_thread(bool em_lote)
+{
+    static FilaSpsc<Elemento, N> fila;
+    static Elemento lote[N];
+    for (size_t k = 0; k < N; k++) lote[k] = montar((uint32_t)k);
+    uint32_t conferencia = 0;
+    uint64_t inicio = cronometro_ns();
+    for (uint32_t feitos = 0; feitos < ELEMENTOS_MEDIDOS; feitos += N)
+    {
+        if (em_lote)
+        {
+            fila.inserirLote(lote, N);
+            fila.removerLote(lote, N);
+        }
+        else
+        {
+            for (size_t k = 0; k < N; k++) fila.inserir(lote[k]);
+            for (size_t k = 0; k < N; k++) fila.remover(lote[k]);
+        }
+        conferencia += lote[N - 1].sequencia;
+    }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir((float)conferencia);
+    return (double)decorrido / ELEMENTOS_MEDIDOS;
+}
+
+/** Produtor e consumidor em duas threads, com os índices trocados entre os núcleos. */
+template <size_t N>
+static double medir_duas_threads(bool em_lote)
+{
+    static FilaSpsc<Elemento, N> fila;
+    uint64_t inicio = cronometro_ns();
+    std::thread produtor([&] {
+        Elemento lote[N];
+        for (size_t k = 0; k < N; k++) lote[k] = montar((uint32_t)k);
+        uint32_t enviados = 0;
+        while (enviados < ELEMENTOS_MEDIDOS)
+        {
+            size_t n = em_lote ? fila.inserirLote(lote, N) : (fila.inserir(lote[0]) ? 1 : 0);
+            enviados += (uint32_t)n;
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+    Elemento lote[N];
+    uint32_t recebidos = 0;
+    while (recebidos < ELEMENTOS_MEDIDOS)
+    {
+        size_t n = em_lote ? fila.removerLote(lote, N) : (fila.remover(lote[0]) ? 1 : 0);
+        recebidos += (uint32_t)n;
+        if (n == 0) std::this_thread::yield();
+    }
+    produtor.join();
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir((float)lote[0].sequencia);
+    return (double)decorrido / ELEMENTOS_MEDIDOS;
+}
+
+/**
+ * Só informativo (elementos de 64 bytes, N = 8 como a fila de amostras):
+ * no RP2040 os tempos reais vêm de medicao.h.
+ */
+static void medir_vazao(void)
+{
+    printf("ns por elemento (64 bytes, N=8) | uma thread: unitário %.1f, lote %.1f | duas threads: unitário %.1f, lote %.1f\n",
+           medir_uma_thread<8>(false), medir_uma_thread<8>(true), medir_duas_threads<8>(false),
+           medir_duas_threads<8>(true));
+}
+
+int main(void)
+{
+    testar_limites_na_volta();
+    testar_espiar_e_avancar();
+
+    estresse<2>(200000, UNITARIO, PERTO_DA_VOLTA, "N=2 unitário, perto da volta:");
+    estresse<8>(500000, LOTE, PERTO_DA_VOLTA, "N=8 em lote, perto da volta:");
+    estresse<16>(500000, MISTO, PERTO_DA_VOLTA, "N=16 misto, perto da volta:");
+    estresse<64>(500000, MISTO, 0, "N=64 misto, índices em 0:");
+    medir_vazao();
+    return 0;
+}
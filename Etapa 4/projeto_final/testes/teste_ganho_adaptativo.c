@@ -0,0 +1,143 @@
+// ======================================================================
+//  Arquivo: teste_ganho_adaptativo.c
+//  Descrição: Ganho adaptativo contra o beta fixo do Madgwick num degrau
+//             de flexão de jerk mínimo: tempo de acomodação após o degrau
+//             e oscilação da inclinação estimada em repouso
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "MadgwickAHRS.h"
+#include "ganho_adaptativo.h"
+#include "teste.h"
+
+#define TAXA_HZ 500.0f                // TAXA_FUSAO_HZ
+#define DT (1.0 / TAXA_HZ)
+#define GRAU (M_PI / 180.0)
+#define BETA_NOMINAL 0.2f             // Beta inicial de MadgwickAHRSbatchInit
+#define REPOUSO_INICIAL_S 3.0
+#define DURACAO_DEGRAU_S 0.6
+#define REPOUSO_FINAL_S 4.0
+#define AMPLITUDE_GRAUS 90.0          // Flexão do quadril ao sentar
+#define RAIO_M 0.2                    // Distância do sensor ao eixo do quadril
+#define ERRO_ACOMODADO_GRAUS 1.0
+
+enum { FIXO = 0, ADAPTATIVO = 1 };
+
+/** Ruído gaussiano (Box-Muller sobre um LCG), reprodutível em qualquer libc. */
+static double gaussiano(void)
+{
+    static uint32_t estado = 7;
+    double u[2];
+    for (int i = 0; i < 2; i++)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        u[i] = ((estado >> 8) + 0.5) / (double)(1u << 24);
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+/**
+ * Flexão (rad), velocidade e aceleração angulares no instante t: repouso,
+ * degrau de jerk mínimo (10s³ - 15s⁴ + 6s⁵) e repouso.
+ */
+static void flexao_em(double t, double *angulo, double *velocidade, double *aceleracao)
+{
+    double s = (t - REPOUSO_INICIAL_S) / DURACAO_DEGRAU_S;
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    double a = AMPLITUDE_GRAUS * GRAU, T = DURACAO_DEGRAU_S;
+    *angulo = a * (10.0 * s * s * s - 15.0 * s * s * s * s + 6.0 * s * s * s * s * s);
+    *velocidade = a / T * (30.0 * s * s - 60.0 * s * s * s + 30.0 * s * s * s * s);
+    *aceleracao = a / (T * T) * (60.0 * s - 180.0 * s * s + 120.0 * s * s * s);
+}
+
+/** Inclinação (graus) entre a gravidade prevista pelo quaternion i e a verdadeira (cos θ, sen θ no plano YZ). */
+static double erro_inclinacao(const AHRS_batch_t *lote, int i, double angulo)
+{
+    float q0 = lote->q0[i], q1 = lote->q1[i], q2 = lote->q2[i], q3 = lote->q3[i];
+    double n = sqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    double vx = 2.0 * (q1 * q3 - q0 * q2) / (n * n);
+    double vy = 2.0 * (q0 * q1 + q2 * q3) / (n * n);
+    double vz = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3) / (n * n);
+    double produto = vx * 0.0 + vy * sin(angulo) + vz * cos(angulo);
+    if (produto > 1.0) produto = 1.0;
+    return acos(produto) / GRAU;
+}
+
+// O mesmo traço nos dois sensores do lote: o 0 com beta fixo, o 1 com o ganho adaptativo
+static void testar_degrau(void)
+{
+    AHRS_batch_t lote;
+    ganho_adaptativo_t ganho;
+    MadgwickAHRSbatchInit(&lote, 2, TAXA_HZ);
+    ganho_adaptativo_iniciar(&ganho, TAXA_HZ);
+
+    const uint32_t amostras = (uint32_t)((REPOUSO_INICIAL_S + DURACAO_DEGRAU_S + REPOUSO_FINAL_S) * TAXA_HZ);
+    const double fim_degrau = REPOUSO_INICIAL_S + DURACAO_DEGRAU_S;
+    double ultimo_fora[2] = {fim_degrau, fim_degrau};
+    double soma[2] = {0.0, 0.0}, soma2[2] = {0.0, 0.0};
+    uint32_t amostras_repouso = 0;
+
+    for (uint32_t k = 0; k < amostras; k++)
+    {
+        double t = k * DT, angulo, velocidade, aceleracao;
+        flexao_em(t, &angulo, &velocidade, &aceleracao);
+
+        // A coxa gira em torno de X (flexão negativa): a gravidade gira no plano YZ
+        // do sensor. A 20cm do quadril somam-se a aceleração tangencial (Y) e a
+        // centrípeta (Z); o giroscópio tem 5% de erro de escala, bias e ruído.
+        float accel[3] = {
+            (float)(0.01 * gaussiano()),
+            (float)(-sin(angulo) - RAIO_M * aceleracao / 9.81 + 0.01 * gaussiano()),
+            (float)(cos(angulo) + RAIO_M * velocidade * velocidade / 9.81 + 0.01 * gaussiano()),
+        };
+        float gyro[3] = {
+            (float)(-1.05 * velocidade + 0.002 + 0.003 * gaussiano()),
+            (float)(-0.0015 + 0.003 * gaussiano()),
+            (float)(0.001 + 0.003 * gaussiano()),
+        };
+        for (int i = 0; i < 2; i++)
+        {
+            lote.ax[i] = accel[0]; lote.ay[i] = accel[1]; lote.az[i] = accel[2];
+            lote.gx[i] = gyro[0]; lote.gy[i] = gyro[1]; lote.gz[i] = gyro[2];
+        }
+        lote.beta[FIXO] = BETA_NOMINAL;
+        float beta = BETA_NOMINAL * ganho_adaptativo_fator(&ganho, accel, gyro);
+        lote.beta[ADAPTATIVO] = (beta > GANHO_BETA_MAXIMO) ? GANHO_BETA_MAXIMO : beta;
+        MadgwickAHRSbatchUpdateIMU(&lote);
+
+        for (int i = 0; i < 2; i++)
+        {
+            double erro = erro_inclinacao(&lote, i, -angulo);
+            if (t >= fim_degrau && erro > ERRO_ACOMODADO_GRAUS) ultimo_fora[i] = t;
+            if (t >= 1.0 && t < REPOUSO_INICIAL_S)
+            {
+                soma[i] += erro;
+                soma2[i] += erro * erro;
+            }
+        }
+        if (t >= 1.0 && t < REPOUSO_INICIAL_S) amostras_repouso++;
+    }
+
+    double acomodacao_ms[2], oscilacao[2];
+    for (int i = 0; i < 2; i++)
+    {
+        acomodacao_ms[i] = (ultimo_fora[i] - fim_degrau) * 1000.0;
+        double media = soma[i] / amostras_repouso;
+        oscilacao[i] = sqrt(soma2[i] / amostras_repouso - media * media);
+    }
+    printf("degrau de %.0f° em %.0f ms: acomodação (< %.1f°) fixo %.0f ms, adaptativo %.0f ms | "
+           "oscilação em repouso: fixo %.4f°, adaptativo %.4f°\n",
+           AMPLITUDE_GRAUS, DURACAO_DEGRAU_S * 1000.0, ERRO_ACOMODADO_GRAUS, acomodacao_ms[FIXO],
+           acomodacao_ms[ADAPTATIVO], oscilacao[FIXO], oscilacao[ADAPTATIVO]);
+    VERIFICAR(ultimo_fora[FIXO] < amostras * DT - 1.0); // O beta fixo também acomoda dentro do traço
+    VERIFICAR(acomodacao_ms[ADAPTATIVO] <= acomodacao_ms[FIXO]);
+    VERIFICAR(oscilacao[ADAPTATIVO] < oscilacao[FIXO]);
+}
+
+int main(void)
+{
+    testar_degrau();
+    return 0;
+}
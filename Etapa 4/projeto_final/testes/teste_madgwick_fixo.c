@@ -0,0 +1,249 @@
+// ======================================================================
+//  Arquivo: teste_madgwick_fixo.c
+//  Descrição: Concordância entre o Madgwick em Q7.24 e o em float, e tempo
+//             por atualização de cada versão
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "MadgwickAHRS.h"
+#include "cronometro.h"
+#include "teste.h"
+
+void flutuante_MadgwickAHRSinit(AHRS_data_t *imu, float desired_sample_freq);
+void flutuante_MadgwickAHRSupdate(AHRS_data_t *imu);
+void flutuante_MadgwickAHRSupdateIMU(AHRS_data_t *imu);
+void fixo_MadgwickAHRSinit(AHRS_data_t *imu, float desired_sample_freq);
+void fixo_MadgwickAHRSupdate(AHRS_data_t *imu);
+void fixo_MadgwickAHRSupdateIMU(AHRS_data_t *imu);
+void fixo_MadgwickAHRSbatchInit(AHRS_batch_t *batch, unsigned int n, float desired_sample_freq);
+void fixo_MadgwickAHRSbatchUpdate(AHRS_batch_t *batch);
+void flutuante_MadgwickAHRSbatchInit(AHRS_batch_t *batch, unsigned int n, float desired_sample_freq);
+void flutuante_MadgwickAHRSbatchUpdate(AHRS_batch_t *batch);
+
+#define FREQUENCIA_HZ 100.0f
+#define AMOSTRAS 60000 // 10 minutos
+#define GRAUS (180.0 / M_PI)
+
+/** Ruído uniforme em [-0.5, 0.5], reprodutível em qualquer libc. */
+static float ruido(void)
+{
+    static uint32_t estado = 12345;
+    estado = estado * 1664525u + 1013904223u;
+    return (float)(estado >> 8) / (float)(1u << 24) - 0.5f;
+}
+
+static double norma(quaternion_t q)
+{
+    return sqrt((double)q.q0 * q.q0 + (double)q.q1 * q.q1 + (double)q.q2 * q.q2 + (double)q.q3 * q.q3);
+}
+
+/**
+ * Ângulo, em graus, da rotação entre dois quaternions. Ambos são normalizados
+ * antes: o invSqrt de uma iteração da versão em float deixa a norma até 0,2%
+ * abaixo de 1, o que sozinho valeria ~7° no arco-cosseno.
+ */
+static double diferenca_graus(quaternion_t a, quaternion_t b)
+{
+    double d = fabs((double)a.q0 * b.q0 + (double)a.q1 * b.q1 + (double)a.q2 * b.q2 + (double)a.q3 * b.q3) / (norma(a) * norma(b));
+    if (d > 1.0) d = 1.0;
+    return 2.0 * acos(d) * GRAUS;
+}
+
+/** Ângulo, em graus, entre as verticais (eixo z do referencial) de dois quaternions. */
+static double diferenca_inclinacao_graus(quaternion_t a, quaternion_t b)
+{
+    double za[3] = {2.0 * (a.q1 * a.q3 - a.q0 * a.q2), 2.0 * (a.q0 * a.q1 + a.q2 * a.q3),
+                    (double)a.q0 * a.q0 - a.q1 * a.q1 - a.q2 * a.q2 + a.q3 * a.q3};
+    double zb[3] = {2.0 * (b.q1 * b.q3 - b.q0 * b.q2), 2.0 * (b.q0 * b.q1 + b.q2 * b.q3),
+                    (double)b.q0 * b.q0 - b.q1 * b.q1 - b.q2 * b.q2 + b.q3 * b.q3};
+    double c = (za[0] * zb[0] + za[1] * zb[1] + za[2] * zb[2]) /
+               sqrt((za[0] * za[0] + za[1] * za[1] + za[2] * za[2]) * (zb[0] * zb[0] + zb[1] * zb[1] + zb[2] * zb[2]));
+    if (c > 1.0) c = 1.0;
+    return acos(c) * GRAUS;
+}
+
+/** Movimento sintético: giro de dezenas de °/s em três eixos e acelerômetro quase vertical. */
+static void gerar_amostra(int k, int com_magnetometro, AHRS_data_t *imu)
+{
+    float t = (float)k / FREQUENCIA_HZ;
+    float giro[3] = {40.0f * sinf(t * 0.7f) + ruido(), 25.0f * cosf(t * 1.3f) + ruido(), 15.0f * sinf(t * 0.3f) + ruido()};
+    float acel[3] = {0.3f * sinf(t) + 0.02f * ruido(), 0.2f * cosf(t * 0.5f) + 0.02f * ruido(), 0.95f + 0.02f * ruido()};
+    float mag[3] = {22.0f + ruido(), -5.0f + ruido(), -40.0f + ruido()};
+    for (int i = 0; i < 3; i++)
+    {
+        imu->gyro[i] = giro[i] * (float)(M_PI / 180.0);
+        imu->accel[i] = acel[i];
+        imu->mag[i] = com_magnetometro ? mag[i] : 0.0f;
+    }
+}
+
+static void copiar_entradas(const AHRS_data_t *origem, AHRS_data_t *destino)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        destino->gyro[i] = origem->gyro[i];
+        destino->accel[i] = origem->accel[i];
+        destino->mag[i] = origem->mag[i];
+    }
+}
+
+/**
+ * Os dois filtros recebem a mesma sequência; a diferença fica limitada pelo
+ * erro do invSqrt de uma iteração da versão em float (o Q7.24 é mais preciso
+ * que ela), sem deriva ao longo dos 10 minutos. Sem magnetômetro o rumo não é
+ * observável e deriva de forma diferente em cada versão, então só a inclinação
+ * é comparada.
+ */
+static void testar_concordancia(int com_magnetometro, double limite_graus)
+{
+    AHRS_data_t flutuante, fixo;
+    flutuante_MadgwickAHRSinit(&flutuante, FREQUENCIA_HZ);
+    fixo_MadgwickAHRSinit(&fixo, FREQUENCIA_HZ);
+
+    double maior = 0.0;
+    for (int k = 0; k < AMOSTRAS; k++)
+    {
+        gerar_amostra(k, com_magnetometro, &flutuante);
+        copiar_entradas(&flutuante, &fixo);
+        if (com_magnetometro)
+        {
+            flutuante_MadgwickAHRSupdate(&flutuante);
+            fixo_MadgwickAHRSupdate(&fixo);
+        }
+        else
+        {
+            flutuante_MadgwickAHRSupdateIMU(&flutuante);
+            fixo_MadgwickAHRSupdateIMU(&fixo);
+        }
+
+        double diferenca = com_magnetometro ? diferenca_graus(flutuante.orientation, fixo.orientation)
+                                            : diferenca_inclinacao_graus(flutuante.orientation, fixo.orientation);
+        if (diferenca > maior) maior = diferenca;
+
+        VERIFICAR(fabs(norma(fixo.orientation) - 1.0) < 1e-4);
+    }
+    printf("%s: maior diferença float x Q7.24 = %.3f°\n", com_magnetometro ? "AHRS" : "IMU", maior);
+    VERIFICAR(maior < limite_graus);
+}
+
+/** O lote em Q7.24 dá, sensor a sensor, o mesmo resultado da atualização individual. */
+static void testar_lote(void)
+{
+    AHRS_batch_t lote;
+    AHRS_data_t individual[2];
+    fixo_MadgwickAHRSbatchInit(&lote, 2, FREQUENCIA_HZ);
+    for (int s = 0; s < 2; s++) fixo_MadgwickAHRSinit(&individual[s], FREQUENCIA_HZ);
+
+    for (int k = 0; k < 1000; k++)
+    {
+        for (unsigned s = 0; s < 2; s++)
+        {
+            gerar_amostra(k + 500 * (int)s, 1, &individual[s]);
+            lote.gx[s] = individual[s].gyro[0];
+            lote.gy[s] = individual[s].gyro[1];
+            lote.gz[s] = individual[s].gyro[2];
+            lote.ax[s] = individual[s].accel[0];
+            lote.ay[s] = individual[s].accel[1];
+            lote.az[s] = individual[s].accel[2];
+            lote.mx[s] = individual[s].mag[0];
+            lote.my[s] = individual[s].mag[1];
+            lote.mz[s] = individual[s].mag[2];
+            fixo_MadgwickAHRSupdate(&individual[s]);
+        }
+        fixo_MadgwickAHRSbatchUpdate(&lote);
+    }
+    for (unsigned s = 0; s < 2; s++)
+    {
+        VERIFICAR(lote.q0[s] == individual[s].orientation.q0);
+        VERIFICAR(lote.q1[s] == individual[s].orientation.q1);
+        VERIFICAR(lote.q2[s] == individual[s].orientation.q2);
+        VERIFICAR(lote.q3[s] == individual[s].orientation.q3);
+    }
+}
+
+// ----------------------------------------------------------------------
+// Desempenho: as mesmas entradas em cada versão
+// ----------------------------------------------------------------------
+#define AMOSTRAS_MEDIDAS 4096
+#define REPETICOES 50
+
+static AHRS_data_t entradas[AMOSTRAS_MEDIDAS];
+
+typedef void (*atualizacao_t)(AHRS_data_t *imu);
+
+/** Tempo médio, em ns, de uma atualização sobre as entradas pré-geradas. */
+static double medir(void (*iniciar)(AHRS_data_t *, float), atualizacao_t atualizar)
+{
+    AHRS_data_t imu;
+    iniciar(&imu, FREQUENCIA_HZ);
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+    {
+        for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+        {
+            copiar_entradas(&entradas[k], &imu);
+            atualizar(&imu);
+        }
+    }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(imu.orientation.q0);
+    return (double)decorrido / ((double)REPETICOES * AMOSTRAS_MEDIDAS);
+}
+
+/** Tempo médio, em ns por sensor, do lote de dois sensores. */
+static double medir_lote(void (*iniciar)(AHRS_batch_t *, unsigned int, float), void (*atualizar)(AHRS_batch_t *))
+{
+    AHRS_batch_t lote;
+    iniciar(&lote, 2, FREQUENCIA_HZ);
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+    {
+        for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+        {
+            for (unsigned s = 0; s < 2; s++)
+            {
+                const AHRS_data_t *e = &entradas[(k + 1000 * (int)s) % AMOSTRAS_MEDIDAS];
+                lote.gx[s] = e->gyro[0];
+                lote.gy[s] = e->gyro[1];
+                lote.gz[s] = e->gyro[2];
+                lote.ax[s] = e->accel[0];
+                lote.ay[s] = e->accel[1];
+                lote.az[s] = e->accel[2];
+                lote.mx[s] = e->mag[0];
+                lote.my[s] = e->mag[1];
+                lote.mz[s] = e->mag[2];
+            }
+            atualizar(&lote);
+        }
+    }
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(lote.q0[0] + lote.q0[1]);
+    return (double)decorrido / (2.0 * REPETICOES * AMOSTRAS_MEDIDAS);
+}
+
+/**
+ * Só informativo: no host a FPU favorece o float; no RP2040 (M0+, sem FPU) a
+ * relação se inverte e os tempos reais vêm de medicao.h.
+ */
+static void medir_desempenho(void)
+{
+    for (int k = 0; k < AMOSTRAS_MEDIDAS; k++) gerar_amostra(k, 1, &entradas[k]);
+
+    printf("ns por atualização no host | float: AHRS %.1f, IMU %.1f, lote %.1f | Q7.24: AHRS %.1f, IMU %.1f, lote %.1f\n",
+           medir(flutuante_MadgwickAHRSinit, flutuante_MadgwickAHRSupdate),
+           medir(flutuante_MadgwickAHRSinit, flutuante_MadgwickAHRSupdateIMU),
+           medir_lote(flutuante_MadgwickAHRSbatchInit, flutuante_MadgwickAHRSbatchUpdate),
+           medir(fixo_MadgwickAHRSinit, fixo_MadgwickAHRSupdate),
+           medir(fixo_MadgwickAHRSinit, fixo_MadgwickAHRSupdateIMU),
+           medir_lote(fixo_MadgwickAHRSbatchInit, fixo_MadgwickAHRSbatchUpdate));
+}
+
+int main(void)
+{
+    testar_concordancia(0, 1.0);
+    testar_concordancia(1, 1.0);
+    testar_lote();
+    medir_desempenho();
+    return 0;
+}
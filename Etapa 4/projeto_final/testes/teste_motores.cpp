@@ -0,0 +1,262 @@
+// ======================================================================
+//  Arquivo: teste_motores.cpp
+//  Descrição: Todos os motores de fusão (motor_fusao.hpp) sobre o mesmo
+//             traço sintético de tronco e coxa: tempo por atualização e erro
+//             da orientação relativa, com um limite de erro por motor; e o
+//             aquecimento de cada motor (alinharInicial, MonitorConvergencia e
+//             o limite de 5s) com o paciente parado e andando
+// ======================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "cronometro.h"
+#include "motor_fusao.hpp"
+#include "teste.h"
+
+static const float TAXA_HZ = 500.0f;            // TAXA_FUSAO_HZ
+static const double DT = 1.0 / TAXA_HZ;
+static const uint32_t AMOSTRAS = 30 * 500;      // 30s
+static const uint32_t CONVERGENCIA = 5 * 500;   // Erro medido a partir de 5s
+static const uint32_t AQUECIMENTO = 1 * 500;    // Ganho aumentado no primeiro segundo (ESCALA_GANHO_AQUECIMENTO)
+static const double GRAU = M_PI / 180.0;
+static const uint32_t AMOSTRAS_POR_LEITURA = 5;     // O monitor é atualizado uma vez por leitura (10ms)
+static const uint32_t TEMPO_MAXIMO_AQUECIMENTO_MS = 5000; // Como em analise_postural.cpp
+static const float ESCALA_GANHO_AQUECIMENTO = 5.0f;
+
+// ----------------------------------------------------------------------
+// Traço sintético
+// ----------------------------------------------------------------------
+struct Quat {
+    double w, x, y, z;
+};
+
+static Quat multiplicar(const Quat& a, const Quat& b)
+{
+    return {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z, a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x, a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
+
+static Quat conjugado(const Quat& q) { return {q.w, -q.x, -q.y, -q.z}; }
+
+static Quat eixo_angulo(double x, double y, double z, double angulo)
+{
+    double s = sin(0.5 * angulo);
+    return {cos(0.5 * angulo), x * s, y * s, z * s};
+}
+
+/** Vetor da Terra no referencial do sensor (q* ⊗ v ⊗ q), com q sensor -> Terra. */
+static void para_sensor(const Quat& q, const double v[3], float saida[3])
+{
+    Quat r = multiplicar(multiplicar(conjugado(q), Quat{0.0, v[0], v[1], v[2]}), q);
+    saida[0] = (float)r.x;
+    saida[1] = (float)r.y;
+    saida[2] = (float)r.z;
+}
+
+/** Ruído gaussiano (Box-Muller sobre um LCG), reprodutível em qualquer libc. */
+static double gaussiano()
+{
+    static uint32_t estado = 2024;
+    double u[2];
+    for (double& ui : u)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        ui = ((estado >> 8) + 0.5) / (double)(1u << 24);
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+struct Passo {
+    AmostraImu amostras[NUM_SENSORES_FUSAO];
+    Quat relativo; ///< Orientação verdadeira tronco -> coxa
+};
+
+/** Orientação (sensor -> Terra) em função do tempo. */
+typedef Quat (*Trajetoria)(double t);
+
+// Tronco balançando e girando devagar; coxa = tronco ⊗ flexão em X (±35°, 0,25Hz)
+// com abdução de ±8°
+static Quat tronco_em(double t)
+{
+    return multiplicar(eixo_angulo(0.0, 0.0, 1.0, 20.0 * GRAU * sin(2.0 * M_PI * 0.05 * t)),
+                       eixo_angulo(1.0, 0.0, 0.0, 5.0 * GRAU * sin(2.0 * M_PI * 0.2 * t)));
+}
+
+static Quat relativo_em(double t)
+{
+    return multiplicar(eixo_angulo(1.0, 0.0, 0.0, -35.0 * GRAU * sin(2.0 * M_PI * 0.25 * t)),
+                       eixo_angulo(0.0, 0.0, 1.0, 8.0 * GRAU * sin(2.0 * M_PI * 0.1 * t)));
+}
+
+// Parado: tronco inclinado 10° e coxa fletida 40° com 15° de rumo
+static Quat tronco_parado(double) { return eixo_angulo(1.0, 0.0, 0.0, 10.0 * GRAU); }
+static Quat relativo_parado(double)
+{
+    return multiplicar(eixo_angulo(0.0, 0.0, 1.0, 15.0 * GRAU), eixo_angulo(1.0, 0.0, 0.0, -40.0 * GRAU));
+}
+
+// Andando: passada de 1Hz (coxa ±30°), tronco oscilando ±4° no dobro da frequência
+static Quat tronco_andando(double t) { return eixo_angulo(0.0, 1.0, 0.0, 4.0 * GRAU * sin(2.0 * M_PI * 2.0 * t)); }
+static Quat relativo_andando(double t) { return eixo_angulo(1.0, 0.0, 0.0, -30.0 * GRAU * sin(2.0 * M_PI * t)); }
+
+/**
+ * Amostras dos dois sensores ao longo das trajetórias: giroscópio com bias e
+ * ruído, acelerômetro (gravidade mais a aceleração vertical do passo, em g) e
+ * magnetômetro com ruído.
+ */
+static std::vector<Passo> gerar_traco(Trajetoria tronco_em, Trajetoria relativo_em, uint32_t amostras,
+                                      double aceleracao_vertical_g)
+{
+    static const double CAMPO[3] = {20.0, 0.0, -45.0}; // uT
+    // Bias residual após a calibração do giroscópio no boot (mpu9250_calibrate_gyro), ~0,1-0,2°/s
+    static const double BIAS[NUM_SENSORES_FUSAO][3] = {{0.002, -0.0015, 0.001}, {-0.0012, 0.0025, -0.002}}; // rad/s
+
+    std::vector<Passo> traco(amostras);
+    for (uint32_t k = 0; k < amostras; k++)
+    {
+        double t = k * DT;
+        double vertical[3] = {0.0, 0.0, 1.0 + aceleracao_vertical_g * sin(2.0 * M_PI * 2.0 * t)};
+        Quat rel = relativo_em(t);
+        Quat q[NUM_SENSORES_FUSAO] = {tronco_em(t), multiplicar(tronco_em(t), rel)};
+        Quat proximo[NUM_SENSORES_FUSAO] = {tronco_em(t + DT), multiplicar(tronco_em(t + DT), relativo_em(t + DT))};
+        traco[k].relativo = rel;
+        for (size_t i = 0; i < NUM_SENSORES_FUSAO; i++)
+        {
+            // Velocidade angular no referencial do sensor: 2 vec(q* ⊗ q') / dt
+            Quat d = multiplicar(conjugado(q[i]), proximo[i]);
+            AmostraImu& a = traco[k].amostras[i];
+            a.gyro[0] = (float)(2.0 * d.x / DT + BIAS[i][0] + 0.003 * gaussiano());
+            a.gyro[1] = (float)(2.0 * d.y / DT + BIAS[i][1] + 0.003 * gaussiano());
+            a.gyro[2] = (float)(2.0 * d.z / DT + BIAS[i][2] + 0.003 * gaussiano());
+            para_sensor(q[i], vertical, a.accel);
+            para_sensor(q[i], CAMPO, a.mag);
+            for (int eixo = 0; eixo < 3; eixo++)
+            {
+                a.accel[eixo] += (float)(0.01 * gaussiano());
+                a.mag[eixo] += (float)(0.5 * gaussiano());
+            }
+        }
+    }
+    return traco;
+}
+
+// ----------------------------------------------------------------------
+// Medição de um motor
+// ----------------------------------------------------------------------
+/** Ângulo (graus) entre a orientação relativa estimada e a verdadeira. */
+static double erro_graus(const QuaternionUnitario& estimado, const Quat& verdade)
+{
+    double d = fabs(estimado.w() * verdade.w + estimado.x() * verdade.x + estimado.y() * verdade.y +
+                    estimado.z() * verdade.z);
+    return 2.0 * acos(d > 1.0 ? 1.0 : d) / GRAU;
+}
+
+template <typename Motor>
+static void iniciar(Motor& motor, const std::vector<Passo>& traco)
+{
+    motor.iniciar(TAXA_HZ);
+    motor.alinharInicial(traco[0].amostras);
+    motor.definirEscalaGanho(ESCALA_GANHO_AQUECIMENTO);
+}
+
+template <typename Motor>
+static void avaliar(const char* nome, const std::vector<Passo>& traco, double limite_graus)
+{
+    // Erro: orientação relativa como em getPosition(), após a convergência
+    Motor motor;
+    iniciar(motor, traco);
+    double soma2 = 0.0, pior = 0.0;
+    for (uint32_t k = 0; k < AMOSTRAS; k++)
+    {
+        if (k == AQUECIMENTO) motor.definirEscalaGanho(1.0f);
+        motor.atualizar(traco[k].amostras, (float)DT);
+        if (k < CONVERGENCIA) continue;
+        double erro = erro_graus(relativo(motor.orientacao(0), motor.orientacao(1)), traco[k].relativo);
+        soma2 += erro * erro;
+        if (erro > pior) pior = erro;
+    }
+    double rms = sqrt(soma2 / (AMOSTRAS - CONVERGENCIA));
+
+    // Tempo: só as atualizações, de novo sobre o traço inteiro
+    Motor cronometrado;
+    iniciar(cronometrado, traco);
+    uint64_t inicio = cronometro_ns();
+    for (uint32_t k = 0; k < AMOSTRAS; k++)
+    {
+        cronometrado.atualizar(traco[k].amostras, (float)DT);
+    }
+    uint64_t fim = cronometro_ns();
+    cronometro_consumir(cronometrado.orientacao(1).w());
+
+    printf("%-12s %7.1f ns/atualização | erro relativo: rms %.2f°, máximo %.2f° (limite %.1f°)\n", nome,
+           (double)(fim - inicio) / AMOSTRAS, rms, pior, limite_graus);
+    VERIFICAR(pior < limite_graus);
+}
+
+// ----------------------------------------------------------------------
+// Aquecimento
+// ----------------------------------------------------------------------
+/**
+ * Aquecimento como em atualizarFusao(): alinharInicial na primeira amostra,
+ * ganho elevado e o monitor atualizado a cada leitura, até convergir ou até
+ * TEMPO_MAXIMO_AQUECIMENTO_MS.
+ * @return Tempo até a convergência (ms), ou até o limite se não convergiu
+ */
+template <typename Motor>
+static uint32_t aquecer(const std::vector<Passo>& traco, bool* convergiu)
+{
+    Motor motor;
+    MonitorConvergencia monitor;
+    iniciar(motor, traco);
+    monitor.reiniciar();
+    *convergiu = false;
+    for (uint32_t k = 0; k < traco.size(); k++)
+    {
+        motor.atualizar(traco[k].amostras, (float)DT);
+        if ((k + 1) % AMOSTRAS_POR_LEITURA != 0) continue;
+        uint32_t decorrido_ms = (uint32_t)((k + 1) * 1000 / TAXA_HZ);
+        if (monitor.atualizar(motor, traco[k].amostras))
+        {
+            *convergiu = true;
+            return decorrido_ms;
+        }
+        if (decorrido_ms >= TEMPO_MAXIMO_AQUECIMENTO_MS) return decorrido_ms;
+    }
+    return UINT32_MAX;
+}
+
+// Parado: converge em menos de 1s; andando: o monitor não aceita a estimativa
+// e a proteção é liberada pelo limite de 5s
+template <typename Motor>
+static void testar_aquecimento(const char* nome, const std::vector<Passo>& parado, const std::vector<Passo>& andando)
+{
+    bool convergiu;
+    uint32_t parado_ms = aquecer<Motor>(parado, &convergiu);
+    VERIFICAR(convergiu && parado_ms < 1000);
+    uint32_t andando_ms = aquecer<Motor>(andando, &convergiu);
+    VERIFICAR(!convergiu && andando_ms == TEMPO_MAXIMO_AQUECIMENTO_MS);
+    printf("%-12s aquecimento: convergiu parado em %lu ms, andando liberado pelo limite em %lu ms: ok\n", nome,
+           (unsigned long)parado_ms, (unsigned long)andando_ms);
+}
+
+int main()
+{
+    std::vector<Passo> traco = gerar_traco(tronco_em, relativo_em, AMOSTRAS, 0.0);
+    avaliar<MotorMadgwick>("madgwick", traco, 3.0);
+    avaliar<MotorMahony>("mahony", traco, 3.0);
+    avaliar<MotorComplementar>("complementar", traco, 3.0);
+    avaliar<MotorEskf>("eskf", traco, 3.0);
+    avaliar<MotorArticulacao>("articulacao", traco, 3.0);
+
+    uint32_t aquecimento = (TEMPO_MAXIMO_AQUECIMENTO_MS + 1000) * (uint32_t)TAXA_HZ / 1000;
+    std::vector<Passo> parado = gerar_traco(tronco_parado, relativo_parado, aquecimento, 0.0);
+    std::vector<Passo> andando = gerar_traco(tronco_andando, relativo_andando, aquecimento, 0.15);
+    testar_aquecimento<MotorMadgwick>("madgwick", parado, andando);
+    testar_aquecimento<MotorMahony>("mahony", parado, andando);
+    testar_aquecimento<MotorComplementar>("complementar", parado, andando);
+    testar_aquecimento<MotorEskf>("eskf", parado, andando);
+    testar_aquecimento<MotorArticulacao>("articulacao", parado, andando);
+    return 0;
+}
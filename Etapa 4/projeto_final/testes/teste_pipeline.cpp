@@ -0,0 +1,254 @@
+// ======================================================================
+//  Arquivo: teste_pipeline.cpp
+//  Descrição: Estresse das filas entre os núcleos: o laço real do núcleo 1
+//             (nucleo1_principal) e os consumidores do núcleo 0
+//             (pipeline_servir_logs, pipeline_encaminhar_armazenamento) em
+//             duas threads, sem registro perdido sem contagem nem duplicado
+// ======================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <unistd.h> // dup, dup2
+#include <vector>
+
+#include "analise_postural.h"
+#include "armazenamento.h"
+#include "captura_sensores.h"
+#include "pipeline_sensores.h"
+#include "pool_quadros.hpp"
+#include "pico/multicore.h"
+#include "sequencias_mpu9250.h"
+extern "C" {
+#include "agendador.h"
+#include "sensor_watchdog.h"
+#include "supervisor.h"
+}
+#include "teste.h"
+
+// Períodos do núcleo 1 com produção; no período seguinte só devolve os quadros
+static const uint32_t PERIODOS = 200000;
+
+// ----------------------------------------------------------------------
+// Núcleo 1 simulado: os estágios produzem registros numerados
+// ----------------------------------------------------------------------
+static PoolQuadros<QuadroAmostras, CAPTURA_QUADROS> quadros;
+static uint32_t periodo_atual = 0;
+static uint32_t logs_enviados = 0;
+static uint32_t eventos_enviados = 0;
+static uint32_t amostras_enviadas = 0;
+static uint32_t comandos_executados = 0;
+static Orientacao orientacao_vazia = {};
+
+static std::atomic<bool> producao_concluida{false};
+static std::atomic<bool> nucleo0_drenado{false};
+static std::atomic<bool> nucleo1_concluido{false};
+
+static bool produzindo() { return periodo_atual < PERIODOS; }
+
+bool atualizarFusao(mpu9250_t*)
+{
+    if (!produzindo()) return false;
+    pipeline_log("log %u\n", (unsigned)logs_enviados++);
+    RegistroEvento registro = {};
+    registro.fim_ms = eventos_enviados++;
+    pipeline_publicar_evento(registro);
+    return true;
+}
+uint32_t amostrasDescartadasFusao(void) { return 0; }
+
+// Cada avaliação anota um quadro novo e o publica; a referência do estágio é
+// solta logo em seguida, ficando só a do núcleo 0
+const Orientacao& getPosition(void)
+{
+    if (!produzindo()) return orientacao_vazia;
+    uint8_t indice = quadros.alocar();
+    VERIFICAR(indice != quadros.NENHUM);
+    QuadroAmostras& quadro = quadros[indice];
+    uint32_t sequencia = amostras_enviadas++;
+    quadro.instante_us = 1000ull * sequencia;
+    quadro.orientacao.flexao = (float)(sequencia % 100000);
+    quadro.orientacao.abducao = -quadro.orientacao.flexao;
+    quadro.entregue = pipeline_publicar_quadro(indice);
+    quadros.liberar(indice);
+    return quadro.orientacao;
+}
+
+void dangerCheck(const Orientacao&) {}
+void definirLogDetalhado(bool) {}
+bool alarme_esta_ligado(void) { return true; }
+bool alarme_esta_silenciado(void) { return comandos_executados % 2 == 1; }
+void silenciar_alarme(void) { comandos_executados++; }
+void desilenciar_alarme(void) { comandos_executados++; }
+
+// Captura: o pool do teste faz o papel do da captura
+bool captura_iniciar(mpu9250_t*, size_t, alarm_pool_t*) { return true; }
+QuadroAmostras& captura_quadro(uint8_t indice) { return quadros[indice]; }
+void captura_reter(uint8_t indice) { quadros.reter(indice); }
+void captura_liberar(uint8_t indice) { quadros.liberar(indice); }
+bool captura_solicitar_barramento(void) { return true; }
+void captura_parar(void) {}
+void captura_devolver_barramento(void) {}
+EstatisticasCaptura captura_estatisticas(void)
+{
+    EstatisticasCaptura e = {};
+    e.quadros_alocados = quadros.alocacoes();
+    e.quadros_devolvidos = quadros.devolucoes();
+    e.quadros_maximo_em_uso = quadros.maximoEmUso();
+    return e;
+}
+
+Corrotina sequenciaRecuperarMagnetometro(mpu9250_t*) { return Corrotina(); }
+
+// Agendador: um período por chamada, sem timer
+extern "C" {
+void agendador_iniciar(agendador_t* agendador, uint32_t periodo_us, uint32_t orcamento_us, uint64_t agora_us)
+{
+    memset(agendador, 0, sizeof(*agendador));
+    agendador->periodo_us = periodo_us;
+    agendador->orcamento_us = orcamento_us;
+    agendador->inicio_us = agora_us;
+}
+bool agendador_iniciar_timer(agendador_t*) { return true; }
+bool agendador_baixa_prioridade(const agendador_t*) { return false; }
+void agendador_terminar_periodo(agendador_t*, uint64_t) {}
+
+uint32_t agendador_comecar_periodo(agendador_t* agendador, uint64_t)
+{
+    agendador->periodos++;
+    return periodo_atual;
+}
+
+// Ao fim da produção espera o núcleo 0 esvaziar as filas, roda um período para
+// liberar os quadros devolvidos e então para (o laço do núcleo 1 não termina)
+void agendador_aguardar(agendador_t*)
+{
+    static uint32_t chamadas = 0;
+    periodo_atual = chamadas++;
+    std::this_thread::yield();
+    if (periodo_atual == PERIODOS)
+    {
+        producao_concluida = true;
+        while (!nucleo0_drenado) std::this_thread::yield();
+    }
+    else if (periodo_atual > PERIODOS)
+    {
+        nucleo1_concluido = true;
+        while (true) std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
+
+// Supervisor e watchdog dos sensores: sempre em dia
+int supervisor_registrar(const char*, uint32_t) { return 0; }
+void supervisor_batimento(int) {}
+int supervisor_verificar(void) { return SUPERVISOR_NENHUMA; }
+bool sensor_watchdog_update(void) { return false; }
+bool sensor_watchdog_is_sensor_frozen(uint8_t) { return false; }
+void sensor_watchdog_reset_system(void) { VERIFICAR(!"sensor travado"); }
+
+// O núcleo 1 é uma thread
+void multicore_launch_core1_with_stack(void (*entrada)(void), uint32_t*, size_t)
+{
+    std::thread(entrada).detach();
+}
+}
+
+// ----------------------------------------------------------------------
+// Núcleo 0 simulado: o armazenamento confere a sequência recebida
+// ----------------------------------------------------------------------
+static std::vector<uint32_t> eventos_recebidos;
+static std::vector<uint32_t> amostras_recebidas;
+static uint32_t chamadas_aceita = 0;
+
+// Recusa um evento a cada três consultas: a contrapressão deixa eventos na fila do núcleo 1
+bool armazenamento_aceita_evento(void) { return ++chamadas_aceita % 3 != 0; }
+
+ResultadoArmazenamento armazenamento_registrar_evento(const RegistroEvento& registro)
+{
+    eventos_recebidos.push_back(registro.fim_ms);
+    return ResultadoArmazenamento::ACEITO;
+}
+
+// O quadro ainda estava retido quando o núcleo 0 o leu: os dois campos são da mesma amostra
+ResultadoArmazenamento armazenamento_registrar_amostra(const AmostraPostura& amostra)
+{
+    VERIFICAR(amostra.flexao == (float)(amostra.instante_ms % 100000));
+    VERIFICAR(amostra.abducao == -amostra.flexao);
+    amostras_recebidas.push_back(amostra.instante_ms);
+    return ResultadoArmazenamento::ACEITO;
+}
+
+ResultadoArmazenamento armazenamento_registrar_diagnostico(const char*, ...) { return ResultadoArmazenamento::ACEITO; }
+
+/** Recebidos em ordem estrita (nada duplicado) e, somados aos descartes contados, iguais aos enviados. */
+static void verificar_sequencia(const std::vector<uint32_t>& recebidos, uint32_t perdidos, uint32_t enviados)
+{
+    for (size_t i = 1; i < recebidos.size(); i++) VERIFICAR(recebidos[i] > recebidos[i - 1]);
+    VERIFICAR(recebidos.size() + perdidos == enviados);
+}
+
+int main(void)
+{
+    // A saída dos logs vai para um arquivo, lido ao final
+    FILE* saida = tmpfile();
+    VERIFICAR(saida != nullptr);
+    fflush(stdout);
+    int stdout_original = dup(fileno(stdout));
+    dup2(fileno(saida), fileno(stdout));
+
+    static mpu9250_t sensores[2] = {};
+    sensores[1].id = 1;
+    pipeline_lancar_nucleo1(sensores);
+
+    uint32_t comandos_enviados = 0;
+    for (uint32_t volta = 0; !producao_concluida; volta++)
+    {
+        pipeline_servir_logs();
+        pipeline_encaminhar_armazenamento();
+        if (volta % 64 == 0 && pipeline_enviar_comando(ComandoPipeline::ALTERNAR_SILENCIO)) comandos_enviados++;
+        if (volta % 1024 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200)); // Núcleo 0 atrasado: as filas enchem
+        else std::this_thread::yield();
+    }
+    while (pipeline_servir_logs() || pipeline_encaminhar_armazenamento()) {}
+    nucleo0_drenado = true;
+    while (!nucleo1_concluido) std::this_thread::yield();
+
+    fflush(stdout);
+    dup2(stdout_original, fileno(stdout));
+    close(stdout_original);
+
+    std::vector<uint32_t> logs_recebidos;
+    rewind(saida);
+    unsigned sequencia;
+    char linha[PIPELINE_TAMANHO_MENSAGEM];
+    while (fgets(linha, sizeof(linha), saida))
+    {
+        VERIFICAR(sscanf(linha, "log %u", &sequencia) == 1);
+        logs_recebidos.push_back(sequencia);
+    }
+    fclose(saida);
+
+    EstatisticasPipeline estatisticas = pipeline_estatisticas();
+    printf("logs: %zu recebidos, %u descartados | eventos: %zu recebidos, %u descartados | "
+           "amostras: %zu recebidas, %u descartadas | quadros: %u alocados, %u devolvidos, máximo %u em uso\n",
+           logs_recebidos.size(), (unsigned)estatisticas.logs_perdidos, eventos_recebidos.size(),
+           (unsigned)estatisticas.registros_perdidos, amostras_recebidas.size(), (unsigned)estatisticas.amostras_perdidas,
+           (unsigned)quadros.alocacoes(), (unsigned)quadros.devolucoes(), (unsigned)quadros.maximoEmUso());
+
+    verificar_sequencia(logs_recebidos, estatisticas.logs_perdidos, logs_enviados);
+    verificar_sequencia(eventos_recebidos, estatisticas.registros_perdidos, eventos_enviados);
+    verificar_sequencia(amostras_recebidas, estatisticas.amostras_perdidas, amostras_enviadas);
+    VERIFICAR(!amostras_recebidas.empty() && !eventos_recebidos.empty() && !logs_recebidos.empty());
+
+    // Todo quadro voltou ao pool, e o núcleo 0 nunca reteve mais que a fila de devoluções
+    VERIFICAR(quadros.alocacoes() == amostras_enviadas);
+    VERIFICAR(quadros.devolucoes() == quadros.alocacoes());
+    VERIFICAR(quadros.emUso() == 0);
+    VERIFICAR(quadros.maximoEmUso() <= PIPELINE_CAPACIDADE_AMOSTRAS + 1);
+    VERIFICAR(quadros.falhas() == 0);
+
+    VERIFICAR(comandos_executados == comandos_enviados);
+    return 0;
+}
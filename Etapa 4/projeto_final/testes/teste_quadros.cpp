@@ -0,0 +1,597 @@
+// ======================================================================
+//  Arquivo: teste_quadros.cpp
+//  Descrição: Percurso de ponta a ponta dos quadros de amostras: captura
+//             (timer e DMA simulados) → fusão → getPosition →
+//             pipeline_publicar_quadro → núcleo 0 → devolução, com o laço
+//             real do núcleo 1 numa thread. Confere que todo quadro alocado
+//             volta ao pool, que o máximo em uso fica no limite dos estágios,
+//             pelos endereços, que os dados nunca saem do quadro e, num
+//             travamento da captura que transborda as FIFOs, que a lacuna é
+//             limitada, contada e registrada sem degrau no erro do ângulo;
+//             com a captura parada além do prazo, o supervisor aponta a
+//             parte "sensores" como culpada
+// ======================================================================
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <unistd.h> // dup, dup2
+
+#include "analise_postural.h"
+#include "armazenamento.h"
+#include "captura_sensores.h"
+#include "pipeline_sensores.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/multicore.h"
+#include "sdk_host.h"
+extern "C" {
+#include "agendador.h"
+#include "buzzer.h"
+#include "mpu9250_regs.h"
+#include "sensor_watchdog.h"
+#include "supervisor.h"
+}
+#include "teste.h"
+
+// O quadro só circula por índice: nenhum estágio consegue copiá-lo
+static_assert(!std::is_copy_constructible<QuadroAmostras>::value, "QuadroAmostras não pode ser copiável");
+static_assert(!std::is_copy_assignable<QuadroAmostras>::value, "QuadroAmostras não pode ser atribuível");
+
+static const uint32_t SEGUNDOS = 60;                 // Duração simulada com os sensores produzindo
+static const uint32_t NUCLEO0_PARADO_DE_S = 20;      // Núcleo 0 sem gravar de 20s a 35s: a posse dele enche
+static const uint32_t NUCLEO0_PARADO_ATE_S = 35;
+static const uint32_t TRANSBORDO_EM_S = 45;          // Captura travada por TRAVAMENTO_MS: as FIFOs transbordam
+static const uint32_t TRAVAMENTO_MS = 400;
+static const uint32_t CONVERGENCIA_S = 5;            // Erro do ângulo medido a partir daqui
+static const float LACUNA_MAXIMA_MS = 300.0f;        // INTERVALO_MAXIMO_S de analise_postural.cpp
+static const uint32_t PERIODOS_POR_SEGUNDO = 1000000 / PIPELINE_PERIODO_LEITURA_US;
+static const uint32_t CAPTURAS_POR_PERIODO = PIPELINE_PERIODO_LEITURA_US / CAPTURA_PERIODO_US;
+
+// Quadros fora do pool no pior caso, a mesma conta do static_assert de
+// pipeline_sensores.cpp: retidos pela fusão, o recente anotado por getPosition,
+// os em posse do núcleo 0 e os capturados desde o último período
+static const uint32_t LIMITE_EM_USO = MAXIMO_QUADROS_RETIDOS + 1 + PIPELINE_CAPACIDADE_AMOSTRAS + CAPTURAS_POR_PERIODO;
+
+// ----------------------------------------------------------------------
+// Pool de quadros: endereços usados nas conferências de cópia
+// ----------------------------------------------------------------------
+static const uint8_t* inicio_pool = nullptr;
+
+static bool dentro_do_pool(const void* p)
+{
+    const uint8_t* b = static_cast<const uint8_t*>(p);
+    return b >= inicio_pool && b < inicio_pool + CAPTURA_QUADROS * sizeof(QuadroAmostras);
+}
+
+/** Quadro que contém o endereço p (que deve estar no pool). */
+static uint8_t quadro_do_endereco(const void* p)
+{
+    return (uint8_t)((static_cast<const uint8_t*>(p) - inicio_pool) / sizeof(QuadroAmostras));
+}
+
+// ----------------------------------------------------------------------
+// Sensores simulados: FIFO de 12 bytes por amostra a TAXA_FUSAO_HZ; o tronco
+// parado e a coxa oscilando em flexão em torno de X (a gravidade gira no
+// plano YZ do sensor, o giroscópio mede a derivada do ângulo)
+// ----------------------------------------------------------------------
+struct SensorSimulado {
+    uint32_t produzidas;   ///< Amostras geradas desde o início (índice de tempo)
+    uint16_t na_fifo;      ///< Amostras à espera na FIFO (as mais recentes)
+    bool transbordou;      ///< A FIFO cheia sobrescreveu amostras: INT_STATUS sinaliza
+    uint32_t ultima_lida;  ///< Índice da última amostra lida
+};
+static SensorSimulado simulados[2];
+
+static const uint16_t CAPACIDADE_FIFO = 512 / MPU9250_FIFO_BYTES_AMOSTRA; // 42 amostras (84ms a 500Hz)
+
+static void produzir(SensorSimulado& simulado, uint16_t novas)
+{
+    simulado.produzidas += novas;
+    simulado.na_fifo = (uint16_t)(simulado.na_fifo + novas);
+    if (simulado.na_fifo > CAPACIDADE_FIFO)
+    {
+        simulado.na_fifo = CAPACIDADE_FIFO;
+        simulado.transbordou = true;
+    }
+}
+
+// Flexão da coxa na amostra k (rad): ±0,6 rad com período de 4s
+static const double AMPLITUDE_RAD = 0.6;
+static const double OMEGA_RAD_S = 2.0 * M_PI / 4.0;
+static double angulo_coxa(uint32_t amostra) { return AMPLITUDE_RAD * sin(OMEGA_RAD_S * amostra / TAXA_FUSAO_HZ); }
+static double velocidade_coxa(uint32_t amostra)
+{
+    return AMPLITUDE_RAD * OMEGA_RAD_S * cos(OMEGA_RAD_S * amostra / TAXA_FUSAO_HZ);
+}
+
+static const uint8_t ENDERECO_TRONCO = 0x68; // AD0 em 0
+static const uint8_t ENDERECO_COXA = 0x69;   // AD0 em 1
+
+static int sensor_do_endereco(uint8_t endereco) { return endereco == ENDERECO_TRONCO ? 0 : 1; }
+
+static void escrever_amostra(uint8_t* destino, int sensor, uint32_t amostra)
+{
+    double angulo = sensor == 0 ? 0.0 : angulo_coxa(amostra);
+    double giro_dps = sensor == 0 ? 0.0 : velocidade_coxa(amostra) * 180.0 / M_PI;
+    int16_t valores[6] = {0, (int16_t)lround(16384.0 * sin(angulo)), (int16_t)lround(16384.0 * cos(angulo)),
+                          (int16_t)lround(131.0 * giro_dps), 0, 0};
+    for (int k = 0; k < 6; k++)
+    {
+        destino[2 * k] = (uint8_t)(valores[k] >> 8);
+        destino[2 * k + 1] = (uint8_t)valores[k];
+    }
+}
+
+// ----------------------------------------------------------------------
+// Barramento, DMA e IRQ simulados: o teste faz o papel do controlador
+// ----------------------------------------------------------------------
+struct i2c_inst {
+    int id;
+};
+static i2c_inst barramento = {0};
+i2c_inst_t *i2c0 = &barramento, *i2c1 = &barramento;
+static i2c_hw_t registradores_i2c;
+
+static dma_hw_t registradores_dma;
+dma_hw_t* dma_hw = &registradores_dma;
+static int canais_dma = 0;
+static uint canal_rx = 0;
+static volatile void* destino_rx = nullptr;  // Leitura pendente (nullptr: nenhuma)
+static uint tamanho_rx = 0;
+static const volatile uint32_t* comandos_tx = nullptr;
+
+static irq_handler_t tratador_dma = nullptr;
+static repeating_timer_t* timer_captura = nullptr;
+
+static uint32_t leituras_de_dados = 0; // Leituras de FIFO_R_W e EXT_SENS_DATA, todas direto no quadro
+
+extern "C" {
+uint i2c_init(i2c_inst_t*, uint baudrate) { return baudrate; }
+i2c_hw_t* i2c_get_hw(i2c_inst_t*) { return &registradores_i2c; }
+uint i2c_get_dreq(i2c_inst_t*, bool is_tx) { return is_tx ? 1 : 2; }
+void gpio_init(uint) {}
+void gpio_set_dir(uint, bool) {}
+void gpio_put(uint, bool) {}
+void gpio_set_function(uint, enum gpio_function) {}
+void gpio_pull_up(uint) {}
+
+// Acessos bloqueantes (reinício das FIFOs): USER_CTRL com FIFO_RST esvazia a FIFO do sensor
+int i2c_write_blocking(i2c_inst_t*, uint8_t endereco, const uint8_t* origem, size_t tamanho, bool)
+{
+    if (tamanho > 1 && origem[0] == MPU9250_USER_CTRL && (origem[1] & USER_FIFO_RST))
+    {
+        SensorSimulado& simulado = simulados[sensor_do_endereco(endereco)];
+        simulado.na_fifo = 0;
+        simulado.transbordou = false;
+    }
+    return (int)tamanho;
+}
+
+int i2c_read_blocking(i2c_inst_t*, uint8_t, uint8_t* destino, size_t tamanho, bool)
+{
+    memset(destino, 0, tamanho);
+    return (int)tamanho;
+}
+
+int dma_claim_unused_channel(bool) { return canais_dma++; }
+dma_channel_config dma_channel_get_default_config(uint) { return dma_channel_config{0}; }
+void channel_config_set_transfer_data_size(dma_channel_config*, enum dma_channel_transfer_size) {}
+void channel_config_set_read_increment(dma_channel_config*, bool) {}
+void channel_config_set_write_increment(dma_channel_config*, bool) {}
+void channel_config_set_dreq(dma_channel_config* c, uint dreq) { c->ctrl = dreq; }
+
+// O canal de recepção (DREQ de RX) é configurado antes do de transmissão, que dispara a leitura
+void dma_channel_configure(uint canal, const dma_channel_config* config, volatile void* escrita,
+                           const volatile void* leitura, uint quantidade, bool)
+{
+    if (config->ctrl == 2)
+    {
+        canal_rx = canal;
+        destino_rx = escrita;
+        tamanho_rx = quantidade;
+    }
+    else
+    {
+        comandos_tx = static_cast<const volatile uint32_t*>(leitura);
+    }
+}
+
+void dma_channel_abort(uint canal)
+{
+    if (canal == canal_rx) destino_rx = nullptr;
+}
+void dma_channel_set_irq1_enabled(uint, bool) {}
+void dma_channel_acknowledge_irq1(uint) {}
+void irq_set_exclusive_handler(uint, irq_handler_t tratador) { tratador_dma = tratador; }
+void irq_set_enabled(uint, bool) {}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t*, int64_t delay_us, repeating_timer_callback_t callback,
+                                       void* user_data, repeating_timer_t* out)
+{
+    VERIFICAR(delay_us == -CAPTURA_PERIODO_US);
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    timer_captura = out;
+    return true;
+}
+bool cancel_repeating_timer(repeating_timer_t* timer)
+{
+    VERIFICAR(timer == timer_captura);
+    timer_captura = nullptr;
+    return true;
+}
+}
+
+/**
+ * Responde a leitura pendente como o sensor e chama a IRQ do DMA. Os bytes de
+ * dados precisam cair no quadro: em fifo[sensor].bytes ou em mag[sensor].
+ * @return false sem leitura pendente
+ */
+static bool completar_leitura()
+{
+    if (destino_rx == nullptr) return false;
+    uint8_t* destino = (uint8_t*)destino_rx;
+    uint n = tamanho_rx;
+    destino_rx = nullptr;
+
+    int sensor = sensor_do_endereco((uint8_t)registradores_i2c.tar);
+    SensorSimulado& simulado = simulados[sensor];
+    uint8_t registrador = (uint8_t)comandos_tx[0];
+    if (registrador == MPU9250_INT_STATUS)
+    {
+        destino[0] = simulado.transbordou ? INT_FIFO_OFLOW : 0; // A leitura limpa o status
+        simulado.transbordou = false;
+    }
+    else if (registrador == MPU9250_FIFO_COUNTH)
+    {
+        uint16_t bytes = (uint16_t)(simulado.na_fifo * MPU9250_FIFO_BYTES_AMOSTRA);
+        destino[0] = (uint8_t)(bytes >> 8);
+        destino[1] = (uint8_t)bytes;
+    }
+    else if (registrador == MPU9250_FIFO_R_W)
+    {
+        VERIFICAR(dentro_do_pool(destino));
+        VERIFICAR(destino == captura_quadro(quadro_do_endereco(destino)).fifo[sensor].bytes);
+        uint16_t amostras = (uint16_t)(n / MPU9250_FIFO_BYTES_AMOSTRA);
+        VERIFICAR(n % MPU9250_FIFO_BYTES_AMOSTRA == 0 && amostras <= simulado.na_fifo);
+        uint32_t primeira = simulado.produzidas - simulado.na_fifo;
+        for (uint16_t k = 0; k < amostras; k++)
+        {
+            escrever_amostra(destino + k * MPU9250_FIFO_BYTES_AMOSTRA, sensor, primeira + k);
+        }
+        simulado.na_fifo = (uint16_t)(simulado.na_fifo - amostras);
+        simulado.ultima_lida = primeira + amostras - 1;
+        leituras_de_dados++;
+    }
+    else if (registrador == MPU9250_EXT_SENS_DATA_00)
+    {
+        VERIFICAR(dentro_do_pool(destino));
+        VERIFICAR(destino == captura_quadro(quadro_do_endereco(destino)).mag[sensor]);
+        memset(destino, 0, n);
+        leituras_de_dados++;
+    }
+    else
+    {
+        VERIFICAR(!"registrador inesperado na captura");
+    }
+    tratador_dma();
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Agendador: o núcleo 1 roda um período por liberação do teste e para na
+// espera seguinte (os dois lados nunca rodam ao mesmo tempo)
+// ----------------------------------------------------------------------
+static std::atomic<uint32_t> periodos_liberados{0};
+static std::atomic<uint32_t> chegadas{0}; // Vezes que o núcleo 1 chegou a agendador_aguardar
+static uint32_t avaliacoes = 0;          // Escrito pelo núcleo 1 a cada avaliação
+
+extern "C" {
+void agendador_iniciar(agendador_t* agendador, uint32_t periodo_us, uint32_t orcamento_us, uint64_t agora_us)
+{
+    memset(agendador, 0, sizeof(*agendador));
+    agendador->periodo_us = periodo_us;
+    agendador->orcamento_us = orcamento_us;
+    agendador->inicio_us = agora_us;
+}
+
+bool agendador_iniciar_timer(agendador_t* agendador)
+{
+    static int pool;
+    agendador->pool = reinterpret_cast<alarm_pool_t*>(&pool);
+    return true;
+}
+
+void agendador_aguardar(agendador_t*)
+{
+    uint32_t atendidos = chegadas.fetch_add(1);
+    while (periodos_liberados.load() <= atendidos) std::this_thread::yield();
+}
+
+uint32_t agendador_comecar_periodo(agendador_t* agendador, uint64_t) { return ++agendador->periodos; }
+void agendador_terminar_periodo(agendador_t*, uint64_t) {}
+bool agendador_baixa_prioridade(const agendador_t*) { return true; } // Logs detalhados e amostras periódicas
+
+// Supervisor: batimentos e prazos das partes registradas pelo pipeline; a
+// verificação aponta a mais atrasada em relação ao prazo, como supervisor.c
+static const char* partes_nome[SUPERVISOR_MAXIMO_PARTES];
+static uint32_t partes_prazo_ms[SUPERVISOR_MAXIMO_PARTES];
+static uint32_t partes_ultimo_ms[SUPERVISOR_MAXIMO_PARTES];
+static int partes = 0;
+static int culpado_visto = SUPERVISOR_NENHUMA; // Último culpado apontado pelo núcleo 1
+
+int supervisor_registrar(const char* nome, uint32_t prazo_ms)
+{
+    partes_nome[partes] = nome;
+    partes_prazo_ms[partes] = prazo_ms;
+    partes_ultimo_ms[partes] = time_us_32() / 1000;
+    return partes++;
+}
+void supervisor_batimento(int parte) { partes_ultimo_ms[parte] = time_us_32() / 1000; }
+int supervisor_verificar(void)
+{
+    avaliacoes++; // Chamado logo após getPosition e dangerCheck
+    uint32_t agora_ms = time_us_32() / 1000;
+    int culpado = SUPERVISOR_NENHUMA;
+    uint32_t maior_excesso = 0;
+    for (int parte = 0; parte < partes; parte++)
+    {
+        uint32_t idade = agora_ms - partes_ultimo_ms[parte];
+        if (idade > partes_prazo_ms[parte] && idade - partes_prazo_ms[parte] > maior_excesso)
+        {
+            maior_excesso = idade - partes_prazo_ms[parte];
+            culpado = parte;
+        }
+    }
+    if (culpado != SUPERVISOR_NENHUMA) culpado_visto = culpado;
+    return culpado;
+}
+
+// Watchdog dos sensores e buzzer: sempre em dia, sem efeito
+void sensor_watchdog_feed(uint8_t, mpu9250_raw_data_t*) {}
+bool sensor_watchdog_update(void) { return false; }
+bool sensor_watchdog_is_sensor_frozen(uint8_t) { return false; }
+void sensor_watchdog_reset_system(void) { VERIFICAR(!"sensor travado"); }
+void buzzer_alarm_on(void) {}
+void buzzer_alarm_off(void) {}
+void buzzer_beep(void) {}
+
+// O núcleo 1 é uma thread
+void multicore_launch_core1_with_stack(void (*entrada)(void), uint32_t*, size_t)
+{
+    std::thread(entrada).detach();
+}
+}
+
+/** Libera um período e espera o núcleo 1 terminá-lo. */
+static void liberar_periodo()
+{
+    uint32_t liberados = ++periodos_liberados;
+    while (chegadas.load() <= liberados) std::this_thread::yield();
+}
+
+// ----------------------------------------------------------------------
+// Núcleo 0: o armazenamento confere cada amostra contra o quadro anotado
+// ----------------------------------------------------------------------
+static uint32_t amostras_gravadas = 0;
+static uint32_t ultimo_instante_ms = 0;
+
+bool armazenamento_aceita_evento(void) { return true; }
+ResultadoArmazenamento armazenamento_registrar_evento(const RegistroEvento&) { return ResultadoArmazenamento::ACEITO; }
+ResultadoArmazenamento armazenamento_registrar_diagnostico(const char*, ...) { return ResultadoArmazenamento::ACEITO; }
+
+// O índice ainda está em posse do núcleo 0: os ângulos vêm do quadro que getPosition anotou
+ResultadoArmazenamento armazenamento_registrar_amostra(const AmostraPostura& amostra)
+{
+    const QuadroAmostras* origem = nullptr;
+    for (uint8_t i = 0; i < CAPTURA_QUADROS; i++)
+    {
+        const QuadroAmostras& quadro = captura_quadro(i);
+        if (quadro.entregue && quadro.instante_us / 1000 == amostra.instante_ms) origem = &quadro;
+    }
+    VERIFICAR(origem != nullptr);
+    VERIFICAR(origem->avaliado && origem->orientacao.angulos_validos);
+    VERIFICAR(amostra.flexao == origem->orientacao.flexao && amostra.abducao == origem->orientacao.abducao);
+    VERIFICAR(amostra.rotacao == origem->orientacao.rotacao && amostra.incerteza == origem->orientacao.incerteza);
+    VERIFICAR(amostra.instante_ms > ultimo_instante_ms);
+    ultimo_instante_ms = amostra.instante_ms;
+    amostras_gravadas++;
+    return ResultadoArmazenamento::ACEITO;
+}
+
+// ----------------------------------------------------------------------
+// Percurso
+// ----------------------------------------------------------------------
+static uint32_t avaliacoes_conferidas = 0;
+static uint32_t anotadas_no_quadro = 0;
+static std::set<const Orientacao*> anotadas_fora; // Antes do primeiro quadro e reavaliações de quadro entregue
+static float menor_flexao = 0.0f, maior_flexao = 0.0f;
+static bool medir_erro = false;                  // Fusão já convergida
+static float erro_maximo_graus[2] = {0.0f, 0.0f}; // Antes e depois do transbordo
+static int trecho = 0;                           // 0 antes do transbordo, 1 depois
+
+/**
+ * Após uma avaliação, getPosition (sem amostra nova, só devolve a última) deve
+ * apontar para a orientação anotada dentro de um quadro do pool, ou para uma
+ * das poucas orientações estáticas de analise_postural.cpp.
+ */
+static void conferir_avaliacao()
+{
+    if (avaliacoes == avaliacoes_conferidas) return;
+    avaliacoes_conferidas = avaliacoes;
+
+    const Orientacao& orientacao = getPosition();
+    if (dentro_do_pool(&orientacao))
+    {
+        QuadroAmostras& quadro = captura_quadro(quadro_do_endereco(&orientacao));
+        VERIFICAR(&orientacao == &quadro.orientacao);
+        VERIFICAR(quadro.avaliado);
+        anotadas_no_quadro++;
+    }
+    else
+    {
+        anotadas_fora.insert(&orientacao);
+    }
+    VERIFICAR(&getPosition() == &orientacao);
+
+    if (orientacao.angulos_validos)
+    {
+        if (orientacao.flexao < menor_flexao) menor_flexao = orientacao.flexao;
+        if (orientacao.flexao > maior_flexao) maior_flexao = orientacao.flexao;
+
+        // A flexão é rotação negativa em torno de X; a avaliação usa a última amostra integrada
+        float esperada = (float)(-angulo_coxa(simulados[1].ultima_lida) * 180.0 / M_PI);
+        float erro = fabsf(orientacao.flexao - esperada);
+        if (medir_erro && erro > erro_maximo_graus[trecho]) erro_maximo_graus[trecho] = erro;
+    }
+}
+
+/**
+ * Roda períodos do núcleo 1: em cada um, CAPTURAS_POR_PERIODO disparos da
+ * captura (com 2 ou 3 amostras novas por sensor, ~500Hz), o período do laço e
+ * o núcleo 0 (gravação, se ativo, e logs). Com a captura travada o timer não
+ * dispara e as amostras se acumulam nas FIFOs.
+ */
+static void rodar_periodos(uint32_t periodos, bool com_amostras, bool nucleo0_grava, bool captura_travada = false)
+{
+    static uint32_t disparos = 0;
+    for (uint32_t p = 0; p < periodos; p++)
+    {
+        for (uint32_t c = 0; c < CAPTURAS_POR_PERIODO; c++)
+        {
+            sdk_host_avancar_us(CAPTURA_PERIODO_US);
+            if (com_amostras)
+            {
+                uint16_t novas = disparos % 2 == 0 ? 2 : 3;
+                for (SensorSimulado& simulado : simulados) produzir(simulado, novas);
+            }
+            disparos++;
+            if (captura_travada) continue;
+            VERIFICAR(timer_captura->callback(timer_captura));
+            while (completar_leitura()) {}
+        }
+
+        liberar_periodo();
+        conferir_avaliacao();
+
+        if (nucleo0_grava) pipeline_encaminhar_armazenamento();
+        pipeline_servir_logs();
+    }
+}
+
+int main(void)
+{
+    // A saída dos logs do núcleo 1 vai para um arquivo, lido ao final
+    FILE* logs = tmpfile();
+    VERIFICAR(logs != nullptr);
+    fflush(stdout);
+    int stdout_original = dup(fileno(stdout));
+    dup2(fileno(logs), fileno(stdout));
+
+    sdk_host_definir_us(1000000);
+
+    static mpu9250_t sensores[2] = {};
+    for (int i = 0; i < 2; i++)
+    {
+        sensores[i].i2c = i2c0;
+        sensores[i].addr = i == 0 ? ENDERECO_TRONCO : ENDERECO_COXA;
+        sensores[i].id = (uint8_t)i;
+        sensores[i].accel_sensitivity = 16384.0f; // ±2g
+        sensores[i].gyro_sensitivity = 131.0f;    // ±250°/s
+    }
+    pipeline_lancar_nucleo1(sensores);
+    while (chegadas.load() == 0) std::this_thread::yield(); // Captura iniciada, núcleo 1 na primeira espera
+    VERIFICAR(timer_captura != nullptr && tratador_dma != nullptr);
+    inicio_pool = reinterpret_cast<const uint8_t*>(&captura_quadro(0));
+
+    // Sensores produzindo, com o núcleo 0 parado por um trecho
+    rodar_periodos(CONVERGENCIA_S * PERIODOS_POR_SEGUNDO, true, true);
+    medir_erro = true;
+    rodar_periodos((NUCLEO0_PARADO_DE_S - CONVERGENCIA_S) * PERIODOS_POR_SEGUNDO, true, true);
+    uint32_t gravadas_antes_da_parada = amostras_gravadas;
+    rodar_periodos((NUCLEO0_PARADO_ATE_S - NUCLEO0_PARADO_DE_S) * PERIODOS_POR_SEGUNDO, true, false);
+    VERIFICAR(amostras_gravadas == gravadas_antes_da_parada);
+    VERIFICAR(pipeline_estatisticas().amostras_perdidas > 0);
+    rodar_periodos((TRANSBORDO_EM_S - NUCLEO0_PARADO_ATE_S) * PERIODOS_POR_SEGUNDO, true, true);
+
+    // Captura travada além da capacidade das FIFOs (84ms) e da lacuna máxima integrada
+    VERIFICAR(captura_estatisticas().transbordos == 0);
+    trecho = 1;
+    rodar_periodos(TRAVAMENTO_MS * 1000 / PIPELINE_PERIODO_LEITURA_US, true, true, true);
+    VERIFICAR(simulados[0].transbordou && simulados[1].transbordou);
+    rodar_periodos((SEGUNDOS - TRANSBORDO_EM_S) * PERIODOS_POR_SEGUNDO, true, true);
+    VERIFICAR(culpado_visto == SUPERVISOR_NENHUMA); // Inclusive no travamento mais curto que o prazo
+
+    // Captura parada além do prazo da parte "sensores": o núcleo 1 continua
+    // batendo, mas sem amostras novas o supervisor aponta os sensores
+    rodar_periodos(2 * PIPELINE_PRAZO_SENSORES_MS * 1000 / PIPELINE_PERIODO_LEITURA_US, false, true, true);
+    VERIFICAR(culpado_visto != SUPERVISOR_NENHUMA);
+    const char* culpado_captura_parada = partes_nome[culpado_visto];
+    VERIFICAR(strcmp(culpado_captura_parada, "sensores") == 0);
+
+    // Sensores sem amostras novas: a fusão integra o que restou e o núcleo 0 devolve tudo
+    rodar_periodos(PERIODOS_POR_SEGUNDO, false, true);
+
+    fflush(stdout);
+    dup2(stdout_original, fileno(stdout));
+    close(stdout_original);
+
+    // O transbordo foi registrado uma vez, com a lacuna limitada
+    uint32_t avisos_transbordo = 0;
+    float lacuna_ms = 0.0f;
+    unsigned long total_transbordos = 0;
+    char linha[PIPELINE_TAMANHO_MENSAGEM + 64];
+    rewind(logs);
+    while (fgets(linha, sizeof(linha), logs))
+    {
+        const char* aviso = strstr(linha, "FIFO transbordou");
+        if (aviso == nullptr) continue;
+        avisos_transbordo++;
+        VERIFICAR(sscanf(aviso, "FIFO transbordou (lacuna de %f ms) - integrada com a última amostra (total: %lu)",
+                         &lacuna_ms, &total_transbordos) == 2);
+    }
+    fclose(logs);
+
+    EstatisticasCaptura captura = captura_estatisticas();
+    EstatisticasPipeline pipeline = pipeline_estatisticas();
+    printf("%u capturas | quadros: %u alocados, %u devolvidos, máximo %u em uso (limite %u de %u) | "
+           "amostras: %u gravadas, %u descartadas, %u sem par | %u avaliações anotadas no quadro | flexão %.1f° a %.1f°\n"
+           "transbordo: %u, lacuna integrada %.1f ms | erro máximo da flexão: %.2f° antes, %.2f° depois | "
+           "captura parada: culpado '%s'\n",
+           (unsigned)captura.capturas, (unsigned)captura.quadros_alocados, (unsigned)captura.quadros_devolvidos,
+           (unsigned)captura.quadros_maximo_em_uso, (unsigned)LIMITE_EM_USO, (unsigned)CAPTURA_QUADROS,
+           (unsigned)amostras_gravadas, (unsigned)pipeline.amostras_perdidas,
+           (unsigned)pipeline.amostras_sem_par, (unsigned)anotadas_no_quadro,
+           menor_flexao, maior_flexao, (unsigned)captura.transbordos, lacuna_ms, erro_maximo_graus[0],
+           erro_maximo_graus[1], culpado_captura_parada);
+
+    // Captura: todo disparo teve quadro, todo dado foi lido direto nele
+    VERIFICAR(captura.capturas > 0 && leituras_de_dados > 0);
+    VERIFICAR(captura.capturas_adiadas == 0 && captura.falhas_barramento == 0);
+    VERIFICAR(pipeline.amostras_sem_par == 0); // Sensores no mesmo ritmo: toda amostra tem par
+
+    // Transbordo: contado na captura e na fusão, lacuna limitada e registrada uma vez,
+    // e o erro do ângulo volta ao patamar de antes (sem degrau)
+    VERIFICAR(captura.transbordos == 2); // Um por sensor; a fusão conta o quadro uma vez
+    VERIFICAR(avisos_transbordo == 1 && total_transbordos == 1);
+    VERIFICAR(fabsf(lacuna_ms - LACUNA_MAXIMA_MS) < 0.05f);
+    VERIFICAR(erro_maximo_graus[1] <= 1.5f * erro_maximo_graus[0] + 1.0f);
+
+    // Todo quadro alocado voltou ao pool, menos o recente (anotado por getPosition,
+    // liberado só quando a fusão integra um quadro mais novo)
+    VERIFICAR(captura.quadros_alocados == captura.quadros_devolvidos + 1);
+    VERIFICAR(captura.quadros_maximo_em_uso <= LIMITE_EM_USO);
+    VERIFICAR(captura.quadros_maximo_em_uso >= PIPELINE_CAPACIDADE_AMOSTRAS); // A parada do núcleo 0 encheu a posse dele
+
+    // Amostras: uma por segundo fora da parada, lidas do quadro anotado
+    VERIFICAR(amostras_gravadas >= SEGUNDOS - (NUCLEO0_PARADO_ATE_S - NUCLEO0_PARADO_DE_S) - 2);
+    VERIFICAR(anotadas_no_quadro > 0 && anotadas_fora.size() <= 2);
+    VERIFICAR(maior_flexao - menor_flexao > 10.0f); // A coxa oscilou: as amostras não são todas iguais
+    return 0;
+}
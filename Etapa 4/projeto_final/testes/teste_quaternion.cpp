@@ -0,0 +1,181 @@
+// ======================================================================
+//  Arquivo: teste_quaternion.cpp
+//  Descrição: Cadeia de getPosition com QuaternionUnitario (quaternion.hpp)
+//             contra a cadeia antiga, que renormalizava a cada produto:
+//             mesmos ângulos articulares e o tempo por avaliação
+// ======================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include "cronometro.h"
+#include "quaternion.hpp"
+#include "teste.h"
+
+#define AMOSTRAS_MEDIDAS 4096
+#define REPETICOES 50
+#define ERRO_NORMA_MADGWICK 0.002 // Raiz inversa rápida do Madgwick (motor_fusao.hpp)
+#define TOLERANCIA_RAD 1e-4
+
+static uint32_t semente = 36;
+
+/** Uniforme em [-1, 1). */
+static double aleatorio(void)
+{
+    semente = semente * 1664525u + 1013904223u;
+    return (double)(semente >> 8) / (double)(1u << 23) - 1.0;
+}
+
+/** Orientação ao acaso com a norma desviada de até ±desvio (o que o filtro entrega). */
+static Quaternion orientacao_aleatoria(double desvio)
+{
+    double w = aleatorio(), x = aleatorio(), y = aleatorio(), z = aleatorio();
+    double escala = (1.0 + desvio * aleatorio()) / std::sqrt(w * w + x * x + y * y + z * z);
+    return { (float)(w * escala), (float)(x * escala), (float)(y * escala), (float)(z * escala) };
+}
+
+// ----------------------------------------------------------------------
+// Cadeia antiga: normalização em cada produto, no relativo e na extração
+// ----------------------------------------------------------------------
+static Quaternion normalizar_antigo(Quaternion q)
+{
+    float norma = sqrtf(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (norma > 0.0f)
+    {
+        float inv = 1.0f / norma;
+        q.w *= inv; q.x *= inv; q.y *= inv; q.z *= inv;
+    }
+    else
+    {
+        q.w = 1.0f; q.x = q.y = q.z = 0.0f;
+    }
+    return q;
+}
+
+static Quaternion multiplicar_antigo(Quaternion a, Quaternion b)
+{
+    return normalizar_antigo((QuaternionLivre::deC(a) * QuaternionLivre::deC(b)).paraC());
+}
+
+/** As sete raízes e divisões da versão anterior de getPosition. */
+static void cadeia_antiga(const Quaternion entrada[4], float angulos[3])
+{
+    Quaternion q_tronco = multiplicar_antigo(entrada[0], entrada[2]);
+    Quaternion q_coxa = multiplicar_antigo(entrada[1], entrada[3]);
+    q_tronco = normalizar_antigo(q_tronco);
+    q_coxa = normalizar_antigo(q_coxa);
+    Quaternion q_rel = normalizar_antigo(multiplicar_antigo(quaternion_conjugate(q_tronco), q_coxa));
+    quaternion_to_hip_angles(normalizar_antigo(q_rel), &angulos[0], &angulos[1], &angulos[2]);
+}
+
+// ----------------------------------------------------------------------
+// Cadeia atual (getPosition)
+// ----------------------------------------------------------------------
+/**
+ * @param normalizar_filtro true para o Madgwick (uma normalização por
+ *        orientação); false para os filtros que já normalizam com sqrtf
+ */
+static void cadeia_nova(const Quaternion entrada[4], bool normalizar_filtro, float angulos[3])
+{
+    QuaternionUnitario sensor[2];
+    for (int i = 0; i < 2; i++)
+    {
+        sensor[i] = normalizar_filtro ? QuaternionUnitario::normalizar(QuaternionLivre::deC(entrada[i]))
+                                      : QuaternionUnitario::confiarUnitario(entrada[i]);
+    }
+    QuaternionUnitario q_tronco = sensor[0] * QuaternionUnitario::confiarUnitario(entrada[2]);
+    QuaternionUnitario q_coxa = sensor[1] * QuaternionUnitario::confiarUnitario(entrada[3]);
+    QuaternionUnitario q_rel = relativo(q_tronco, q_coxa);
+    quaternion_to_hip_angles(q_rel.paraC(), &angulos[0], &angulos[1], &angulos[2]);
+}
+
+// Entradas: orientações do tronco e da coxa, alinhamentos do tronco e da coxa
+static Quaternion entradas[AMOSTRAS_MEDIDAS][4];
+
+static void gerar_entradas(double desvio_filtro)
+{
+    for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+    {
+        entradas[k][0] = orientacao_aleatoria(desvio_filtro);
+        entradas[k][1] = orientacao_aleatoria(desvio_filtro);
+        entradas[k][2] = orientacao_aleatoria(0.0); // Alinhamento: unitário (Shepperd)
+        entradas[k][3] = orientacao_aleatoria(0.0);
+    }
+}
+
+/** Maior diferença entre os ângulos das duas cadeias (rad). */
+static double maior_diferenca(bool normalizar_filtro)
+{
+    double maior = 0.0;
+    for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+    {
+        float antigo[3], novo[3];
+        cadeia_antiga(entradas[k], antigo);
+        cadeia_nova(entradas[k], normalizar_filtro, novo);
+        for (int j = 0; j < 3; j++)
+        {
+            double d = std::fabs((double)antigo[j] - novo[j]);
+            if (d > M_PI) d = 2.0 * M_PI - d; // Mesmo ângulo dos dois lados de ±180°
+            if (d > maior) maior = d;
+        }
+    }
+    return maior;
+}
+
+// ----------------------------------------------------------------------
+// Testes
+// ----------------------------------------------------------------------
+// Madgwick (norma com erro de até 0,2%) e filtros em sqrtf: os mesmos ângulos da cadeia antiga
+static void testar_mesmos_angulos(void)
+{
+    gerar_entradas(ERRO_NORMA_MADGWICK);
+    double madgwick = maior_diferenca(true);
+    gerar_entradas(1e-7);
+    double sqrtf_filtros = maior_diferenca(false);
+    printf("diferença para a cadeia antiga: Madgwick %.2e rad, filtros em sqrtf %.2e rad: ok\n", madgwick,
+           sqrtf_filtros);
+    VERIFICAR(madgwick < TOLERANCIA_RAD);
+    VERIFICAR(sqrtf_filtros < TOLERANCIA_RAD);
+}
+
+// ----------------------------------------------------------------------
+// Desempenho
+// ----------------------------------------------------------------------
+template <typename Cadeia>
+static double medir(Cadeia cadeia)
+{
+    float soma = 0.0f;
+    uint64_t melhor = UINT64_MAX;
+    for (int r = 0; r < REPETICOES; r++)
+    {
+        uint64_t inicio = cronometro_ns();
+        for (int k = 0; k < AMOSTRAS_MEDIDAS; k++)
+        {
+            float angulos[3];
+            cadeia(entradas[k], angulos);
+            soma += angulos[0] + angulos[1] + angulos[2];
+        }
+        uint64_t decorrido = cronometro_ns() - inicio;
+        if (decorrido < melhor) melhor = decorrido;
+    }
+    cronometro_consumir(soma);
+    return (double)melhor / AMOSTRAS_MEDIDAS;
+}
+
+/** Só informativo: no RP2040 (raiz e divisão em software) os tempos reais vêm de medicao.h. */
+static void medir_desempenho(void)
+{
+    gerar_entradas(ERRO_NORMA_MADGWICK);
+    double antiga = medir([](const Quaternion e[4], float a[3]) { cadeia_antiga(e, a); });
+    double madgwick = medir([](const Quaternion e[4], float a[3]) { cadeia_nova(e, true, a); });
+    double sqrtf_filtros = medir([](const Quaternion e[4], float a[3]) { cadeia_nova(e, false, a); });
+    printf("ns por avaliação: cadeia antiga (7 raízes) %.1f, Madgwick (2) %.1f, filtros em sqrtf (0) %.1f\n",
+           antiga, madgwick, sqrtf_filtros);
+}
+
+int main(void)
+{
+    testar_mesmos_angulos();
+    medir_desempenho();
+    return 0;
+}
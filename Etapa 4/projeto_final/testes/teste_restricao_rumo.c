@@ -0,0 +1,210 @@
+// ======================================================================
+//  Arquivo: teste_restricao_rumo.c
+//  Descrição: Restrição de rumo articular sobre a deriva do bias do
+//             giroscópio sem magnetômetro: ciclos de em pé, andando e
+//             sentado com o Madgwick só com a gravidade, com e sem a
+//             correção de restricao_rumo_calcular
+// ======================================================================
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "MadgwickAHRS.h"
+#include "restricao_rumo.h"
+#include "teste.h"
+
+#define TAXA_HZ 500.0f // TAXA_FUSAO_HZ
+#define DT (1.0 / TAXA_HZ)
+#define GRAU (M_PI / 180.0)
+#define EM_PE_S 30.0
+#define ANDANDO_S 30.0
+#define SENTADO_S 60.0
+#define CICLO_S (EM_PE_S + ANDANDO_S + SENTADO_S)
+#define CICLOS 5                // 10 minutos
+#define GIRO2_PARADO 0.12       // MonitorConvergencia::GIRO2_MAXIMO
+
+enum { TRONCO = 0, COXA = 1 };
+
+typedef struct
+{
+    double w, x, y, z;
+} quat_t;
+
+static quat_t multiplicar(quat_t a, quat_t b)
+{
+    quat_t r = {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z, a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x, a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+    return r;
+}
+
+static quat_t conjugado(quat_t q)
+{
+    quat_t r = {q.w, -q.x, -q.y, -q.z};
+    return r;
+}
+
+static quat_t eixo_angulo(double x, double y, double z, double angulo)
+{
+    double s = sin(0.5 * angulo);
+    quat_t r = {cos(0.5 * angulo), x * s, y * s, z * s};
+    return r;
+}
+
+/** Ruído gaussiano (Box-Muller sobre um LCG), reprodutível em qualquer libc. */
+static double gaussiano(void)
+{
+    static uint32_t estado = 40;
+    double u[2];
+    for (int i = 0; i < 2; i++)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        u[i] = ((estado >> 8) + 0.5) / (double)(1u << 24);
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+/**
+ * Orientação verdadeira dos segmentos (segmento -> Terra): em pé o eixo
+ * longitudinal Y aponta para cima (X de flexão horizontal). Andando, a coxa
+ * oscila ±25° a 1Hz; sentado, o quadril fica fletido 90° e o tronco, 10°
+ * inclinado para a frente.
+ */
+static void postura_em(double t, quat_t q[2])
+{
+    const quat_t EM_PE = eixo_angulo(1.0, 0.0, 0.0, 90.0 * GRAU);
+    double fase = fmod(t, CICLO_S);
+    double flexao = 0.0, inclinacao = 0.0;
+    if (fase >= EM_PE_S && fase < EM_PE_S + ANDANDO_S)
+    {
+        flexao = 25.0 * GRAU * sin(2.0 * M_PI * (fase - EM_PE_S));
+    }
+    else if (fase >= EM_PE_S + ANDANDO_S)
+    {
+        // Senta e levanta em 1s cada (cosseno entre as posturas)
+        double s = fase - EM_PE_S - ANDANDO_S;
+        double transicao = s < 1.0 ? s : (s > SENTADO_S - 1.0 ? SENTADO_S - s : 1.0);
+        double peso = 0.5 - 0.5 * cos(M_PI * transicao);
+        flexao = 90.0 * GRAU * peso;
+        inclinacao = 10.0 * GRAU * peso;
+    }
+    q[TRONCO] = multiplicar(EM_PE, eixo_angulo(1.0, 0.0, 0.0, -inclinacao));
+    q[COXA] = multiplicar(EM_PE, eixo_angulo(1.0, 0.0, 0.0, -flexao));
+}
+
+/** Ângulo (graus) entre a orientação relativa estimada (tronco⁻¹ ⊗ coxa) e a verdadeira. */
+static double erro_relativo(const AHRS_batch_t *lote, const quat_t verdade[2])
+{
+    quat_t estimado[2];
+    for (int i = 0; i < 2; i++)
+    {
+        quat_t q = {lote->q0[i], lote->q1[i], lote->q2[i], lote->q3[i]};
+        double n = sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+        quat_t normalizado = {q.w / n, q.x / n, q.y / n, q.z / n};
+        estimado[i] = normalizado;
+    }
+    quat_t rel_est = multiplicar(conjugado(estimado[TRONCO]), estimado[COXA]);
+    quat_t rel_ver = multiplicar(conjugado(verdade[TRONCO]), verdade[COXA]);
+    double d = fabs(rel_est.w * rel_ver.w + rel_est.x * rel_ver.x + rel_est.y * rel_ver.y + rel_est.z * rel_ver.z);
+    return 2.0 * acos(d > 1.0 ? 1.0 : d) / GRAU;
+}
+
+/**
+ * Roda o traço com o bias residual dos giroscópios (a deriva de rumo relativo
+ * é de ~0,3°/s em pé) e devolve o maior erro relativo e o erro ao fim de cada
+ * trecho em pé.
+ */
+static void rodar(bool com_restricao, double *maior, double fim_em_pe[CICLOS])
+{
+    static const double BIAS[2][3] = {{0.001, 0.003, -0.001}, {-0.0015, -0.002, 0.001}}; // rad/s
+
+    AHRS_batch_t lote;
+    restricao_rumo_t restricao;
+    MadgwickAHRSbatchInit(&lote, 2, TAXA_HZ);
+    restricao_rumo_iniciar(&restricao);
+
+    quat_t verdade[2];
+    postura_em(0.0, verdade);
+    for (int i = 0; i < 2; i++)
+    {
+        lote.q0[i] = (float)verdade[i].w; lote.q1[i] = (float)verdade[i].x;
+        lote.q2[i] = (float)verdade[i].y; lote.q3[i] = (float)verdade[i].z;
+    }
+
+    *maior = 0.0;
+    const uint32_t amostras = (uint32_t)(CICLOS * CICLO_S * TAXA_HZ);
+    for (uint32_t k = 0; k < amostras; k++)
+    {
+        double t = k * DT;
+        quat_t proximo[2];
+        postura_em(t, verdade);
+        postura_em(t + DT, proximo);
+
+        bool parado = true;
+        for (int i = 0; i < 2; i++)
+        {
+            // Giro no referencial do segmento (2 vec(q* ⊗ q') / dt) e gravidade (q* ⊗ Z ⊗ q)
+            quat_t d = multiplicar(conjugado(verdade[i]), proximo[i]);
+            quat_t z = {0.0, 0.0, 0.0, 1.0};
+            quat_t g = multiplicar(multiplicar(conjugado(verdade[i]), z), verdade[i]);
+            lote.gx[i] = (float)(2.0 * d.x / DT + BIAS[i][0] + 0.003 * gaussiano());
+            lote.gy[i] = (float)(2.0 * d.y / DT + BIAS[i][1] + 0.003 * gaussiano());
+            lote.gz[i] = (float)(2.0 * d.z / DT + BIAS[i][2] + 0.003 * gaussiano());
+            lote.ax[i] = (float)(g.x + 0.01 * gaussiano());
+            lote.ay[i] = (float)(g.y + 0.01 * gaussiano());
+            lote.az[i] = (float)(g.z + 0.01 * gaussiano());
+            double giro2 = lote.gx[i] * lote.gx[i] + lote.gy[i] * lote.gy[i] + lote.gz[i] * lote.gz[i];
+            parado = parado && giro2 < GIRO2_PARADO;
+        }
+        MadgwickAHRSbatchUpdateIMU(&lote);
+
+        if (com_restricao)
+        {
+            Quaternion q_tronco = {lote.q0[TRONCO], lote.q1[TRONCO], lote.q2[TRONCO], lote.q3[TRONCO]};
+            Quaternion q_coxa = {lote.q0[COXA], lote.q1[COXA], lote.q2[COXA], lote.q3[COXA]};
+            float correcao = restricao_rumo_calcular(&restricao, q_tronco, q_coxa, parado, (float)DT);
+            if (correcao != 0.0f)
+            {
+                // Giro da coxa em torno da vertical da Terra (MotorFusao::girarRumo)
+                quat_t giro = eixo_angulo(0.0, 0.0, 1.0, correcao);
+                quat_t coxa = {q_coxa.w, q_coxa.x, q_coxa.y, q_coxa.z};
+                coxa = multiplicar(giro, coxa);
+                lote.q0[COXA] = (float)coxa.w; lote.q1[COXA] = (float)coxa.x;
+                lote.q2[COXA] = (float)coxa.y; lote.q3[COXA] = (float)coxa.z;
+            }
+        }
+
+        double erro = erro_relativo(&lote, verdade);
+        if (erro > *maior) *maior = erro;
+        uint32_t fim_trecho = (uint32_t)(EM_PE_S * TAXA_HZ) - 1;
+        if (k % (uint32_t)(CICLO_S * TAXA_HZ) == fim_trecho) fim_em_pe[k / (uint32_t)(CICLO_S * TAXA_HZ)] = erro;
+    }
+}
+
+// Sem a restrição o rumo relativo deriva sem limite; com ela o erro fica
+// limitado à deriva de um trecho sem correção e volta ao neutro em pé
+static void testar_deriva(void)
+{
+    double maior_livre, maior_restrito, fim_livre[CICLOS], fim_restrito[CICLOS];
+    rodar(false, &maior_livre, fim_livre);
+    rodar(true, &maior_restrito, fim_restrito);
+
+    printf("deriva em %d ciclos de %.0fs: sem restrição máximo %.1f°, fim %.1f° | "
+           "com restrição máximo %.1f°, em pé ao fim de cada ciclo:",
+           CICLOS, CICLO_S, maior_livre, fim_livre[CICLOS - 1], maior_restrito);
+    for (int c = 0; c < CICLOS; c++) printf(" %.2f°", fim_restrito[c]);
+    printf("\n");
+
+    VERIFICAR(fim_livre[CICLOS - 1] > 60.0);     // A deriva livre é a que se corrige
+    VERIFICAR(maior_restrito < 30.0);            // Limitado: não acumula entre ciclos
+    for (int c = 0; c < CICLOS; c++)
+    {
+        VERIFICAR(fim_restrito[c] < 3.0);        // Em pé e parado: de volta ao neutro
+        VERIFICAR(fim_restrito[c] < fim_livre[c]);
+    }
+}
+
+int main(void)
+{
+    testar_deriva();
+    return 0;
+}
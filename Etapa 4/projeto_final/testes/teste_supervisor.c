@@ -0,0 +1,197 @@
+// ======================================================================
+//  Arquivo: teste_supervisor.c
+//  Descrição: Supervisor do watchdog com relógio e watchdog simulados:
+//             alimentação só com todas as partes em dia, culpado de maior
+//             excesso nos registradores de rascunho e leitura após o reinício
+// ======================================================================
+
+#include <stdio.h>
+#include "hardware/watchdog.h"
+#include "pico/time.h"
+#include "sdk_host.h"
+#include "supervisor.h"
+#include "teste.h"
+
+// ----------------------------------------------------------------------
+// Watchdog simulado: conta as alimentações; os registradores sobrevivem ao "reinício"
+// ----------------------------------------------------------------------
+static watchdog_hw_t registradores;
+watchdog_hw_t *watchdog_hw = &registradores;
+static uint32_t alimentacoes = 0;
+static bool reinicio_pelo_watchdog = false;
+
+void watchdog_update(void) { alimentacoes++; }
+bool watchdog_caused_reboot(void) { return reinicio_pelo_watchdog; }
+
+// Partes do firmware, com os prazos de pipeline_sensores.h e tarefas_nucleo0.h
+static int nucleo1, sensores, nucleo0, armazenamento;
+
+static void reiniciar(bool pelo_watchdog)
+{
+    reinicio_pelo_watchdog = pelo_watchdog;
+    supervisor_iniciar();
+    nucleo1 = supervisor_registrar("nucleo1", 200);
+    sensores = supervisor_registrar("sensores", 500);
+    nucleo0 = supervisor_registrar("nucleo0", 1000);
+    armazenamento = supervisor_registrar("armazenamento", 2000);
+}
+
+// Partes que continuam batendo em simular
+typedef struct {
+    bool nucleo1, sensores, nucleo0, armazenamento;
+} vivas_t;
+
+static const vivas_t TODAS = {true, true, true, true};
+
+/**
+ * Simula ms milissegundos: o núcleo 1 bate a cada 2ms (com os sensores) e
+ * verifica a cada 20ms; o núcleo 0 bate e alimenta a cada 100ms.
+ * Retorna as alimentações; culpado recebe o último culpado visto pelo núcleo 0
+ * ou, se ele estiver parado, pelo núcleo 1.
+ */
+static uint32_t simular(uint32_t ms, vivas_t vivas, int *culpado)
+{
+    uint32_t alimentacoes_antes = alimentacoes;
+    *culpado = SUPERVISOR_NENHUMA;
+    for (uint32_t t = 0; t < ms; t++)
+    {
+        sdk_host_avancar_us(1000);
+        uint32_t agora = time_us_32() / 1000;
+        if (vivas.nucleo1 && agora % 2 == 0)
+        {
+            if (agora % 20 == 0)
+            {
+                int c = supervisor_verificar();
+                if (c != SUPERVISOR_NENHUMA && !vivas.nucleo0) *culpado = c;
+            }
+            supervisor_batimento(nucleo1);
+            if (vivas.sensores) supervisor_batimento(sensores);
+        }
+        if (vivas.nucleo0 && agora % 100 == 0)
+        {
+            if (vivas.armazenamento) supervisor_batimento(armazenamento);
+            supervisor_batimento(nucleo0);
+            int c = supervisor_alimentar();
+            if (c != SUPERVISOR_NENHUMA) *culpado = c;
+        }
+    }
+    return alimentacoes - alimentacoes_antes;
+}
+
+// ----------------------------------------------------------------------
+// Testes
+// ----------------------------------------------------------------------
+
+static void testar_todas_em_dia(void)
+{
+    int culpado;
+    reiniciar(false);
+    VERIFICAR(supervisor_culpado_reinicio(NULL) == SUPERVISOR_NENHUMA);
+    VERIFICAR(simular(5000, TODAS, &culpado) == 50);
+    VERIFICAR(culpado == SUPERVISOR_NENHUMA);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == 0);
+    printf("todas em dia: ok\n");
+}
+
+// Núcleo 1 parado: o núcleo 0 para de alimentar assim que o prazo vence
+static void testar_nucleo1_parado(void)
+{
+    int culpado;
+    vivas_t vivas = {false, false, true, true};
+    reiniciar(false);
+    simular(1000, TODAS, &culpado);
+
+    // Último batimento em t=1000; o prazo de 200ms vence entre as alimentações de 1200 e 1300
+    uint32_t feitas = simular(3000, vivas, &culpado);
+    VERIFICAR(feitas == 2);
+    VERIFICAR(culpado == nucleo1);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == SUPERVISOR_MAGICO);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_PARTE] == (uint32_t)nucleo1);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_IDADE] == 3000);
+
+    uint32_t idade_ms;
+    reiniciar(true);
+    VERIFICAR(supervisor_culpado_reinicio(&idade_ms) == nucleo1);
+    VERIFICAR(idade_ms == 3000);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == 0); // Lido uma vez só
+    printf("núcleo 1 parado: %u alimentações, culpado %s após %u ms: ok\n", (unsigned)feitas,
+           supervisor_nome(supervisor_culpado_reinicio(NULL)), (unsigned)idade_ms);
+}
+
+// Várias partes atrasadas: o culpado é a de maior excesso sobre o próprio prazo
+static void testar_maior_excesso(void)
+{
+    int culpado;
+    vivas_t so_nucleo1 = {true, false, false, false};
+    reiniciar(false);
+    simular(1000, TODAS, &culpado);
+
+    // Após 2600ms: sensores excedem 2100ms, núcleo 0 1600ms, armazenamento 600ms
+    uint32_t feitas = simular(2600, so_nucleo1, &culpado);
+    VERIFICAR(feitas == 0);
+    VERIFICAR(culpado == sensores);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_PARTE] == (uint32_t)sensores);
+
+    // O armazenamento para antes e o núcleo 0 depois: vence o maior excesso,
+    // não o menor prazo
+    vivas_t sem_armazenamento = {true, true, true, false};
+    reiniciar(false);
+    simular(1000, TODAS, &culpado);
+    simular(1500, sem_armazenamento, &culpado);
+    VERIFICAR(culpado == SUPERVISOR_NENHUMA); // 1500ms dentro do prazo de 2000
+    vivas_t nucleo0_parado = {true, true, false, false};
+    feitas = simular(3200, nucleo0_parado, &culpado);
+    VERIFICAR(feitas == 0);
+    VERIFICAR(culpado == armazenamento); // Excessos: armazenamento 2700ms, núcleo 0 2200ms
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_IDADE] == 4700);
+
+    reiniciar(true);
+    VERIFICAR(supervisor_culpado_reinicio(NULL) == armazenamento);
+    printf("culpado de maior excesso: ok\n");
+}
+
+// Atraso passageiro: o magic é apagado quando a alimentação volta, e não há culpado no boot
+static void testar_atraso_passageiro(void)
+{
+    int culpado;
+    vivas_t sem_nucleo1 = {false, true, true, true};
+    reiniciar(false);
+    simular(1000, TODAS, &culpado);
+    simular(300, sem_nucleo1, &culpado);
+    VERIFICAR(culpado == nucleo1);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == SUPERVISOR_MAGICO);
+
+    VERIFICAR(simular(1000, TODAS, &culpado) == 10);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == 0);
+    reiniciar(true);
+    VERIFICAR(supervisor_culpado_reinicio(NULL) == SUPERVISOR_NENHUMA);
+    printf("atraso passageiro: ok\n");
+}
+
+// Registradores com culpado, mas o reinício não foi pelo watchdog: nada é lido
+static void testar_reinicio_sem_watchdog(void)
+{
+    watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] = SUPERVISOR_MAGICO;
+    watchdog_hw->scratch[SUPERVISOR_SCRATCH_PARTE] = 1;
+    reiniciar(false);
+    VERIFICAR(supervisor_culpado_reinicio(NULL) == SUPERVISOR_NENHUMA);
+    VERIFICAR(watchdog_hw->scratch[SUPERVISOR_SCRATCH_MAGICO] == 0);
+
+    // Registro além da tabela
+    for (int i = supervisor_registrar("extra", 100); i != SUPERVISOR_NENHUMA; i = supervisor_registrar("extra", 100))
+    {
+        VERIFICAR(i < SUPERVISOR_MAXIMO_PARTES);
+    }
+    printf("reinício sem watchdog: ok\n");
+}
+
+int main(void)
+{
+    sdk_host_definir_us(10000000);
+    testar_todas_em_dia();
+    testar_nucleo1_parado();
+    testar_maior_excesso();
+    testar_atraso_passageiro();
+    testar_reinicio_sem_watchdog();
+    return 0;
+}
@@ -0,0 +1,202 @@
+// ======================================================================
+//  Arquivo: teste_swing_twist.c
+//  Descrição: Extrator swing-twist dos ângulos do quadril nas
+//             singularidades (compilado com ANGULOS_SWING_TWIST) e os testes
+//             de limite sem trigonometria nos dois extratores, em float e em
+//             ponto fixo
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "algoritmo_postura.h"
+#include "teste.h"
+
+#define GRAU (M_PI / 180.0)
+#define TOLERANCIA_GRAUS 0.01 // Erro das aproximações de trig_rapida.h (< 0,005°) mais o arredondamento em float
+#define TOLERANCIA_ASIN_UM_GRAUS 0.05 // Em asin(±1), 1 ulp a menos no seno (1 - 6e-8) já vale 0,02°
+
+typedef struct
+{
+    double w, x, y, z;
+} quat_t;
+
+static quat_t multiplicar(quat_t a, quat_t b)
+{
+    quat_t r = {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z, a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x, a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+    return r;
+}
+
+static quat_t eixo_angulo(double ax, double ay, double az, double angulo)
+{
+    double n = sqrt(ax * ax + ay * ay + az * az);
+    if (n < 1e-15)
+    {
+        quat_t identidade = {1.0, 0.0, 0.0, 0.0};
+        return identidade;
+    }
+    double s = sin(angulo / 2.0) / n;
+    quat_t q = {cos(angulo / 2.0), ax * s, ay * s, az * s};
+    return q;
+}
+
+#ifdef ANGULOS_SWING_TWIST
+/**
+ * Pose anatômica pela definição do swing-twist (graus): o fêmur (Y) aponta
+ * para d, com flexão no plano sagital e adução para fora dele; o balanço é a
+ * menor rotação de Y até d, seguido da torção em torno de Y.
+ */
+static quat_t pose(double flexao, double aducao, double rotacao)
+{
+    double roll = -flexao * GRAU, a = aducao * GRAU;
+    double d[3] = {-sin(a), cos(a) * cos(roll), cos(a) * sin(roll)};
+    double angulo = acos(fmax(-1.0, fmin(1.0, d[1])));
+    return multiplicar(eixo_angulo(d[2], 0.0, -d[0], angulo), eixo_angulo(0.0, 1.0, 0.0, rotacao * GRAU));
+}
+#else
+/** Pose anatômica pela sequência XYZ (graus): q = Rz(adução) ⊗ Ry(rotação) ⊗ Rx(-flexão). */
+static quat_t pose(double flexao, double aducao, double rotacao)
+{
+    return multiplicar(multiplicar(eixo_angulo(0.0, 0.0, 1.0, aducao * GRAU), eixo_angulo(0.0, 1.0, 0.0, rotacao * GRAU)),
+                       eixo_angulo(1.0, 0.0, 0.0, -flexao * GRAU));
+}
+#endif
+
+static Quaternion para_float(quat_t q)
+{
+    Quaternion r = {(float)q.w, (float)q.x, (float)q.y, (float)q.z};
+    return r;
+}
+
+static void angulos_graus(quat_t q, double saida[3])
+{
+    float flexao, aducao, rotacao;
+    quaternion_to_hip_angles(para_float(q), &flexao, &aducao, &rotacao);
+    VERIFICAR(isfinite(flexao) && isfinite(aducao) && isfinite(rotacao));
+    saida[0] = flexao / GRAU;
+    saida[1] = aducao / GRAU;
+    saida[2] = rotacao / GRAU;
+}
+
+static uint32_t semente = 7;
+static double aleatorio(void)
+{
+    semente = semente * 1664525u + 1013904223u;
+    return (semente >> 8) / 8388608.0 - 1.0;
+}
+
+#ifdef ANGULOS_SWING_TWIST
+static double volta(double a)
+{
+    while (a > 180.0) a -= 360.0;
+    while (a < -180.0) a += 360.0;
+    return a;
+}
+
+/** Maior variação de ângulo (graus) por grau de perturbação aleatória de 0,1° em torno da pose. */
+static double ganho_perturbacao(quat_t q)
+{
+    double base[3], maior = 0.0;
+    angulos_graus(q, base);
+    for (int t = 0; t < 200; t++)
+    {
+        double perturbado[3];
+        angulos_graus(multiplicar(q, eixo_angulo(aleatorio(), aleatorio(), aleatorio(), 0.1 * GRAU)), perturbado);
+        for (int j = 0; j < 3; j++)
+        {
+            double g = fabs(volta(perturbado[j] - base[j])) / 0.1;
+            if (g > maior) maior = g;
+        }
+    }
+    return maior;
+}
+
+/**
+ * Rotação de ±90° em torno do fêmur é a singularidade do asin da sequência
+ * XYZ; no swing-twist ela é uma pose comum: ângulos exatos e uma perturbação
+ * de 0,1° mexe nos ângulos na mesma ordem de grandeza.
+ */
+static void testar_singularidade_euler(void)
+{
+    const double flexoes[] = {0.0, 45.0, 90.0, 120.0};
+    for (int f = 0; f < 4; f++)
+        for (double rotacao = -90.0; rotacao <= 90.0; rotacao += 0.5)
+        {
+            double v[3] = {flexoes[f], 10.0, rotacao}, a[3];
+            quat_t q = pose(v[0], v[1], v[2]);
+            angulos_graus(q, a);
+            for (int j = 0; j < 3; j++) VERIFICAR(fabs(a[j] - v[j]) < TOLERANCIA_GRAUS);
+            if (fabs(rotacao) >= 85.0) VERIFICAR(ganho_perturbacao(q) < 2.0);
+        }
+}
+
+/**
+ * Degenerações do próprio swing-twist: coxa apontando lateralmente (adução de
+ * ±90°, flexão indefinida) e invertida (balanço de 180°). As saídas ficam
+ * finitas e o ângulo que continua definido é exato.
+ */
+static void testar_singularidades_swing_twist(void)
+{
+    for (double rotacao = -60.0; rotacao <= 60.0; rotacao += 15.0)
+    {
+        double a[3];
+        angulos_graus(pose(0.0, 90.0, rotacao), a);
+        VERIFICAR(fabs(a[1] - 90.0) < TOLERANCIA_ASIN_UM_GRAUS);
+        angulos_graus(pose(30.0, -90.0, rotacao), a);
+        VERIFICAR(fabs(a[1] + 90.0) < TOLERANCIA_ASIN_UM_GRAUS);
+    }
+
+    // Balanço de 180° em torno do eixo de flexão: w = y = 0, a torção é
+    // atan2(0, 0) = 0 (sem NaN) e a flexão é ±180°
+    quat_t invertida = {0.0, 1.0, 0.0, 0.0};
+    double a[3];
+    angulos_graus(invertida, a);
+    VERIFICAR(fabs(fabs(a[0]) - 180.0) < TOLERANCIA_GRAUS);
+    VERIFICAR(fabs(a[1]) < TOLERANCIA_GRAUS);
+    VERIFICAR(a[2] == 0.0);
+}
+#else
+/** Sequência XYZ longe do asin singular (rotação de ±90°): ângulos exatos na amplitude do quadril. */
+static void testar_xyz(void)
+{
+    for (double flexao = -20.0; flexao <= 120.0; flexao += 10.0)
+        for (double aducao = -40.0; aducao <= 40.0; aducao += 10.0)
+            for (double rotacao = -80.0; rotacao <= 80.0; rotacao += 10.0)
+            {
+                double v[3] = {flexao, aducao, rotacao}, a[3];
+                angulos_graus(pose(v[0], v[1], v[2]), a);
+                for (int j = 0; j < 3; j++) VERIFICAR(fabs(a[j] - v[j]) < TOLERANCIA_GRAUS);
+            }
+}
+#endif
+
+/** Os testes de limite sem trigonometria concordam com os ângulos longe da fronteira. */
+static void testar_limites(void)
+{
+    const double L[3] = {90.0, 30.0, 45.0};
+    limites_quadril_t limites;
+    hip_limits_define(&limites, (float)(L[0] * GRAU), (float)(L[1] * GRAU), (float)(L[2] * GRAU));
+    for (int i = 0; i < 200000; i++)
+    {
+        double v[3] = {aleatorio() * 150.0 + 45.0, aleatorio() * 85.0, aleatorio() * 120.0}, a[3];
+        quat_t q = pose(v[0], v[1], v[2]);
+        angulos_graus(q, a);
+        componentes_quadril_t c = quaternion_to_hip_components(para_float(q));
+        bool excede[3];
+        hip_components_exceed(&c, &limites, excede);
+        for (int j = 0; j < 3; j++)
+            if (fabs(a[j] - L[j]) > TOLERANCIA_GRAUS) VERIFICAR(excede[j] == (a[j] > L[j]));
+    }
+}
+
+int main(void)
+{
+#ifdef ANGULOS_SWING_TWIST
+    testar_singularidade_euler();
+    testar_singularidades_swing_twist();
+#else
+    testar_xyz();
+#endif
+    testar_limites();
+    return 0;
+}
@@ -0,0 +1,163 @@
+// ======================================================================
+//  Arquivo: teste_trig_rapida.c
+//  Descrição: Varredura dos erros de atan2 e asin aproximados (float e
+//             Q7.24) contra os limites declarados em trig_rapida.h, e o
+//             tempo por chamada contra atan2f/asinf da libm
+// ======================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include "cronometro.h"
+#include "trig_rapida.h"
+#include "teste.h"
+
+#define PASSOS 1000000
+#define Q24 16777216.0
+
+/** Diferença angular, com a volta em ±π tratada como erro nulo. */
+static double erro_angular(double a, double b)
+{
+    double d = fabs(a - b);
+    return d > M_PI ? 2.0 * M_PI - d : d;
+}
+
+/** Círculo completo em três raios (a redução de argumento não depende da escala). */
+static void testar_atan2(void)
+{
+    const double raios[] = {1.0, 1e-3, 37.0};
+    double maior_float = 0.0, maior_q24 = 0.0;
+    for (int i = 0; i <= PASSOS; i++)
+    {
+        double t = -M_PI + 2.0 * M_PI * i / PASSOS;
+        for (int r = 0; r < 3; r++)
+        {
+            float x = (float)(raios[r] * cos(t)), y = (float)(raios[r] * sin(t));
+            double erro = erro_angular(trig_atan2f(y, x), atan2((double)y, (double)x));
+            if (erro > maior_float) maior_float = erro;
+
+            int32_t xq = (int32_t)lrint(x * Q24), yq = (int32_t)lrint(y * Q24);
+            erro = erro_angular(trig_atan2_q24(yq, xq) / Q24, atan2((double)yq, (double)xq));
+            if (erro > maior_q24) maior_q24 = erro;
+        }
+    }
+    printf("atan2: float %.3g rad, Q7.24 %.3g rad\n", maior_float, maior_q24);
+    VERIFICAR(maior_float <= TRIG_ATAN2_ERRO_MAXIMO);
+    VERIFICAR(maior_q24 <= TRIG_ATAN2_ERRO_MAXIMO);
+
+    VERIFICAR(trig_atan2f(0.0f, 0.0f) == 0.0f);
+    VERIFICAR(trig_atan2_q24(0, 0) == 0);
+    VERIFICAR(fabs(trig_atan2f(0.0f, -1.0f) - M_PI) <= TRIG_ATAN2_ERRO_MAXIMO);
+    VERIFICAR(fabs(trig_atan2_q24(INT32_MIN, 0) / Q24 + M_PI / 2.0) <= TRIG_ATAN2_ERRO_MAXIMO);
+}
+
+/** Domínio [-1, 1] inteiro, mais a saturação fora dele. */
+static void testar_asin(void)
+{
+    double maior_float = 0.0, maior_q24 = 0.0;
+    for (int i = 0; i <= PASSOS; i++)
+    {
+        float x = (float)(-1.0 + 2.0 * i / PASSOS);
+        double erro = fabs(trig_asinf(x) - asin((double)x));
+        if (erro > maior_float) maior_float = erro;
+
+        int32_t xq = (int32_t)lrint(x * Q24);
+        erro = fabs(trig_asin_q24(xq) / Q24 - asin(xq / Q24));
+        if (erro > maior_q24) maior_q24 = erro;
+    }
+    printf("asin: float %.3g rad, Q7.24 %.3g rad\n", maior_float, maior_q24);
+    VERIFICAR(maior_float <= TRIG_ASIN_ERRO_MAXIMO);
+    VERIFICAR(maior_q24 <= TRIG_ASIN_ERRO_MAXIMO);
+
+    VERIFICAR(fabs(trig_asinf(1.5f) - M_PI / 2.0) <= TRIG_ASIN_ERRO_MAXIMO);
+    VERIFICAR(fabs(trig_asinf(-1.5f) + M_PI / 2.0) <= TRIG_ASIN_ERRO_MAXIMO);
+    VERIFICAR(fabs(trig_asin_q24(2 * TRIG_Q_UM) / Q24 - M_PI / 2.0) <= TRIG_ASIN_ERRO_MAXIMO);
+}
+
+// ----------------------------------------------------------------------
+// Desempenho: as mesmas entradas nas aproximações e na libm
+// ----------------------------------------------------------------------
+#define ENTRADAS_MEDIDAS 4096
+#define REPETICOES 200
+
+static float ys[ENTRADAS_MEDIDAS], xs[ENTRADAS_MEDIDAS], senos[ENTRADAS_MEDIDAS];
+static trig_q24_t ys_q24[ENTRADAS_MEDIDAS], xs_q24[ENTRADAS_MEDIDAS], senos_q24[ENTRADAS_MEDIDAS];
+
+/** Tempo médio, em ns, de uma chamada de f(y, x) sobre as entradas. */
+static double medir_atan2(float (*f)(float, float))
+{
+    float soma = 0.0f;
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int k = 0; k < ENTRADAS_MEDIDAS; k++) soma += f(ys[k], xs[k]);
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(soma);
+    return (double)decorrido / ((double)REPETICOES * ENTRADAS_MEDIDAS);
+}
+
+static double medir_asin(float (*f)(float))
+{
+    float soma = 0.0f;
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int k = 0; k < ENTRADAS_MEDIDAS; k++) soma += f(senos[k]);
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir(soma);
+    return (double)decorrido / ((double)REPETICOES * ENTRADAS_MEDIDAS);
+}
+
+static double medir_atan2_q24(void)
+{
+    uint32_t soma = 0; // Sem sinal: a soma pode dar a volta
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int k = 0; k < ENTRADAS_MEDIDAS; k++) soma += (uint32_t)trig_atan2_q24(ys_q24[k], xs_q24[k]);
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir((float)soma);
+    return (double)decorrido / ((double)REPETICOES * ENTRADAS_MEDIDAS);
+}
+
+static double medir_asin_q24(void)
+{
+    uint32_t soma = 0; // Sem sinal: a soma pode dar a volta
+    uint64_t inicio = cronometro_ns();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int k = 0; k < ENTRADAS_MEDIDAS; k++) soma += (uint32_t)trig_asin_q24(senos_q24[k]);
+    uint64_t decorrido = cronometro_ns() - inicio;
+    cronometro_consumir((float)soma);
+    return (double)decorrido / ((double)REPETICOES * ENTRADAS_MEDIDAS);
+}
+
+/**
+ * Só informativo: no host a libm usa a FPU; no RP2040 atan2f/asinf são
+ * emulados em software e os tempos reais vêm de medicao.h.
+ */
+static void medir_desempenho(void)
+{
+    uint32_t estado = 37;
+    for (int k = 0; k < ENTRADAS_MEDIDAS; k++)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        double t = -M_PI + 2.0 * M_PI * (estado >> 8) / (double)(1u << 24);
+        ys[k] = (float)sin(t);
+        xs[k] = (float)cos(t);
+        senos[k] = (float)sin(0.5 * t);
+        ys_q24[k] = (trig_q24_t)lrint(ys[k] * Q24);
+        xs_q24[k] = (trig_q24_t)lrint(xs[k] * Q24);
+        senos_q24[k] = (trig_q24_t)lrint(senos[k] * Q24);
+    }
+
+    double libm_atan2 = medir_atan2(atan2f), libm_asin = medir_asin(asinf);
+    double rapida_atan2 = medir_atan2(trig_atan2f), rapida_asin = medir_asin(trig_asinf);
+    printf("ns por chamada no host | atan2: libm %.1f, float %.1f (%.1fx), Q7.24 %.1f | "
+           "asin: libm %.1f, float %.1f (%.1fx), Q7.24 %.1f\n",
+           libm_atan2, rapida_atan2, libm_atan2 / rapida_atan2, medir_atan2_q24(), libm_asin, rapida_asin,
+           libm_asin / rapida_asin, medir_asin_q24());
+}
+
+int main(void)
+{
+    testar_atan2();
+    testar_asin();
+    medir_desempenho();
+    return 0;
+}